@@ -699,15 +699,77 @@ namespace Just
  */
 // #pragma once
 
-#ifdef _WIN32
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#endif
 
 namespace Just
 {
 	namespace Execute
 	{
+		/*!
+		 * \struct	ProcessUsage
+		 *
+		 * \brief	Resources an executed process consumed.
+		 * 			On Windows only the wall time is collected.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct ProcessUsage
+		{
+			// wall-clock time from spawn until the process was collected, in seconds
+			double WallTime = 0;
+
+			// CPU time spent in user mode and in kernel mode, in seconds
+			double UserTime = 0;
+			double SystemTime = 0;
+
+			// peak resident set size, in kilobytes
+			long long MaxRss = 0;
+
+			// page faults serviced without I/O (minor) and with I/O (major)
+			long long MinorFaults = 0;
+			long long MajorFaults = 0;
+
+			// block input / output operations
+			long long BlockReads = 0;
+			long long BlockWrites = 0;
+
+			// voluntary (waiting on something) and involuntary (preempted) context switches
+			long long VoluntarySwitches = 0;
+			long long InvoluntarySwitches = 0;
+
+			// bytes passed to read / write syscalls, and bytes that actually went to / from storage
+			long long ReadChars = 0;
+			long long WriteChars = 0;
+			long long StorageReadBytes = 0;
+			long long StorageWriteBytes = 0;
+
+			// return total CPU time (user + system)
+			inline double CpuTime() const { return UserTime + SystemTime; }
+		};
+
 		/*!
 		 * \struct	ProcessOutput
 		 *
@@ -727,12 +789,290 @@ namespace Just
 			// did process finish executing
 			bool DidFinish = false;
 
+			// resources the process consumed
+			ProcessUsage Usage;
+
+			// how many output bytes were dropped due to capture policy (Output holds the head followed by the tail)
+			unsigned long long DroppedBytes = 0;
+
+			// if output was spilled to a file due to capture policy, path of the file holding the complete output
+			std::string SpillPath;
+
 			// return if executed successfully and was a success
 			inline bool IsSuccess() const { return DidFinish && ReturnCode == 0; }
 		};
 
 		/*!
-		 * \fn	ProcessOutput Command(const std::string& command)
+		 * \struct	CapturePolicy
+		 *
+		 * \brief	How much of a process output to keep in memory.
+		 * 			By default everything is kept. With a byte budget, the first HeadBytes and the last
+		 * 			(MaxBytes - HeadBytes) bytes are kept, and the middle is dropped and counted, so memory
+		 * 			per executed process is bounded while the most useful parts are kept.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct CapturePolicy
+		{
+			// max output bytes to keep in memory, or 0 for unlimited
+			size_t MaxBytes = 0;
+
+			// how many of the MaxBytes are taken from the start of the output; the rest is taken from the end
+			size_t HeadBytes = 0;
+
+			// if not 0, once output exceeds this many bytes the complete output is written to a temp file.
+			// must not exceed MaxBytes (if it does, MaxBytes is used instead).
+			size_t SpillThreshold = 0;
+
+			// directory to create spill files in
+			std::string SpillDirectory = "/tmp";
+
+			// create a policy that keeps the first head bytes and the last tail bytes
+			static inline CapturePolicy HeadTail(size_t head, size_t tail)
+			{
+				CapturePolicy ret;
+				ret.MaxBytes = head + tail;
+				ret.HeadBytes = head;
+				return ret;
+			}
+		};
+
+		/*!
+		 * \class	__OutputCapture
+		 *
+		 * \brief	Used internally, collect process output according to a capture policy.
+		 * 			The tail is kept in a fixed-size ring buffer.
+		 */
+		class __OutputCapture
+		{
+			CapturePolicy _Policy;
+			size_t _HeadLimit;
+			size_t _TailLimit;
+			std::string _Head;
+			std::string _Tail;
+			size_t _TailPosition = 0;
+			unsigned long long _Total = 0;
+			FILE* _SpillFile = NULL;
+			std::string _SpillPath;
+
+			// create a temp file to spill output to
+			bool _OpenSpillFile()
+			{
+#ifdef _WIN32
+				char* name = _tempnam(_Policy.SpillDirectory.c_str(), "just_output_");
+				if (!name) return false;
+				_SpillPath = name;
+				free(name);
+				_SpillFile = fopen(_SpillPath.c_str(), "wb");
+#else
+				std::string pattern = _Policy.SpillDirectory + "/just_output_XXXXXX";
+				int fd = mkstemp(&pattern[0]);
+				if (fd == -1) return false;
+				_SpillPath = pattern;
+				_SpillFile = fdopen(fd, "wb");
+				if (!_SpillFile) close(fd);
+#endif
+				return _SpillFile != NULL;
+			}
+
+			// keep data in the tail ring buffer
+			void _AppendTail(const char* data, size_t size)
+			{
+				if (_TailLimit == 0) return;
+				if (size >= _TailLimit)
+				{
+					_Tail.assign(data + size - _TailLimit, _TailLimit);
+					_TailPosition = 0;
+					return;
+				}
+				if (_Tail.size() < _TailLimit)
+				{
+					size_t toAppend = (std::min)(size, _TailLimit - _Tail.size());
+					_Tail.append(data, toAppend);
+					data += toAppend;
+					size -= toAppend;
+					if (size == 0) return;
+				}
+				while (size)
+				{
+					size_t toCopy = (std::min)(size, _TailLimit - _TailPosition);
+					_Tail.replace(_TailPosition, toCopy, data, toCopy);
+					_TailPosition = (_TailPosition + toCopy) % _TailLimit;
+					data += toCopy;
+					size -= toCopy;
+				}
+			}
+
+		public:
+
+			__OutputCapture(const CapturePolicy& policy) : _Policy(policy)
+			{
+				_HeadLimit = (std::min)(policy.HeadBytes, policy.MaxBytes);
+				_TailLimit = policy.MaxBytes - _HeadLimit;
+				if (_Policy.MaxBytes && _Policy.SpillThreshold > _Policy.MaxBytes) _Policy.SpillThreshold = _Policy.MaxBytes;
+				_Tail.reserve(_TailLimit);
+			}
+
+			~__OutputCapture()
+			{
+				if (_SpillFile) fclose(_SpillFile);
+			}
+
+			// add output data
+			void Append(const char* data, size_t size)
+			{
+				// start spilling? write everything we have so far (nothing was dropped yet)
+				if (_Policy.SpillThreshold && !_SpillFile && _SpillPath.empty() && _Total + size > _Policy.SpillThreshold)
+				{
+					if (_OpenSpillFile()) fwrite(_Head.data(), 1, _Head.size(), _SpillFile);
+				}
+				if (_SpillFile) fwrite(data, 1, size, _SpillFile);
+				_Total += size;
+
+				// unlimited
+				if (_Policy.MaxBytes == 0)
+				{
+					_Head.append(data, size);
+					return;
+				}
+
+				// until budget is used, everything goes to head so output stays in order
+				if (_Head.size() < _Policy.MaxBytes && _Total - size == _Head.size())
+				{
+					size_t toAppend = (std::min)(size, _Policy.MaxBytes - _Head.size());
+					_Head.append(data, toAppend);
+					data += toAppend;
+					size -= toAppend;
+					if (size == 0) return;
+
+					// budget exceeded: move whatever is beyond the head limit into the tail ring
+					std::string overflow = _Head.substr(_HeadLimit);
+					_Head.resize(_HeadLimit);
+					_AppendTail(overflow.data(), overflow.size());
+				}
+				_AppendTail(data, size);
+			}
+
+			// move captured output into process output
+			void Finish(ProcessOutput& output)
+			{
+				output.Output = std::move(_Head);
+				if (_TailPosition == 0) output.Output += _Tail;
+				else
+				{
+					output.Output.append(_Tail, _TailPosition, std::string::npos);
+					output.Output.append(_Tail, 0, _TailPosition);
+				}
+				output.DroppedBytes = _Total - output.Output.size();
+				if (_SpillFile)
+				{
+					fclose(_SpillFile);
+					_SpillFile = NULL;
+					output.SpillPath = _SpillPath;
+				}
+			}
+		};
+
+		/*!
+		 * \struct	Options
+		 *
+		 * \brief	Scheduling and resource hints applied to an executed process before it runs its program:
+		 * 			CPU affinity, nice value, I/O priority, scheduling policy and address space / CPU time limits.
+		 * 			Unset fields are inherited from us. Applied on linux only.
+		 * 			If a hint can't be applied (for example raising priority without permission), the process
+		 * 			is not executed and reports exit code 127, like a program that failed to exec.
+		 * 			Trivially copyable, so it can be passed to a child that shares our memory or sent to the spawn server.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct Options
+		{
+			// I/O scheduling class (see ioprio_set)
+			enum class IoClass : int
+			{
+				Unset = 0,
+				RealTime = 1,
+				BestEffort = 2,
+				Idle = 3,
+			};
+
+			// CPU scheduling policy (see sched_setscheduler)
+			enum class Policy : int
+			{
+				Unset = -1,
+				Other = 0,
+				Fifo = 1,
+				RoundRobin = 2,
+				Batch = 3,
+				Idle = 5,
+			};
+
+			// max CPUs the affinity mask can hold
+			static const int MaxCpus = 1024;
+
+			// CPUs the process may run on, as a bit mask. empty mask = inherit
+			unsigned long long CpuMask[MaxCpus / 64] = {};
+
+			// nice value (-20 to 19), if SetNice is true
+			bool SetNice = false;
+			int Nice = 0;
+
+			// I/O priority class, and level inside the class (0 = highest, 7 = lowest)
+			IoClass IoPriorityClass = IoClass::Unset;
+			int IoPriorityLevel = 4;
+
+			// scheduling policy, and static priority for Fifo / RoundRobin (1 to 99)
+			Policy SchedPolicy = Policy::Unset;
+			int SchedPriority = 0;
+
+			// max virtual memory in bytes (RLIMIT_AS), or 0 to inherit
+			unsigned long long MaxAddressSpace = 0;
+
+			// max CPU time in seconds (RLIMIT_CPU), or 0 to inherit
+			unsigned long long MaxCpuSeconds = 0;
+
+			// allow running on a CPU
+			inline Options& AddCpu(int cpu)
+			{
+				if (cpu >= 0 && cpu < MaxCpus) CpuMask[cpu / 64] |= 1ULL << (cpu % 64);
+				return *this;
+			}
+
+			// check if CPU is in affinity mask
+			inline bool HasCpu(int cpu) const
+			{
+				return cpu >= 0 && cpu < MaxCpus && (CpuMask[cpu / 64] & (1ULL << (cpu % 64))) != 0;
+			}
+
+			// return if affinity mask is set
+			inline bool HasAffinity() const
+			{
+				for (auto word : CpuMask) if (word) return true;
+				return false;
+			}
+
+			// return if no hint is set
+			inline bool IsEmpty() const
+			{
+				return !HasAffinity() && !SetNice && IoPriorityClass == IoClass::Unset && SchedPolicy == Policy::Unset && MaxAddressSpace == 0 && MaxCpuSeconds == 0;
+			}
+
+			// create options for background work: lowest nice, idle I/O class and batch scheduling
+			static inline Options Background()
+			{
+				Options ret;
+				ret.SetNice = true;
+				ret.Nice = 19;
+				ret.IoPriorityClass = IoClass::Idle;
+				ret.IoPriorityLevel = 7;
+				ret.SchedPolicy = Policy::Batch;
+				return ret;
+			}
+		};
+
+#ifdef _WIN32
+		/*!
+		 * \fn	ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
 		 *
 		 * \brief	Executes a command.
 		 *
@@ -740,14 +1080,19 @@ namespace Just
 		 * \date	10/20/2018
 		 *
 		 * \param	command	The command to execute.
+		 * \param	capture	(Optional) How much of the output to keep.
+		 * \param	options	(Optional) Scheduling and resource hints (ignored on Windows).
 		 *
 		 * \return	A ProcessOutput.
 		 */
-		ProcessOutput Command(const std::string& command)
+		ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
 		{
+			(void)options;
 			ProcessOutput ret;
+			__OutputCapture output(capture);
 			char   psBuffer[128];
 			FILE   *pPipe;
+			auto start = std::chrono::steady_clock::now();
 
 			// run the command
 			if ((pPipe = _popen(command.c_str(), "rt")) == NULL)
@@ -758,8 +1103,9 @@ namespace Just
 			// read output
 			while (fgets(psBuffer, 128, pPipe))
 			{
-				ret.Output += psBuffer;
+				output.Append(psBuffer, strlen(psBuffer));
 			}
+			output.Finish(ret);
 
 			// close pipe and print return value of pPipe.
 			if (feof(pPipe))
@@ -769,968 +1115,10061 @@ namespace Just
 			}
 
 			// return data on execution
+			ret.Usage.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 			return ret;
 		}
-	}
-}
-#endif
-
+#else
+		/*!
+		 * \enum	SpawnMethod
+		 *
+		 * \brief	How child processes are spawned on linux.
+		 * 			Forking copies the page tables of the parent, so its cost grows with the parent's RSS.
+		 * 			The other methods don't copy the address space and their latency does not depend on it.
+		 */
+		enum class SpawnMethod
+		{
+			// classic fork + exec
+			Fork,
 
+			// clone(CLONE_VM | CLONE_VFORK): child borrows parent memory until exec
+			VFork,
 
-// ::Execute\Scripts.h::
+			// posix_spawn (on glibc, a vfork-style clone as well)
+			PosixSpawn,
 
-/*!
- * \file	Source\Execute\Scripts.h.
- *
- * \brief	Execute different scripts.
- */
-// #pragma once
+			// ask the pre-forked spawn server to launch the child (see SpawnServer.h).
+			// falls back to PosixSpawn if server is not running.
+			Server,
+		};
 
-#ifdef _WIN32
-// #include "Command.h"
+		// spawn method to use for all executed processes. atomic, since it may change while other threads spawn
+		inline std::atomic<SpawnMethod> _spawnMethod(SpawnMethod::PosixSpawn);
 
-namespace Just
-{
-	namespace Execute
-	{
 		/*!
-		 * \fn	ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string())
+		 * \fn	inline void SetSpawnMethod(SpawnMethod method)
 		 *
-		 * \brief	Executes the script operation
-		 *
-		 * \author	Ronen Ness
-		 * \date	10/20/2018
+		 * \brief	Sets how child processes are spawned for all execute functions.
 		 *
-		 * \param	scriptType	Type of the script (python / ruby / perl / ...).
-		 * \param	scriptPath	Full path of the script file to execute.
-		 * \param	params	  	(Optional) Script params.
+		 * \date	10/19/2026
 		 *
-		 * \return	A ProcessOutput.
+		 * \param	method	Spawn method.
 		 */
-		ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string())
+		inline void SetSpawnMethod(SpawnMethod method)
 		{
-			return Command(scriptType + " \"" + scriptPath + "\" " + params);
+			_spawnMethod.store(method, std::memory_order_release);
 		}
 
 		/*!
-		 * \fn	ProcessOutput PythonScript(const std::string& scriptPath, const std::string& params = std::string())
-		 *
-		 * \brief	Executes Python script.
+		 * \fn	inline SpawnMethod GetSpawnMethod()
 		 *
-		 * \author	Ronen Ness
-		 * \date	10/20/2018
+		 * \brief	Gets how child processes are spawned.
 		 *
-		 * \param	scriptPath	Full path of the script file to execute.
-		 * \param	params	  	(Optional) Params to pass to script.
+		 * \date	10/19/2026
 		 *
-		 * \return	A ProcessOutput.
+		 * \return	Spawn method.
 		 */
-		ProcessOutput PythonScript(const std::string& scriptPath, const std::string& params = std::string())
-		{
-			static std::string type = "python";
-			return Script(type, scriptPath, params);
-		}
-
-		/*!
-		* \fn	ProcessOutput PerlScript(const std::string& scriptPath, const std::string& params = std::string())
-		*
-		* \brief	Executes Perl script.
-		*
-		* \author	Ronen Ness
-		* \date	10/20/2018
-		*
-		* \param	scriptPath	Full path of the script file to execute.
-		* \param	params	  	(Optional) Params to pass to script.
-		*
-		* \return	A ProcessOutput.
-		*/
-		ProcessOutput PerlScript(const std::string& scriptPath, const std::string& params = std::string())
+		inline SpawnMethod GetSpawnMethod()
 		{
-			static std::string type = "perl";
-			return Script(type, scriptPath, params);
+			return _spawnMethod.load(std::memory_order_acquire);
 		}
 
 		/*!
-		* \fn	ProcessOutput RubyScript(const std::string& scriptPath, const std::string& params = std::string())
-		*
-		* \brief	Executes Ruby script.
-		*
-		* \author	Ronen Ness
-		* \date	10/20/2018
-		*
-		* \param	scriptPath	Full path of the script file to execute.
-		* \param	params	  	(Optional) Params to pass to script.
-		*
-		* \return	A ProcessOutput.
-		*/
-		ProcessOutput RubyScript(const std::string& scriptPath, const std::string& params = std::string())
+		 * \struct	__Child
+		 *
+		 * \brief	Used internally, a spawned child process.
+		 * 			Children launched by the spawn server are not our children, their exit status
+		 * 			is reported through StatusFd instead.
+		 */
+		struct __Child
 		{
-			static std::string type = "ruby";
-			return Script(type, scriptPath, params);
-		}
-	}
-}
-#endif
-
-
-
-// ::Http\HttpRequests.h::
-
-/*!
-* \file	Source\Http\HttpRequests.h.
-*
-* \brief	Send HTTP requests.
-*/
-// #pragma once
+			// process id, or -1 if failed to spawn
+			pid_t Pid = -1;
 
-#ifdef _WIN32
+			// socket to read exit status from, or -1 if this is our own child
+			int StatusFd = -1;
 
-#include <string.h>
-#include <windows.h>
-#include <sstream>
-#include <unordered_map>
-#include <winhttp.h>
-// #include "../Strings/To/All.h"
-// #include "../Strings/From/Maps.h"
+			// true if program could not be executed; reported as exit code 127 like the shell does
+			bool ExecFailed = false;
 
-#pragma comment(lib, "winhttp.lib")
+			inline bool IsValid() const { return Pid != -1 || ExecFailed; }
+		};
 
-namespace Just
-{
-	namespace Http
-	{
 		/*!
-		 * \enum	HttpConnectionErrors
+		 * \struct	__ChildStatus
 		 *
-		 * \brief	Values that represent HTTP connection errors.
+		 * \brief	Used internally, exit status and resource usage of a collected child.
 		 */
-		enum HttpConnectionErrors
+		struct __ChildStatus
 		{
-			NoError,
-			FailedToConnect,
-			FailedToOpenSession,
-			FailedToOpenRequest,
-			FailedToSendRequest,
-			FailedToReceiveResponse,
-			NoHttpDataAvailable,
-			FailedToReadHttpData,
-			ResponseError,
+			int Status;
+			struct rusage Usage;
+			long long ReadChars;
+			long long WriteChars;
+			long long StorageReadBytes;
+			long long StorageWriteBytes;
 		};
 
 		/*!
-		 * \struct	HttpResponse
+		 * \fn	inline void _ReadProcIo(pid_t pid, __ChildStatus& status)
 		 *
-		 * \brief	An HTTP response.
+		 * \brief	Used internally, read I/O counters of a process from /proc/<pid>/io.
+		 * 			Must be called before the process is reaped.
 		 *
-		 * \author	Ronen Ness
-		 * \date	10/19/2018
+		 * \date	10/19/2026
+		 *
+		 * \param	pid   	Process id.
+		 * \param	status	Status to fill.
 		 */
-		struct HttpResponse
+		inline void _ReadProcIo(pid_t pid, __ChildStatus& status)
 		{
-		public:
-			// returned text
-			std::string Text;
-
-			// how many bytes we read in total from response
-			unsigned int TotalBytesRead = 0;
-
-			// return if response was OK.
-			inline bool good() const { return Error == NoError; }
+			char path[64];
+			snprintf(path, sizeof(path), "/proc/%d/io", (int)pid);
+			FILE* file = fopen(path, "r");
+			if (!file) return;
+
+			char name[64];
+			long long value;
+			while (fscanf(file, "%63[^:]: %lld\n", name, &value) == 2)
+			{
+				std::string key(name);
+				if (key == "rchar") status.ReadChars = value;
+				else if (key == "wchar") status.WriteChars = value;
+				else if (key == "read_bytes") status.StorageReadBytes = value;
+				else if (key == "write_bytes") status.StorageWriteBytes = value;
+			}
+			fclose(file);
+		}
 
-			// error types we can get
-			HttpConnectionErrors Error = NoError;
+		/*!
+		 * \fn	inline bool _WaitChild(pid_t pid, __ChildStatus& status)
+		 *
+		 * \brief	Used internally, wait for one of our child processes to exit and reap it.
+		 * 			The child is first waited without being reaped, so its /proc entry can still be read.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	pid   	Child process id.
+		 * \param	status	Status to fill.
+		 *
+		 * \return	True if child was reaped.
+		 */
+		inline bool _WaitChild(pid_t pid, __ChildStatus& status)
+		{
+			memset(&status, 0, sizeof(status));
 
-			// error code / details (or 0 if no errors).
-			// not: this is not HTTP error codes you could get from server, its from errors you get from OS.
-			DWORD ErrorCode = 0;
-		};
+			// wait for exit, but leave the child as a zombie so we can read its I/O counters
+			siginfo_t info;
+			while (waitid(P_PID, (id_t)pid, &info, WEXITED | WNOWAIT) == -1 && errno == EINTR) {}
+			_ReadProcIo(pid, status);
 
-		// useragent string
-		std::string _useragent = "JUST Program/1.0";
+			// reap it and get its resource usage
+			pid_t result;
+			while ((result = wait4(pid, &status.Status, 0, &status.Usage)) == -1 && errno == EINTR) {}
+			return result == pid;
+		}
 
-		// To automatically release handles when out of scope.
-		class __HandlesReleaser
+		/*!
+		 * \fn	inline void _CollectProcess(const __Child& child, std::chrono::steady_clock::time_point start, ProcessOutput& ret)
+		 *
+		 * \brief	Used internally, wait for a child process to exit and fill its return code and resource usage.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	child	Spawned child.
+		 * \param	start	When the child was spawned.
+		 * \param	ret  	Output to fill.
+		 */
+		inline void _CollectProcess(const __Child& child, std::chrono::steady_clock::time_point start, ProcessOutput& ret)
 		{
-			HINTERNET _handle;
-		public:
-			__HandlesReleaser(HINTERNET handle)
+			__ChildStatus status;
+			bool collected;
+			if (child.ExecFailed)
 			{
-				_handle = handle;
+				memset(&status, 0, sizeof(status));
+				status.Status = 127 << 8;
+				collected = true;
 			}
-			virtual ~__HandlesReleaser()
+			else if (child.StatusFd == -1)
 			{
-				WinHttpCloseHandle(_handle);
+				collected = _WaitChild(child.Pid, status);
 			}
-		};
+			else
+			{
+				ssize_t count;
+				while ((count = read(child.StatusFd, &status, sizeof(status))) == -1 && errno == EINTR) {}
+				collected = count == (ssize_t)sizeof(status);
+				close(child.StatusFd);
+			}
+			ret.Usage.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (!collected) return;
+
+			const struct rusage& usage = status.Usage;
+			ret.Usage.UserTime = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+			ret.Usage.SystemTime = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+			ret.Usage.MaxRss = usage.ru_maxrss;
+			ret.Usage.MinorFaults = usage.ru_minflt;
+			ret.Usage.MajorFaults = usage.ru_majflt;
+			ret.Usage.BlockReads = usage.ru_inblock;
+			ret.Usage.BlockWrites = usage.ru_oublock;
+			ret.Usage.VoluntarySwitches = usage.ru_nvcsw;
+			ret.Usage.InvoluntarySwitches = usage.ru_nivcsw;
+			ret.Usage.ReadChars = status.ReadChars;
+			ret.Usage.WriteChars = status.WriteChars;
+			ret.Usage.StorageReadBytes = status.StorageReadBytes;
+			ret.Usage.StorageWriteBytes = status.StorageWriteBytes;
+
+			// killed by signal are reported like the shell does (128 + signal)
+			if (WIFEXITED(status.Status)) ret.ReturnCode = WEXITSTATUS(status.Status);
+			else if (WIFSIGNALED(status.Status)) ret.ReturnCode = 128 + WTERMSIG(status.Status);
+			ret.DidFinish = true;
+		}
 
 		/*!
-		 * \fn	void SetUserAgent(const std::string& ua)
+		 * \fn	inline std::string _ResolveProgram(const std::string& program)
 		 *
-		 * \brief	Sets useragent for all HTTP requests.
+		 * \brief	Used internally, search a program in PATH (like execvp does).
+		 * 			Done in the parent, so the child only has to call execve.
 		 *
-		 * \author	Ronen Ness
-		 * \date	10/19/2018
+		 * \date	10/19/2026
 		 *
-		 * \param	ua	New useragent text.
+		 * \param	program	Program name or path.
+		 *
+		 * \return	Path to program, or the program as-is if not found (exec will fail on it).
 		 */
-		void SetUserAgent(const std::string& ua)
+		inline std::string _ResolveProgram(const std::string& program)
 		{
-			_useragent = ua;
+			if (program.empty() || program.find('/') != std::string::npos) return program;
+			const char* path = getenv("PATH");
+			std::string paths = path ? path : "/usr/local/bin:/bin:/usr/bin";
+			size_t begin = 0;
+			while (begin <= paths.size())
+			{
+				size_t end = paths.find(':', begin);
+				if (end == std::string::npos) end = paths.size();
+				std::string folder = paths.substr(begin, end - begin);
+				std::string candidate = (folder.empty() ? std::string(".") : folder) + "/" + program;
+				if (access(candidate.c_str(), X_OK) == 0) return candidate;
+				begin = end + 1;
+			}
+			return program;
 		}
 
 		/*!
-		 * \fn	HttpResponse Send(std::string url, int port = 80)
+		 * \fn	inline void _SetCloseOnExec(int fd, bool value)
 		 *
-		 * \brief	Send an Http request.
+		 * \brief	Used internally, set or clear the close-on-exec flag of a file descriptor.
 		 *
-		 * \author	Ronen Ness
-		 * \date	10/19/2018
+		 * \date	10/19/2026
 		 *
-		 * \param	host 				Host to send request to.
-		 * \param	method				Request type (GET / POST / PUT /...)
-		 * \param	action				Url under host for request.
-		 * \param	content				(Optional) Content to send.
-		 * \param	additionalHeaders	(Optional) Additional headers.
-		 * \param	port				(Optional) Port to connect to.
+		 * \param	fd   	File descriptor.
+		 * \param	value	Whether to close on exec.
+		 */
+		inline void _SetCloseOnExec(int fd, bool value)
+		{
+			int flags = fcntl(fd, F_GETFD);
+			if (flags == -1) return;
+			fcntl(fd, F_SETFD, value ? (flags | FD_CLOEXEC) : (flags & ~FD_CLOEXEC));
+		}
+
+		/*!
+		 * \struct	__ExecArgs
 		 *
-		 * \return	A HttpResponse.
+		 * \brief	Used internally, everything a child needs to exec, prepared before spawning
+		 * 			so the child itself only makes async-signal-safe calls.
 		 */
-		HttpResponse Send(const std::string& host, 
-			const std::string& method = "GET",
-			const std::string& action = "/", 
-			const std::string& content = std::string(), 
-			const std::string& additionalHeaders = std::string(),
-			USHORT port = INTERNET_DEFAULT_HTTP_PORT)
+		struct __ExecArgs
 		{
-			// internal macro to stop and return in case of errors
-			#define __ReturnHttpErrorIfFailed(condition, ErrType) \
-			if (!condition) { \
-				ret.Error = ErrType; \
-				ret.ErrorCode = GetLastError(); \
-				return ret; }
+			const char* Path;
+			char* const* Argv;
+			char* const* Envp;
+			int StdinFd;
+			int StdoutFd;
+			sigset_t SignalMask;
+
+			// scheduling and resource hints to apply, or NULL for none
+			const Options* Hints;
+
+			// set by a child that shares our memory if exec failed
+			volatile int Error;
+		};
 
-			// return value
-			HttpResponse ret;
+		/*!
+		 * \fn	inline bool _ApplyOptions(const Options& options)
+		 *
+		 * \brief	Used internally, runs in the spawned child: apply scheduling and resource hints to the calling process.
+		 * 			Only makes raw syscalls, so it is safe to call in a child that shares our memory.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	options	Hints to apply.
+		 *
+		 * \return	True if all hints were applied (errno is set otherwise).
+		 */
+		inline bool _ApplyOptions(const Options& options)
+		{
+			if (options.MaxAddressSpace)
+			{
+				struct rlimit limit;
+				limit.rlim_cur = limit.rlim_max = (rlim_t)options.MaxAddressSpace;
+				if (setrlimit(RLIMIT_AS, &limit) != 0) return false;
+			}
+			if (options.MaxCpuSeconds)
+			{
+				struct rlimit limit;
+				limit.rlim_cur = limit.rlim_max = (rlim_t)options.MaxCpuSeconds;
+				if (setrlimit(RLIMIT_CPU, &limit) != 0) return false;
+			}
+			if (options.SchedPolicy != Options::Policy::Unset)
+			{
+				struct sched_param param;
+				param.sched_priority = options.SchedPriority;
+				if (sched_setscheduler(0, (int)options.SchedPolicy, &param) != 0) return false;
+			}
+			if (options.SetNice && setpriority(PRIO_PROCESS, 0, options.Nice) != 0) return false;
+			if (options.IoPriorityClass != Options::IoClass::Unset)
+			{
+				// IOPRIO_WHO_PROCESS, class in the top bits (IOPRIO_CLASS_SHIFT = 13)
+				int priority = ((int)options.IoPriorityClass << 13) | (options.IoPriorityLevel & 7);
+				if (syscall(SYS_ioprio_set, 1, 0, priority) != 0) return false;
+			}
+			if (options.HasAffinity() && syscall(SYS_sched_setaffinity, 0, sizeof(options.CpuMask), options.CpuMask) != 0) return false;
+			return true;
+		}
 
-			// some params
-			BOOL  bResults = FALSE;
-			HINTERNET hSession = NULL,
-				hConnect = NULL,
-				hRequest = NULL;
+		/*!
+		 * \fn	inline void _ExecChild(const __ExecArgs& args)
+		 *
+		 * \brief	Used internally, runs in the spawned child: set standard streams, apply hints and exec.
+		 * 			Never returns; if hints or exec fail the child exits with code 127.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	args	Exec args.
+		 */
+		inline void _ExecChild(const __ExecArgs& args)
+		{
+			if (args.StdinFd != -1)
+			{
+				if (args.StdinFd == STDIN_FILENO) _SetCloseOnExec(args.StdinFd, false);
+				else dup2(args.StdinFd, STDIN_FILENO);
+			}
+			if (args.StdoutFd != -1)
+			{
+				if (args.StdoutFd == STDOUT_FILENO) _SetCloseOnExec(args.StdoutFd, false);
+				else dup2(args.StdoutFd, STDOUT_FILENO);
+			}
+			if (args.Hints && !_ApplyOptions(*args.Hints))
+			{
+				const_cast<__ExecArgs&>(args).Error = errno;
+				_exit(127);
+			}
+			pthread_sigmask(SIG_SETMASK, &args.SignalMask, NULL);
+			execve(args.Path, args.Argv, args.Envp);
+			const_cast<__ExecArgs&>(args).Error = errno;
+			_exit(127);
+		}
 
-			// use WinHttpOpen to obtain a session handle.
-			LPCWSTR useragent; Just::String::To::LpcwStr(_useragent, useragent);
-			hSession = WinHttpOpen(useragent,
-				WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-				WINHTTP_NO_PROXY_NAME,
-				WINHTTP_NO_PROXY_BYPASS, 
-				0);
-			delete[] useragent;
-			__ReturnHttpErrorIfFailed(hSession, FailedToOpenSession);
+		/*!
+		 * \fn	inline int _CloneChildEntry(void* arg)
+		 *
+		 * \brief	Used internally, entry point of a child spawned with clone(CLONE_VM | CLONE_VFORK).
+		 * 			The child shares our memory but has its own copy of signal handlers, which are reset
+		 * 			before signals are unblocked so none of our handlers can run in it.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline int _CloneChildEntry(void* arg)
+		{
+			const __ExecArgs& args = *(const __ExecArgs*)arg;
+			for (int sig = 1; sig < NSIG; ++sig)
+			{
+				struct sigaction action;
+				if (sigaction(sig, NULL, &action) == 0 && action.sa_handler != SIG_IGN && action.sa_handler != SIG_DFL)
+				{
+					action.sa_handler = SIG_DFL;
+					action.sa_flags = 0;
+					sigaction(sig, &action, NULL);
+				}
+			}
+			_ExecChild(args);
+			return 127;
+		}
 
-			// to make sure session is cleared
-			__HandlesReleaser hSessionR(hSession);
+		// hook to launch a process through the spawn server, set while it is running (see SpawnServer.h).
+		// atomic, since the server starts and stops while other threads spawn
+		typedef __Child (*__SpawnServerLaunch)(const std::string& path, const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options);
+		inline std::atomic<__SpawnServerLaunch> _spawnServerLaunch(nullptr);
 
-			// specify an HTTP server.
-			LPCWSTR lphost; Just::String::To::LpcwStr(host, lphost);
-			hConnect = WinHttpConnect(hSession, lphost, port, 0);
-			delete[] lphost;
-			__ReturnHttpErrorIfFailed(hConnect, FailedToConnect);
+		/*!
+		 * \fn	inline __Child _Spawn(const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options = Options())
+		 *
+		 * \brief	Used internally, spawn a child process running argv (searched in PATH), using the current spawn method.
+		 * 			All descriptors we create are close-on-exec, so the child only inherits its
+		 * 			standard streams. If exec fails the child exits with code 127.
+		 * 			posix_spawn can't apply our hints, so VFork is used instead when any hint is set.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	argv		Program and its arguments.
+		 * \param	stdinFd 	Descriptor to use as child's stdin, or -1 to inherit ours.
+		 * \param	stdoutFd	Descriptor to use as child's stdout, or -1 to inherit ours.
+		 * \param	options 	(Optional) Scheduling and resource hints for the child.
+		 *
+		 * \return	Spawned child (invalid on failure).
+		 */
+		inline __Child _Spawn(const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options = Options())
+		{
+			__Child ret;
+			if (argv.empty()) return ret;
+			std::string path = _ResolveProgram(argv[0]);
+			SpawnMethod method = _spawnMethod.load(std::memory_order_acquire);
 
-			// to make sure connection is cleared
-			__HandlesReleaser hConnectR(hConnect);
+			// launch through spawn server if running
+			if (method == SpawnMethod::Server)
+			{
+				auto launch = _spawnServerLaunch.load(std::memory_order_acquire);
+				if (launch)
+				{
+					ret = launch(path, argv, stdinFd, stdoutFd, options);
+					if (ret.IsValid()) return ret;
+				}
+				method = SpawnMethod::PosixSpawn;
+			}
+			bool hasHints = !options.IsEmpty();
+			if (method == SpawnMethod::PosixSpawn && hasHints) method = SpawnMethod::VFork;
+
+			// prepare everything exec needs before spawning
+			std::vector<char*> args;
+			for (const auto& arg : argv) args.push_back(const_cast<char*>(arg.c_str()));
+			args.push_back(NULL);
+			__ExecArgs exec;
+			exec.Path = path.c_str();
+			exec.Argv = args.data();
+			exec.Envp = environ;
+			exec.StdinFd = stdinFd;
+			exec.StdoutFd = stdoutFd;
+			exec.Hints = hasHints ? &options : NULL;
+
+			if (method == SpawnMethod::PosixSpawn)
+			{
+				posix_spawn_file_actions_t actions;
+				posix_spawn_file_actions_init(&actions);
+				if (stdinFd != -1) posix_spawn_file_actions_adddup2(&actions, stdinFd, STDIN_FILENO);
+				if (stdoutFd != -1) posix_spawn_file_actions_adddup2(&actions, stdoutFd, STDOUT_FILENO);
+				pid_t pid;
+				int error = posix_spawn(&pid, exec.Path, &actions, NULL, exec.Argv, exec.Envp);
+				posix_spawn_file_actions_destroy(&actions);
+
+				if (error == 0) ret.Pid = pid;
+				else ret.ExecFailed = error != ENOMEM && error != EAGAIN;
+				return ret;
+			}
 
-			// create an HTTP Request handle.
-			LPCWSTR wmethod; Just::String::To::LpcwStr(method, wmethod);
-			LPCWSTR waction; Just::String::To::LpcwStr(action, waction);
-			hRequest = WinHttpOpenRequest(hConnect,
-				wmethod,
-				waction,
-				NULL, 
-				WINHTTP_NO_REFERER,
-				WINHTTP_DEFAULT_ACCEPT_TYPES,
-				0);
-			delete[] wmethod;
-			delete[] waction;
-			__ReturnHttpErrorIfFailed(hRequest, FailedToOpenRequest);
+			// block all signals while spawning so no handler runs in the child before exec
+			sigset_t all;
+			sigfillset(&all);
+			pthread_sigmask(SIG_SETMASK, &all, &exec.SignalMask);
+			if (method == SpawnMethod::VFork)
+			{
+				const size_t stackSize = 64 * 1024;
+				std::vector<char> stack(stackSize);
+				exec.Error = 0;
+				ret.Pid = clone(_CloneChildEntry, stack.data() + stackSize, CLONE_VM | CLONE_VFORK | SIGCHLD, &exec);
 
-			// to make sure request is cleared
-			__HandlesReleaser hRequestR(hRequest);
+				// child shares our memory, so we know if exec failed; reap it right away
+				if (ret.Pid > 0 && exec.Error != 0)
+				{
+					__ChildStatus status;
+					_WaitChild(ret.Pid, status);
+					ret.Pid = -1;
+					ret.ExecFailed = true;
+				}
+			}
+			else
+			{
+				ret.Pid = fork();
+				if (ret.Pid == 0) _ExecChild(exec);
+			}
+			pthread_sigmask(SIG_SETMASK, &exec.SignalMask, NULL);
+			if (ret.Pid < 0) ret.Pid = -1;
+			return ret;
+		}
 
-			// set additional headers
-			LPCWSTR headers = WINHTTP_NO_ADDITIONAL_HEADERS;
-			if (additionalHeaders.size()) Just::String::To::LpcwStr(additionalHeaders, headers);
+		/*!
+		 * \fn	inline void _Communicate(int inFd, const std::string& input, int outFd, __OutputCapture& output)
+		 *
+		 * \brief	Used internally, write input to a child while reading its output, until the output is closed.
+		 * 			Both descriptors are closed when done. SIGPIPE raised by writing to a child that
+		 * 			stopped reading is swallowed.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	inFd  	Write end of child's stdin, or -1 for none.
+		 * \param	input 	Data to write to child's stdin.
+		 * \param	outFd 	Read end of child's stdout.
+		 * \param	output	Capture to append output to.
+		 */
+		inline void _Communicate(int inFd, const std::string& input, int outFd, __OutputCapture& output)
+		{
+			// block SIGPIPE while writing, remembering if one was already pending
+			sigset_t blockSet, oldSet, pending;
+			sigemptyset(&blockSet);
+			sigaddset(&blockSet, SIGPIPE);
+			pthread_sigmask(SIG_BLOCK, &blockSet, &oldSet);
+			sigpending(&pending);
+			bool wasPending = sigismember(&pending, SIGPIPE);
+
+			// nothing to write? close stdin right away so child sees EOF
+			size_t written = 0;
+			if (inFd != -1 && input.empty())
+			{
+				close(inFd);
+				inFd = -1;
+			}
+			if (inFd != -1) fcntl(inFd, F_SETFL, fcntl(inFd, F_GETFL) | O_NONBLOCK);
 
-			// set content
-			LPCWSTR contentBuff = WINHTTP_NO_REQUEST_DATA;
-			if (content.size()) Just::String::To::LpcwStr(content, contentBuff);
+			char buffer[64 * 1024];
+			while (outFd != -1)
+			{
+				struct pollfd fds[2];
+				int count = 0;
+				fds[count].fd = outFd; fds[count].events = POLLIN; fds[count].revents = 0; count++;
+				if (inFd != -1) { fds[count].fd = inFd; fds[count].events = POLLOUT; fds[count].revents = 0; count++; }
+				if (poll(fds, count, -1) < 0)
+				{
+					if (errno == EINTR) continue;
+					break;
+				}
 
-			// send the Request.
-			bResults = WinHttpSendRequest(hRequest,
-				headers,
-				(DWORD)additionalHeaders.length(),
-				&contentBuff,
-				(DWORD)content.length(),
-				(DWORD)content.length(),
-				(DWORD)0);
-			if (headers) delete[] headers;
-			if (contentBuff) delete[] contentBuff;
-			__ReturnHttpErrorIfFailed(bResults, FailedToSendRequest);
+				// feed input
+				if (count > 1 && fds[1].revents)
+				{
+					ssize_t result = write(inFd, input.data() + written, input.size() - written);
+					if (result > 0) written += (size_t)result;
+					if ((result < 0 && errno != EAGAIN && errno != EINTR) || written == input.size())
+					{
+						close(inFd);
+						inFd = -1;
+					}
+				}
 
-			// wait to recieve response
-			bResults = WinHttpReceiveResponse(hRequest, NULL);
-			__ReturnHttpErrorIfFailed(bResults, FailedToReceiveResponse);
+				// read output
+				if (fds[0].revents)
+				{
+					ssize_t result = read(outFd, buffer, sizeof(buffer));
+					if (result > 0) output.Append(buffer, (size_t)result);
+					else if (result == 0 || (errno != EAGAIN && errno != EINTR))
+					{
+						close(outFd);
+						outFd = -1;
+					}
+				}
+			}
+			if (inFd != -1) close(inFd);
+			if (outFd != -1) close(outFd);
 
-			// read actual data from response
-			DWORD dwSize = 0;
-			DWORD dwDownloaded = 0;
-			do
+			// consume SIGPIPE we caused and restore mask
+			sigpending(&pending);
+			if (!wasPending && sigismember(&pending, SIGPIPE))
 			{
-				// get how much data we have to read
-				dwSize = 0;
-				bResults = WinHttpQueryDataAvailable(hRequest, &dwSize);
-				__ReturnHttpErrorIfFailed(bResults, NoHttpDataAvailable);
+				struct timespec zero = { 0, 0 };
+				sigtimedwait(&blockSet, NULL, &zero);
+			}
+			pthread_sigmask(SIG_SETMASK, &oldSet, NULL);
+		}
 
-				// allocate space for the buffer.
-				char* pszOutBuffer = new char[dwSize + 1];
-				
-				// read the Data.
-				ZeroMemory(pszOutBuffer, dwSize + 1);
+		/*!
+		 * \fn	inline ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		 *
+		 * \brief	Executes a command via /bin/sh, capturing its stdout and resource usage.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	command	The command to execute.
+		 * \param	capture	(Optional) How much of the output to keep.
+		 * \param	options	(Optional) Scheduling and resource hints for the process.
+		 *
+		 * \return	A ProcessOutput.
+		 */
+		inline ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		{
+			ProcessOutput ret;
 
-				bResults = WinHttpReadData(hRequest, (LPVOID)pszOutBuffer, dwSize, &dwDownloaded);
-				if (!bResults) { delete[] pszOutBuffer; }
-				__ReturnHttpErrorIfFailed(bResults, FailedToReadHttpData);
+			// create pipe for child output
+			int fds[2];
+			if (pipe2(fds, O_CLOEXEC) != 0)
+			{
+				return ret;
+			}
 
-				// add to response
-				ret.Text += pszOutBuffer;
-				ret.TotalBytesRead += dwSize;
+			// run the command
+			auto start = std::chrono::steady_clock::now();
+			__Child child = _Spawn({ "/bin/sh", "-c", command }, -1, fds[1], options);
+			close(fds[1]);
+			if (!child.IsValid())
+			{
+				close(fds[0]);
+				return ret;
+			}
 
-				// Free the memory allocated to the buffer.
-				delete[] pszOutBuffer;
+			// read output, wait for process and return data on execution
+			__OutputCapture output(capture);
+			_Communicate(-1, std::string(), fds[0], output);
+			output.Finish(ret);
+			_CollectProcess(child, start, ret);
+			return ret;
+		}
+#endif
+	}
+}
+
+
+
+
+// ::Execute\Pipeline.h::
+
+/*!
+ * \file	Source\Execute\Pipeline.h.
+ *
+ * \brief	Execute programs and chains of programs directly, without a shell.
+ */
+// #pragma once
+
+#ifndef _WIN32
+#include <string>
+#include <vector>
+// #include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \struct	PipelineOutput
+		 *
+		 * \brief	Output of an executed pipeline.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct PipelineOutput
+		{
+			// output text of the last stage
+			std::string Output;
+
+			// bytes of last stage output dropped due to capture policy, and spill file path (see ProcessOutput)
+			unsigned long long DroppedBytes = 0;
+			std::string SpillPath;
+
+			// return code, status and usage of every stage, in order (their Output is empty)
+			std::vector<ProcessOutput> Stages;
+
+			// return code of the last stage, or -1 if there are no stages
+			inline int ReturnCode() const { return Stages.empty() ? -1 : Stages.back().ReturnCode; }
+
+			// return if all stages executed and succeeded (like 'set -o pipefail')
+			inline bool IsSuccess() const
+			{
+				if (Stages.empty()) return false;
+				for (const auto& stage : Stages) if (!stage.IsSuccess()) return false;
+				return true;
+			}
+		};
+
+		/*!
+		 * \fn	inline PipelineOutput Pipeline(const std::vector<std::vector<std::string>>& stages, const std::string& input = std::string(), size_t pipeCapacity = 0, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		 *
+		 * \brief	Executes a chain of programs connected with pipes, like 'a | b | c' in the shell,
+		 * 			but without spawning a shell or quoting arguments.
+		 * 			Stages are argv vectors, the program is searched in PATH.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	stages			Argv of every stage, in order.
+		 * \param	input			(Optional) Data to write to the first stage's stdin. Stdin is closed after it.
+		 * \param	pipeCapacity	(Optional) If not 0, resize every pipe to this many bytes (F_SETPIPE_SZ).
+		 * 							Larger pipes mean less context switches between stages for bulk data.
+		 * 							The kernel caps it at /proc/sys/fs/pipe-max-size.
+		 * \param	capture			(Optional) How much of the last stage output to keep.
+		 * \param	options			(Optional) Scheduling and resource hints applied to every stage.
+		 *
+		 * \return	Output of the last stage and status of every stage.
+		 */
+		inline PipelineOutput Pipeline(const std::vector<std::vector<std::string>>& stages, const std::string& input = std::string(), size_t pipeCapacity = 0, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		{
+			PipelineOutput ret;
+			if (stages.empty()) return ret;
+			ret.Stages.resize(stages.size());
+
+			// create the first stage input pipe and the last stage output pipe
+			int inputPipe[2], outputPipe[2];
+			if (pipe2(inputPipe, O_CLOEXEC) != 0) return ret;
+			if (pipe2(outputPipe, O_CLOEXEC) != 0)
+			{
+				close(inputPipe[0]);
+				close(inputPipe[1]);
+				return ret;
+			}
+			if (pipeCapacity)
+			{
+				fcntl(inputPipe[1], F_SETPIPE_SZ, (int)pipeCapacity);
+				fcntl(outputPipe[1], F_SETPIPE_SZ, (int)pipeCapacity);
+			}
+
+			// spawn stages, each reading from previous stage pipe
+			std::vector<__Child> children(stages.size());
+			auto start = std::chrono::steady_clock::now();
+			int stageInput = inputPipe[0];
+			for (size_t i = 0; i < stages.size(); ++i)
+			{
+				int stageOutput = outputPipe[1];
+				int nextInput = -1;
+				if (i + 1 < stages.size())
+				{
+					int fds[2];
+					if (pipe2(fds, O_CLOEXEC) == 0)
+					{
+						if (pipeCapacity) fcntl(fds[1], F_SETPIPE_SZ, (int)pipeCapacity);
+						stageOutput = fds[1];
+						nextInput = fds[0];
+					}
+				}
+
+				// failed to create pipe? stop here, the stages we started will see EOF
+				if (i + 1 < stages.size() && nextInput == -1) break;
+				children[i] = _Spawn(stages[i], stageInput, stageOutput, options);
+
+				// close our copies so EOF propagates when a stage exits
+				close(stageInput);
+				if (stageOutput != outputPipe[1]) close(stageOutput);
+				stageInput = nextInput;
+			}
+			close(outputPipe[1]);
+			if (stageInput != -1) close(stageInput);
+
+			// feed input and read last stage output
+			__OutputCapture output(capture);
+			_Communicate(inputPipe[1], input, outputPipe[0], output);
+			ProcessOutput captured;
+			output.Finish(captured);
+			ret.Output = std::move(captured.Output);
+			ret.DroppedBytes = captured.DroppedBytes;
+			ret.SpillPath = captured.SpillPath;
+
+			// collect all stages
+			for (size_t i = 0; i < stages.size(); ++i)
+			{
+				if (children[i].IsValid()) _CollectProcess(children[i], start, ret.Stages[i]);
+			}
+			return ret;
+		}
+
+		/*!
+		 * \fn	inline ProcessOutput Run(const std::vector<std::string>& argv, const std::string& input = std::string(), const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		 *
+		 * \brief	Executes a program directly, without a shell.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	argv   	Program and its arguments. Program is searched in PATH.
+		 * \param	input  	(Optional) Data to write to program's stdin. Stdin is closed after it.
+		 * \param	capture	(Optional) How much of the output to keep.
+		 * \param	options	(Optional) Scheduling and resource hints for the program.
+		 *
+		 * \return	A ProcessOutput.
+		 */
+		inline ProcessOutput Run(const std::vector<std::string>& argv, const std::string& input = std::string(), const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		{
+			PipelineOutput output = Pipeline({ argv }, input, 0, capture, options);
+			ProcessOutput ret = output.Stages[0];
+			ret.Output = std::move(output.Output);
+			ret.DroppedBytes = output.DroppedBytes;
+			ret.SpillPath = std::move(output.SpillPath);
+			return ret;
+		}
+	}
+}
+#endif
+
+
+
+
+// ::Execute\CachedRun.h::
+
+/*!
+ * \file	Source\Execute\CachedRun.h.
+ *
+ * \brief	Memoize results of deterministic commands in an on-disk cache.
+ */
+// #pragma once
+
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+// #include "Command.h"
+// #include "Pipeline.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \class	__ContentHasher
+		 *
+		 * \brief	Used internally, streaming 128-bit non-cryptographic hash used for cache keys.
+		 *
+		 * \date	10/19/2026
+		 */
+		class __ContentHasher
+		{
+			uint64_t _A = 0x9E3779B97F4A7C15ULL;
+			uint64_t _B = 0xC2B2AE3D27D4EB4FULL;
+			uint64_t _Length = 0;
+
+			static inline uint64_t _Mix(uint64_t k)
+			{
+				k ^= k >> 33; k *= 0xFF51AFD7ED558CCDULL;
+				k ^= k >> 33; k *= 0xC4CEB9FE1A85EC53ULL;
+				k ^= k >> 33;
+				return k;
+			}
+
+			inline void _Word(uint64_t word)
+			{
+				_A = (_A ^ _Mix(word)) * 0x100000001B3ULL;
+				_A = (_A << 27) | (_A >> 37);
+				_B = (_B + _Mix(word ^ 0x5851F42D4C957F2DULL)) * 0x9FB21C651E98DF25ULL;
+				_B ^= _B >> 29;
+			}
+
+		public:
+
+			// add data to hash
+			void Update(const void* data, size_t size)
+			{
+				const unsigned char* bytes = (const unsigned char*)data;
+				_Length += size;
+				while (size >= 8)
+				{
+					uint64_t word;
+					memcpy(&word, bytes, 8);
+					_Word(word);
+					bytes += 8;
+					size -= 8;
+				}
+				if (size)
+				{
+					uint64_t word = 0;
+					memcpy(&word, bytes, size);
+					_Word(word ^ ((uint64_t)size << 56));
+				}
+			}
+
+			// add a length-prefixed string to hash, so concatenated fields can't collide
+			inline void Update(const std::string& str)
+			{
+				uint64_t size = str.size();
+				Update(&size, sizeof(size));
+				Update(str.data(), str.size());
+			}
+
+			// get final hash as 32 hex characters
+			std::string Digest() const
+			{
+				uint64_t a = _Mix(_A ^ _Length), b = _Mix(_B + a);
+				char out[33];
+				snprintf(out, sizeof(out), "%016llx%016llx", (unsigned long long)a, (unsigned long long)b);
+				return std::string(out);
+			}
+		};
+
+		/*!
+		 * \class	CachedRun
+		 *
+		 * \brief	Opt-in memoization for deterministic commands (code generators, linters, etc.).
+		 * 			A run is keyed on its argv, the working directory, selected environment variables, its stdin
+		 * 			and the content of the input files it declares. Results are stored as files named by the key hash, and
+		 * 			a hit returns the stored ProcessOutput without spawning anything.
+		 * 			When the cache exceeds its size limit, least recently used entries are evicted.
+		 * 			Safe to use from multiple threads; multiple processes may share a directory.
+		 *
+		 * \date	10/19/2026
+		 */
+		class CachedRun
+		{
+		public:
+
+			// cache statistics
+			struct Stats
+			{
+				// lookups that were served from cache / had to execute
+				uint64_t Hits = 0;
+				uint64_t Misses = 0;
+
+				// entries written / evicted
+				uint64_t Stores = 0;
+				uint64_t Evictions = 0;
+
+				// wall time the hits took when they were originally executed, in seconds
+				double TimeSaved = 0;
+			};
+
+			/*!
+			 * \fn	CachedRun(const std::string& directory, uint64_t maxBytes = 256 * 1024 * 1024, const std::vector<std::string>& environmentKeys = std::vector<std::string>())
+			 *
+			 * \brief	Constructor.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	directory	   	Cache directory. Created if missing.
+			 * \param	maxBytes	   	(Optional) Max total size of cache entries.
+			 * \param	environmentKeys	(Optional) Names of environment variables that affect results and are part of the key.
+			 */
+			CachedRun(const std::string& directory, uint64_t maxBytes = 256 * 1024 * 1024, const std::vector<std::string>& environmentKeys = std::vector<std::string>())
+				: _Directory(directory), _MaxBytes(maxBytes), _EnvironmentKeys(environmentKeys)
+			{
+				std::error_code error;
+				std::filesystem::create_directories(_Directory, error);
+				_TotalBytes = _Scan(nullptr);
+			}
+
+			/*!
+			 * \fn	ProcessOutput Run(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles = std::vector<std::string>(), const std::string& input = std::string())
+			 *
+			 * \brief	Executes a program directly (see Execute::Run), or return its cached result.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	argv	  	Program and its arguments.
+			 * \param	inputFiles	(Optional) Files the program reads. Their content is part of the key.
+			 * \param	input	  	(Optional) Data to write to program's stdin.
+			 *
+			 * \return	A ProcessOutput, either cached or fresh.
+			 */
+			ProcessOutput Run(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles = std::vector<std::string>(), const std::string& input = std::string())
+			{
+				return _Cached(argv, inputFiles, input, [&]() { return Execute::Run(argv, input, CapturePolicy(), _Options); });
+			}
+
+			/*!
+			 * \fn	ProcessOutput Command(const std::string& command, const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			 *
+			 * \brief	Executes a shell command (see Execute::Command), or return its cached result.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	command   	The command to execute.
+			 * \param	inputFiles	(Optional) Files the command reads. Their content is part of the key.
+			 *
+			 * \return	A ProcessOutput, either cached or fresh.
+			 */
+			ProcessOutput Command(const std::string& command, const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			{
+				return _Cached({ "/bin/sh", "-c", command }, inputFiles, std::string(), [&]() { return Execute::Command(command, CapturePolicy(), _Options); });
+			}
+
+			/*!
+			 * \fn	ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string(), const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			 *
+			 * \brief	Executes a script (see Execute::Script), or return its cached result.
+			 * 			The script file itself is always part of the key.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	scriptType	Type of the script (python / ruby / perl / ...).
+			 * \param	scriptPath	Full path of the script file to execute.
+			 * \param	params	  	(Optional) Script params.
+			 * \param	inputFiles	(Optional) Other files the script reads.
+			 *
+			 * \return	A ProcessOutput, either cached or fresh.
+			 */
+			ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string(), const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			{
+				std::vector<std::string> files(inputFiles);
+				files.push_back(scriptPath);
+				return Command(scriptType + " \"" + scriptPath + "\" " + params, files);
+			}
+
+			// set scheduling and resource hints for executed processes. hints are not part of the key
+			inline void SetOptions(const Options& options) { _Options = options; }
+
+			// set if runs that did not succeed are cached too (default: true, failures of a deterministic tool are results as well)
+			inline void SetCacheFailures(bool cacheFailures) { _CacheFailures = cacheFailures; }
+
+			// get cache statistics
+			inline Stats GetStats() const
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				return _Stats;
+			}
+
+			// get current estimated size of cache entries, in bytes
+			inline uint64_t GetSize() const { return _TotalBytes.load(); }
+
+			/*!
+			 * \fn	void Clear()
+			 *
+			 * \brief	Delete all cache entries.
+			 *
+			 * \date	10/19/2026
+			 */
+			void Clear()
+			{
+				std::error_code error;
+				for (auto& entry : std::filesystem::directory_iterator(_Directory, error))
+				{
+					if (entry.is_directory(error)) std::filesystem::remove_all(entry.path(), error);
+				}
+				_TotalBytes = 0;
+			}
+
+		private:
+
+			// entry file header
+			struct __EntryHeader
+			{
+				uint32_t Magic;
+				uint32_t Version;
+				int32_t ReturnCode;
+				int32_t DidFinish;
+				ProcessUsage Usage;
+				uint64_t OutputSize;
+			};
+			static_assert(std::is_trivially_copyable<ProcessUsage>::value, "ProcessUsage is stored as raw bytes.");
+			static constexpr uint32_t _Magic = 0x4A435231; // 'JCR1'
+			static constexpr uint32_t _Version = 1;
+
+			// temp files older than this are left over by a crashed writer even if their pid was reused
+			static constexpr auto _StaleTempAge = std::chrono::hours(1);
+
+			// content hash of a file, cached by (path, size, mtime) so unchanged files are not hashed again
+			struct __FileHash
+			{
+				off_t Size;
+				struct timespec ModifyTime;
+				std::string Hash;
+			};
+
+			std::string _Directory;
+			uint64_t _MaxBytes;
+			std::vector<std::string> _EnvironmentKeys;
+			bool _CacheFailures = true;
+			Options _Options;
+			std::atomic<uint64_t> _TotalBytes{ 0 };
+			std::atomic<uint64_t> _TempCounter{ 0 };
+			mutable std::mutex _Mutex;
+			Stats _Stats;
+			std::unordered_map<std::string, __FileHash> _FileHashes;
+
+			// hash file content, or return empty string if file is missing
+			std::string _HashFile(const std::string& path)
+			{
+				struct stat info;
+				if (stat(path.c_str(), &info) != 0) return std::string();
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					auto found = _FileHashes.find(path);
+					if (found != _FileHashes.end() && found->second.Size == info.st_size &&
+						found->second.ModifyTime.tv_sec == info.st_mtim.tv_sec && found->second.ModifyTime.tv_nsec == info.st_mtim.tv_nsec)
+					{
+						return found->second.Hash;
+					}
+				}
+
+				FILE* file = fopen(path.c_str(), "rb");
+				if (!file) return std::string();
+				__ContentHasher hasher;
+				std::vector<char> buffer(1024 * 1024);
+				size_t count;
+				while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0) hasher.Update(buffer.data(), count);
+				fclose(file);
+
+				std::string ret = hasher.Digest();
+				std::lock_guard<std::mutex> lock(_Mutex);
+				_FileHashes[path] = __FileHash{ info.st_size, info.st_mtim, ret };
+				return ret;
+			}
+
+			// build the key hash of a run
+			std::string _Key(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles, const std::string& input)
+			{
+				__ContentHasher hasher;
+				hasher.Update(std::string("argv"));
+				for (const auto& arg : argv) hasher.Update(arg);
+
+				// relative paths in argv and input files mean something else in another directory
+				std::error_code error;
+				hasher.Update(std::string("cwd"));
+				hasher.Update(std::filesystem::current_path(error).string());
+				hasher.Update(std::string("env"));
+				for (const auto& key : _EnvironmentKeys)
+				{
+					const char* value = getenv(key.c_str());
+					hasher.Update(key);
+					hasher.Update(value ? std::string("=") + value : std::string("unset"));
+				}
+				hasher.Update(std::string("stdin"));
+				hasher.Update(input);
+				hasher.Update(std::string("files"));
+				for (const auto& path : inputFiles)
+				{
+					hasher.Update(path);
+					hasher.Update(_HashFile(path));
+				}
+				return hasher.Digest();
+			}
+
+			// get entry file path from key
+			inline std::string _EntryPath(const std::string& key) const
+			{
+				return _Directory + "/" + key.substr(0, 2) + "/" + key.substr(2);
+			}
+
+			// try to load an entry; touches it on success so it counts as recently used
+			bool _Load(const std::string& path, ProcessOutput& out) const
+			{
+				FILE* file = fopen(path.c_str(), "rb");
+				if (!file) return false;
+				__EntryHeader header;
+				bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.Magic == _Magic && header.Version == _Version;
+				if (ok)
+				{
+					out.Output.resize((size_t)header.OutputSize);
+					ok = header.OutputSize == 0 || fread(&out.Output[0], 1, (size_t)header.OutputSize, file) == header.OutputSize;
+				}
+				fclose(file);
+				if (!ok) return false;
+
+				out.ReturnCode = header.ReturnCode;
+				out.DidFinish = header.DidFinish != 0;
+				out.Usage = header.Usage;
+				utimensat(AT_FDCWD, path.c_str(), NULL, 0);
+				return true;
+			}
+
+			// store an entry, writing to a temp file and renaming so readers never see partial entries
+			void _Store(const std::string& key, const ProcessOutput& output)
+			{
+				std::string path = _EntryPath(key);
+				std::error_code error;
+				std::filesystem::create_directories(_Directory + "/" + key.substr(0, 2), error);
+
+				std::string tempPath = path + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(_TempCounter++);
+				FILE* file = fopen(tempPath.c_str(), "wb");
+				if (!file) return;
+				__EntryHeader header{};
+				header.Magic = _Magic;
+				header.Version = _Version;
+				header.ReturnCode = output.ReturnCode;
+				header.DidFinish = output.DidFinish ? 1 : 0;
+				header.Usage = output.Usage;
+				header.OutputSize = output.Output.size();
+				bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+					fwrite(output.Output.data(), 1, output.Output.size(), file) == output.Output.size();
+				ok = (fclose(file) == 0) && ok;
+				if (!ok || rename(tempPath.c_str(), path.c_str()) != 0)
+				{
+					remove(tempPath.c_str());
+					return;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					_Stats.Stores++;
+				}
+				if ((_TotalBytes += sizeof(header) + output.Output.size()) > _MaxBytes) _Evict();
+			}
+
+			// return if a temp file (<key>.tmp<pid>_<n>) was left by a writer that crashed: its pid is gone, or it is too old
+			static bool _IsStaleTemp(const std::string& name, std::filesystem::file_time_type modified)
+			{
+				size_t found = name.rfind(".tmp");
+				pid_t pid = (pid_t)strtol(name.c_str() + found + 4, nullptr, 10);
+				if (pid > 0 && kill(pid, 0) == -1 && errno == ESRCH) return true;
+				return std::filesystem::file_time_type::clock::now() - modified > _StaleTempAge;
+			}
+
+			// scan all entries, returning their total size and optionally listing them.
+			// deletes temp files crashed writers left; skips the ones other processes are still writing
+			uint64_t _Scan(std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>>* entries)
+			{
+				uint64_t total = 0;
+				std::error_code error;
+				for (auto it = std::filesystem::recursive_directory_iterator(_Directory, error);
+					!error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+				{
+					if (!it->is_regular_file(error)) continue;
+					std::string name = it->path().filename().string();
+					if (name.find(".tmp") != std::string::npos)
+					{
+						std::error_code tempError;
+						auto modified = it->last_write_time(tempError);
+						if (!tempError && _IsStaleTemp(name, modified)) std::filesystem::remove(it->path(), tempError);
+						continue;
+					}
+					total += it->file_size(error);
+					if (entries) entries->push_back(std::make_pair(it->last_write_time(error), it->path()));
+				}
+				return total;
+			}
+
+			// evict least recently used entries until cache is at 90% of its limit
+			void _Evict()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+				uint64_t total = _Scan(&entries);
+				std::sort(entries.begin(), entries.end());
+
+				uint64_t target = _MaxBytes / 10 * 9;
+				std::error_code error;
+				for (const auto& entry : entries)
+				{
+					if (total <= target) break;
+					uint64_t size = std::filesystem::file_size(entry.second, error);
+					if (!error && std::filesystem::remove(entry.second, error))
+					{
+						total -= size;
+						_Stats.Evictions++;
+					}
+				}
+				_TotalBytes = total;
+			}
+
+			// lookup or execute and store
+			template <typename Runner>
+			ProcessOutput _Cached(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles, const std::string& input, Runner execute)
+			{
+				std::string key = _Key(argv, inputFiles, input);
+				ProcessOutput ret;
+				if (_Load(_EntryPath(key), ret))
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					_Stats.Hits++;
+					_Stats.TimeSaved += ret.Usage.WallTime;
+					return ret;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					_Stats.Misses++;
+				}
+				ret = execute();
+				if (ret.DidFinish && (_CacheFailures || ret.IsSuccess())) _Store(key, ret);
+				return ret;
+			}
+		};
+	}
+}
+#endif
+
+
+
+
+// ::Execute\Graph.h::
+
+/*!
+ * \file	Source\Execute\Graph.h.
+ *
+ * \brief	Execute a graph of dependent jobs in parallel, skipping jobs that are up to date.
+ */
+// #pragma once
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+// #include "Command.h"
+// #include "Pipeline.h"
+// #include "CachedRun.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \class	Graph
+		 *
+		 * \brief	A tiny embedded make: jobs declare their dependencies, input and output files, and run
+		 * 			on a bounded number of threads. Ready jobs on the longest remaining path (critical path)
+		 * 			start first, using durations recorded on previous runs as estimates.
+		 * 			A job is skipped when its outputs are up to date, either by modification time or by
+		 * 			content hash of its inputs.
+		 *
+		 * \date	10/19/2026
+		 */
+		class Graph
+		{
+		public:
+
+			// how to decide if a job is up to date
+			enum class UpToDateCheck
+			{
+				// outputs exist and are newer than all inputs, and no dependency ran
+				ModifyTime,
+
+				// outputs exist and the command and input contents did not change since it last succeeded
+				Hash,
+			};
+
+			// a job to execute
+			struct Job
+			{
+				// unique job name
+				std::string Name;
+
+				// program and arguments to run without a shell; if empty, Command is used
+				std::vector<std::string> Argv;
+
+				// shell command to run if Argv is empty
+				std::string Command;
+
+				// names of jobs that must succeed before this job starts
+				std::vector<std::string> Dependencies;
+
+				// files this job reads and writes. jobs without outputs always run
+				std::vector<std::string> Inputs;
+				std::vector<std::string> Outputs;
+
+				// how much of the job output to keep
+				CapturePolicy Capture;
+
+				// scheduling and resource hints for the job process
+				Execute::Options Options;
+			};
+
+			// what happened to a job
+			enum class JobStatus
+			{
+				NotRun,
+				Skipped,
+				Succeeded,
+				Failed,
+				Blocked,
+			};
+
+			// result of a single job
+			struct JobResult
+			{
+				std::string Name;
+				JobStatus Status = JobStatus::NotRun;
+				ProcessOutput Output;
+			};
+
+			// result of running the graph
+			struct Result
+			{
+				// true if no job failed or was blocked
+				bool Success = false;
+
+				// error in the graph itself (unknown dependency, cycle), empty if none
+				std::string Error;
+
+				// results in the order jobs were added
+				std::vector<JobResult> Jobs;
+
+				// total wall time, in seconds
+				double WallTime = 0;
+			};
+
+			/*!
+			 * \fn	Graph(const std::string& stateFile = std::string(), UpToDateCheck check = UpToDateCheck::ModifyTime)
+			 *
+			 * \brief	Constructor.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	stateFile	(Optional) File to load and save job durations and hashes, used as scheduling hints
+			 * 						and for hash based up-to-date checks. If empty, nothing is persisted.
+			 * \param	check		(Optional) How to decide if a job is up to date.
+			 */
+			Graph(const std::string& stateFile = std::string(), UpToDateCheck check = UpToDateCheck::ModifyTime)
+				: _StateFile(stateFile), _Check(check)
+			{
+				_LoadState();
+			}
+
+			/*!
+			 * \fn	void Add(const Job& job)
+			 *
+			 * \brief	Add a job. Dependencies may be added after the jobs that depend on them.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	job	Job to add.
+			 */
+			void Add(const Job& job)
+			{
+				_Jobs.push_back(job);
+			}
+
+			/*!
+			 * \fn	void AddCommand(const std::string& name, const std::string& command, const std::vector<std::string>& dependencies = std::vector<std::string>(), const std::vector<std::string>& inputs = std::vector<std::string>(), const std::vector<std::string>& outputs = std::vector<std::string>())
+			 *
+			 * \brief	Add a job that runs a shell command.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	name			Unique job name.
+			 * \param	command			Shell command.
+			 * \param	dependencies	(Optional) Names of jobs to run first.
+			 * \param	inputs			(Optional) Files the job reads.
+			 * \param	outputs			(Optional) Files the job writes.
+			 */
+			void AddCommand(const std::string& name, const std::string& command, const std::vector<std::string>& dependencies = std::vector<std::string>(), const std::vector<std::string>& inputs = std::vector<std::string>(), const std::vector<std::string>& outputs = std::vector<std::string>())
+			{
+				Job job;
+				job.Name = name;
+				job.Command = command;
+				job.Dependencies = dependencies;
+				job.Inputs = inputs;
+				job.Outputs = outputs;
+				Add(job);
+			}
+
+			/*!
+			 * \fn	Result Run(size_t maxParallel = 0, bool keepGoing = false)
+			 *
+			 * \brief	Run all jobs that are not up to date.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	maxParallel	(Optional) Max jobs to run at once, 0 for number of CPUs.
+			 * \param	keepGoing  	(Optional) If true keep starting independent jobs after a failure (like make -k).
+			 *
+			 * \return	A Result.
+			 */
+			Result Run(size_t maxParallel = 0, bool keepGoing = false)
+			{
+				auto start = std::chrono::steady_clock::now();
+				Result ret;
+				ret.Jobs.resize(_Jobs.size());
+				for (size_t i = 0; i < _Jobs.size(); ++i) ret.Jobs[i].Name = _Jobs[i].Name;
+				if (!_BuildEdges(ret.Error)) return ret;
+
+				// critical path priorities: own estimated duration + longest path through dependents
+				std::vector<double> priority(_Jobs.size(), -1);
+				std::function<double(size_t)> pathLength = [&](size_t job) -> double {
+					if (priority[job] >= 0) return priority[job];
+					double longest = 0;
+					for (size_t dependent : _Dependents[job]) longest = (std::max)(longest, pathLength(dependent));
+					return priority[job] = _EstimatedDuration(_Jobs[job].Name) + longest;
+				};
+				for (size_t i = 0; i < _Jobs.size(); ++i) pathLength(i);
+
+				// ready queue, highest priority first
+				auto compare = [&](size_t a, size_t b) { return priority[a] < priority[b]; };
+				std::priority_queue<size_t, std::vector<size_t>, decltype(compare)> ready(compare);
+				std::vector<size_t> remaining(_Jobs.size());
+				std::vector<bool> dependencyRan(_Jobs.size(), false);
+				for (size_t i = 0; i < _Jobs.size(); ++i)
+				{
+					remaining[i] = _Jobs[i].Dependencies.size();
+					if (remaining[i] == 0) ready.push(i);
+				}
+
+				std::mutex& mutex = _StateMutex;
+				std::condition_variable changed;
+				size_t running = 0, done = 0;
+				bool failed = false;
+
+				// mark job and everything depending on it as blocked
+				std::function<void(size_t)> block = [&](size_t job) {
+					for (size_t dependent : _Dependents[job])
+					{
+						if (ret.Jobs[dependent].Status != JobStatus::NotRun) continue;
+						ret.Jobs[dependent].Status = JobStatus::Blocked;
+						done++;
+						block(dependent);
+					}
+				};
+
+				auto worker = [&]() {
+					std::unique_lock<std::mutex> lock(mutex);
+					while (true)
+					{
+						changed.wait(lock, [&]() { return done == _Jobs.size() || (!ready.empty() && (keepGoing || !failed)) || (running == 0 && (failed && !keepGoing)); });
+						if (done == _Jobs.size() || ready.empty() || (failed && !keepGoing)) break;
+
+						size_t job = ready.top();
+						ready.pop();
+						running++;
+						bool forceRun = dependencyRan[job];
+						lock.unlock();
+
+						// run job unless up to date
+						JobResult& result = ret.Jobs[job];
+						std::string hash;
+						bool upToDate = _IsUpToDate(_Jobs[job], forceRun, hash);
+						if (upToDate)
+						{
+							result.Status = JobStatus::Skipped;
+						}
+						else
+						{
+							const Job& info = _Jobs[job];
+							result.Output = info.Argv.empty() ? Execute::Command(info.Command, info.Capture, info.Options) : Execute::Run(info.Argv, std::string(), info.Capture, info.Options);
+							result.Status = result.Output.IsSuccess() ? JobStatus::Succeeded : JobStatus::Failed;
+						}
+
+						lock.lock();
+						if (!upToDate)
+						{
+							_State[_Jobs[job].Name].Duration = result.Output.Usage.WallTime;
+							if (result.Status == JobStatus::Succeeded && !hash.empty()) _State[_Jobs[job].Name].Hash = hash;
+						}
+						running--;
+						done++;
+						if (result.Status == JobStatus::Failed)
+						{
+							failed = true;
+							block(job);
+						}
+						else
+						{
+							for (size_t dependent : _Dependents[job])
+							{
+								if (!upToDate) dependencyRan[dependent] = true;
+								if (--remaining[dependent] == 0 && ret.Jobs[dependent].Status == JobStatus::NotRun) ready.push(dependent);
+							}
+						}
+						changed.notify_all();
+					}
+					changed.notify_all();
+				};
+
+				if (maxParallel == 0) maxParallel = (std::max)(1u, std::thread::hardware_concurrency());
+				std::vector<std::thread> workers;
+				for (size_t i = 0; i < (std::min)(maxParallel, _Jobs.size()); ++i) workers.emplace_back(worker);
+				for (auto& thread : workers) thread.join();
+
+				_SaveState();
+				ret.Success = true;
+				for (const auto& job : ret.Jobs)
+				{
+					if (job.Status != JobStatus::Skipped && job.Status != JobStatus::Succeeded) ret.Success = false;
+				}
+				ret.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				return ret;
+			}
+
+			// get number of jobs
+			inline size_t Size() const { return _Jobs.size(); }
+
+		private:
+
+			// persisted per-job state
+			struct __JobState
+			{
+				double Duration = -1;
+				std::string Hash;
+			};
+
+			std::string _StateFile;
+			UpToDateCheck _Check;
+			std::vector<Job> _Jobs;
+			std::vector<std::vector<size_t>> _Dependents;
+			std::unordered_map<std::string, __JobState> _State;
+
+			// guards state and scheduling while jobs run
+			std::mutex _StateMutex;
+
+			// build dependents lists and validate graph
+			bool _BuildEdges(std::string& error)
+			{
+				std::unordered_map<std::string, size_t> indices;
+				for (size_t i = 0; i < _Jobs.size(); ++i)
+				{
+					if (!indices.emplace(_Jobs[i].Name, i).second)
+					{
+						error = "Duplicate job: " + _Jobs[i].Name;
+						return false;
+					}
+				}
+				_Dependents.assign(_Jobs.size(), std::vector<size_t>());
+				std::vector<size_t> inDegree(_Jobs.size(), 0);
+				for (size_t i = 0; i < _Jobs.size(); ++i)
+				{
+					for (const auto& dependency : _Jobs[i].Dependencies)
+					{
+						auto found = indices.find(dependency);
+						if (found == indices.end())
+						{
+							error = "Unknown dependency '" + dependency + "' of job: " + _Jobs[i].Name;
+							return false;
+						}
+						_Dependents[found->second].push_back(i);
+						inDegree[i]++;
+					}
+				}
+
+				// check for cycles (Kahn's algorithm)
+				std::vector<size_t> queue;
+				for (size_t i = 0; i < _Jobs.size(); ++i) if (inDegree[i] == 0) queue.push_back(i);
+				size_t visited = 0;
+				while (visited < queue.size())
+				{
+					for (size_t dependent : _Dependents[queue[visited++]])
+					{
+						if (--inDegree[dependent] == 0) queue.push_back(dependent);
+					}
+				}
+				if (visited != _Jobs.size())
+				{
+					error = "Jobs graph has a cycle";
+					return false;
+				}
+				return true;
+			}
+
+			// estimated job duration: last recorded, or average of recorded jobs, or 1 second
+			double _EstimatedDuration(const std::string& name) const
+			{
+				auto found = _State.find(name);
+				if (found != _State.end() && found->second.Duration >= 0) return found->second.Duration;
+				double total = 0;
+				size_t count = 0;
+				for (const auto& state : _State)
+				{
+					if (state.second.Duration >= 0) { total += state.second.Duration; count++; }
+				}
+				return count ? total / count : 1.0;
+			}
+
+			// check if job outputs are up to date; in hash mode also returns the job's current hash
+			bool _IsUpToDate(const Job& job, bool dependencyRan, std::string& hash)
+			{
+				if (_Check == UpToDateCheck::Hash)
+				{
+					__ContentHasher hasher;
+					for (const auto& arg : job.Argv) hasher.Update(arg);
+					hasher.Update(job.Command);
+					for (const auto& input : job.Inputs)
+					{
+						hasher.Update(input);
+						FILE* file = fopen(input.c_str(), "rb");
+						if (!file) { hasher.Update(std::string("missing")); continue; }
+						std::vector<char> buffer(1024 * 1024);
+						size_t count;
+						while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0) hasher.Update(buffer.data(), count);
+						fclose(file);
+					}
+					hash = hasher.Digest();
+				}
+				if (job.Outputs.empty()) return false;
+
+				// all outputs must exist
+				struct timespec oldestOutput = { 0, 0 };
+				bool first = true;
+				for (const auto& output : job.Outputs)
+				{
+					struct stat info;
+					if (stat(output.c_str(), &info) != 0) return false;
+					if (first || _Before(info.st_mtim, oldestOutput)) oldestOutput = info.st_mtim;
+					first = false;
+				}
+
+				if (_Check == UpToDateCheck::Hash)
+				{
+					std::lock_guard<std::mutex> lock(_StateMutex);
+					auto found = _State.find(job.Name);
+					return found != _State.end() && found->second.Hash == hash;
+				}
+
+				// modify time: no dependency ran and no input is newer than the oldest output
+				if (dependencyRan) return false;
+				for (const auto& input : job.Inputs)
+				{
+					struct stat info;
+					if (stat(input.c_str(), &info) != 0) return false;
+					if (_Before(oldestOutput, info.st_mtim)) return false;
+				}
+				return true;
+			}
+
+			// compare timestamps
+			static inline bool _Before(const struct timespec& a, const struct timespec& b)
+			{
+				return a.tv_sec < b.tv_sec || (a.tv_sec == b.tv_sec && a.tv_nsec < b.tv_nsec);
+			}
+
+			// load state file: one 'name<TAB>duration<TAB>hash' line per job
+			void _LoadState()
+			{
+				if (_StateFile.empty()) return;
+				std::ifstream file(_StateFile);
+				std::string line;
+				while (std::getline(file, line))
+				{
+					std::istringstream fields(line);
+					std::string name, duration, hash;
+					if (!std::getline(fields, name, '\t') || !std::getline(fields, duration, '\t')) continue;
+					std::getline(fields, hash, '\t');
+					__JobState state;
+					state.Duration = atof(duration.c_str());
+					state.Hash = hash;
+					_State[name] = state;
+				}
+			}
+
+			// save state file, writing to a temp file and renaming
+			void _SaveState()
+			{
+				if (_StateFile.empty()) return;
+				std::string tempFile = _StateFile + ".tmp";
+				{
+					std::ofstream file(tempFile, std::ios::trunc);
+					for (const auto& state : _State)
+					{
+						file << state.first << '\t' << state.second.Duration << '\t' << state.second.Hash << '\n';
+					}
+					if (!file.good()) return;
+				}
+				rename(tempFile.c_str(), _StateFile.c_str());
+			}
+		};
+	}
+}
+#endif
+
+
+
+
+// ::Execute\Report.h::
+
+/*!
+ * \file	Source\Execute\Report.h.
+ *
+ * \brief	Aggregate resource usage across a batch of executed processes.
+ */
+// #pragma once
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+// #include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \class	UsageReport
+		 *
+		 * \brief	Collect the resource usage of many executed processes and report totals, peaks
+		 * 			and the most expensive runs.
+		 *
+		 * \date	10/19/2026
+		 */
+		class UsageReport
+		{
+		public:
+
+			// a single recorded run
+			struct Entry
+			{
+				// label given when added
+				std::string Label;
+
+				// return code and usage of the run
+				int ReturnCode = -1;
+				ProcessUsage Usage;
+			};
+
+			/*!
+			 * \fn	void Add(const std::string& label, const ProcessOutput& output)
+			 *
+			 * \brief	Record a run.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	label 	Label to show in report (command, step name, etc.).
+			 * \param	output	Process output to take usage from.
+			 */
+			void Add(const std::string& label, const ProcessOutput& output)
+			{
+				Entry entry;
+				entry.Label = label;
+				entry.ReturnCode = output.ReturnCode;
+				entry.Usage = output.Usage;
+				_Entries.push_back(entry);
+				if (!output.IsSuccess()) _Failures++;
+			}
+
+			/*!
+			 * \fn	ProcessUsage Total() const
+			 *
+			 * \brief	Get usage summed across all runs.
+			 * 			MaxRss is the peak of a single run, not a sum.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	Summed usage.
+			 */
+			ProcessUsage Total() const
+			{
+				ProcessUsage ret;
+				for (const auto& entry : _Entries)
+				{
+					const ProcessUsage& usage = entry.Usage;
+					ret.WallTime += usage.WallTime;
+					ret.UserTime += usage.UserTime;
+					ret.SystemTime += usage.SystemTime;
+					ret.MaxRss = (std::max)(ret.MaxRss, usage.MaxRss);
+					ret.MinorFaults += usage.MinorFaults;
+					ret.MajorFaults += usage.MajorFaults;
+					ret.BlockReads += usage.BlockReads;
+					ret.BlockWrites += usage.BlockWrites;
+					ret.VoluntarySwitches += usage.VoluntarySwitches;
+					ret.InvoluntarySwitches += usage.InvoluntarySwitches;
+					ret.ReadChars += usage.ReadChars;
+					ret.WriteChars += usage.WriteChars;
+					ret.StorageReadBytes += usage.StorageReadBytes;
+					ret.StorageWriteBytes += usage.StorageWriteBytes;
+				}
+				return ret;
+			}
+
+			/*!
+			 * \fn	std::vector<Entry> Top(size_t count, bool byCpu = false) const
+			 *
+			 * \brief	Get the most expensive runs.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	count	Max number of entries to return.
+			 * \param	byCpu	(Optional) If true sort by CPU time, otherwise by wall time.
+			 *
+			 * \return	Entries sorted from most to least expensive.
+			 */
+			std::vector<Entry> Top(size_t count, bool byCpu = false) const
+			{
+				std::vector<Entry> ret(_Entries);
+				std::stable_sort(ret.begin(), ret.end(), [byCpu](const Entry& a, const Entry& b) {
+					return byCpu ? a.Usage.CpuTime() > b.Usage.CpuTime() : a.Usage.WallTime > b.Usage.WallTime;
+				});
+				if (ret.size() > count) ret.resize(count);
+				return ret;
+			}
+
+			/*!
+			 * \fn	std::string ToString(size_t top = 10) const
+			 *
+			 * \brief	Format report as a text table: totals followed by the most expensive runs.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	top	(Optional) How many runs to list, sorted by wall time.
+			 *
+			 * \return	Report text.
+			 */
+			std::string ToString(size_t top = 10) const
+			{
+				std::ostringstream out;
+				out << std::fixed << std::setprecision(3);
+				out << "runs: " << _Entries.size() << ", failed: " << _Failures << "\n";
+				_WriteHeader(out);
+				_WriteRow(out, "TOTAL", Total());
+				for (const auto& entry : Top(top))
+				{
+					_WriteRow(out, entry.Label, entry.Usage);
+				}
+				return out.str();
+			}
+
+			// get all recorded runs
+			inline const std::vector<Entry>& Entries() const { return _Entries; }
+
+			// get how many recorded runs did not succeed
+			inline size_t Failures() const { return _Failures; }
+
+			// clear all recorded runs
+			inline void Clear() { _Entries.clear(); _Failures = 0; }
+
+		private:
+
+			// recorded runs
+			std::vector<Entry> _Entries;
+
+			// how many runs failed
+			size_t _Failures = 0;
+
+			// write table header
+			static void _WriteHeader(std::ostringstream& out)
+			{
+				out << std::left << std::setw(32) << "label" << std::right
+					<< std::setw(10) << "wall(s)" << std::setw(10) << "user(s)" << std::setw(10) << "sys(s)"
+					<< std::setw(12) << "maxrss(KB)" << std::setw(10) << "minflt" << std::setw(8) << "majflt"
+					<< std::setw(10) << "blk-in" << std::setw(10) << "blk-out" << std::setw(10) << "vcsw" << std::setw(10) << "ivcsw"
+					<< std::setw(14) << "read(B)" << std::setw(14) << "write(B)" << "\n";
+			}
+
+			// write a single table row
+			static void _WriteRow(std::ostringstream& out, const std::string& label, const ProcessUsage& usage)
+			{
+				std::string shortLabel = label.size() > 31 ? label.substr(0, 28) + "..." : label;
+				out << std::left << std::setw(32) << shortLabel << std::right
+					<< std::setw(10) << usage.WallTime << std::setw(10) << usage.UserTime << std::setw(10) << usage.SystemTime
+					<< std::setw(12) << usage.MaxRss << std::setw(10) << usage.MinorFaults << std::setw(8) << usage.MajorFaults
+					<< std::setw(10) << usage.BlockReads << std::setw(10) << usage.BlockWrites
+					<< std::setw(10) << usage.VoluntarySwitches << std::setw(10) << usage.InvoluntarySwitches
+					<< std::setw(14) << usage.StorageReadBytes << std::setw(14) << usage.StorageWriteBytes << "\n";
+			}
+		};
+	}
+}
+
+
+
+
+// ::Execute\Scripts.h::
+
+/*!
+ * \file	Source\Execute\Scripts.h.
+ *
+ * \brief	Execute different scripts.
+ */
+// #pragma once
+
+// #include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \fn	ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string())
+		 *
+		 * \brief	Executes the script operation
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/20/2018
+		 *
+		 * \param	scriptType	Type of the script (python / ruby / perl / ...).
+		 * \param	scriptPath	Full path of the script file to execute.
+		 * \param	params	  	(Optional) Script params.
+		 *
+		 * \return	A ProcessOutput.
+		 */
+		ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string())
+		{
+			return Command(scriptType + " \"" + scriptPath + "\" " + params);
+		}
+
+		/*!
+		 * \fn	ProcessOutput PythonScript(const std::string& scriptPath, const std::string& params = std::string())
+		 *
+		 * \brief	Executes Python script.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/20/2018
+		 *
+		 * \param	scriptPath	Full path of the script file to execute.
+		 * \param	params	  	(Optional) Params to pass to script.
+		 *
+		 * \return	A ProcessOutput.
+		 */
+		ProcessOutput PythonScript(const std::string& scriptPath, const std::string& params = std::string())
+		{
+			static std::string type = "python";
+			return Script(type, scriptPath, params);
+		}
+
+		/*!
+		* \fn	ProcessOutput PerlScript(const std::string& scriptPath, const std::string& params = std::string())
+		*
+		* \brief	Executes Perl script.
+		*
+		* \author	Ronen Ness
+		* \date	10/20/2018
+		*
+		* \param	scriptPath	Full path of the script file to execute.
+		* \param	params	  	(Optional) Params to pass to script.
+		*
+		* \return	A ProcessOutput.
+		*/
+		ProcessOutput PerlScript(const std::string& scriptPath, const std::string& params = std::string())
+		{
+			static std::string type = "perl";
+			return Script(type, scriptPath, params);
+		}
+
+		/*!
+		* \fn	ProcessOutput RubyScript(const std::string& scriptPath, const std::string& params = std::string())
+		*
+		* \brief	Executes Ruby script.
+		*
+		* \author	Ronen Ness
+		* \date	10/20/2018
+		*
+		* \param	scriptPath	Full path of the script file to execute.
+		* \param	params	  	(Optional) Params to pass to script.
+		*
+		* \return	A ProcessOutput.
+		*/
+		ProcessOutput RubyScript(const std::string& scriptPath, const std::string& params = std::string())
+		{
+			static std::string type = "ruby";
+			return Script(type, scriptPath, params);
+		}
+	}
+}
+
+
+
+// ::Execute\SpawnServer.h::
+
+/*!
+ * \file	Source\Execute\SpawnServer.h.
+ *
+ * \brief	A small pre-forked helper process that spawns children on our behalf.
+ */
+// #pragma once
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <mutex>
+#include <type_traits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// #include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \namespace	SpawnServer
+		 *
+		 * \brief	Spawn server: a process forked while we are still small, which launches children for us
+		 * 			when asked over a socket. Forking a small process is cheap, so launch latency does not
+		 * 			grow with our RSS. Children's exit status and resource usage are sent back to us, so
+		 * 			executed processes report the same output as when spawned locally.
+		 * 			To use it, call Start() early in main (before allocating a lot of memory or starting threads),
+		 * 			then SetSpawnMethod(SpawnMethod::Server).
+		 *
+		 * \date	10/19/2026
+		 */
+		namespace SpawnServer
+		{
+			// control socket to the server, server pid, and lock for sending requests
+			inline int _control = -1;
+			inline pid_t _serverPid = -1;
+			inline std::mutex _mutex;
+
+			// request flags
+			const uint32_t _HasStdin = 1;
+			const uint32_t _HasStdout = 2;
+			const uint32_t _HasHints = 4;
+
+			// request header, followed by path, cwd, argv and environment as null-terminated strings
+			struct __Request
+			{
+				uint32_t Flags;
+				uint32_t Argc;
+				uint32_t Envc;
+				Options Hints;
+			};
+			static_assert(std::is_trivially_copyable<Options>::value, "Options are sent to the server as raw bytes");
+
+			/*!
+			 * \fn	inline bool _SendFds(int socket, const void* data, size_t size, const int* fds, int fdsCount)
+			 *
+			 * \brief	Used internally, send a message with file descriptors attached.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline bool _SendFds(int socket, const void* data, size_t size, const int* fds, int fdsCount)
+			{
+				struct iovec iov;
+				iov.iov_base = const_cast<void*>(data);
+				iov.iov_len = size;
+
+				char control[CMSG_SPACE(sizeof(int) * 3)];
+				memset(control, 0, sizeof(control));
+				struct msghdr message;
+				memset(&message, 0, sizeof(message));
+				message.msg_iov = &iov;
+				message.msg_iovlen = 1;
+				message.msg_control = control;
+				message.msg_controllen = CMSG_SPACE(sizeof(int) * fdsCount);
+
+				struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+				header->cmsg_level = SOL_SOCKET;
+				header->cmsg_type = SCM_RIGHTS;
+				header->cmsg_len = CMSG_LEN(sizeof(int) * fdsCount);
+				memcpy(CMSG_DATA(header), fds, sizeof(int) * fdsCount);
+
+				ssize_t result;
+				while ((result = sendmsg(socket, &message, MSG_NOSIGNAL)) == -1 && errno == EINTR) {}
+				return result == (ssize_t)size;
+			}
+
+			/*!
+			 * \fn	inline void _HandleRequest(int control, const sigset_t& childMask, std::unordered_map<pid_t, int>& replies)
+			 *
+			 * \brief	Used internally, runs in the server: receive a launch request and fork the child.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline bool _HandleRequest(int control, const sigset_t& childMask, std::unordered_map<pid_t, int>& replies)
+			{
+				// get message size first
+				char peek;
+				ssize_t size = recv(control, &peek, 1, MSG_PEEK | MSG_TRUNC);
+				if (size <= 0) return size < 0 && errno == EINTR;
+
+				// receive message with its descriptors
+				std::vector<char> data((size_t)size + 1, 0);
+				struct iovec iov;
+				iov.iov_base = data.data();
+				iov.iov_len = (size_t)size;
+				char controlBuffer[CMSG_SPACE(sizeof(int) * 3)];
+				struct msghdr message;
+				memset(&message, 0, sizeof(message));
+				message.msg_iov = &iov;
+				message.msg_iovlen = 1;
+				message.msg_control = controlBuffer;
+				message.msg_controllen = sizeof(controlBuffer);
+				if (recvmsg(control, &message, MSG_CMSG_CLOEXEC) != size) return true;
+
+				int fds[3] = { -1, -1, -1 };
+				int fdsCount = 0;
+				struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+				if (header && header->cmsg_type == SCM_RIGHTS)
+				{
+					fdsCount = (int)((header->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+					memcpy(fds, CMSG_DATA(header), sizeof(int) * (fdsCount > 3 ? 3 : fdsCount));
+				}
+				if (fdsCount < 1 || (size_t)size < sizeof(__Request))
+				{
+					for (int i = 0; i < fdsCount && i < 3; ++i) close(fds[i]);
+					return true;
+				}
+
+				// parse request
+				__Request request;
+				memcpy(&request, data.data(), sizeof(request));
+				int reply = fds[0];
+				int next = 1;
+				int stdinFd = (request.Flags & _HasStdin) && next < fdsCount ? fds[next++] : -1;
+				int stdoutFd = (request.Flags & _HasStdout) && next < fdsCount ? fds[next++] : -1;
+
+				std::vector<char*> strings;
+				char* position = data.data() + sizeof(request);
+				char* end = data.data() + size;
+				while (position < end)
+				{
+					strings.push_back(position);
+					position += strlen(position) + 1;
+				}
+
+				pid_t pid = -1;
+				if (strings.size() == 2 + (size_t)request.Argc + request.Envc)
+				{
+					std::vector<char*> argv(strings.begin() + 2, strings.begin() + 2 + request.Argc);
+					argv.push_back(NULL);
+					std::vector<char*> envp(strings.begin() + 2 + request.Argc, strings.end());
+					envp.push_back(NULL);
+
+					__ExecArgs exec;
+					exec.Path = strings[0];
+					exec.Argv = argv.data();
+					exec.Envp = envp.data();
+					exec.StdinFd = stdinFd;
+					exec.StdoutFd = stdoutFd;
+					exec.SignalMask = childMask;
+					exec.Hints = (request.Flags & _HasHints) ? &request.Hints : NULL;
+					const char* cwd = strings[1];
+
+					// we are small, so a plain fork is cheap here
+					pid = fork();
+					if (pid == 0)
+					{
+						if (chdir(cwd) != 0) _exit(127);
+						_ExecChild(exec);
+					}
+				}
+				if (stdinFd != -1) close(stdinFd);
+				if (stdoutFd != -1) close(stdoutFd);
+
+				// tell client the child pid, and remember where to send its exit status
+				int32_t sent = (int32_t)pid;
+				if (send(reply, &sent, sizeof(sent), MSG_NOSIGNAL) != sizeof(sent) || pid <= 0)
+				{
+					close(reply);
+				}
+				else
+				{
+					replies[pid] = reply;
+				}
+				return true;
+			}
+
+			/*!
+			 * \fn	inline void _CollectChildren(std::unordered_map<pid_t, int>& replies)
+			 *
+			 * \brief	Used internally, runs in the server: reap exited children and report their status.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline void _CollectChildren(std::unordered_map<pid_t, int>& replies)
+			{
+				while (true)
+				{
+					siginfo_t info;
+					memset(&info, 0, sizeof(info));
+					if (waitid(P_ALL, 0, &info, WEXITED | WNOHANG | WNOWAIT) != 0 || info.si_pid == 0) break;
+
+					__ChildStatus status;
+					_WaitChild(info.si_pid, status);
+					auto found = replies.find(info.si_pid);
+					if (found != replies.end())
+					{
+						send(found->second, &status, sizeof(status), MSG_NOSIGNAL);
+						close(found->second);
+						replies.erase(found);
+					}
+				}
+			}
+
+			/*!
+			 * \fn	inline void _ServerMain(int control)
+			 *
+			 * \brief	Used internally, main loop of the server process. Exits when control socket is closed.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline void _ServerMain(int control)
+			{
+				// don't keep any descriptor of our parent open, except the control socket and standard streams
+				std::vector<int> inherited;
+				DIR* dir = opendir("/proc/self/fd");
+				if (dir)
+				{
+					struct dirent* entry;
+					while ((entry = readdir(dir)) != NULL)
+					{
+						int fd = atoi(entry->d_name);
+						if (fd > STDERR_FILENO && fd != control && fd != dirfd(dir)) inherited.push_back(fd);
+					}
+					closedir(dir);
+				}
+				for (int fd : inherited) close(fd);
+
+				// get notified on child exit via a signalfd; children get an empty signal mask
+				sigset_t childMask, childSignal;
+				sigemptyset(&childMask);
+				sigemptyset(&childSignal);
+				sigaddset(&childSignal, SIGCHLD);
+				for (int sig = 1; sig < NSIG; ++sig) signal(sig, SIG_DFL);
+				signal(SIGPIPE, SIG_IGN);
+				sigprocmask(SIG_SETMASK, &childSignal, NULL);
+				int childEvents = signalfd(-1, &childSignal, SFD_CLOEXEC | SFD_NONBLOCK);
+
+				std::unordered_map<pid_t, int> replies;
+				while (true)
+				{
+					struct pollfd fds[2];
+					fds[0].fd = control; fds[0].events = POLLIN; fds[0].revents = 0;
+					fds[1].fd = childEvents; fds[1].events = POLLIN; fds[1].revents = 0;
+					if (poll(fds, 2, -1) < 0 && errno != EINTR) break;
+
+					if (fds[1].revents)
+					{
+						struct signalfd_siginfo info;
+						while (read(childEvents, &info, sizeof(info)) > 0) {}
+						_CollectChildren(replies);
+					}
+					if (fds[0].revents && !_HandleRequest(control, childMask, replies)) break;
+				}
+				_exit(0);
+			}
+
+			/*!
+			 * \fn	inline __Child _Launch(const std::string& path, const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options)
+			 *
+			 * \brief	Used internally, ask the server to launch a child.
+			 * 			Our environment and working directory are sent along, so the child sees them as if we spawned it.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline __Child _Launch(const std::string& path, const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options)
+			{
+				__Child ret;
+
+				// build request
+				char cwd[4096];
+				if (!getcwd(cwd, sizeof(cwd))) return ret;
+				size_t envc = 0;
+				while (environ[envc]) envc++;
+				__Request request;
+				request.Flags = (stdinFd != -1 ? _HasStdin : 0) | (stdoutFd != -1 ? _HasStdout : 0) | (options.IsEmpty() ? 0 : _HasHints);
+				request.Hints = options;
+				request.Argc = (uint32_t)argv.size();
+				request.Envc = (uint32_t)envc;
+
+				std::string data((const char*)&request, sizeof(request));
+				data.append(path).push_back('\0');
+				data.append(cwd).push_back('\0');
+				for (const auto& arg : argv) data.append(arg).push_back('\0');
+				for (size_t i = 0; i < envc; ++i) data.append(environ[i]).push_back('\0');
+
+				// per-request socket to get the child pid and exit status on
+				int reply[2];
+				if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, reply) != 0) return ret;
+				int fds[3];
+				int fdsCount = 0;
+				fds[fdsCount++] = reply[1];
+				if (stdinFd != -1) fds[fdsCount++] = stdinFd;
+				if (stdoutFd != -1) fds[fdsCount++] = stdoutFd;
+
+				bool sent;
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					sent = _control != -1 && _SendFds(_control, data.data(), data.size(), fds, fdsCount);
+				}
+				close(reply[1]);
+
+				int32_t pid = -1;
+				ssize_t count = -1;
+				if (sent)
+				{
+					while ((count = read(reply[0], &pid, sizeof(pid))) == -1 && errno == EINTR) {}
+				}
+				if (count != sizeof(pid) || pid <= 0)
+				{
+					close(reply[0]);
+					return ret;
+				}
+				ret.Pid = pid;
+				ret.StatusFd = reply[0];
+				return ret;
+			}
+
+			/*!
+			 * \fn	inline bool Start()
+			 *
+			 * \brief	Fork the spawn server. Call it early, while this process is still small.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	True if server is running.
+			 */
+			inline bool Start()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_control != -1) return true;
+
+				int sockets[2];
+				if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0) return false;
+				pid_t pid = fork();
+				if (pid == -1)
+				{
+					close(sockets[0]);
+					close(sockets[1]);
+					return false;
+				}
+				if (pid == 0)
+				{
+					close(sockets[0]);
+					_ServerMain(sockets[1]);
+				}
+				close(sockets[1]);
+				_control = sockets[0];
+				_serverPid = pid;
+				_spawnServerLaunch.store(_Launch, std::memory_order_release);
+				return true;
+			}
+
+			/*!
+			 * \fn	inline void Stop()
+			 *
+			 * \brief	Stop the spawn server. Children it launched keep running,
+			 * 			but their exit status will not be reported.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline void Stop()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_control == -1) return;
+				_spawnServerLaunch.store(nullptr, std::memory_order_release);
+				close(_control);
+				_control = -1;
+				while (waitpid(_serverPid, NULL, 0) == -1 && errno == EINTR) {}
+				_serverPid = -1;
+			}
+
+			// return if spawn server is running
+			inline bool IsRunning()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _control != -1;
+			}
+		}
+	}
+}
+#endif
+
+
+
+
+// ::Http\HttpRequests.h::
+
+/*!
+* \file	Source\Http\HttpRequests.h.
+*
+* \brief	Send HTTP requests.
+*/
+// #pragma once
+
+#ifdef _WIN32
+
+#include <string.h>
+#include <windows.h>
+#include <sstream>
+#include <unordered_map>
+#include <winhttp.h>
+// #include "../Strings/To/All.h"
+// #include "../Strings/From/Maps.h"
+
+#pragma comment(lib, "winhttp.lib")
+
+namespace Just
+{
+	namespace Http
+	{
+		/*!
+		 * \enum	HttpConnectionErrors
+		 *
+		 * \brief	Values that represent HTTP connection errors.
+		 */
+		enum HttpConnectionErrors
+		{
+			NoError,
+			FailedToConnect,
+			FailedToOpenSession,
+			FailedToOpenRequest,
+			FailedToSendRequest,
+			FailedToReceiveResponse,
+			NoHttpDataAvailable,
+			FailedToReadHttpData,
+			ResponseError,
+		};
+
+		/*!
+		 * \struct	HttpResponse
+		 *
+		 * \brief	An HTTP response.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/19/2018
+		 */
+		struct HttpResponse
+		{
+		public:
+			// returned text
+			std::string Text;
+
+			// how many bytes we read in total from response
+			unsigned int TotalBytesRead = 0;
+
+			// return if response was OK.
+			inline bool good() const { return Error == NoError; }
+
+			// error types we can get
+			HttpConnectionErrors Error = NoError;
+
+			// error code / details (or 0 if no errors).
+			// not: this is not HTTP error codes you could get from server, its from errors you get from OS.
+			DWORD ErrorCode = 0;
+		};
+
+		// useragent string
+		std::string _useragent = "JUST Program/1.0";
+
+		// To automatically release handles when out of scope.
+		class __HandlesReleaser
+		{
+			HINTERNET _handle;
+		public:
+			__HandlesReleaser(HINTERNET handle)
+			{
+				_handle = handle;
+			}
+			virtual ~__HandlesReleaser()
+			{
+				WinHttpCloseHandle(_handle);
+			}
+		};
+
+		/*!
+		 * \fn	void SetUserAgent(const std::string& ua)
+		 *
+		 * \brief	Sets useragent for all HTTP requests.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/19/2018
+		 *
+		 * \param	ua	New useragent text.
+		 */
+		void SetUserAgent(const std::string& ua)
+		{
+			_useragent = ua;
+		}
+
+		/*!
+		 * \fn	HttpResponse Send(std::string url, int port = 80)
+		 *
+		 * \brief	Send an Http request.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/19/2018
+		 *
+		 * \param	host 				Host to send request to.
+		 * \param	method				Request type (GET / POST / PUT /...)
+		 * \param	action				Url under host for request.
+		 * \param	content				(Optional) Content to send.
+		 * \param	additionalHeaders	(Optional) Additional headers.
+		 * \param	port				(Optional) Port to connect to.
+		 *
+		 * \return	A HttpResponse.
+		 */
+		HttpResponse Send(const std::string& host, 
+			const std::string& method = "GET",
+			const std::string& action = "/", 
+			const std::string& content = std::string(), 
+			const std::string& additionalHeaders = std::string(),
+			USHORT port = INTERNET_DEFAULT_HTTP_PORT)
+		{
+			// internal macro to stop and return in case of errors
+			#define __ReturnHttpErrorIfFailed(condition, ErrType) \
+			if (!condition) { \
+				ret.Error = ErrType; \
+				ret.ErrorCode = GetLastError(); \
+				return ret; }
+
+			// return value
+			HttpResponse ret;
+
+			// some params
+			BOOL  bResults = FALSE;
+			HINTERNET hSession = NULL,
+				hConnect = NULL,
+				hRequest = NULL;
+
+			// use WinHttpOpen to obtain a session handle.
+			LPCWSTR useragent; Just::String::To::LpcwStr(_useragent, useragent);
+			hSession = WinHttpOpen(useragent,
+				WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+				WINHTTP_NO_PROXY_NAME,
+				WINHTTP_NO_PROXY_BYPASS, 
+				0);
+			delete[] useragent;
+			__ReturnHttpErrorIfFailed(hSession, FailedToOpenSession);
+
+			// to make sure session is cleared
+			__HandlesReleaser hSessionR(hSession);
+
+			// specify an HTTP server.
+			LPCWSTR lphost; Just::String::To::LpcwStr(host, lphost);
+			hConnect = WinHttpConnect(hSession, lphost, port, 0);
+			delete[] lphost;
+			__ReturnHttpErrorIfFailed(hConnect, FailedToConnect);
+
+			// to make sure connection is cleared
+			__HandlesReleaser hConnectR(hConnect);
+
+			// create an HTTP Request handle.
+			LPCWSTR wmethod; Just::String::To::LpcwStr(method, wmethod);
+			LPCWSTR waction; Just::String::To::LpcwStr(action, waction);
+			hRequest = WinHttpOpenRequest(hConnect,
+				wmethod,
+				waction,
+				NULL, 
+				WINHTTP_NO_REFERER,
+				WINHTTP_DEFAULT_ACCEPT_TYPES,
+				0);
+			delete[] wmethod;
+			delete[] waction;
+			__ReturnHttpErrorIfFailed(hRequest, FailedToOpenRequest);
+
+			// to make sure request is cleared
+			__HandlesReleaser hRequestR(hRequest);
+
+			// set additional headers
+			LPCWSTR headers = WINHTTP_NO_ADDITIONAL_HEADERS;
+			if (additionalHeaders.size()) Just::String::To::LpcwStr(additionalHeaders, headers);
+
+			// set content
+			LPCWSTR contentBuff = WINHTTP_NO_REQUEST_DATA;
+			if (content.size()) Just::String::To::LpcwStr(content, contentBuff);
+
+			// send the Request.
+			bResults = WinHttpSendRequest(hRequest,
+				headers,
+				(DWORD)additionalHeaders.length(),
+				&contentBuff,
+				(DWORD)content.length(),
+				(DWORD)content.length(),
+				(DWORD)0);
+			if (headers) delete[] headers;
+			if (contentBuff) delete[] contentBuff;
+			__ReturnHttpErrorIfFailed(bResults, FailedToSendRequest);
+
+			// wait to recieve response
+			bResults = WinHttpReceiveResponse(hRequest, NULL);
+			__ReturnHttpErrorIfFailed(bResults, FailedToReceiveResponse);
+
+			// read actual data from response
+			DWORD dwSize = 0;
+			DWORD dwDownloaded = 0;
+			do
+			{
+				// get how much data we have to read
+				dwSize = 0;
+				bResults = WinHttpQueryDataAvailable(hRequest, &dwSize);
+				__ReturnHttpErrorIfFailed(bResults, NoHttpDataAvailable);
+
+				// allocate space for the buffer.
+				char* pszOutBuffer = new char[dwSize + 1];
+				
+				// read the Data.
+				ZeroMemory(pszOutBuffer, dwSize + 1);
+
+				bResults = WinHttpReadData(hRequest, (LPVOID)pszOutBuffer, dwSize, &dwDownloaded);
+				if (!bResults) { delete[] pszOutBuffer; }
+				__ReturnHttpErrorIfFailed(bResults, FailedToReadHttpData);
+
+				// add to response
+				ret.Text += pszOutBuffer;
+				ret.TotalBytesRead += dwSize;
+
+				// Free the memory allocated to the buffer.
+				delete[] pszOutBuffer;
+
+			} while (dwSize > 0);
+
+			// return response
+			return ret;
+		}
+
+		/*!
+		* \fn	HttpResponse Send(std::string url, int port = 80)
+		*
+		* \brief	Send an Http request.
+		*
+		* \author	Ronen Ness
+		* \date	10/19/2018
+		*
+		* \param	url 				Full url to send request to.
+		* \param	method				Request type (GET / POST / PUT /...)
+		* \param	content				(Optional) Content to send.
+		* \param	additionalHeaders	(Optional) Additional headers.
+		* \param	port				(Optional) Port to connect to.
+		*
+		* \return	A HttpResponse.
+		*/
+		HttpResponse Send(const std::string& url,
+			const std::string& method = "GET",
+			const std::string& content = std::string(),
+			const std::unordered_map<std::string, std::string>& additionalHeaders = std::unordered_map<std::string, std::string>(),
+			USHORT port = 80)
+		{
+			// split host and and action parts.
+			// first check if URL contains "http:", then we find the first / that is not part of the http:// part and split based on it.
+			bool gotHttp = url.substr(0, 5).find("http:") == 0;
+			auto hostEnd = url.find('/', gotHttp ? strlen("http://")+1 : 0);
+			auto host = hostEnd == std::string::npos ? url : url.substr(0, hostEnd);
+			auto action = hostEnd == std::string::npos ? "/" : url.substr(hostEnd);
+			
+			// if host contains /, for example from http://, remove it.
+			auto hostStart = host.rfind("/");
+			if (hostStart != std::string::npos) { host = host.substr(hostStart + 1); }
+
+			// convert headers to string
+			auto headers = Just::String::From::Map(additionalHeaders, ":", "\n");
+
+			// send http request
+			return Send(host, method, action, content, headers, port);
+		}
+
+		/*!
+		 * \fn	HttpResponse SendForm(const std::string& url, const std::string& type = "POST", const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		 *
+		 * \brief	Sends an HTTP form.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/19/2018
+		 *
+		 * \param	url		  	URL of the document.
+		 * \param	method	  	(Optional) The method of HTTP request.
+		 * \param	data	  	(Optional) The form data to send.
+		 * \param	port	  	(Optional) Port to connect to.
+		 *
+		 * \return	A HttpResponse.
+		 */
+		HttpResponse SendForm(const std::string& url,
+			const std::string& method = "POST",
+			const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(),
+			USHORT port = 80)
+		{
+			auto headers = std::unordered_map<std::string, std::string>();
+			headers["Content-Type"] = "application/x-www-form-urlencoded";
+			auto content = Just::String::From::Map(data, "=", "&");
+			return Send(url, method, content, headers, port);
+		}
+
+		/*!
+		 * \fn	HttpResponse Get(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		 *
+		 * \brief	Send HTTP GET request.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/19/2018
+		 *
+		 * \param	url				 	URL of the document.
+		 * \param	port			 	(Optional) Port to connect to.
+		 *
+		 * \return	A HttpResponse.
+		 */
+		HttpResponse Get(const std::string& url, USHORT port = 80)
+		{
+			static std::string method = "GET";
+			static std::unordered_map<std::string, std::string> headers;
+			return Send(url, method, std::string(), headers, port);
+		}
+
+		/*!
+		* \fn	HttpResponse Post(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		*
+		* \brief	Send HTTP POST request.
+		*
+		* \author	Ronen Ness
+		* \date	10/19/2018
+		*
+		* \param	url				 	URL of the document.
+		* \param	data				(Optional) Data to send with request.
+		* \param	port			 	(Optional) Port to connect to.
+		*
+		* \return	A HttpResponse.
+		*/
+		HttpResponse Post(const std::string& url,
+			const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(),
+			USHORT port = 80)
+		{
+			static std::string method = "POST";
+			return SendForm(url, method, data, port);
+		}
+
+		/*!
+		* \fn	HttpResponse Put(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		*
+		* \brief	Send HTTP PUT request.
+		*
+		* \author	Ronen Ness
+		* \date	10/19/2018
+		*
+		* \param	url				 	URL of the document.
+		* \param	data				(Optional) Data to send with request.
+		* \param	port			 	(Optional) Port to connect to.
+		*
+		* \return	A HttpResponse.
+		*/
+		HttpResponse Put(const std::string& url,
+			const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(),
+			USHORT port = 80)
+		{
+			static std::string method = "PUT";
+			return SendForm(url, method, data, port);
+		}
+
+		/*!
+		* \fn	HttpResponse Delete(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		*
+		* \brief	Send HTTP DELETE request.
+		*
+		* \author	Ronen Ness
+		* \date	10/19/2018
+		*
+		* \param	url				 	URL of the document.
+		* \param	port			 	(Optional) Port to connect to.
+		*
+		* \return	A HttpResponse.
+		*/
+		HttpResponse Delete(const std::string& url, USHORT port = 80)
+		{
+			static std::string method = "DELETE";
+			return Send(url, method, std::string(), std::unordered_map<std::string, std::string>(), port = port);
+		}
+	}
+}
+#endif
+
+
+
+// ::SharedMemory\Copy.h::
+
+/*!
+* \file	Source\SharedMemory\Copy.h.
+*
+* \brief	Bulk memory copy that bypasses the caches for large sizes (non-temporal stores), picked at runtime for the CPU.
+*/
+// #pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+// JUST_SHM_STREAMING_COPY is defined where BulkCopy has streaming stores (x86-64), elsewhere both modes are memcpy.
+// JUST_SHM_TARGET_AVX2 is internal, undefined at the end of this file
+#if defined(__x86_64__) || defined(_M_X64)
+#define JUST_SHM_STREAMING_COPY 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define JUST_SHM_TARGET_AVX2
+#else
+#define JUST_SHM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	CopyMode
+		*
+		* \brief	How BulkCopy writes the destination.
+		*/
+		enum class CopyMode
+		{
+			// streaming from the threshold up (see SetStreamingThreshold), cached below it
+			Auto = 0,
+
+			// plain memcpy, destination ends up in the cache. best when it is read again soon, or is small
+			Cached = 1,
+
+			// non-temporal stores straight to memory, without evicting what is in the cache. best for large copies
+			// that won't be read again soon by this core (the reader is another process, usually on another core)
+			Streaming = 2,
+		};
+
+		// copies from this size up stream by default. about the point where the copy no longer fits in the caches
+		inline std::atomic<size_t> _StreamingThreshold(4u << 20);
+
+		// set the size from which CopyMode::Auto copies stream, 0 to always stream, SIZE_MAX to never stream
+		inline void SetStreamingThreshold(size_t bytes) { _StreamingThreshold.store(bytes, std::memory_order_relaxed); }
+
+		// get the size from which CopyMode::Auto copies stream
+		inline size_t GetStreamingThreshold() { return _StreamingThreshold.load(std::memory_order_relaxed); }
+
+#ifdef JUST_SHM_STREAMING_COPY
+		/*!
+		* \fn	inline void _StreamCopySse2(char* destination, const char* source, size_t size)
+		*
+		* \brief	Used internally, copy with 16 byte non-temporal stores. SSE2 is part of x86-64, so this always works.
+		*
+		* \date		10/19/2026
+		*/
+		inline void _StreamCopySse2(char* destination, const char* source, size_t size)
+		{
+			// align destination, streaming stores need aligned addresses
+			size_t head = (16 - ((uintptr_t)destination & 15)) & 15;
+			if (head > size) head = size;
+			memcpy(destination, source, head);
+			destination += head;
+			source += head;
+			size -= head;
+
+			for (; size >= 64; size -= 64, destination += 64, source += 64)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)source);
+				__m128i b = _mm_loadu_si128((const __m128i*)(source + 16));
+				__m128i c = _mm_loadu_si128((const __m128i*)(source + 32));
+				__m128i d = _mm_loadu_si128((const __m128i*)(source + 48));
+				_mm_stream_si128((__m128i*)destination, a);
+				_mm_stream_si128((__m128i*)(destination + 16), b);
+				_mm_stream_si128((__m128i*)(destination + 32), c);
+				_mm_stream_si128((__m128i*)(destination + 48), d);
+			}
+			memcpy(destination, source, size);
+
+			// streaming stores are weakly ordered, make them visible before anything written after the copy
+			_mm_sfence();
+		}
+
+		/*!
+		* \fn	inline void _StreamCopyAvx2(char* destination, const char* source, size_t size)
+		*
+		* \brief	Used internally, copy with 32 byte non-temporal stores. Only call it if the CPU supports AVX2.
+		*
+		* \date		10/19/2026
+		*/
+		JUST_SHM_TARGET_AVX2 inline void _StreamCopyAvx2(char* destination, const char* source, size_t size)
+		{
+			size_t head = (32 - ((uintptr_t)destination & 31)) & 31;
+			if (head > size) head = size;
+			memcpy(destination, source, head);
+			destination += head;
+			source += head;
+			size -= head;
+
+			for (; size >= 128; size -= 128, destination += 128, source += 128)
+			{
+				__m256i a = _mm256_loadu_si256((const __m256i*)source);
+				__m256i b = _mm256_loadu_si256((const __m256i*)(source + 32));
+				__m256i c = _mm256_loadu_si256((const __m256i*)(source + 64));
+				__m256i d = _mm256_loadu_si256((const __m256i*)(source + 96));
+				_mm256_stream_si256((__m256i*)destination, a);
+				_mm256_stream_si256((__m256i*)(destination + 32), b);
+				_mm256_stream_si256((__m256i*)(destination + 64), c);
+				_mm256_stream_si256((__m256i*)(destination + 96), d);
+			}
+			memcpy(destination, source, size);
+			_mm_sfence();
+		}
+
+		/*!
+		* \fn	inline bool _HasAvx2()
+		*
+		* \brief	Used internally, return if the CPU (and OS) support AVX2. Checked once.
+		*
+		* \date		10/19/2026
+		*/
+		inline bool _HasAvx2()
+		{
+#ifdef _MSC_VER
+			static const bool supported = []() {
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7) return false;
+				__cpuid(info, 1);
+				bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+				__cpuidex(info, 7, 0);
+				return osSavesAvx && (info[1] & (1 << 5)) != 0;
+			}();
+#else
+			static const bool supported = __builtin_cpu_supports("avx2");
+#endif
+			return supported;
+		}
+#endif
+
+		/*!
+		* \fn	inline void BulkCopy(void* destination, const void* source, size_t size, CopyMode mode = CopyMode::Auto)
+		*
+		* \brief	Copy memory, with non-temporal stores for large sizes so a big transfer does not flush the caches
+		* 			of the copying core (and the lines don't have to be pulled back from it by the process that reads them).
+		* 			Uses AVX2 if the CPU has it, SSE2 otherwise; on other architectures it is a plain memcpy.
+		* 			Ends with a store fence, so it can be published with a release store like a memcpy.
+		*
+		* \date		10/19/2026
+		*
+		* \param	destination			Memory to copy to. Must not overlap source.
+		* \param	source				Memory to copy from.
+		* \param	size				Bytes to copy.
+		* \param	mode				(Optional) Copy strategy, Auto picks by size.
+		*/
+		inline void BulkCopy(void* destination, const void* source, size_t size, CopyMode mode = CopyMode::Auto)
+		{
+#ifdef JUST_SHM_STREAMING_COPY
+			if (mode == CopyMode::Streaming || (mode == CopyMode::Auto && size >= _StreamingThreshold.load(std::memory_order_relaxed)))
+			{
+				if (_HasAvx2()) _StreamCopyAvx2((char*)destination, (const char*)source, size);
+				else _StreamCopySse2((char*)destination, (const char*)source, size);
+				return;
+			}
+#else
+			(void)mode;
+#endif
+			memcpy(destination, source, size);
+		}
+	}
+}
+
+#undef JUST_SHM_TARGET_AVX2
+
+
+
+
+// ::SharedMemory\SharedMemory.h::
+
+/*!
+* \file	Source\SharedMemory\SharedMemory.h.
+*
+* \brief	Creating and using Shared Memory between processes.
+*/
+// #pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+// #include "Copy.h"
+
+#ifdef _WIN32
+#include <windows.h>
+// #include "../Strings/To/All.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	Options
+		*
+		* \brief	Options for mapping a shared memory, to get predictable access latency.
+		* 			Applied on linux only.
+		*
+		* \date		10/19/2026
+		*/
+		struct Options
+		{
+			// pre-fault all pages when mapping (MAP_POPULATE), so first access doesn't page fault
+			bool Populate = false;
+
+			// use huge pages: MFD_HUGETLB for anonymous memory, transparent huge pages (madvise) for named memory
+			bool HugePages = false;
+
+			// lock pages in RAM (mlock) so they are never swapped out. fails if RLIMIT_MEMLOCK is too low
+			bool LockPages = false;
+
+			// if true, the process that created a named shared memory removes its name when it closes.
+			// processes already connected keep using it, but new processes can't connect anymore, and a ConnectOrCreate
+			// after that creates a new, separate memory. off by default, the name stays until Unlink() is called
+			bool UnlinkOnClose = false;
+
+			// if not 0, the shared memory can grow up to MaxSize bytes with Grow(). Address space for MaxSize is
+			// reserved up front, so the buffer never moves. Processes connecting to it must set MaxSize too
+			// (any non 0 value, the creator's is used)
+			size_t MaxSize = 0;
+
+			// map read only (Connect, ConnectFd, OpenFileBacked), for example to share an immutable dataset.
+			// writing through Write* functions throws
+			bool ReadOnly = false;
+		};
+
+		/*!
+		* \struct	__FileHeader
+		*
+		* \brief	Used internally, header page in front of the buffer of file backed shared memories.
+		* 			DataChecksum is the buffer checksum at the last Snapshot, HeaderChecksum covers the fields before it.
+		*/
+		struct __FileHeader
+		{
+			uint64_t Magic;
+			uint64_t Size;
+			uint64_t Generation;
+			uint64_t DataChecksum;
+			uint64_t HeaderChecksum;
+		};
+
+		// magic value marking a file backed shared memory, and size of its header (a page, so the buffer stays page aligned)
+		const uint64_t _FileMagic = 0x4a55535446494c45ULL;
+		const size_t _FileHeaderSize = 4096;
+
+		/*!
+		* \fn	inline uint64_t _Checksum(const void* data, size_t size)
+		*
+		* \brief	Used internally, fast 64 bit checksum (4 lanes of xxhash64-like rounds, several GB/s).
+		*
+		* \date		10/19/2026
+		*/
+		inline uint64_t _Checksum(const void* data, size_t size)
+		{
+			const uint64_t prime1 = 0x9e3779b185ebca87ULL, prime2 = 0xc2b2ae3d27d4eb4fULL;
+			auto round = [&](uint64_t lane, uint64_t word) {
+				lane += word * prime2;
+				lane = (lane << 31) | (lane >> 33);
+				return lane * prime1;
+			};
+			const char* bytes = (const char*)data;
+			uint64_t lanes[4] = { prime1 + prime2, prime2, 0, (uint64_t)0 - prime1 };
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				for (int lane = 0; lane < 4; ++lane)
+				{
+					uint64_t word;
+					memcpy(&word, bytes + i + lane * 8, 8);
+					lanes[lane] = round(lanes[lane], word);
+				}
+			}
+			uint64_t hash = ((lanes[0] << 1) | (lanes[0] >> 63)) + ((lanes[1] << 7) | (lanes[1] >> 57)) +
+				((lanes[2] << 12) | (lanes[2] >> 52)) + ((lanes[3] << 18) | (lanes[3] >> 46)) + (uint64_t)size;
+			for (; i < size; ++i) hash = round(hash, (unsigned char)bytes[i]);
+			hash ^= hash >> 33;
+			hash *= prime2;
+			hash ^= hash >> 29;
+			return hash;
+		}
+
+#ifndef _WIN32
+		/*!
+		* \struct	__GrowableHeader
+		*
+		* \brief	Used internally, header in front of the buffer of growable shared memories.
+		* 			Size is the current buffer size, and Generation grows every time it changes.
+		*/
+		struct alignas(64) __GrowableHeader
+		{
+			std::atomic<uint64_t> Magic;
+			uint64_t MaxSize;
+			std::atomic<uint64_t> Size;
+			std::atomic<uint64_t> Generation;
+			std::atomic<uint32_t> GrowLock;
+		};
+
+		// magic value marking a growable shared memory
+		const uint64_t _GrowableMagic = 0x4a55535447524f57ULL;
+#endif
+
+		/*!
+		* \fn	inline int32_t _CurrentProcessId()
+		*
+		* \brief	Used internally, get id of the current process, to record who holds something in shared memory.
+		*
+		* \date		10/19/2026
+		*/
+		inline int32_t _CurrentProcessId()
+		{
+#ifdef _WIN32
+			return (int32_t)GetCurrentProcessId();
+#else
+			return (int32_t)getpid();
+#endif
+		}
+
+		/*!
+		* \fn	inline bool _IsProcessDead(int32_t pid)
+		*
+		* \brief	Used internally, return if a process is gone, so what it held in shared memory can be reclaimed.
+		*
+		* \date		10/19/2026
+		*/
+		inline bool _IsProcessDead(int32_t pid)
+		{
+			if (pid <= 0) return false;
+#ifdef _WIN32
+			HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, (DWORD)pid);
+			if (process == NULL) return GetLastError() == ERROR_INVALID_PARAMETER;
+			DWORD code;
+			bool dead = GetExitCodeProcess(process, &code) && code != STILL_ACTIVE;
+			CloseHandle(process);
+			return dead;
+#else
+			return kill(pid, 0) == -1 && errno == ESRCH;
+#endif
+		}
+
+		/*!
+		* \fn	inline void _LockOwned(std::atomic<uint32_t>& lock)
+		*
+		* \brief	Used internally, take a lock word in shared memory. It holds the owner's pid, so a process that died
+		* 			holding it is found and the lock taken over. Only for data that stays consistent at every step.
+		*
+		* \date		10/19/2026
+		*/
+		inline void _LockOwned(std::atomic<uint32_t>& lock)
+		{
+			uint32_t self = (uint32_t)_CurrentProcessId();
+			for (uint32_t spins = 1; ; ++spins)
+			{
+				uint32_t owner = 0;
+				if (lock.compare_exchange_weak(owner, self, std::memory_order_acquire)) return;
+				if (owner && spins % 64 == 0 && _IsProcessDead((int32_t)owner) && lock.compare_exchange_strong(owner, self, std::memory_order_acquire)) return;
+				std::this_thread::yield();
+			}
+		}
+
+		// release a lock taken with _LockOwned
+		inline void _UnlockOwned(std::atomic<uint32_t>& lock)
+		{
+			lock.store(0, std::memory_order_release);
+		}
+
+		/*!
+		* \struct	FieldWrite
+		*
+		* \brief	A field to write with Client::WriteFields: where in the shared memory, and what.
+		*
+		* \date		10/19/2026
+		*/
+		struct FieldWrite
+		{
+			size_t Offset;
+			const void* Data;
+			size_t Size;
+		};
+
+		/*!
+		* \struct	FieldRead
+		*
+		* \brief	A field to read with Client::ReadFields: where in the shared memory, and where to copy it to.
+		*
+		* \date		10/19/2026
+		*/
+		struct FieldRead
+		{
+			size_t Offset;
+			void* Data;
+			size_t Size;
+		};
+
+		/**
+		* Manage a shared memory connection.
+		*/
+		class Client
+		{
+		private:
+
+#ifdef _WIN32
+			// file handle
+			HANDLE _MapFile;
+
+			// backing file, for file backed memories
+			HANDLE _File = INVALID_HANDLE_VALUE;
+#else
+			// shared memory file descriptor
+			int _Fd;
+
+			// name to unlink on close, if we created it and should unlink it
+			std::string _UnlinkName;
+
+			// growable memories only: reserved address space (starting with the header), bytes of it mapped,
+			// generation we mapped, and options to map more with. reads and writes of any thread may map more,
+			// one at a time under the refresh lock; size and generation are atomic so the others check them without it
+			char* _Base = NULL;
+			size_t _Reserved = 0;
+			mutable size_t _Mapped = 0;
+			mutable std::atomic<uint64_t> _Generation{ 0 };
+			mutable std::mutex _RefreshLock;
+			Options _Options;
+#endif
+
+			// buffer
+			char* _Buffer;
+
+			// shared memory size (grows lazily with growable memories)
+			mutable std::atomic<size_t> _BufferSize;
+
+			// file backed memories only: mapping start (the header page)
+			char* _FileBase = NULL;
+
+			// if mapped read only
+			bool _ReadOnly = false;
+
+			// get file backed memory header
+			inline __FileHeader* _GetFileHeader() const { return (__FileHeader*)_FileBase; }
+
+			// get checksum of a file header's fields
+			static inline uint64_t _HeaderChecksum(const __FileHeader& header)
+			{
+				return _Checksum(&header, offsetof(__FileHeader, HeaderChecksum));
+			}
+
+#ifndef _WIN32
+			// get shm_open name from path (must start with a single slash)
+			static std::string _ShmName(const std::string& path)
+			{
+				return (!path.empty() && path[0] == '/') ? path : "/" + path;
+			}
+
+			// map an open descriptor. on failure closes everything and returns false
+			bool _Map(size_t bufferSize, const Options& options)
+			{
+				int flags = MAP_SHARED | (options.Populate ? MAP_POPULATE : 0);
+				void* buffer = mmap(NULL, bufferSize, PROT_READ | (options.ReadOnly ? 0 : PROT_WRITE), flags, _Fd, 0);
+				if (buffer == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				_Buffer = (char*)buffer;
+				_BufferSize = bufferSize;
+				_ReadOnly = options.ReadOnly;
+#ifdef MADV_HUGEPAGE
+				if (options.HugePages) madvise(_Buffer, _BufferSize, MADV_HUGEPAGE);
+#endif
+				if (options.LockPages && mlock(_Buffer, _BufferSize) != 0)
+				{
+					Close();
+					return false;
+				}
+				return true;
+			}
+
+			// get growable memory header
+			inline __GrowableHeader* _GetHeader() const { return (__GrowableHeader*)_Base; }
+
+			// reserve address space for a growable memory, and map its current size. on failure closes everything
+			bool _MapGrowable(size_t maxSize, size_t bufferSize, const Options& options)
+			{
+				_Reserved = sizeof(__GrowableHeader) + maxSize;
+				void* base = mmap(NULL, _Reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				if (base == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				_Base = (char*)base;
+				_Buffer = _Base + sizeof(__GrowableHeader);
+				_Options = options;
+				_ReadOnly = options.ReadOnly;
+				_Mapped = 0;
+				if (!_MapMore(sizeof(__GrowableHeader) + bufferSize))
+				{
+					Close();
+					return false;
+				}
+				_BufferSize = bufferSize;
+				return true;
+			}
+
+			// map a growable memory up to total bytes (including header), in place inside the reserved space.
+			// called on setup, or with the refresh lock held
+			bool _MapMore(size_t total) const
+			{
+				if (total <= _Mapped) return true;
+				size_t from = _Mapped & ~(size_t)(sysconf(_SC_PAGESIZE) - 1);
+				int flags = MAP_SHARED | MAP_FIXED | (_Options.Populate ? MAP_POPULATE : 0);
+				int protection = PROT_READ | (_Options.ReadOnly ? 0 : PROT_WRITE);
+				if (mmap(_Base + from, total - from, protection, flags, _Fd, (off_t)from) == MAP_FAILED) return false;
+#ifdef MADV_HUGEPAGE
+				if (_Options.HugePages) madvise(_Base + from, total - from, MADV_HUGEPAGE);
+#endif
+				if (_Options.LockPages && mlock(_Base + from, total - from) != 0) return false;
+				_Mapped = total;
+				return true;
+			}
+
+			// create a growable memory on an open, empty descriptor
+			bool _CreateGrowable(size_t bufferSize, const Options& options)
+			{
+				if (options.MaxSize < bufferSize || ftruncate(_Fd, (off_t)(sizeof(__GrowableHeader) + bufferSize)) != 0) return false;
+				if (!_MapGrowable(options.MaxSize, bufferSize, options)) return false;
+				__GrowableHeader* header = new (_Base) __GrowableHeader();
+				header->MaxSize = options.MaxSize;
+				header->Size.store(bufferSize, std::memory_order_relaxed);
+				header->Magic.store(_GrowableMagic, std::memory_order_release);
+				return true;
+			}
+
+			// connect to a growable memory on an open descriptor. on failure closes everything
+			bool _ConnectGrowable(size_t bufferSize, const Options& options)
+			{
+				__GrowableHeader header;
+				if (pread(_Fd, (void*)&header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+					header.Magic.load(std::memory_order_relaxed) != _GrowableMagic)
+				{
+					Close();
+					return false;
+				}
+				if (!_MapGrowable((size_t)header.MaxSize, 0, options)) return false;
+				_Generation = (uint64_t)-1;
+				if (!Refresh() || _BufferSize < bufferSize)
+				{
+					Close();
+					return false;
+				}
+				return true;
+			}
+#endif
+
+			// check a range is inside the buffer. growable memories map more first, if they grew
+			inline bool _InRange(size_t offset, size_t dataLen) const
+			{
+				size_t size = _BufferSize.load(std::memory_order_acquire);
+				if (offset <= size && dataLen <= size - offset) return true;
+#ifndef _WIN32
+				if (_Base && Refresh())
+				{
+					size = _BufferSize.load(std::memory_order_acquire);
+					return offset <= size && dataLen <= size - offset;
+				}
+#endif
+				return false;
+			}
+
+			// check a set of fields is in range, with a single range check for the span they cover
+			template <typename FieldType>
+			bool _FieldsInRange(const FieldType* fields, size_t count) const
+			{
+				if (count == 0) return true;
+				size_t begin = SIZE_MAX, end = 0;
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (fields[i].Size > SIZE_MAX - fields[i].Offset) return false;
+					if (fields[i].Offset < begin) begin = fields[i].Offset;
+					if (fields[i].Offset + fields[i].Size > end) end = fields[i].Offset + fields[i].Size;
+				}
+				return _InRange(begin, end - begin);
+			}
+
+			// open or create a file backed memory and map it, header page first.
+			// when opening, the header is validated before mapping and bufferSize is taken from it
+			bool _MapFileBacked(const std::string& path, size_t bufferSize, bool create, const Options& options)
+			{
+				__FileHeader header = { _FileMagic, (uint64_t)bufferSize, 0, 0, 0 };
+				header.HeaderChecksum = _HeaderChecksum(header);
+#ifdef _WIN32
+				_File = CreateFileA(path.c_str(), GENERIC_READ | (options.ReadOnly ? 0 : GENERIC_WRITE), FILE_SHARE_READ | FILE_SHARE_WRITE,
+					NULL, create ? CREATE_NEW : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+				if (_File == INVALID_HANDLE_VALUE) return false;
+				if (!create)
+				{
+					DWORD read = 0;
+					LARGE_INTEGER fileSize;
+					if (!ReadFile(_File, &header, sizeof(header), &read, NULL) || read != sizeof(header) ||
+						header.Magic != _FileMagic || header.HeaderChecksum != _HeaderChecksum(header) ||
+						!GetFileSizeEx(_File, &fileSize) || (uint64_t)fileSize.QuadPart < _FileHeaderSize + header.Size)
+					{
+						Close();
+						return false;
+					}
+					bufferSize = (size_t)header.Size;
+				}
+				uint64_t total = _FileHeaderSize + (uint64_t)bufferSize;
+				_MapFile = CreateFileMapping(_File, NULL, options.ReadOnly ? PAGE_READONLY : PAGE_READWRITE,
+					(DWORD)(total >> 32), (DWORD)(total & 0xffffffff), NULL);
+				if (_MapFile == NULL)
+				{
+					Close();
+					return false;
+				}
+				_FileBase = (char*)MapViewOfFile(_MapFile, options.ReadOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)total);
+				if (_FileBase == NULL)
+				{
+					Close();
+					return false;
+				}
+#else
+				_Fd = open(path.c_str(), (options.ReadOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0666);
+				if (_Fd == -1) return false;
+				if (create)
+				{
+					if (ftruncate(_Fd, (off_t)(_FileHeaderSize + bufferSize)) != 0)
+					{
+						Close();
+						unlink(path.c_str());
+						return false;
+					}
+				}
+				else
+				{
+					struct stat info;
+					if (pread(_Fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+						header.Magic != _FileMagic || header.HeaderChecksum != _HeaderChecksum(header) ||
+						fstat(_Fd, &info) != 0 || (uint64_t)info.st_size < _FileHeaderSize + header.Size)
+					{
+						Close();
+						return false;
+					}
+					bufferSize = (size_t)header.Size;
+				}
+				int flags = MAP_SHARED | (options.Populate ? MAP_POPULATE : 0);
+				void* base = mmap(NULL, _FileHeaderSize + bufferSize, PROT_READ | (options.ReadOnly ? 0 : PROT_WRITE), flags, _Fd, 0);
+				if (base == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				_FileBase = (char*)base;
+#endif
+				_Buffer = _FileBase + _FileHeaderSize;
+				_BufferSize = bufferSize;
+				_ReadOnly = options.ReadOnly;
+				if (create) memcpy(_FileBase, &header, sizeof(header));
+#ifndef _WIN32
+				if (options.LockPages && mlock(_FileBase, _FileHeaderSize + bufferSize) != 0)
+				{
+					Close();
+					return false;
+				}
+#endif
+				return true;
+			}
+
+		public:
+
+			/**
+			* Constructor.
+			*/
+#ifdef _WIN32
+			Client() : _MapFile(NULL), _Buffer(NULL), _BufferSize(0) {}
+#else
+			Client() : _Fd(-1), _Buffer(NULL), _BufferSize(0) {}
+#endif
+
+			/**
+			* Destructor.
+			*/
+			~Client()
+			{
+				Close();
+			}
+
+			// clients own their mapping, so they can be moved but not copied
+			Client(const Client&) = delete;
+			Client& operator=(const Client&) = delete;
+			Client(Client&& other) noexcept : Client() { *this = std::move(other); }
+			Client& operator=(Client&& other) noexcept
+			{
+				if (this == &other) return *this;
+				Close();
+#ifdef _WIN32
+				_MapFile = other._MapFile;
+				_File = other._File;
+				other._MapFile = NULL;
+				other._File = INVALID_HANDLE_VALUE;
+#else
+				_Fd = other._Fd;
+				_UnlinkName = std::move(other._UnlinkName);
+				_Base = other._Base;
+				_Reserved = other._Reserved;
+				_Mapped = other._Mapped;
+				_Generation.store(other._Generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				_Options = other._Options;
+				other._Fd = -1;
+				other._UnlinkName.clear();
+				other._Base = NULL;
+				other._Reserved = other._Mapped = 0;
+#endif
+				_Buffer = other._Buffer;
+				_BufferSize.store(other._BufferSize.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				_FileBase = other._FileBase;
+				_ReadOnly = other._ReadOnly;
+				other._Buffer = NULL;
+				other._BufferSize = 0;
+				other._FileBase = NULL;
+				return *this;
+			}
+
+			/*!
+			* \fn	bool CreateNew(const std::string& path, size_t bufferSize, const Options& options = Options())
+			*
+			* \brief	Create a new shared memory. Fails if a shared memory with this path already exists.
+			* 			On linux path is a shm_open name, a leading slash is added if missing. The name outlives
+			* 			the process unless Options::UnlinkOnClose is set; remove it with Unlink() when done.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	path 				Shared memory file path.
+			* \param	bufferSize			Shared memory buffer size.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to create the shared memory.
+			*/
+			bool CreateNew(const std::string& path, size_t bufferSize, const Options& options = Options())
+			{
+				// if already init throw exception
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (bufferSize == 0) return false;
+
+#ifdef _WIN32
+				(void)options;
+
+				// convert path to wide string
+				LPCWSTR converted;
+				String::To::LpcwStr(path, converted);
+
+				// create shared memory
+				_MapFile = CreateFileMapping(
+					INVALID_HANDLE_VALUE,					// use paging file
+					NULL,									// default security
+					PAGE_READWRITE,							// read/write access
+					(DWORD)((unsigned long long)bufferSize >> 32),	// maximum object size (high-order DWORD)
+					(DWORD)(bufferSize & 0xffffffff),		// maximum object size (low-order DWORD)
+					converted);								// name of mapping object
+				bool alreadyExists = GetLastError() == ERROR_ALREADY_EXISTS;
+				delete[] converted;
+
+				// if had error or it already existed stop here
+				if (_MapFile == NULL || alreadyExists)
+				{
+					Close();
+					return false;
+				}
+
+				// get mapping
+				_Buffer = (char*)MapViewOfFile(_MapFile,
+					FILE_MAP_ALL_ACCESS,
+					0,
+					0,
+					bufferSize);
+
+				// if failed, close the file handle and stop here
+				if (_Buffer == NULL)
+				{
+					Close();
+					return false;
+				}
+
+				// success
+				_BufferSize = bufferSize;
+				return true;
+#else
+				// create and size shared memory
+				std::string name = _ShmName(path);
+				_Fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+				if (_Fd == -1) return false;
+				_UnlinkName = name;
+				if (options.MaxSize)
+				{
+					if (!_CreateGrowable(bufferSize, options))
+					{
+						Close();
+						return false;
+					}
+				}
+				else if (ftruncate(_Fd, (off_t)bufferSize) != 0 || !_Map(bufferSize, options))
+				{
+					Close();
+					return false;
+				}
+				if (!options.UnlinkOnClose) _UnlinkName.clear();
+				return true;
+#endif
+			}
+
+			/*!
+			* \fn	bool Connect(const std::string& path, size_t bufferSize = 0, const Options& options = Options())
+			*
+			* \brief	Connect to existing shared memory other processed previously opened.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	path 				Shared memory file path.
+			* \param	bufferSize			(Optional) Shared memory buffer size. If 0, the whole shared memory is mapped.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to connect to the shared memory.
+			*/
+			bool Connect(const std::string& path, size_t bufferSize = 0, const Options& options = Options())
+			{
+				// if already init throw exception
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+
+#ifdef _WIN32
+				// convert path to wide string
+				LPCWSTR converted;
+				String::To::LpcwStr(path, converted);
+
+				// create shared memory
+				DWORD access = options.ReadOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+				_MapFile = OpenFileMapping(
+					access,                // read/write access
+					FALSE,                 // do not inherit the name
+					converted);            // name of mapping object
+				delete[] converted;
+
+				// if had error stop here
+				if (_MapFile == NULL)
+				{
+					return false;
+				}
+
+				// get mapping
+				_ReadOnly = options.ReadOnly;
+				_Buffer = (char*)MapViewOfFile(_MapFile,
+					access,
+					0,
+					0,
+					bufferSize);
+
+				// if failed, close the file handle and stop here
+				if (_Buffer == NULL)
+				{
+					Close();
+					return false;
+				}
+
+				// success
+				if (bufferSize == 0)
+				{
+					MEMORY_BASIC_INFORMATION info;
+					bufferSize = VirtualQuery(_Buffer, &info, sizeof(info)) ? info.RegionSize : 0;
+				}
+				_BufferSize = bufferSize;
+				return true;
+#else
+				_Fd = shm_open(_ShmName(path).c_str(), (options.ReadOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC, 0);
+				if (_Fd == -1) return false;
+				if (options.MaxSize) return _ConnectGrowable(bufferSize, options);
+
+				// shared memory must be at least as big as requested
+				struct stat info;
+				if (fstat(_Fd, &info) != 0 || info.st_size == 0 || (size_t)info.st_size < bufferSize)
+				{
+					Close();
+					return false;
+				}
+				return _Map(bufferSize ? bufferSize : (size_t)info.st_size, options);
+#endif
+			}
+
+			/*!
+			* \fn	bool ConnectOrCreate(const std::string& path, size_t bufferSize, const Options& options = Options())
+			*
+			* \brief	Try to connect to existing shared memory and if fail, try to create it.
+			* 			When processes race on the same path one creates it (zero filled) and the others connect;
+			* 			a connect that comes while the creator is still sizing it fails, and can be retried.
+			* 			On linux, don't combine with Options::UnlinkOnClose: once the creator closes the name is gone,
+			* 			and the next ConnectOrCreate creates a new memory that processes still connected to the old
+			* 			one never see.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	path 				Shared memory file path.
+			* \param	bufferSize			Shared memory buffer size.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to connect / create the shared memory.
+			*/
+			bool ConnectOrCreate(const std::string& path, size_t bufferSize, const Options& options = Options())
+			{
+				return CreateNew(path, bufferSize, options) || Connect(path, bufferSize, options);
+			}
+
+			/*!
+			* \fn	bool CreateFileBacked(const std::string& path, size_t bufferSize, const Options& options = Options())
+			*
+			* \brief	Create a new shared memory backed by a regular file, so its content survives restarts and reboots.
+			* 			The file holds a header page and then the buffer; other processes share it with OpenFileBacked.
+			* 			Changes reach the file lazily, call Snapshot() to make a consistent, verifiable copy durable.
+			* 			Not supported together with Options::MaxSize or Options::HugePages.
+			*
+			* \date		10/19/2026
+			*
+			* \param	path 				File path. Fails if the file already exists.
+			* \param	bufferSize			Shared memory buffer size.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to create the file and map it.
+			*/
+			bool CreateFileBacked(const std::string& path, size_t bufferSize, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (bufferSize == 0 || options.MaxSize || options.HugePages || options.ReadOnly) return false;
+				return _MapFileBacked(path, bufferSize, true, options);
+			}
+
+			/*!
+			* \fn	bool OpenFileBacked(const std::string& path, const Options& options = Options())
+			*
+			* \brief	Open a shared memory file made by CreateFileBacked, by this or a previous run.
+			* 			Only the header is read; the buffer is mapped as is, so attaching takes about the same time
+			* 			regardless of the dataset size (use Options::Populate to fault it all in upfront instead).
+			* 			With Options::ReadOnly, the file is opened read only, for example to share an immutable dataset.
+			*
+			* \date		10/19/2026
+			*
+			* \param	path 				File path.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to open and map the file, false if it is missing, truncated or its header is corrupted.
+			*/
+			bool OpenFileBacked(const std::string& path, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (options.MaxSize || options.HugePages) return false;
+				return _MapFileBacked(path, 0, false, options);
+			}
+
+			/*!
+			* \fn	bool Snapshot()
+			*
+			* \brief	Make the current content of a file backed shared memory durable: flush the buffer to the file,
+			* 			then record its checksum and a new snapshot generation in the header, and flush that too.
+			* 			After a crash, Verify() tells if the buffer still matches the last completed snapshot.
+			* 			Writers should be quiet while it runs, or the recorded checksum may not match.
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if the memory is not file backed, is read only, or flushing failed.
+			*/
+			bool Snapshot()
+			{
+				if (!_FileBase || _ReadOnly) return false;
+#ifdef _WIN32
+				if (!FlushViewOfFile(_Buffer, _BufferSize) || !FlushFileBuffers(_File)) return false;
+#else
+				if (msync(_Buffer, _BufferSize, MS_SYNC) != 0) return false;
+#endif
+				__FileHeader* header = _GetFileHeader();
+				header->DataChecksum = _Checksum(_Buffer, _BufferSize);
+				header->Generation += 1;
+				header->HeaderChecksum = _HeaderChecksum(*header);
+#ifdef _WIN32
+				return FlushViewOfFile(_FileBase, sizeof(__FileHeader)) && FlushFileBuffers(_File);
+#else
+				return msync(_FileBase, _FileHeaderSize, MS_SYNC) == 0;
+#endif
+			}
+
+			/*!
+			* \fn	bool Verify() const
+			*
+			* \brief	Check a file backed shared memory matches its last snapshot, for example after opening it
+			* 			following a crash. Reads the whole buffer, so it takes time proportional to its size.
+			*
+			* \date		10/19/2026
+			*
+			* \return	True if there was a snapshot and the buffer checksum still matches it.
+			*/
+			bool Verify() const
+			{
+				if (!_FileBase) return false;
+				const __FileHeader* header = _GetFileHeader();
+				return header->Generation != 0 && header->DataChecksum == _Checksum(_Buffer, _BufferSize);
+			}
+
+			// get how many snapshots were taken of a file backed shared memory (0 if none, or not file backed)
+			inline uint64_t GetSnapshotGeneration() const { return _FileBase ? _GetFileHeader()->Generation : 0; }
+
+			// return if shared memory was mapped read only
+			inline bool IsReadOnly() const { return _ReadOnly; }
+
+#ifndef _WIN32
+			/*!
+			* \fn	bool CreateAnonymous(size_t bufferSize, const Options& options = Options())
+			*
+			* \brief	Create a new shared memory without a name (memfd_create).
+			* 			Share it with other processes by passing GetFd() to them (inherit it, or send it over
+			* 			a unix socket), which then call ConnectFd. Released when the last process closes it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	bufferSize			Shared memory buffer size. With HugePages, must be a multiple of the huge page size.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to create the shared memory.
+			*/
+			bool CreateAnonymous(size_t bufferSize, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (bufferSize == 0) return false;
+				unsigned int flags = MFD_CLOEXEC;
+#ifdef MFD_HUGETLB
+				if (options.HugePages) flags |= MFD_HUGETLB;
+#endif
+				_Fd = memfd_create("just_shared_memory", flags);
+				if (_Fd == -1) return false;
+				if (options.MaxSize)
+				{
+					if (_CreateGrowable(bufferSize, options)) return true;
+					Close();
+					return false;
+				}
+				if (ftruncate(_Fd, (off_t)bufferSize) != 0)
+				{
+					Close();
+					return false;
+				}
+				return _Map(bufferSize, options);
+			}
+
+			/*!
+			* \fn	bool ConnectFd(int fd, size_t bufferSize = 0, const Options& options = Options())
+			*
+			* \brief	Connect to a shared memory by its file descriptor (see CreateAnonymous).
+			* 			The descriptor is duplicated, caller keeps ownership of fd.
+			*
+			* \date		10/19/2026
+			*
+			* \param	fd 					Shared memory file descriptor.
+			* \param	bufferSize			(Optional) Shared memory buffer size. If 0, the whole shared memory is mapped.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to connect to the shared memory.
+			*/
+			bool ConnectFd(int fd, size_t bufferSize = 0, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				_Fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+				if (_Fd == -1) return false;
+				if (options.MaxSize) return _ConnectGrowable(bufferSize, options);
+				struct stat info;
+				if (fstat(_Fd, &info) != 0 || info.st_size == 0 || (size_t)info.st_size < bufferSize)
+				{
+					Close();
+					return false;
+				}
+				return _Map(bufferSize ? bufferSize : (size_t)info.st_size, options);
+			}
+
+			// get shared memory file descriptor, or -1 if not valid
+			inline int GetFd() const { return _Fd; }
+
+			/*!
+			* \fn	static bool Unlink(const std::string& path)
+			*
+			* \brief	Remove a shared memory name, for example one left behind by a crashed process.
+			* 			Processes already connected to it are not affected.
+			*
+			* \date		10/19/2026
+			*
+			* \param	path 				Shared memory file path.
+			*
+			* \return	If name existed and was removed.
+			*/
+			static bool Unlink(const std::string& path)
+			{
+				return shm_unlink(_ShmName(path).c_str()) == 0;
+			}
+
+			/*!
+			* \fn	bool Grow(size_t bufferSize)
+			*
+			* \brief	Grow a shared memory created with Options::MaxSize, for all processes using it.
+			* 			The buffer stays at the same address, so pointers into it remain valid. Other processes
+			* 			notice on their next read or write beyond their old size (or Refresh), and map the new part then.
+			* 			Any process may grow it; growing to a smaller size than current does nothing.
+			*
+			* \date		10/19/2026
+			*
+			* \param	bufferSize			New buffer size, at most MaxSize.
+			*
+			* \return	If succeed to grow the shared memory.
+			*/
+			bool Grow(size_t bufferSize)
+			{
+				if (!IsValid() || !_Base) throw std::runtime_error("Shared memory is not growable!");
+				__GrowableHeader* header = _GetHeader();
+				if (bufferSize > header->MaxSize) return false;
+
+				// size the file under a lock, so concurrent growers never shrink it. the lock is taken over from a dead
+				// grower; the size is published after the file is sized, so a grow cut short is just redone
+				bool success = true;
+				_LockOwned(header->GrowLock);
+				if (bufferSize > header->Size.load(std::memory_order_relaxed))
+				{
+					success = ftruncate(_Fd, (off_t)(sizeof(__GrowableHeader) + bufferSize)) == 0;
+					if (success)
+					{
+						header->Size.store(bufferSize, std::memory_order_release);
+						header->Generation.fetch_add(1, std::memory_order_release);
+					}
+				}
+				_UnlockOwned(header->GrowLock);
+				return success && Refresh();
+			}
+
+			/*!
+			* \fn	bool Refresh() const
+			*
+			* \brief	If another process grew the shared memory, map the new part now. Reads and writes do it by themselves,
+			* 			call this before accessing the buffer directly (GetBuffer) beyond GetSize().
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if mapping the new part failed.
+			*/
+			bool Refresh() const
+			{
+				if (!_Base) return true;
+				__GrowableHeader* header = _GetHeader();
+				uint64_t generation = header->Generation.load(std::memory_order_acquire);
+				if (generation == _Generation.load(std::memory_order_acquire)) return true;
+
+				// threads sharing this client map one at a time, the size is published after the new part is mapped
+				std::lock_guard<std::mutex> lock(_RefreshLock);
+				if (generation == _Generation.load(std::memory_order_relaxed)) return true;
+				size_t bufferSize = (size_t)header->Size.load(std::memory_order_acquire);
+				if (!_MapMore(sizeof(__GrowableHeader) + bufferSize)) return false;
+				_BufferSize.store(bufferSize, std::memory_order_release);
+				_Generation.store(generation, std::memory_order_release);
+				return true;
+			}
+
+			// return if shared memory grew since this process last mapped it (cheap, a single load)
+			inline bool IsStale() const
+			{
+				return _Base && _GetHeader()->Generation.load(std::memory_order_relaxed) != _Generation.load(std::memory_order_relaxed);
+			}
+
+			// get how many times shared memory grew, 0 if it is not growable
+			inline uint64_t GetGeneration() const
+			{
+				return _Base ? _GetHeader()->Generation.load(std::memory_order_acquire) : 0;
+			}
+#endif
+
+			/*!
+			* \fn	void WriteBuffer(const void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto)
+			*
+			* \brief	Write to shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	data 				Data buffer to write.
+			* \param	dataLen				Data buffer size, in bytes. Must match data buffer. Default to shared memory size.
+			* \param	offset				Offset in buffer to write into.
+			* \param	mode				(Optional) Copy strategy. By default large writes use non-temporal stores (see BulkCopy).
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			void WriteBuffer(const void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto)
+			{
+				if (!IsValid()) throw std::runtime_error("Cannot call write when shared memory is not valid!");
+				if (_ReadOnly) throw std::runtime_error("Cannot call write when shared memory is read only!");
+				if (dataLen == 0) dataLen = _BufferSize;
+				if (!_InRange(offset, dataLen)) throw std::runtime_error("Exceeded shared memory size!");
+				BulkCopy(_Buffer + offset, data, dataLen, mode);
+			}
+
+			/*!
+			* \fn	void WriteFields(const FieldWrite* fields, size_t count)
+			*
+			* \brief	Write many fields at once (scatter): one bounds check for the span they cover, one copy per field,
+			* 			then a single release fence, so a reader that acquires a flag written after this sees them all.
+			*
+			* \date		10/19/2026
+			*
+			* \param	fields 				Fields to write: offset in shared memory, data and size of each.
+			* \param	count				Number of fields.
+			* Note: if any field exceeds shared memory size will throw std::runtime_error, before writing anything.
+			*/
+			void WriteFields(const FieldWrite* fields, size_t count)
+			{
+				if (!IsValid()) throw std::runtime_error("Cannot call write when shared memory is not valid!");
+				if (_ReadOnly) throw std::runtime_error("Cannot call write when shared memory is read only!");
+				if (!_FieldsInRange(fields, count)) throw std::runtime_error("Exceeded shared memory size!");
+				for (size_t i = 0; i < count; ++i) memcpy(_Buffer + fields[i].Offset, fields[i].Data, fields[i].Size);
+				std::atomic_thread_fence(std::memory_order_release);
+			}
+
+			// write many fields at once, see WriteFields above
+			inline void WriteFields(std::initializer_list<FieldWrite> fields)
+			{
+				WriteFields(fields.begin(), fields.size());
+			}
+
+			/*!
+			* \fn	inline void WriteInt(int val, size_t offset = 0)
+			*
+			* \brief	Write an integer into shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				Integer value to write.
+			* \param	offset				Offset in buffer to write into.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void WriteInt(int val, size_t offset = 0)
+			{
+				WriteBuffer(&val, sizeof(val), offset);
+			}
+
+			/*!
+			* \fn	inline void WriteBool(bool val, size_t offset = 0)
+			*
+			* \brief	Write a bool into shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				Bool value to write.
+			* \param	offset				Offset in buffer to write into.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void WriteBool(bool val, size_t offset = 0)
+			{
+				WriteBuffer(&val, sizeof(val), offset);
+			}
+
+			/*!
+			* \fn	inline void WriteChar(char val, size_t offset = 0)
+			*
+			* \brief	Write a char into shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				Char value to write.
+			* \param	offset				Offset in buffer to write into.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void WriteChar(char val, size_t offset = 0)
+			{
+				WriteBuffer(&val, sizeof(val), offset);
+			}
+
+			/*!
+			* \fn	inline void WriteStr(const wchar_t* val, size_t offset = 0)
+			*
+			* \brief	Write a wide string into shared memory (without the null terminator).
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				String value to write.
+			* \param	offset				Offset in buffer to write into.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void WriteStr(const wchar_t* val, size_t offset = 0)
+			{
+				size_t length = wcslen(val) * sizeof(wchar_t);
+				if (length) WriteBuffer(val, length, offset);
+			}
+
+			/*!
+			* \fn	void ReadBuffer(void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto) const
+			*
+			* \brief	Read from shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	data 				Data buffer to read into. Must be allocated and released by caller.
+			* \param	dataLen				Data buffer size, in bytes. Must match data buffer. Default to shared memory size.
+			* \param	offset				Offset in buffer to read from.
+			* \param	mode				(Optional) Copy strategy. By default large reads use non-temporal stores into data (see BulkCopy).
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			void ReadBuffer(void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto) const
+			{
+				if (!IsValid()) throw std::runtime_error("Cannot call read when shared memory is not valid!");
+				if (dataLen == 0) dataLen = _BufferSize;
+				if (!_InRange(offset, dataLen)) throw std::runtime_error("Exceeded shared memory size!");
+				BulkCopy(data, _Buffer + offset, dataLen, mode);
+			}
+
+			/*!
+			* \fn	void ReadFields(const FieldRead* fields, size_t count) const
+			*
+			* \brief	Read many fields at once (gather): a single acquire fence, one bounds check for the span they
+			* 			cover, then one copy per field.
+			*
+			* \date		10/19/2026
+			*
+			* \param	fields 				Fields to read: offset in shared memory, buffer to read into and size of each.
+			* \param	count				Number of fields.
+			* Note: if any field exceeds shared memory size will throw std::runtime_error, before reading anything.
+			*/
+			void ReadFields(const FieldRead* fields, size_t count) const
+			{
+				if (!IsValid()) throw std::runtime_error("Cannot call read when shared memory is not valid!");
+				if (!_FieldsInRange(fields, count)) throw std::runtime_error("Exceeded shared memory size!");
+				std::atomic_thread_fence(std::memory_order_acquire);
+				for (size_t i = 0; i < count; ++i) memcpy(fields[i].Data, _Buffer + fields[i].Offset, fields[i].Size);
+			}
+
+			// read many fields at once, see ReadFields above
+			inline void ReadFields(std::initializer_list<FieldRead> fields) const
+			{
+				ReadFields(fields.begin(), fields.size());
+			}
+
+			/*!
+			* \fn	inline void ReadInt(int& out, size_t offset = 0) const
+			*
+			* \brief	Read an integer from shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	out 				Integer value to read into.
+			* \param	offset				Offset in buffer to read from.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void ReadInt(int& out, size_t offset = 0) const
+			{
+				ReadBuffer(&out, sizeof(out), offset);
+			}
+
+			/*!
+			* \fn	inline void ReadBool(bool& out, size_t offset = 0) const
+			*
+			* \brief	Read a bool from shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				Bool value to read into.
+			* \param	offset				Offset in buffer to read from.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void ReadBool(bool& out, size_t offset = 0) const
+			{
+				ReadBuffer(&out, sizeof(out), offset);
+			}
+
+			/*!
+			* \fn	inline void ReadChar(char& out, size_t offset = 0) const
+			*
+			* \brief	Read a char from shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				Char value to read into.
+			* \param	offset				Offset in buffer to read from.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void ReadChar(char& out, size_t offset = 0) const
+			{
+				ReadBuffer(&out, sizeof(out), offset);
+			}
+
+			/*!
+			* \fn	inline void ReadStr(wchar_t* out, size_t maxLen = 0, size_t offset = 0) const
+			*
+			* \brief	Read a wide string from shared memory.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \param	val 				Buffer to read into. If maxLen is not provided, must be a buffer in the size of the shared memory.
+			* \param	maxLen 				Expected string len to read, in characters. If not provided, will read whole shared memory buffer.
+			* \param	offset				Offset in buffer to read from.
+			* Note: if exceed shared memory size will throw std::runtime_error.
+			*/
+			inline void ReadStr(wchar_t* out, size_t maxLen = 0, size_t offset = 0) const
+			{
+				ReadBuffer(out, maxLen * sizeof(wchar_t), offset);
+			}
+
+			/*!
+			* \fn	inline bool IsValid() const
+			*
+			* \brief	Check if valid and can be used to read / write.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \return	If shared memory is initialized and ready.
+			*/
+#ifdef _WIN32
+			inline bool IsValid() const { return _MapFile != NULL && _Buffer != NULL; }
+#else
+			inline bool IsValid() const { return _Fd != -1 && _Buffer != NULL; }
+#endif
+
+			/*!
+			* \fn	inline size_t GetSize() const
+			*
+			* \brief	Get shared memory buffer size. For growable memories, the size this process mapped so far.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*
+			* \return	Shared memory buffer size.
+			*/
+			inline size_t GetSize() const { return _BufferSize; }
+
+			/*!
+			* \fn	inline char* GetBuffer() const
+			*
+			* \brief	Get the mapped shared memory, to access it directly.
+			*
+			* \date		10/19/2026
+			*
+			* \return	Shared memory buffer, or null if not valid.
+			*/
+			inline char* GetBuffer() const { return _Buffer; }
+
+			/*!
+			* \fn	void Close()
+			*
+			* \brief	Close this handle.
+			* 			When all handles of a shared memory are closed, the platform may release it.
+			* 			On linux, if we created it with Options::UnlinkOnClose its name is removed, otherwise it stays
+			* 			until Unlink() is called.
+			*
+			* \author	Ronen Ness
+			* \date		11/13/2018
+			*/
+			void Close()
+			{
+#ifdef _WIN32
+				if (_Buffer) UnmapViewOfFile(_FileBase ? _FileBase : _Buffer);
+				if (_MapFile) CloseHandle(_MapFile);
+				if (_File != INVALID_HANDLE_VALUE) CloseHandle(_File);
+				_MapFile = NULL;
+				_File = INVALID_HANDLE_VALUE;
+#else
+				if (_Base) munmap(_Base, _Reserved);
+				else if (_FileBase) munmap(_FileBase, _FileHeaderSize + _BufferSize);
+				else if (_Buffer) munmap(_Buffer, _BufferSize);
+				if (_Fd != -1) close(_Fd);
+				if (!_UnlinkName.empty()) shm_unlink(_UnlinkName.c_str());
+				_Fd = -1;
+				_UnlinkName.clear();
+				_Base = NULL;
+				_Reserved = _Mapped = 0;
+				_Generation = 0;
+#endif
+				_Buffer = NULL;
+				_BufferSize = 0;
+				_FileBase = NULL;
+				_ReadOnly = false;
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\SpscRing.h::
+
+/*!
+* \file	Source\SharedMemory\SpscRing.h.
+*
+* \brief	Lock-free single producer / single consumer ring buffer of variable length records, inside a shared memory.
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+// #include "SharedMemory.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		// size of a cache line, used to keep indexes written by different processes apart
+		const size_t _CacheLineSize = 64;
+
+		static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory structures need lock-free 64 bit atomics");
+
+		/*!
+		* \struct	__SpscRingHeader
+		*
+		* \brief	Used internally, header of a ring in shared memory. Data follows right after it.
+		* 			Head is written only by the producer and Tail only by the consumer, each on its own cache line.
+		*/
+		struct __SpscRingHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Head;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Tail;
+		};
+
+		/*!
+		* \class	SpscRing
+		*
+		* \brief	A ring buffer for streaming records from one process (or thread) to another through shared memory.
+		* 			Records have variable length and are stored contiguously, each with an 8 bytes frame, so they can
+		* 			be written and read in place (Reserve / Commit, Peek / Pop) without copying.
+		* 			Writes become visible to the reader only on Publish, so a batch of records costs one atomic store,
+		* 			and the reader acknowledges a batch with one store as well.
+		* 			Each side caches the other side's index, so the shared cache lines are touched only when needed.
+		* 			Exactly one producer and one consumer may use a ring at a time. Neither side ever blocks.
+		*
+		* \date		10/19/2026
+		*/
+		class SpscRing
+		{
+		private:
+
+			// magic value marking an initialized ring
+			static const uint64_t _Magic = 0x4a55535453505343ULL;
+
+			// record frame: payload size, followed by payload padded to 8 bytes
+			static const uint64_t _FrameSize = 8;
+
+			// frame size marking padding up to the end of the ring
+			static const uint32_t _WrapMarker = 0xffffffff;
+
+			__SpscRingHeader* _Header = nullptr;
+			char* _Data = nullptr;
+			uint64_t _Mask = 0;
+
+			// producer side: next write position, reserved record size, and cached consumer position
+			uint64_t _WritePosition = 0;
+			uint64_t _Reserved = 0;
+			bool _HasReservation = false;
+			uint64_t _CachedTail = 0;
+
+			// consumer side: next read position, and cached producer position
+			uint64_t _ReadPosition = 0;
+			uint64_t _CachedHead = 0;
+
+			// round up to frame alignment
+			static inline uint64_t _Align(uint64_t size) { return (size + 7) & ~(uint64_t)7; }
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Ring offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__SpscRingHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__SpscRingHeader* header = (__SpscRingHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __SpscRingHeader();
+					header->Capacity = capacity;
+					header->Head.store(0, std::memory_order_relaxed);
+					header->Tail.store(0, std::memory_order_relaxed);
+				}
+				else
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a ring!");
+					capacity = (size_t)header->Capacity;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Header = header;
+				_Data = (char*)header + sizeof(__SpscRingHeader);
+				_Mask = capacity - 1;
+				_WritePosition = _CachedHead = header->Head.load(std::memory_order_acquire);
+				_ReadPosition = _CachedTail = header->Tail.load(std::memory_order_acquire);
+				_HasReservation = false;
+				if (create) header->Magic.store(_Magic, std::memory_order_release);
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity)
+			*
+			* \brief	Get how many bytes of shared memory a ring needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Ring data capacity, in bytes.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity)
+			{
+				return sizeof(__SpscRingHeader) + capacity;
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity)
+			*
+			* \brief	Initialize a new, empty ring in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the ring.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the ring in.
+			* \param	offset				Offset of the ring in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Ring data capacity, in bytes. Must be a power of 2, at least 64.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity)
+			{
+				if (capacity < 64 || (capacity & (capacity - 1))) throw std::runtime_error("Ring capacity must be a power of 2, at least 64!");
+				_Attach(memory, offset, true, capacity);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a ring another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the ring is in.
+			* \param	offset				Offset of the ring in the shared memory.
+			* Note: throws std::runtime_error if there is no ring at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0);
+			}
+
+			// return if ring is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get ring data capacity, in bytes
+			inline size_t GetCapacity() const { return (size_t)(_Mask + 1); }
+
+			// get max size of a single record: half the capacity, so a record always fits after wrapping, and below
+			// the wrap marker, since frames keep the size in 32 bits
+			inline size_t MaxRecordSize() const
+			{
+				uint64_t max = (_Mask + 1) / 2 - _FrameSize;
+				return (size_t)(max < _WrapMarker ? max : _WrapMarker - 1);
+			}
+
+			/*!
+			* \fn	char* Reserve(size_t size)
+			*
+			* \brief	Producer: reserve space for the next record, to write it in place.
+			* 			Call Commit when done writing, then Publish to make it visible.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size 				Record size, in bytes (at most MaxRecordSize).
+			*
+			* \return	Where to write the record, or null if there is not enough free space right now.
+			*/
+			char* Reserve(size_t size)
+			{
+				if (size > MaxRecordSize()) throw std::runtime_error("Record is too big for ring!");
+				uint64_t needed = _FrameSize + _Align(size);
+				uint64_t index = _WritePosition & _Mask;
+				uint64_t untilEnd = (_Mask + 1) - index;
+				uint64_t total = needed <= untilEnd ? needed : untilEnd + needed;
+
+				// check free space, refreshing consumer position only if cached one is not enough
+				uint64_t capacity = _Mask + 1;
+				if (_WritePosition + total - _CachedTail > capacity)
+				{
+					_CachedTail = _Header->Tail.load(std::memory_order_acquire);
+					if (_WritePosition + total - _CachedTail > capacity) return nullptr;
+				}
+
+				// record doesn't fit before end of ring? mark padding and wrap around
+				if (needed > untilEnd)
+				{
+					*(uint32_t*)(_Data + index) = _WrapMarker;
+					_WritePosition += untilEnd;
+					index = 0;
+				}
+				_Reserved = size;
+				_HasReservation = true;
+				return _Data + index + _FrameSize;
+			}
+
+			/*!
+			* \fn	void Commit(size_t size)
+			*
+			* \brief	Producer: finish writing the reserved record. It is not visible until Publish.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size 				Actual record size, can be smaller than reserved.
+			*/
+			void Commit(size_t size)
+			{
+				if (!_HasReservation || size > _Reserved) throw std::runtime_error("Invalid ring commit!");
+				*(uint32_t*)(_Data + (_WritePosition & _Mask)) = (uint32_t)size;
+				_WritePosition += _FrameSize + _Align(size);
+				_HasReservation = false;
+			}
+
+			/*!
+			* \fn	inline void Publish()
+			*
+			* \brief	Producer: make all committed records visible to the consumer.
+			*
+			* \date		10/19/2026
+			*/
+			inline void Publish()
+			{
+				_Header->Head.store(_WritePosition, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	bool Write(const void* data, size_t size, bool publish = true)
+			*
+			* \brief	Producer: copy a record into the ring.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Record data.
+			* \param	size 				Record size, in bytes.
+			* \param	publish				(Optional) If false, record is visible only on next Publish (to batch records).
+			*
+			* \return	False if there is not enough free space right now.
+			*/
+			bool Write(const void* data, size_t size, bool publish = true)
+			{
+				char* target = Reserve(size);
+				if (!target) return false;
+				memcpy(target, data, size);
+				Commit(size);
+				if (publish) Publish();
+				return true;
+			}
+
+			/*!
+			* \fn	const char* Peek(size_t& size)
+			*
+			* \brief	Consumer: get the next record in place, without removing it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size 				Record size, in bytes.
+			*
+			* \return	Record data, or null if ring is empty.
+			*/
+			const char* Peek(size_t& size)
+			{
+				while (true)
+				{
+					if (_ReadPosition == _CachedHead)
+					{
+						_CachedHead = _Header->Head.load(std::memory_order_acquire);
+						if (_ReadPosition == _CachedHead) return nullptr;
+					}
+					uint64_t index = _ReadPosition & _Mask;
+					uint32_t frame = *(const uint32_t*)(_Data + index);
+					if (frame == _WrapMarker)
+					{
+						_ReadPosition += (_Mask + 1) - index;
+						continue;
+					}
+					size = frame;
+					return _Data + index + _FrameSize;
+				}
+			}
+
+			/*!
+			* \fn	void Pop(bool release = true)
+			*
+			* \brief	Consumer: remove the record returned by Peek.
+			*
+			* \date		10/19/2026
+			*
+			* \param	release				(Optional) If false, its space is given back to the producer only on next Release (to batch records).
+			*/
+			void Pop(bool release = true)
+			{
+				uint32_t frame = *(const uint32_t*)(_Data + (_ReadPosition & _Mask));
+				_ReadPosition += _FrameSize + _Align(frame);
+				if (release) Release();
+			}
+
+			/*!
+			* \fn	inline void Release()
+			*
+			* \brief	Consumer: give the space of all popped records back to the producer.
+			*
+			* \date		10/19/2026
+			*/
+			inline void Release()
+			{
+				_Header->Tail.store(_ReadPosition, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	bool Read(std::string& out)
+			*
+			* \brief	Consumer: copy the next record out of the ring and remove it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	out 				String to copy record into.
+			*
+			* \return	False if ring is empty.
+			*/
+			bool Read(std::string& out)
+			{
+				size_t size;
+				const char* data = Peek(size);
+				if (!data) return false;
+				out.assign(data, size);
+				Pop();
+				return true;
+			}
+
+			/*!
+			* \fn	template <typename Handler> size_t Consume(Handler handler, size_t maxRecords = (size_t)-1)
+			*
+			* \brief	Consumer: handle available records in place, as one batch: handler(const char* data, size_t size).
+			* 			Their space is released once, after the last record.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Called for every record.
+			* \param	maxRecords			(Optional) Max records to handle.
+			*
+			* \return	Number of records handled.
+			*/
+			template <typename Handler>
+			size_t Consume(Handler handler, size_t maxRecords = (size_t)-1)
+			{
+				size_t count = 0;
+				size_t size;
+				const char* data;
+				while (count < maxRecords && (data = Peek(size)) != nullptr)
+				{
+					handler(data, size);
+					Pop(false);
+					count++;
+				}
+				if (count) Release();
+				return count;
+			}
+
+			// return if there is nothing to read (consumer side; may be stale on producer side)
+			inline bool IsEmpty() const
+			{
+				return _ReadPosition == _Header->Head.load(std::memory_order_acquire);
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\Futex.h::
+
+/*!
+* \file	Source\SharedMemory\Futex.h.
+*
+* \brief	Cross-process wait / notify on words inside a shared memory, so consumers don't have to poll.
+*/
+// #pragma once
+#include <stdint.h>
+#include <limits.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <thread>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free, "Futex words must be plain lock-free 32 bit atomics");
+
+		/*!
+		* \fn	inline void _CpuRelax()
+		*
+		* \brief	Used internally, hint the CPU we are spinning (pause instruction where there is one).
+		*
+		* \date		10/19/2026
+		*/
+		inline void _CpuRelax()
+		{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			_mm_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		/*!
+		* \fn	inline bool WaitOnAddress(std::atomic<uint32_t>* address, uint32_t expected, int64_t timeoutMicroseconds = -1)
+		*
+		* \brief	Sleep while a 32 bit word in shared memory equals expected, until another process calls Wake on it.
+		* 			On linux this is a shared (not process private) futex, so it works across processes that map the same
+		* 			memory, even at different addresses. The check and the sleep are atomic, so a Wake that comes after the
+		* 			value changed is never missed. May return spuriously, callers should re-check their condition.
+		* 			On windows there is no cross-process futex, so it polls the word with short sleeps instead.
+		*
+		* \date		10/19/2026
+		*
+		* \param	address				Word in the shared memory to wait on. Must be 4 bytes aligned.
+		* \param	expected			Value to sleep while the word has.
+		* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+		*
+		* \return	False if timed out, true otherwise (woken, value changed, or spurious wakeup).
+		*/
+		inline bool WaitOnAddress(std::atomic<uint32_t>* address, uint32_t expected, int64_t timeoutMicroseconds = -1)
+		{
+#ifndef _WIN32
+			struct timespec timeout;
+			if (timeoutMicroseconds >= 0)
+			{
+				timeout.tv_sec = (time_t)(timeoutMicroseconds / 1000000);
+				timeout.tv_nsec = (long)(timeoutMicroseconds % 1000000) * 1000;
+			}
+			long ret = syscall(SYS_futex, (uint32_t*)address, FUTEX_WAIT, expected, timeoutMicroseconds >= 0 ? &timeout : NULL, NULL, 0);
+			return !(ret == -1 && errno == ETIMEDOUT);
+#else
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+			while (address->load(std::memory_order_acquire) == expected)
+			{
+				if (timeoutMicroseconds >= 0 && std::chrono::steady_clock::now() >= deadline) return false;
+				Sleep(1);
+			}
+			return true;
+#endif
+		}
+
+		/*!
+		* \fn	inline int Wake(std::atomic<uint32_t>* address, int count = 1)
+		*
+		* \brief	Wake processes sleeping in WaitOnAddress on a word. Change the word before calling it.
+		*
+		* \date		10/19/2026
+		*
+		* \param	address				Word in the shared memory to wake waiters of.
+		* \param	count				(Optional) Max waiters to wake, INT_MAX for all.
+		*
+		* \return	Number of waiters woken (always 0 on windows, where waiters poll).
+		*/
+		inline int Wake(std::atomic<uint32_t>* address, int count = 1)
+		{
+#ifndef _WIN32
+			long ret = syscall(SYS_futex, (uint32_t*)address, FUTEX_WAKE, count, NULL, NULL, 0);
+			return ret < 0 ? 0 : (int)ret;
+#else
+			(void)address;
+			(void)count;
+			return 0;
+#endif
+		}
+
+		// wake all processes waiting on a word
+		inline int WakeAll(std::atomic<uint32_t>* address)
+		{
+			return Wake(address, INT_MAX);
+		}
+
+		/*!
+		* \struct	__EventHeader
+		*
+		* \brief	Used internally, header of an event in shared memory.
+		* 			Epoch grows with every notify, Waiters counts processes parked (or about to park) on it.
+		*/
+		struct __EventHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			std::atomic<uint32_t> Epoch;
+			std::atomic<uint32_t> Waiters;
+		};
+
+		/*!
+		* \class	Event
+		*
+		* \brief	Lets consumers of a shared memory structure (ring, queue, snapshot...) sleep until a producer
+		* 			notifies them, instead of polling. It is an event count: take a key with GetKey(), check your
+		* 			condition, and if it is not met Wait(key). A notify that happens after GetKey() is never missed.
+		* 			Waiting first spins for a while, since notifies often come within microseconds, then parks on
+		* 			a futex so idle consumers use no CPU. The spin length adapts: it grows when spinning caught the
+		* 			notify and shrinks when it had to park anyway. Notify costs no syscall when nobody is parked.
+		*
+		* \date		10/19/2026
+		*/
+		class Event
+		{
+		private:
+
+			// magic value marking an initialized event
+			static const uint64_t _Magic = 0x4a55535445564e54ULL;
+
+			// spin length bounds, in iterations
+			static const uint32_t _MinSpin = 16;
+			static const uint32_t _MaxSpin = 16384;
+
+			__EventHeader* _Header = nullptr;
+			uint32_t _Spin = 1024;
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Event offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < RequiredSize()) throw std::runtime_error("Exceeded shared memory size!");
+				__EventHeader* header = (__EventHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __EventHeader();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				else if (header->Magic.load(std::memory_order_acquire) != _Magic)
+				{
+					throw std::runtime_error("Shared memory does not contain an event!");
+				}
+				_Header = header;
+
+				// spinning only helps if the notifier can run meanwhile
+				if (std::thread::hardware_concurrency() <= 1) _Spin = 0;
+			}
+
+		public:
+
+			// get how many bytes of shared memory an event needs
+			static inline size_t RequiredSize()
+			{
+				return sizeof(__EventHeader);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset)
+			*
+			* \brief	Initialize a new event in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the event.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the event in.
+			* \param	offset				Offset of the event in the shared memory, aligned to 64 bytes.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, true);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to an event another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the event is in.
+			* \param	offset				Offset of the event in the shared memory.
+			* Note: throws std::runtime_error if there is no event at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false);
+			}
+
+			// return if event is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get a key to wait with. take it before checking the condition you wait for
+			inline uint32_t GetKey() const
+			{
+				return _Header->Epoch.load(std::memory_order_seq_cst);
+			}
+
+			// set max spin iterations before parking, 0 to park right away. it adapts from there
+			inline void SetSpin(uint32_t spin) { _Spin = spin; }
+
+			/*!
+			* \fn	bool Wait(uint32_t key, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Wait until the event is notified after key was taken.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key from GetKey().
+			* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+			*
+			* \return	False if timed out.
+			*/
+			bool Wait(uint32_t key, int64_t timeoutMicroseconds = -1)
+			{
+				for (uint32_t i = 0; i < _Spin; ++i)
+				{
+					if (_Header->Epoch.load(std::memory_order_acquire) != key)
+					{
+						if (_Spin < _MaxSpin) _Spin *= 2;
+						return true;
+					}
+					_CpuRelax();
+				}
+				if (_Spin > _MinSpin) _Spin /= 2;
+				if (timeoutMicroseconds == 0) return _Header->Epoch.load(std::memory_order_acquire) != key;
+
+				// announce we park before checking the epoch again; notifiers bump the epoch before checking waiters
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+				_Header->Waiters.fetch_add(1, std::memory_order_seq_cst);
+				bool notified = true;
+				while (_Header->Epoch.load(std::memory_order_seq_cst) == key)
+				{
+					int64_t remaining = -1;
+					if (timeoutMicroseconds >= 0)
+					{
+						remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+						if (remaining <= 0) { notified = false; break; }
+					}
+					WaitOnAddress(&_Header->Epoch, key, remaining);
+				}
+				_Header->Waiters.fetch_sub(1, std::memory_order_relaxed);
+				return notified;
+			}
+
+			/*!
+			* \fn	template <typename Condition> bool WaitFor(Condition condition, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Wait until condition() returns true, re-checking it after every notify.
+			*
+			* \date		10/19/2026
+			*
+			* \param	condition			Callable returning bool, for example "queue is not empty".
+			* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+			*
+			* \return	False if timed out before the condition was met.
+			*/
+			template <typename Condition>
+			bool WaitFor(Condition condition, int64_t timeoutMicroseconds = -1)
+			{
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+				while (true)
+				{
+					uint32_t key = GetKey();
+					if (condition()) return true;
+					int64_t remaining = -1;
+					if (timeoutMicroseconds >= 0)
+					{
+						remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+						if (remaining <= 0) return false;
+					}
+					Wait(key, remaining);
+				}
+			}
+
+			// wake one parked waiter (spinning waiters always see the notify)
+			inline void NotifyOne()
+			{
+				_Header->Epoch.fetch_add(1, std::memory_order_seq_cst);
+				if (_Header->Waiters.load(std::memory_order_seq_cst) != 0) Wake(&_Header->Epoch, 1);
+			}
+
+			// wake all waiters
+			inline void NotifyAll()
+			{
+				_Header->Epoch.fetch_add(1, std::memory_order_seq_cst);
+				if (_Header->Waiters.load(std::memory_order_seq_cst) != 0) WakeAll(&_Header->Epoch);
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\Arena.h::
+
+/*!
+* \file	Source\SharedMemory\Arena.h.
+*
+* \brief	Allocator for variable size objects inside a shared memory, with offset pointers and STL adapters.
+*/
+// #pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+// #include "Futex.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \class	OffsetPtr
+		*
+		* \brief	A pointer that stores the distance from itself to its target instead of an address.
+		* 			When both the pointer and its target are in the same shared memory, it stays valid in every process,
+		* 			no matter where each one mapped the memory. Usable as the pointer type of STL allocators.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename T>
+		class OffsetPtr
+		{
+		private:
+
+			// distance in bytes from this to the target. 1 means null, since nothing can start inside the pointer itself
+			int64_t _Offset = 1;
+
+			inline void _Set(const void* target)
+			{
+				// computed on integers: the target is not inside this object, as compilers would assume for pointer arithmetic
+				_Offset = target ? (int64_t)((uintptr_t)target - (uintptr_t)this) : 1;
+			}
+
+		public:
+
+			typedef T element_type;
+			typedef typename std::remove_cv<T>::type value_type;
+			typedef ptrdiff_t difference_type;
+			typedef typename std::add_lvalue_reference<T>::type reference;
+			typedef OffsetPtr<T> pointer;
+			typedef std::random_access_iterator_tag iterator_category;
+
+			template <typename U>
+			using rebind = OffsetPtr<U>;
+
+			OffsetPtr() = default;
+			OffsetPtr(std::nullptr_t) {}
+			OffsetPtr(T* target) { _Set(target); }
+			OffsetPtr(const OffsetPtr& other) { _Set(other.Get()); }
+
+			// implicit where U* converts to T*, explicit otherwise (like static_cast from void*)
+			template <typename U, typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type = 0>
+			OffsetPtr(const OffsetPtr<U>& other) { _Set(static_cast<T*>(other.Get())); }
+			template <typename U, typename std::enable_if<!std::is_convertible<U*, T*>::value, int>::type = 0>
+			explicit OffsetPtr(const OffsetPtr<U>& other) { _Set(static_cast<T*>(other.Get())); }
+
+			OffsetPtr& operator=(const OffsetPtr& other) { _Set(other.Get()); return *this; }
+			OffsetPtr& operator=(T* target) { _Set(target); return *this; }
+			OffsetPtr& operator=(std::nullptr_t) { _Offset = 1; return *this; }
+
+			// get raw pointer, valid in this process only
+			inline T* Get() const
+			{
+				return _Offset == 1 ? nullptr : (T*)((uintptr_t)this + (uintptr_t)_Offset);
+			}
+
+			static inline OffsetPtr pointer_to(reference target) { return OffsetPtr(std::addressof(target)); }
+
+			inline T* operator->() const { return Get(); }
+			template <typename U = T, typename std::enable_if<!std::is_void<U>::value, int>::type = 0>
+			inline U& operator*() const { return *Get(); }
+			template <typename U = T, typename std::enable_if<!std::is_void<U>::value, int>::type = 0>
+			inline U& operator[](ptrdiff_t index) const { return Get()[index]; }
+			explicit inline operator bool() const { return _Offset != 1; }
+
+			inline OffsetPtr& operator+=(ptrdiff_t count) { _Set(Get() + count); return *this; }
+			inline OffsetPtr& operator-=(ptrdiff_t count) { _Set(Get() - count); return *this; }
+			inline OffsetPtr& operator++() { return *this += 1; }
+			inline OffsetPtr& operator--() { return *this -= 1; }
+			inline OffsetPtr operator++(int) { OffsetPtr ret(*this); ++*this; return ret; }
+			inline OffsetPtr operator--(int) { OffsetPtr ret(*this); --*this; return ret; }
+			friend inline OffsetPtr operator+(const OffsetPtr& ptr, ptrdiff_t count) { return OffsetPtr(ptr.Get() + count); }
+			friend inline OffsetPtr operator+(ptrdiff_t count, const OffsetPtr& ptr) { return OffsetPtr(ptr.Get() + count); }
+			friend inline OffsetPtr operator-(const OffsetPtr& ptr, ptrdiff_t count) { return OffsetPtr(ptr.Get() - count); }
+			friend inline ptrdiff_t operator-(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() - b.Get(); }
+
+			friend inline bool operator==(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() == b.Get(); }
+			friend inline bool operator!=(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() != b.Get(); }
+			friend inline bool operator<(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() < b.Get(); }
+			friend inline bool operator>(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() > b.Get(); }
+			friend inline bool operator<=(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() <= b.Get(); }
+			friend inline bool operator>=(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() >= b.Get(); }
+			friend inline bool operator==(const OffsetPtr& a, std::nullptr_t) { return !a; }
+			friend inline bool operator!=(const OffsetPtr& a, std::nullptr_t) { return (bool)a; }
+		};
+
+		// number of small size classes: 16, 32, ... 4096 bytes
+		const size_t _ArenaClasses = 9;
+
+		// biggest allocation served by the size classes
+		const size_t _ArenaMaxSmall = (size_t)16 << (_ArenaClasses - 1);
+
+		// free list heads pack a 24 bit ABA tag above a 40 bit offset, so arenas are limited to 1TB
+		const uint64_t _ArenaOffsetBits = 40;
+		const uint64_t _ArenaOffsetMask = ((uint64_t)1 << _ArenaOffsetBits) - 1;
+
+		/*!
+		* \struct	__ArenaHeader
+		*
+		* \brief	Used internally, header of an arena in shared memory. All offsets are from the header.
+		* 			Top is the start of never used memory, Classes are lock-free free lists of small blocks,
+		* 			and LargeHead is a free list of big blocks sorted by offset, guarded by LargeLock.
+		*/
+		struct __ArenaHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Size;
+			std::atomic<uint64_t> Root;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Top;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Used;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Classes[_ArenaClasses];
+			alignas(_CacheLineSize) std::atomic<uint32_t> LargeLock;
+			std::atomic<uint64_t> LargeHead;
+		};
+
+		/*!
+		* \struct	__ArenaBlock
+		*
+		* \brief	Used internally, header in front of every block. Next is used only while the block is free.
+		*/
+		struct __ArenaBlock
+		{
+			// block size including this header
+			uint64_t Size;
+
+			// size class, or _ArenaLarge
+			uint32_t Class;
+
+			// _ArenaBlockCheck, to catch freeing pointers that were not allocated
+			uint32_t Check;
+
+			// offset of next free block
+			std::atomic<uint64_t> Next;
+		};
+
+		const uint32_t _ArenaLarge = 0xff;
+		const uint32_t _ArenaBlockCheck = 0x4a534142;
+
+		// payload starts after size, class and check, so blocks are 16 bytes aligned
+		const uint64_t _ArenaBlockHeaderSize = 16;
+
+		// get block at offset
+		inline __ArenaBlock* _ArenaBlockAt(__ArenaHeader* header, uint64_t offset)
+		{
+			return (__ArenaBlock*)((char*)header + offset);
+		}
+
+		// take block size bytes of never used memory, 0 if arena is full
+		inline uint64_t _ArenaBump(__ArenaHeader* header, uint64_t size)
+		{
+			uint64_t top = header->Top.load(std::memory_order_relaxed);
+			do
+			{
+				if (header->Size - top < size) return 0;
+			} while (!header->Top.compare_exchange_weak(top, top + size, std::memory_order_relaxed));
+			return top;
+		}
+
+		// lock / unlock the large blocks list. the lock holds the owner's pid and is taken over from a dead process;
+		// every change to the list is a single store that leaves it whole, so at worst the dead one's block leaks
+		inline void _ArenaLockLarge(__ArenaHeader* header)
+		{
+			_LockOwned(header->LargeLock);
+		}
+		inline void _ArenaUnlockLarge(__ArenaHeader* header)
+		{
+			_UnlockOwned(header->LargeLock);
+		}
+
+		/*!
+		* \fn	inline void* _ArenaAllocate(__ArenaHeader* header, size_t size)
+		*
+		* \brief	Used internally, allocate from an arena header. Shared by Arena and ArenaAllocator.
+		*
+		* \date		10/19/2026
+		*/
+		inline void* _ArenaAllocate(__ArenaHeader* header, size_t size)
+		{
+			if (size == 0) size = 1;
+			if (size > header->Size) return nullptr;
+			uint64_t offset = 0, blockSize;
+
+			if (size <= _ArenaMaxSmall)
+			{
+				// pop from the size class free list
+				uint32_t sizeClass = 0;
+				while (((size_t)16 << sizeClass) < size) ++sizeClass;
+				blockSize = ((uint64_t)16 << sizeClass) + _ArenaBlockHeaderSize;
+				std::atomic<uint64_t>& head = header->Classes[sizeClass];
+				uint64_t current = head.load(std::memory_order_acquire);
+				while ((current & _ArenaOffsetMask) != 0)
+				{
+					// next may be garbage if another process popped and reused the block meanwhile, the tag makes the CAS fail then
+					uint64_t next = _ArenaBlockAt(header, current & _ArenaOffsetMask)->Next.load(std::memory_order_relaxed);
+					uint64_t tag = (current >> _ArenaOffsetBits) + 1;
+					if (head.compare_exchange_weak(current, (tag << _ArenaOffsetBits) | (next & _ArenaOffsetMask), std::memory_order_acquire))
+					{
+						offset = current & _ArenaOffsetMask;
+						break;
+					}
+				}
+				if (offset == 0) offset = _ArenaBump(header, blockSize);
+				if (offset == 0) return nullptr;
+				__ArenaBlock* block = _ArenaBlockAt(header, offset);
+				block->Size = blockSize;
+				block->Class = sizeClass;
+				block->Check = _ArenaBlockCheck;
+			}
+			else
+			{
+				// first fit from the large free list, splitting off what is left if it is worth keeping
+				blockSize = ((uint64_t)size + _ArenaBlockHeaderSize + 15) & ~(uint64_t)15;
+				_ArenaLockLarge(header);
+				std::atomic<uint64_t>* link = &header->LargeHead;
+				while (link->load(std::memory_order_relaxed))
+				{
+					__ArenaBlock* block = _ArenaBlockAt(header, link->load(std::memory_order_relaxed));
+					if (block->Size >= blockSize)
+					{
+						offset = link->load(std::memory_order_relaxed);
+						uint64_t next = block->Next.load(std::memory_order_relaxed);
+						if (block->Size - blockSize > _ArenaMaxSmall + _ArenaBlockHeaderSize)
+						{
+							__ArenaBlock* rest = _ArenaBlockAt(header, offset + blockSize);
+							rest->Size = block->Size - blockSize;
+							rest->Class = _ArenaLarge;
+							rest->Check = 0;
+							rest->Next.store(next, std::memory_order_relaxed);
+							link->store(offset + blockSize, std::memory_order_relaxed);
+						}
+						else
+						{
+							blockSize = block->Size;
+							link->store(next, std::memory_order_relaxed);
+						}
+						break;
+					}
+					link = &block->Next;
+				}
+				_ArenaUnlockLarge(header);
+				if (offset == 0) offset = _ArenaBump(header, blockSize);
+				if (offset == 0) return nullptr;
+				__ArenaBlock* block = _ArenaBlockAt(header, offset);
+				block->Size = blockSize;
+				block->Class = _ArenaLarge;
+				block->Check = _ArenaBlockCheck;
+			}
+
+			header->Used.fetch_add(blockSize, std::memory_order_relaxed);
+			return (char*)header + offset + _ArenaBlockHeaderSize;
+		}
+
+		/*!
+		* \fn	inline void _ArenaFree(__ArenaHeader* header, void* data)
+		*
+		* \brief	Used internally, free a block of an arena header. Shared by Arena and ArenaAllocator.
+		*
+		* \date		10/19/2026
+		*/
+		inline void _ArenaFree(__ArenaHeader* header, void* data)
+		{
+			if (!data) return;
+			uint64_t offset = (uint64_t)((char*)data - (char*)header) - _ArenaBlockHeaderSize;
+			__ArenaBlock* block = _ArenaBlockAt(header, offset);
+			if ((char*)data < (char*)header + sizeof(__ArenaHeader) || offset >= header->Size || block->Check != _ArenaBlockCheck)
+			{
+				throw std::runtime_error("Pointer was not allocated from this arena!");
+			}
+			block->Check = 0;
+			header->Used.fetch_sub(block->Size, std::memory_order_relaxed);
+
+			if (block->Class < _ArenaClasses)
+			{
+				std::atomic<uint64_t>& head = header->Classes[block->Class];
+				uint64_t current = head.load(std::memory_order_relaxed);
+				do
+				{
+					block->Next.store(current & _ArenaOffsetMask, std::memory_order_relaxed);
+				} while (!head.compare_exchange_weak(current, (((current >> _ArenaOffsetBits) + 1) << _ArenaOffsetBits) | offset, std::memory_order_release));
+				return;
+			}
+
+			// insert sorted, merging with free neighbours
+			_ArenaLockLarge(header);
+			std::atomic<uint64_t>* link = &header->LargeHead;
+			__ArenaBlock* previous = nullptr;
+			uint64_t next;
+			while ((next = link->load(std::memory_order_relaxed)) && next < offset)
+			{
+				previous = _ArenaBlockAt(header, next);
+				link = &previous->Next;
+			}
+			if (next && offset + block->Size == next)
+			{
+				__ArenaBlock* nextBlock = _ArenaBlockAt(header, next);
+				block->Size += nextBlock->Size;
+				next = nextBlock->Next.load(std::memory_order_relaxed);
+			}
+			if (previous && (uint64_t)((char*)previous - (char*)header) + previous->Size == offset)
+			{
+				// unlink the merged next block before previous grows over it, so the list never overlaps
+				previous->Next.store(next, std::memory_order_relaxed);
+				previous->Size += block->Size;
+			}
+			else
+			{
+				block->Next.store(next, std::memory_order_relaxed);
+				link->store(offset, std::memory_order_relaxed);
+			}
+			_ArenaUnlockLarge(header);
+		}
+
+		/*!
+		* \class	Arena
+		*
+		* \brief	Allocates variable size objects inside a shared memory, so they can be used in place by every process
+		* 			attached to it. Allocations up to 4KB come from lock-free free lists per power of 2 size class;
+		* 			bigger ones from a first-fit free list that merges neighbours, under a spinlock.
+		* 			All state lives in the shared memory, so any process may allocate and free. If a process dies
+		* 			holding the spinlock, others take it over; the block it was allocating or freeing is lost.
+		* 			Link objects with OffsetPtr (not raw pointers), or pass offsets (ToOffset / FromOffset) through
+		* 			queues. Use ArenaAllocator, Vector and String to keep STL containers in the arena.
+		*
+		* \date		10/19/2026
+		*/
+		class Arena
+		{
+		private:
+
+			// magic value marking an initialized arena
+			static const uint64_t _Magic = 0x4a55535441524e41ULL;
+
+			__ArenaHeader* _Header = nullptr;
+
+		public:
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t size = 0)
+			*
+			* \brief	Initialize a new, empty arena in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the arena.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the arena in.
+			* \param	offset				Offset of the arena in the shared memory, aligned to 64 bytes.
+			* \param	size				(Optional) Arena size in bytes, including its header. 0 for the rest of the memory.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t size = 0)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Arena offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize()) throw std::runtime_error("Exceeded shared memory size!");
+				if (size == 0) size = memory.GetSize() - offset;
+				if (size < sizeof(__ArenaHeader) || memory.GetSize() - offset < size) throw std::runtime_error("Exceeded shared memory size!");
+				if (size > _ArenaOffsetMask) throw std::runtime_error("Arena size is limited to 1TB!");
+
+				__ArenaHeader* header = new (memory.GetBuffer() + offset) __ArenaHeader();
+				header->Size = size & ~(uint64_t)15;
+				header->Top.store(sizeof(__ArenaHeader), std::memory_order_relaxed);
+				header->Magic.store(_Magic, std::memory_order_release);
+				_Header = header;
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to an arena another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the arena is in.
+			* \param	offset				Offset of the arena in the shared memory.
+			* Note: throws std::runtime_error if there is no arena at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Arena offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__ArenaHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__ArenaHeader* header = (__ArenaHeader*)(memory.GetBuffer() + offset);
+				if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain an arena!");
+				if (memory.GetSize() - offset < header->Size) throw std::runtime_error("Exceeded shared memory size!");
+				_Header = header;
+			}
+
+			// return if arena is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			/*!
+			* \fn	void* Allocate(size_t size)
+			*
+			* \brief	Allocate memory in the arena, 16 bytes aligned.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size				Bytes to allocate.
+			*
+			* \return	Allocated memory, or nullptr if the arena is full.
+			*/
+			inline void* Allocate(size_t size)
+			{
+				return _ArenaAllocate(_Header, size);
+			}
+
+			/*!
+			* \fn	void Free(void* data)
+			*
+			* \brief	Free memory allocated from the arena, by any process.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data				Memory to free, may be nullptr.
+			* Note: throws std::runtime_error if data was not allocated from this arena.
+			*/
+			inline void Free(void* data)
+			{
+				_ArenaFree(_Header, data);
+			}
+
+			// construct an object in the arena. throws std::bad_alloc if arena is full
+			template <typename T, typename... Args>
+			T* New(Args&&... args)
+			{
+				static_assert(alignof(T) <= 16, "Arena objects must be aligned to at most 16 bytes");
+				void* data = Allocate(sizeof(T));
+				if (!data) throw std::bad_alloc();
+				try
+				{
+					return new (data) T(std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					Free(data);
+					throw;
+				}
+			}
+
+			// destruct and free an object made with New
+			template <typename T>
+			void Delete(T* object)
+			{
+				if (!object) return;
+				object->~T();
+				Free((void*)object);
+			}
+
+			// get offset of memory in the arena, to pass to other processes. 0 for nullptr
+			inline uint64_t ToOffset(const void* data) const
+			{
+				return data ? (uint64_t)((const char*)data - (const char*)_Header) : 0;
+			}
+
+			// get memory from an offset given by ToOffset
+			inline void* FromOffset(uint64_t offset) const
+			{
+				return offset ? (char*)_Header + offset : nullptr;
+			}
+
+			// set the root object, that processes connecting to the arena start from
+			inline void SetRoot(const void* data)
+			{
+				_Header->Root.store(ToOffset(data), std::memory_order_release);
+			}
+
+			// get the root object, nullptr if not set
+			template <typename T = void>
+			inline T* GetRoot() const
+			{
+				return (T*)FromOffset(_Header->Root.load(std::memory_order_acquire));
+			}
+
+			// get bytes in allocated blocks, including block headers and size class rounding
+			inline size_t GetUsedBytes() const { return (size_t)_Header->Used.load(std::memory_order_relaxed); }
+
+			// get bytes never allocated so far
+			inline size_t GetUntouchedBytes() const { return (size_t)(_Header->Size - _Header->Top.load(std::memory_order_relaxed)); }
+
+			// get arena header, used by ArenaAllocator
+			inline __ArenaHeader* GetHeader() const { return _Header; }
+		};
+
+		/*!
+		* \class	ArenaAllocator
+		*
+		* \brief	STL allocator that allocates from an Arena. It refers to the arena with an OffsetPtr, so containers
+		* 			placed in the arena (with Arena::New) can be used by any attached process.
+		* 			Elements that allocate themselves (like String in a Vector) need the allocator passed on construction.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename T>
+		class ArenaAllocator
+		{
+		private:
+
+			template <typename U>
+			friend class ArenaAllocator;
+
+			OffsetPtr<__ArenaHeader> _Header;
+
+		public:
+
+			typedef T value_type;
+			typedef OffsetPtr<T> pointer;
+			typedef OffsetPtr<const T> const_pointer;
+			typedef OffsetPtr<void> void_pointer;
+			typedef OffsetPtr<const void> const_void_pointer;
+			typedef size_t size_type;
+			typedef ptrdiff_t difference_type;
+			typedef std::true_type propagate_on_container_copy_assignment;
+			typedef std::true_type propagate_on_container_move_assignment;
+			typedef std::true_type propagate_on_container_swap;
+
+			template <typename U>
+			struct rebind { typedef ArenaAllocator<U> other; };
+
+			ArenaAllocator(const Arena& arena) : _Header(arena.GetHeader()) {}
+			ArenaAllocator(const ArenaAllocator& other) : _Header(other._Header) {}
+			template <typename U>
+			ArenaAllocator(const ArenaAllocator<U>& other) : _Header(other._Header) {}
+			ArenaAllocator& operator=(const ArenaAllocator& other) { _Header = other._Header; return *this; }
+
+			// allocate n elements. throws std::bad_alloc if arena is full
+			pointer allocate(size_t n)
+			{
+				static_assert(alignof(T) <= 16, "Arena objects must be aligned to at most 16 bytes");
+				if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+				void* data = _ArenaAllocate(_Header.Get(), n * sizeof(T));
+				if (!data) throw std::bad_alloc();
+				return pointer((T*)data);
+			}
+
+			// free elements
+			void deallocate(pointer data, size_t)
+			{
+				_ArenaFree(_Header.Get(), (void*)data.Get());
+			}
+
+			template <typename U>
+			friend inline bool operator==(const ArenaAllocator& a, const ArenaAllocator<U>& b) { return a._Header.Get() == b._Header.Get(); }
+			template <typename U>
+			friend inline bool operator!=(const ArenaAllocator& a, const ArenaAllocator<U>& b) { return a._Header.Get() != b._Header.Get(); }
+		};
+
+		// a vector that lives in an arena
+		template <typename T>
+		using Vector = std::vector<T, ArenaAllocator<T>>;
+
+		/*!
+		* \class	String
+		*
+		* \brief	A string that lives in an arena, with its characters linked by an OffsetPtr.
+		* 			std::basic_string can't be used for this, since standard libraries don't support offset pointers
+		* 			in strings, so this covers the common string operations and converts to std::string_view.
+		*
+		* \date		10/19/2026
+		*/
+		class String
+		{
+		private:
+
+			ArenaAllocator<char> _Allocator;
+			OffsetPtr<char> _Data;
+			size_t _Size = 0;
+			size_t _Capacity = 0;
+
+			// grow capacity to at least required characters (plus null terminator), copying tail after the content.
+			// tail may be in the old buffer (like s.append(s.view())), so it is copied before the old buffer is freed
+			void _Grow(size_t required, std::string_view tail = std::string_view())
+			{
+				if (required <= _Capacity) return;
+				size_t capacity = _Capacity * 2 > required ? _Capacity * 2 : required;
+				if (capacity < 15) capacity = 15;
+				OffsetPtr<char> data = _Allocator.allocate(capacity + 1);
+				if (_Size) memcpy(data.Get(), _Data.Get(), _Size);
+				if (tail.size()) memcpy(data.Get() + _Size, tail.data(), tail.size());
+				data[_Size + tail.size()] = 0;
+				if (_Data) _Allocator.deallocate(_Data, _Capacity + 1);
+				_Data = data;
+				_Capacity = capacity;
+			}
+
+		public:
+
+			typedef char value_type;
+			typedef ArenaAllocator<char> allocator_type;
+			typedef size_t size_type;
+			typedef char* iterator;
+			typedef const char* const_iterator;
+
+			String(const ArenaAllocator<char>& allocator) : _Allocator(allocator) {}
+			String(std::string_view value, const ArenaAllocator<char>& allocator) : _Allocator(allocator) { assign(value); }
+			String(const char* value, const ArenaAllocator<char>& allocator) : _Allocator(allocator) { assign(value); }
+			String(const String& other) : _Allocator(other._Allocator) { assign(other.view()); }
+			String(String&& other) noexcept : _Allocator(other._Allocator), _Data(other._Data), _Size(other._Size), _Capacity(other._Capacity)
+			{
+				other._Data = nullptr;
+				other._Size = other._Capacity = 0;
+			}
+			~String()
+			{
+				if (_Data) _Allocator.deallocate(_Data, _Capacity + 1);
+			}
+
+			String& operator=(const String& other) { if (this != &other) assign(other.view()); return *this; }
+			String& operator=(String&& other) noexcept
+			{
+				if (this == &other) return *this;
+				if (_Allocator != other._Allocator) { assign(other.view()); return *this; }
+				if (_Data) _Allocator.deallocate(_Data, _Capacity + 1);
+				_Data = other._Data;
+				_Size = other._Size;
+				_Capacity = other._Capacity;
+				other._Data = nullptr;
+				other._Size = other._Capacity = 0;
+				return *this;
+			}
+			String& operator=(std::string_view value) { return assign(value); }
+
+			// replace content. value may be part of this string, it is never longer than the buffer then
+			String& assign(std::string_view value)
+			{
+				_Size = 0;
+				return append(value);
+			}
+
+			// append characters. value may be part of this string
+			String& append(std::string_view value)
+			{
+				if (_Size + value.size() > _Capacity) _Grow(_Size + value.size(), value);
+				else if (value.size()) memmove(_Data.Get() + _Size, value.data(), value.size());
+				_Size += value.size();
+				if (_Data) _Data[_Size] = 0;
+				return *this;
+			}
+			String& operator+=(std::string_view value) { return append(value); }
+			String& operator+=(char value) { return append(std::string_view(&value, 1)); }
+			inline void push_back(char value) { append(std::string_view(&value, 1)); }
+
+			// make room for capacity characters
+			inline void reserve(size_t capacity) { _Grow(capacity); }
+
+			// resize, filling new characters with fill
+			void resize(size_t size, char fill = 0)
+			{
+				_Grow(size);
+				if (size > _Size) memset(_Data.Get() + _Size, fill, size - _Size);
+				_Size = size;
+				if (_Data) _Data[_Size] = 0;
+			}
+
+			inline void clear() { resize(0); }
+
+			inline const char* c_str() const { return _Data ? _Data.Get() : ""; }
+			inline const char* data() const { return c_str(); }
+			inline char* data() { return _Data ? _Data.Get() : (char*)""; }
+			inline size_t size() const { return _Size; }
+			inline size_t length() const { return _Size; }
+			inline size_t capacity() const { return _Capacity; }
+			inline bool empty() const { return _Size == 0; }
+			inline char& operator[](size_t index) { return _Data[index]; }
+			inline const char& operator[](size_t index) const { return _Data[index]; }
+			inline iterator begin() { return data(); }
+			inline iterator end() { return data() + _Size; }
+			inline const_iterator begin() const { return c_str(); }
+			inline const_iterator end() const { return c_str() + _Size; }
+			inline ArenaAllocator<char> get_allocator() const { return _Allocator; }
+
+			inline std::string_view view() const { return std::string_view(c_str(), _Size); }
+			inline operator std::string_view() const { return view(); }
+			inline std::string str() const { return std::string(c_str(), _Size); }
+
+			friend inline bool operator==(const String& a, std::string_view b) { return a.view() == b; }
+			friend inline bool operator!=(const String& a, std::string_view b) { return a.view() != b; }
+			friend inline bool operator<(const String& a, const String& b) { return a.view() < b.view(); }
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\BroadcastRing.h::
+
+/*!
+* \file	Source\SharedMemory\BroadcastRing.h.
+*
+* \brief	Ring that broadcasts records from one producer to many consumer processes, each with its own cursor.
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	BroadcastMode
+		*
+		* \brief	What the producer does when the slowest reader is a whole ring behind.
+		*/
+		enum class BroadcastMode : uint32_t
+		{
+			// writes fail until the slowest subscribed reader catches up
+			Backpressure = 0,
+
+			// writes never fail; readers that fall a whole ring behind skip ahead and count the lost records
+			Lossy = 1,
+		};
+
+		/*!
+		* \struct	__BroadcastHeader
+		*
+		* \brief	Used internally, header of a broadcast ring in shared memory.
+		* 			Reader cursors follow it (one cache line each), then the slots.
+		*/
+		struct __BroadcastHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			uint64_t SlotSize;
+			uint64_t MaxReaders;
+			BroadcastMode Mode;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Cursor;
+		};
+
+		/*!
+		* \struct	__BroadcastReaderSlot
+		*
+		* \brief	Used internally, a reader's cursor (next sequence it reads), written only by that reader.
+		*/
+		struct __BroadcastReaderSlot
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Cursor;
+			std::atomic<uint32_t> Active;
+			std::atomic<int32_t> Pid;
+		};
+
+		/*!
+		* \struct	__BroadcastSlot
+		*
+		* \brief	Used internally, slot header. Sequence is 2 * (record sequence) + 1 while the record is written,
+		* 			and 2 * (record sequence) + 2 once it is complete. Data follows as 64 bit words.
+		*/
+		struct __BroadcastSlot
+		{
+			std::atomic<uint64_t> Sequence;
+			std::atomic<uint64_t> Size;
+		};
+
+		/*!
+		* \class	BroadcastRing
+		*
+		* \brief	Fans a stream of records out from one producer to many consumers through a single ring of
+		* 			fixed size slots (like a disruptor). Every record is written once, and each reader moves its own
+		* 			cursor over the same slots, so adding readers adds no writes. The producer either waits for the
+		* 			slowest subscribed reader (Backpressure), or overwrites (Lossy) and lets readers detect overruns
+		* 			through the per-slot sequence.
+		* 			One process writes; every process that reads calls Subscribe on its own BroadcastRing object.
+		*
+		* \date		10/19/2026
+		*/
+		class BroadcastRing
+		{
+		private:
+
+			// magic value marking an initialized ring
+			static const uint64_t _Magic = 0x4a55535442524443ULL;
+
+			__BroadcastHeader* _Header = nullptr;
+			__BroadcastReaderSlot* _Readers = nullptr;
+			char* _Slots = nullptr;
+			uint64_t _Mask = 0;
+			uint64_t _Stride = 0;
+			bool _Lossy = false;
+
+			// producer side: next sequence to write, and cached slowest reader cursor
+			uint64_t _WriteSequence = 0;
+			uint64_t _CachedMin = 0;
+
+			// reader side: our reader slot, next sequence to read, and records lost to overruns
+			__BroadcastReaderSlot* _Reader = nullptr;
+			uint64_t _ReadSequence = 0;
+			uint64_t _Lost = 0;
+			std::vector<uint64_t> _Buffer;
+
+			// get slot stride for a slot size
+			static inline uint64_t _StrideFor(size_t slotSize)
+			{
+				return (sizeof(__BroadcastSlot) + ((slotSize + 7) & ~(uint64_t)7) + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1);
+			}
+
+			// get slot by sequence
+			inline __BroadcastSlot* _Slot(uint64_t sequence) const
+			{
+				return (__BroadcastSlot*)(_Slots + (sequence & _Mask) * _Stride);
+			}
+
+			// get slot data words
+			static inline std::atomic<uint64_t>* _Words(__BroadcastSlot* slot)
+			{
+				return (std::atomic<uint64_t>*)(slot + 1);
+			}
+
+			// recompute slowest reader cursor, dropping readers whose process died
+			uint64_t _MinCursor(bool dropDead)
+			{
+				// pairs with Subscribe: a reader we don't see starts at or after our published cursor
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				uint64_t ret = _WriteSequence;
+				for (uint64_t i = 0; i < _Header->MaxReaders; ++i)
+				{
+					__BroadcastReaderSlot& reader = _Readers[i];
+					if (reader.Active.load(std::memory_order_seq_cst) != 1) continue;
+					if (dropDead && _IsProcessDead(reader.Pid.load(std::memory_order_relaxed)))
+					{
+						reader.Active.store(0, std::memory_order_release);
+						continue;
+					}
+					uint64_t cursor = reader.Cursor.load(std::memory_order_acquire);
+					if (cursor < ret) ret = cursor;
+				}
+				return ret;
+			}
+
+			// copy record of a complete slot out. in lossy mode the writer may overwrite it meanwhile, so words are atomic
+			inline size_t _CopyOut(__BroadcastSlot* slot, void* data, size_t bufferSize)
+			{
+				size_t size = (size_t)slot->Size.load(std::memory_order_relaxed);
+				if (size > _Header->SlotSize) size = (size_t)_Header->SlotSize;
+				size_t copy = size < bufferSize ? size : bufferSize;
+				if (!_Lossy)
+				{
+					memcpy(data, (const void*)_Words(slot), copy);
+					return size;
+				}
+				std::atomic<uint64_t>* words = _Words(slot);
+				size_t whole = copy / 8;
+				for (size_t i = 0; i < whole; ++i)
+				{
+					uint64_t word = words[i].load(std::memory_order_relaxed);
+					memcpy((char*)data + i * 8, &word, 8);
+				}
+				if (copy % 8)
+				{
+					uint64_t word = words[whole].load(std::memory_order_relaxed);
+					memcpy((char*)data + whole * 8, &word, copy % 8);
+				}
+				return size;
+			}
+
+			// read the record at _ReadSequence. returns 0 if there is none yet, 1 if read, -1 if overrun (and skips ahead)
+			int _ReadOne(void* data, size_t bufferSize, size_t& size)
+			{
+				uint64_t cursor = _Header->Cursor.load(std::memory_order_acquire);
+				if (_ReadSequence >= cursor) return 0;
+				__BroadcastSlot* slot = _Slot(_ReadSequence);
+				uint64_t expected = 2 * _ReadSequence + 2;
+				uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+				if (sequence == expected)
+				{
+					size = _CopyOut(slot, data, bufferSize);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (slot->Sequence.load(std::memory_order_relaxed) == expected)
+					{
+						++_ReadSequence;
+						return 1;
+					}
+				}
+
+				// writer lapped us: skip to the oldest record that may still be there
+				uint64_t oldest = cursor > _Mask ? cursor - _Mask : 0;
+				if (oldest <= _ReadSequence) oldest = _ReadSequence + 1;
+				_Lost += oldest - _ReadSequence;
+				_ReadSequence = oldest;
+				return -1;
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity, size_t slotSize, size_t maxReaders, BroadcastMode mode)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Ring offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__BroadcastHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__BroadcastHeader* header = (__BroadcastHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a broadcast ring!");
+					capacity = (size_t)header->Capacity;
+					slotSize = (size_t)header->SlotSize;
+					maxReaders = (size_t)header->MaxReaders;
+					mode = header->Mode;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity, slotSize, maxReaders)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Readers = (__BroadcastReaderSlot*)(header + 1);
+				_Slots = (char*)(_Readers + maxReaders);
+				_Mask = capacity - 1;
+				_Stride = _StrideFor(slotSize);
+				_Lossy = mode == BroadcastMode::Lossy;
+				if (create)
+				{
+					new (header) __BroadcastHeader();
+					header->Capacity = capacity;
+					header->SlotSize = slotSize;
+					header->MaxReaders = maxReaders;
+					header->Mode = mode;
+					for (size_t i = 0; i < maxReaders; ++i) new (_Readers + i) __BroadcastReaderSlot();
+					for (uint64_t i = 0; i < capacity; ++i) new (_Slot(i)) __BroadcastSlot();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+				_WriteSequence = _CachedMin = header->Cursor.load(std::memory_order_acquire);
+			}
+
+		public:
+
+			BroadcastRing() = default;
+
+			// readers own a reader slot, so rings can't be copied
+			BroadcastRing(const BroadcastRing&) = delete;
+			BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+			~BroadcastRing()
+			{
+				Unsubscribe();
+			}
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity, size_t slotSize, size_t maxReaders)
+			*
+			* \brief	Get how many bytes of shared memory a broadcast ring needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Number of slots.
+			* \param	slotSize			Max bytes per record.
+			* \param	maxReaders			Max readers subscribed at once.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity, size_t slotSize, size_t maxReaders)
+			{
+				return sizeof(__BroadcastHeader) + maxReaders * sizeof(__BroadcastReaderSlot) + capacity * (size_t)_StrideFor(slotSize);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize, size_t maxReaders = 16, BroadcastMode mode = BroadcastMode::Backpressure)
+			*
+			* \brief	Initialize a new, empty broadcast ring in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the ring.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the ring in.
+			* \param	offset				Offset of the ring in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Number of slots. Must be a power of 2, at least 2.
+			* \param	slotSize			Max bytes per record.
+			* \param	maxReaders			(Optional) Max readers subscribed at once.
+			* \param	mode				(Optional) Wait for slow readers, or overwrite.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize, size_t maxReaders = 16, BroadcastMode mode = BroadcastMode::Backpressure)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1))) throw std::runtime_error("Ring capacity must be a power of 2, at least 2!");
+				if (slotSize == 0 || maxReaders == 0) throw std::runtime_error("Ring slot size and max readers must not be 0!");
+				_Attach(memory, offset, true, capacity, slotSize, maxReaders, mode);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a broadcast ring another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the ring is in.
+			* \param	offset				Offset of the ring in the shared memory.
+			* Note: throws std::runtime_error if there is no broadcast ring at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0, 0, BroadcastMode::Backpressure);
+			}
+
+			// return if ring is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get max bytes per record
+			inline size_t GetSlotSize() const { return (size_t)_Header->SlotSize; }
+
+			/*!
+			* \fn	bool TryWrite(const void* data, size_t size)
+			*
+			* \brief	Write a record for all readers. Producer only.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Record data.
+			* \param	size 				Record size, at most slot size.
+			*
+			* \return	False if in Backpressure mode and the slowest reader is a whole ring behind.
+			*/
+			bool TryWrite(const void* data, size_t size)
+			{
+				if (size > _Header->SlotSize) throw std::runtime_error("Record is too big for ring slot!");
+				if (!_Lossy && _WriteSequence - _CachedMin > _Mask)
+				{
+					_CachedMin = _MinCursor(false);
+					if (_WriteSequence - _CachedMin > _Mask) _CachedMin = _MinCursor(true);
+					if (_WriteSequence - _CachedMin > _Mask) return false;
+				}
+
+				__BroadcastSlot* slot = _Slot(_WriteSequence);
+				std::atomic<uint64_t>* words = _Words(slot);
+				if (_Lossy)
+				{
+					// readers may be copying the slot: mark it in progress, then store words atomically
+					slot->Sequence.store(2 * _WriteSequence + 1, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_release);
+					size_t whole = size / 8;
+					for (size_t i = 0; i < whole; ++i)
+					{
+						uint64_t word;
+						memcpy(&word, (const char*)data + i * 8, 8);
+						words[i].store(word, std::memory_order_relaxed);
+					}
+					if (size % 8)
+					{
+						uint64_t word = 0;
+						memcpy(&word, (const char*)data + whole * 8, size % 8);
+						words[whole].store(word, std::memory_order_relaxed);
+					}
+				}
+				else
+				{
+					memcpy((void*)words, data, size);
+				}
+				slot->Size.store(size, std::memory_order_relaxed);
+				slot->Sequence.store(2 * _WriteSequence + 2, std::memory_order_release);
+				_Header->Cursor.store(++_WriteSequence, std::memory_order_release);
+				return true;
+			}
+
+			// write a trivially copyable value
+			template <typename T>
+			inline bool TryWrite(const T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Ring records must be trivially copyable");
+				return TryWrite(&value, sizeof(T));
+			}
+
+			/*!
+			* \fn	bool Subscribe()
+			*
+			* \brief	Start reading with this object. Reading starts from the next record written.
+			* 			In Backpressure mode the producer waits for this reader from now on, until Unsubscribe
+			* 			(or until its process dies).
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if max readers are already subscribed.
+			*/
+			bool Subscribe()
+			{
+				if (_Reader) return true;
+				for (uint64_t i = 0; i < _Header->MaxReaders; ++i)
+				{
+					__BroadcastReaderSlot& reader = _Readers[i];
+					uint32_t expected = 0;
+					if (!reader.Active.compare_exchange_strong(expected, 2, std::memory_order_acquire)) continue;
+
+					// become visible to the producer first, then start from its cursor (see _MinCursor)
+					reader.Pid.store(_CurrentProcessId(), std::memory_order_relaxed);
+					reader.Cursor.store(_Header->Cursor.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+					reader.Active.store(1, std::memory_order_seq_cst);
+					_ReadSequence = _Header->Cursor.load(std::memory_order_seq_cst);
+					reader.Cursor.store(_ReadSequence, std::memory_order_release);
+					_Reader = &reader;
+					_Lost = 0;
+					return true;
+				}
+				return false;
+			}
+
+			// stop reading, so the producer stops waiting for this reader
+			void Unsubscribe()
+			{
+				if (!_Reader) return;
+				_Reader->Active.store(0, std::memory_order_release);
+				_Reader = nullptr;
+			}
+
+			/*!
+			* \fn	bool TryRead(void* data, size_t& size)
+			*
+			* \brief	Read the next record, if there is one. Subscribed readers only.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Buffer to copy record into, at least slot size bytes.
+			* \param	size 				Record size.
+			*
+			* \return	False if there is no new record.
+			*/
+			bool TryRead(void* data, size_t& size)
+			{
+				if (!_Reader) throw std::runtime_error("Must subscribe to read from broadcast ring!");
+				int ret;
+				while ((ret = _ReadOne(data, (size_t)_Header->SlotSize, size)) < 0) {}
+				if (ret) _Reader->Cursor.store(_ReadSequence, std::memory_order_release);
+				return ret > 0;
+			}
+
+			// read a trivially copyable value. record should have been written with the same type
+			template <typename T>
+			inline bool TryRead(T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Ring records must be trivially copyable");
+				if (!_Reader) throw std::runtime_error("Must subscribe to read from broadcast ring!");
+				int ret;
+				size_t size;
+				while ((ret = _ReadOne(&value, sizeof(T), size)) < 0) {}
+				if (ret) _Reader->Cursor.store(_ReadSequence, std::memory_order_release);
+				return ret > 0;
+			}
+
+			/*!
+			* \fn	template <typename Handler> size_t Consume(Handler handler, size_t max = (size_t)-1)
+			*
+			* \brief	Read available records, calling handler(const void* data, size_t size) for each.
+			* 			The cursor is stored once for the whole batch.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Callable taking (const void*, size_t). Data is valid only during the call.
+			* \param	max					(Optional) Max records to read.
+			*
+			* \return	Number of records read.
+			*/
+			template <typename Handler>
+			size_t Consume(Handler handler, size_t max = (size_t)-1)
+			{
+				if (!_Reader) throw std::runtime_error("Must subscribe to read from broadcast ring!");
+				_Buffer.resize((size_t)(_Header->SlotSize + 7) / 8);
+				size_t count = 0;
+				while (count < max)
+				{
+					size_t size;
+					int ret = _ReadOne(_Buffer.data(), (size_t)_Header->SlotSize, size);
+					if (ret < 0) continue;
+					if (ret == 0) break;
+					handler((const void*)_Buffer.data(), size);
+					++count;
+				}
+				if (count) _Reader->Cursor.store(_ReadSequence, std::memory_order_release);
+				return count;
+			}
+
+			// get number of records this reader lost to overruns (Lossy mode)
+			inline uint64_t GetLostCount() const { return _Lost; }
+
+			// get number of records written but not read yet by this reader
+			inline uint64_t GetLag() const
+			{
+				uint64_t cursor = _Header->Cursor.load(std::memory_order_acquire);
+				return cursor > _ReadSequence ? cursor - _ReadSequence : 0;
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\HashMap.h::
+
+/*!
+* \file	Source\SharedMemory\HashMap.h.
+*
+* \brief	Fixed capacity hash map inside a shared memory, read in place by many processes without locks.
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+// #include "Futex.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	HashMapMode
+		*
+		* \brief	Who may write to a hash map.
+		*/
+		enum class HashMapMode : uint32_t
+		{
+			// one process writes at a time. erased slots are reused by any key
+			SingleWriter = 0,
+
+			// any number of processes write, locking single slots with a CAS. a slot that held a key keeps it
+			// after Erase (only that key can reuse it), so size the map for the number of distinct keys ever set
+			MultiWriter = 1,
+		};
+
+		/*!
+		* \struct	__HashMapHeader
+		*
+		* \brief	Used internally, header of a hash map in shared memory. Slots follow right after it.
+		*/
+		struct __HashMapHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			uint32_t KeySize;
+			uint32_t ValueSize;
+			HashMapMode Mode;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Count;
+		};
+
+		/*!
+		* \class	HashMap
+		*
+		* \brief	A hash map of trivially copyable keys and values with a fixed capacity, in shared memory.
+		* 			Uses linear probing. Every slot has its own version word (a small seqlock), so readers copy just the
+		* 			slot they need and retry if a writer changed it meanwhile; they never lock and never copy the table.
+		* 			Keys are compared bytewise, so key types must not have padding. Hash must give the same results
+		* 			in every process (the default std::hash does for integers, within the same standard library).
+		*
+		* \date		10/19/2026
+		*/
+		template <typename K, typename V, typename Hash = std::hash<K>>
+		class HashMap
+		{
+			static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value, "HashMap keys and values must be trivially copyable");
+
+		private:
+
+			// magic value marking an initialized hash map
+			static const uint64_t _Magic = 0x4a55535448534d50ULL;
+
+			// key and value sizes, in 64 bit words
+			static const size_t _KeyWords = (sizeof(K) + 7) / 8;
+			static const size_t _ValueWords = (sizeof(V) + 7) / 8;
+
+			// slot: version word, then key words, then value words
+			static const size_t _SlotWords = 1 + _KeyWords + _ValueWords;
+
+			// version word: bit 0 set while a writer holds the slot, bits 1-2 slot state, the rest counts writes
+			static const uint64_t _Locked = 1;
+			static const uint64_t _Empty = 0;
+			static const uint64_t _Occupied = 1;
+			static const uint64_t _Deleted = 2;
+
+			__HashMapHeader* _Header = nullptr;
+			std::atomic<uint64_t>* _Slots = nullptr;
+			uint64_t _Mask = 0;
+			bool _MultiWriter = false;
+
+			static inline uint64_t _State(uint64_t version) { return (version >> 1) & 3; }
+
+			// get first slot to probe. mixes the hash so that keys with a common stride don't pile up
+			static inline uint64_t _HashOf(const K& key)
+			{
+				uint64_t hash = (uint64_t)Hash()(key);
+				hash ^= hash >> 33;
+				hash *= 0xff51afd7ed558ccdULL;
+				hash ^= hash >> 33;
+				hash *= 0xc4ceb9fe1a85ec53ULL;
+				hash ^= hash >> 33;
+				return hash;
+			}
+
+			inline std::atomic<uint64_t>* _Slot(uint64_t index) const
+			{
+				return _Slots + (index & _Mask) * _SlotWords;
+			}
+
+			// copy words out / in, relaxed
+			static inline void _Load(const std::atomic<uint64_t>* words, void* out, size_t size)
+			{
+				uint64_t buffer[(_KeyWords > _ValueWords ? _KeyWords : _ValueWords)];
+				for (size_t i = 0; i < (size + 7) / 8; ++i) buffer[i] = words[i].load(std::memory_order_relaxed);
+				memcpy(out, buffer, size);
+			}
+			static inline void _Store(std::atomic<uint64_t>* words, const void* data, size_t size)
+			{
+				uint64_t buffer[(_KeyWords > _ValueWords ? _KeyWords : _ValueWords)] = {};
+				memcpy(buffer, data, size);
+				for (size_t i = 0; i < (size + 7) / 8; ++i) words[i].store(buffer[i], std::memory_order_relaxed);
+			}
+
+			// compare a slot key, relaxed
+			static inline bool _KeyEquals(const std::atomic<uint64_t>* slot, const K& key)
+			{
+				K slotKey;
+				_Load(slot + 1, &slotKey, sizeof(K));
+				return memcmp(&slotKey, &key, sizeof(K)) == 0;
+			}
+
+			// wait until a slot is not held by a writer, and get its version
+			static inline uint64_t _Stable(const std::atomic<uint64_t>* slot)
+			{
+				uint64_t version;
+				for (unsigned attempt = 0; (version = slot->load(std::memory_order_acquire)) & _Locked; ++attempt)
+				{
+					if (attempt >= 64) std::this_thread::yield();
+					else _CpuRelax();
+				}
+				return version;
+			}
+
+			// take a slot for writing, return its version from before
+			inline uint64_t _Lock(std::atomic<uint64_t>* slot)
+			{
+				uint64_t version;
+				if (_MultiWriter)
+				{
+					do
+					{
+						version = _Stable(slot);
+					} while (!slot->compare_exchange_weak(version, version | _Locked, std::memory_order_acquire, std::memory_order_relaxed));
+				}
+				else
+				{
+					version = slot->load(std::memory_order_relaxed);
+					slot->store(version | _Locked, std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_release);
+				return version;
+			}
+
+			// release a slot with a new state
+			static inline void _Unlock(std::atomic<uint64_t>* slot, uint64_t version, uint64_t state)
+			{
+				slot->store((((version >> 3) + 1) << 3) | (state << 1), std::memory_order_release);
+			}
+
+			// write key and value into a locked slot, and release it occupied
+			inline void _Fill(std::atomic<uint64_t>* slot, uint64_t version, const K& key, const V& value)
+			{
+				if (_State(version) == _Empty || !_MultiWriter) _Store(slot + 1, &key, sizeof(K));
+				_Store(slot + 1 + _KeyWords, &value, sizeof(V));
+				if (_State(version) != _Occupied) _Header->Count.fetch_add(1, std::memory_order_relaxed);
+				_Unlock(slot, version, _Occupied);
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity, HashMapMode mode)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Hash map offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__HashMapHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__HashMapHeader* header = (__HashMapHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic || header->KeySize != sizeof(K) || header->ValueSize != sizeof(V))
+					{
+						throw std::runtime_error("Shared memory does not contain a hash map of this type!");
+					}
+					capacity = (size_t)header->Capacity;
+					mode = header->Mode;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Slots = (std::atomic<uint64_t>*)(header + 1);
+				_Mask = capacity - 1;
+				_MultiWriter = mode == HashMapMode::MultiWriter;
+				if (create)
+				{
+					new (header) __HashMapHeader();
+					header->Capacity = capacity;
+					header->KeySize = sizeof(K);
+					header->ValueSize = sizeof(V);
+					header->Mode = mode;
+					for (size_t i = 0; i < capacity * _SlotWords; ++i) new (_Slots + i) std::atomic<uint64_t>(0);
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity)
+			*
+			* \brief	Get how many bytes of shared memory a hash map needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Number of slots.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity)
+			{
+				return sizeof(__HashMapHeader) + capacity * _SlotWords * sizeof(uint64_t);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity, HashMapMode mode = HashMapMode::SingleWriter)
+			*
+			* \brief	Initialize a new, empty hash map in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the map.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the map in.
+			* \param	offset				Offset of the map in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Number of slots. Must be a power of 2. Keep the map under ~70% full for short probes.
+			* \param	mode				(Optional) Single writer, or many writers.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity, HashMapMode mode = HashMapMode::SingleWriter)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1))) throw std::runtime_error("Hash map capacity must be a power of 2, at least 2!");
+				_Attach(memory, offset, true, capacity, mode);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a hash map another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the map is in.
+			* \param	offset				Offset of the map in the shared memory.
+			* Note: throws std::runtime_error if there is no map of these types at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, HashMapMode::SingleWriter);
+			}
+
+			// return if map is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get number of slots
+			inline size_t GetCapacity() const { return (size_t)(_Mask + 1); }
+
+			// get number of keys (approximate while writers are busy)
+			inline size_t GetCount() const { return (size_t)_Header->Count.load(std::memory_order_relaxed); }
+
+			/*!
+			* \fn	bool Find(const K& key, V& value) const
+			*
+			* \brief	Look a key up. Copies only the value, never blocks writers.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key to find.
+			* \param	value				Value to read into.
+			*
+			* \return	False if key is not in map.
+			*/
+			bool Find(const K& key, V& value) const
+			{
+				uint64_t hash = _HashOf(key);
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					const std::atomic<uint64_t>* slot = _Slot(hash + i);
+					while (true)
+					{
+						uint64_t version = _Stable(slot);
+						uint64_t state = _State(version);
+						if (state == _Empty) return false;
+						bool found = state == _Occupied && _KeyEquals(slot, key);
+						if (found) _Load(slot + 1 + _KeyWords, &value, sizeof(V));
+						std::atomic_thread_fence(std::memory_order_acquire);
+						if (slot->load(std::memory_order_relaxed) != version) continue;
+						if (found) return true;
+						break;
+					}
+				}
+				return false;
+			}
+
+			// return if key is in map
+			inline bool Contains(const K& key) const
+			{
+				V value;
+				return Find(key, value);
+			}
+
+			/*!
+			* \fn	bool Set(const K& key, const V& value)
+			*
+			* \brief	Add a key, or replace its value.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key to set.
+			* \param	value				Value to set.
+			*
+			* \return	False if map is full.
+			*/
+			bool Set(const K& key, const V& value)
+			{
+				uint64_t hash = _HashOf(key);
+				std::atomic<uint64_t>* reusable = nullptr;
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					std::atomic<uint64_t>* slot = _Slot(hash + i);
+					uint64_t state = _State(_Stable(slot));
+					if (state != _Empty && _KeyEquals(slot, key))
+					{
+						// in multi writer mode a slot keeps its key forever, so no need to check it again under lock
+						_Fill(slot, _Lock(slot), key, value);
+						return true;
+					}
+					if (state == _Deleted && !_MultiWriter && !reusable) reusable = slot;
+					if (state != _Empty) continue;
+
+					if (reusable) break;
+					uint64_t version = _Lock(slot);
+					if (_State(version) == _Empty || _KeyEquals(slot, key))
+					{
+						_Fill(slot, version, key, value);
+						return true;
+					}
+					// another writer took the slot first, for another key
+					_Unlock(slot, version, _State(version));
+				}
+				if (!reusable) return false;
+				_Fill(reusable, _Lock(reusable), key, value);
+				return true;
+			}
+
+			/*!
+			* \fn	bool Erase(const K& key)
+			*
+			* \brief	Remove a key.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key to remove.
+			*
+			* \return	False if key was not in map.
+			*/
+			bool Erase(const K& key)
+			{
+				uint64_t hash = _HashOf(key);
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					std::atomic<uint64_t>* slot = _Slot(hash + i);
+					uint64_t state = _State(_Stable(slot));
+					if (state == _Empty) return false;
+					if (!_KeyEquals(slot, key)) continue;
+
+					uint64_t version = _Lock(slot);
+					bool erased = _State(version) == _Occupied;
+					if (erased) _Header->Count.fetch_sub(1, std::memory_order_relaxed);
+					_Unlock(slot, version, _Deleted);
+					return erased;
+				}
+				return false;
+			}
+
+			/*!
+			* \fn	template <typename Handler> void ForEach(Handler handler) const
+			*
+			* \brief	Call handler(key, value) for every key. Each pair is consistent, but the map may change while iterating.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Callable taking (const K&, const V&).
+			*/
+			template <typename Handler>
+			void ForEach(Handler handler) const
+			{
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					const std::atomic<uint64_t>* slot = _Slot(i);
+					K key;
+					V value;
+					uint64_t version;
+					do
+					{
+						version = _Stable(slot);
+						if (_State(version) != _Occupied) break;
+						_Load(slot + 1, &key, sizeof(K));
+						_Load(slot + 1 + _KeyWords, &value, sizeof(V));
+						std::atomic_thread_fence(std::memory_order_acquire);
+					} while (slot->load(std::memory_order_relaxed) != version);
+					if (_State(version) == _Occupied) handler(key, value);
+				}
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\Layout.h::
+
+/*!
+* \file	Source\SharedMemory\Layout.h.
+*
+* \brief	Describe the fields of a shared memory region as types, and access them in place with offsets computed at compile time.
+*/
+// #pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+// #include "SharedMemory.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	Field
+		*
+		* \brief	A field of a Layout: a tag type naming it (any type, usually an empty struct), its value type, and
+		* 			optionally a larger alignment, for example _CacheLineSize to keep a hot atomic on its own cache line.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename TagType, typename T, size_t Align = alignof(T)>
+		struct Field
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Shared memory fields must be trivially copyable");
+			static_assert(!std::is_reference<T>::value && !std::is_pointer<T>::value, "Shared memory fields cannot be pointers or references, they are not valid in other processes");
+			static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Field alignment must be a power of 2, at least the type's alignment");
+
+			using Tag = TagType;
+			using Type = T;
+			static constexpr size_t Alignment = Align;
+		};
+
+		/*!
+		* \fn	template <typename... Fields> constexpr size_t _LayoutOffset(size_t index)
+		*
+		* \brief	Used internally, get offset of a layout field, each field aligned after the previous one.
+		* 			Index past the last field gives the end of the last field.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename... Fields>
+		constexpr size_t _LayoutOffset(size_t index)
+		{
+			const size_t sizes[] = { sizeof(typename Fields::Type)... };
+			const size_t alignments[] = { Fields::Alignment... };
+			size_t offset = 0;
+			for (size_t i = 0; i < sizeof...(Fields); ++i)
+			{
+				offset = (offset + alignments[i] - 1) / alignments[i] * alignments[i];
+				if (i == index) return offset;
+				offset += sizes[i];
+			}
+			return offset;
+		}
+
+		// used internally, count layout fields tagged Tag
+		template <typename Tag, typename... Fields>
+		constexpr size_t _LayoutMatches()
+		{
+			const bool matches[] = { std::is_same<Tag, typename Fields::Tag>::value... };
+			size_t count = 0;
+			for (bool match : matches) count += match ? 1 : 0;
+			return count;
+		}
+
+		// used internally, get index of the first layout field tagged Tag (0 if none, callers check _LayoutMatches)
+		template <typename Tag, typename... Fields>
+		constexpr size_t _LayoutIndex()
+		{
+			const bool matches[] = { std::is_same<Tag, typename Fields::Tag>::value... };
+			for (size_t i = 0; i < sizeof...(Fields); ++i) if (matches[i]) return i;
+			return 0;
+		}
+
+		// used internally, get max alignment of layout fields
+		template <typename... Fields>
+		constexpr size_t _LayoutAlignment()
+		{
+			const size_t alignments[] = { Fields::Alignment... };
+			size_t max = 1;
+			for (size_t alignment : alignments) if (alignment > max) max = alignment;
+			return max;
+		}
+
+		/*!
+		* \class	Layout
+		*
+		* \brief	A fixed layout of typed fields in a shared memory. Offsets are computed at compile time (each field
+		* 			aligned after the previous one), so there are no hand computed offsets to get wrong, and fields are
+		* 			accessed by reference straight in the mapping: no copy, no bounds check, no lock. The memory size
+		* 			and alignment are checked once, when the layout is attached.
+		* 			Asking for a field that is not in the layout, or an atomic view of a field that can't have one,
+		* 			is a compile error.
+		*
+		* 			using Quote = Layout<Field<struct Bid, double>, Field<struct Ask, double>, Field<struct Updates, uint64_t, 64>>;
+		* 			Quote quote(sm, 0);
+		* 			double spread = quote.Get<Ask>() - quote.Get<Bid>();
+		* 			quote.Atomic<Updates>().fetch_add(1);
+		*
+		* \date		10/19/2026
+		*/
+		template <typename... Fields>
+		class Layout
+		{
+			static_assert(sizeof...(Fields) > 0, "Layout must have at least one field");
+
+		private:
+
+			char* _Base = nullptr;
+
+		public:
+
+			// max alignment of all fields. the layout offset in the shared memory must be aligned to it
+			static constexpr size_t Alignment = _LayoutAlignment<Fields...>();
+
+			// bytes the layout takes, rounded up to its alignment so layouts can be placed back to back
+			static constexpr size_t Size = (_LayoutOffset<Fields...>(sizeof...(Fields)) + Alignment - 1) / Alignment * Alignment;
+
+			// get type of a field
+			template <typename Tag>
+			using TypeOf = typename std::tuple_element<_LayoutIndex<Tag, Fields...>(), std::tuple<typename Fields::Type...>>::type;
+
+			// get offset of a field from the start of the layout
+			template <typename Tag>
+			static constexpr size_t OffsetOf()
+			{
+				static_assert(_LayoutMatches<Tag, Fields...>() == 1, "Field is not in layout, or appears in it more than once");
+				return _LayoutOffset<Fields...>(_LayoutIndex<Tag, Fields...>());
+			}
+
+			// get how many bytes of shared memory the layout needs
+			static inline size_t RequiredSize()
+			{
+				return Size;
+			}
+
+			// create an unattached layout
+			Layout() = default;
+
+			/*!
+			* \fn	Layout(Client& memory, size_t offset = 0)
+			*
+			* \brief	Attach a layout to a shared memory. Does not touch the memory: fields keep whatever they hold
+			* 			(zero in a new shared memory).
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the layout is in. Must outlive the layout.
+			* \param	offset				(Optional) Offset of the layout in the shared memory, aligned to Alignment.
+			* Note: throws std::runtime_error if memory is too small or offset is misaligned.
+			*/
+			Layout(Client& memory, size_t offset = 0)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % Alignment) throw std::runtime_error("Layout offset is not aligned to the layout alignment!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < Size) throw std::runtime_error("Exceeded shared memory size!");
+				_Base = memory.GetBuffer() + offset;
+			}
+
+			// return if layout is attached to a shared memory
+			inline bool IsValid() const { return _Base != nullptr; }
+
+			// get a field by reference, in place in the shared memory.
+			// plain reads and writes are not synchronized with other processes, use Atomic() or a lock for that
+			template <typename Tag>
+			inline TypeOf<Tag>& Get() const
+			{
+				return *std::launder(reinterpret_cast<TypeOf<Tag>*>(_Base + OffsetOf<Tag>()));
+			}
+
+#ifdef __cpp_lib_atomic_ref
+			// get an atomic view (std::atomic_ref) of a field, to read and write it safely with other processes
+			template <typename Tag>
+			inline auto Atomic() const
+			{
+				using Type = TypeOf<Tag>;
+				static_assert(!std::is_array<Type>::value, "Arrays have no atomic view, take one of their elements instead");
+				static_assert(std::atomic_ref<Type>::is_always_lock_free, "Atomic fields must be lock free, or they don't work across processes");
+				static_assert(OffsetOf<Tag>() % std::atomic_ref<Type>::required_alignment == 0 && Alignment % std::atomic_ref<Type>::required_alignment == 0, "Field is not aligned enough for an atomic view, give it a larger alignment");
+				return std::atomic_ref<Type>(Get<Tag>());
+			}
+#endif
+
+			// get pointer to the start of the layout
+			inline char* GetBase() const { return _Base; }
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\Metrics.h::
+
+/*!
+* \file	Source\SharedMemory\Metrics.h.
+*
+* \brief	Named counters, gauges and histograms in a shared memory, updated by workers and read by an external scraper.
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	MetricType
+		*
+		* \brief	Kinds of metrics in a metrics registry.
+		*/
+		enum class MetricType : uint32_t
+		{
+			// monotonic count of events, summed over all per-CPU slots
+			Counter = 1,
+
+			// value that goes up and down, last write wins
+			Gauge = 2,
+
+			// count of observed values per bucket, plus their sum
+			Histogram = 3,
+		};
+
+		/*!
+		* \struct	__MetricsHeader
+		*
+		* \brief	Used internally, header of a metrics registry in shared memory.
+		* 			Followed by metric descriptors, then histogram bounds, then the per-CPU slots of values.
+		*/
+		struct __MetricsHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint32_t MaxMetrics;
+			uint32_t MaxWords;
+			uint32_t Slots;
+			uint32_t SlotWords;
+			alignas(_CacheLineSize) std::atomic<uint32_t> Count;
+			std::atomic<uint32_t> UsedWords;
+
+			// registration lock: pid of the process registering a metric, 0 if free
+			std::atomic<uint32_t> Lock;
+		};
+
+		/*!
+		* \struct	__MetricDescriptor
+		*
+		* \brief	Used internally, name and place of a metric. Type is 0 until the metric is fully registered.
+		*/
+		struct __MetricDescriptor
+		{
+			std::atomic<uint32_t> Type;
+			uint32_t Index;
+			uint32_t Words;
+			uint32_t Reserved;
+			char Name[48];
+		};
+
+		static_assert(sizeof(__MetricDescriptor) == 64, "Metric descriptors must take one cache line");
+
+		/*!
+		* \fn	inline uint32_t _CurrentCpu()
+		*
+		* \brief	Used internally, get the CPU the calling thread runs on. Cached per thread and refreshed every
+		* 			64 calls, since it only picks a slot to avoid contention: being stale after a migration is harmless.
+		*
+		* \date		10/19/2026
+		*/
+		inline uint32_t _CurrentCpu()
+		{
+			thread_local uint32_t cpu = 0;
+			thread_local uint32_t calls = 0;
+			if ((calls++ & 63) == 0)
+			{
+#ifdef _WIN32
+				cpu = (uint32_t)GetCurrentProcessorNumber();
+#else
+				int current = sched_getcpu();
+				cpu = current < 0 ? 0 : (uint32_t)current;
+#endif
+			}
+			return cpu;
+		}
+
+		/*!
+		* \struct	MetricValue
+		*
+		* \brief	A metric as read by Metrics::Scrape.
+		*
+		* \date		10/19/2026
+		*/
+		struct MetricValue
+		{
+			std::string Name;
+			MetricType Type;
+
+			// counter total, gauge value, or histogram count of observations
+			int64_t Value = 0;
+
+			// histograms only: sum of observed values, bucket upper bounds (inclusive), and count per bucket.
+			// Buckets has one more entry than Bounds, for values above the last bound
+			uint64_t Sum = 0;
+			std::vector<uint64_t> Bounds;
+			std::vector<uint64_t> Buckets;
+		};
+
+		/*!
+		* \class	Metrics
+		*
+		* \brief	A registry of named metrics in a shared memory. Worker processes register metrics by name (getting the
+		* 			same metric if it already exists) and update them through small handles; a scraper process connects to
+		* 			the same memory and reads them all, with no agent in the workers.
+		* 			Counters and histograms are split into per-CPU slots, each on its own cache lines, so concurrent
+		* 			updates from many cores never fight over a line; updates are single relaxed atomic adds, and the
+		* 			scraper sums the slots. Gauges have a single value.
+		*
+		* \date		10/19/2026
+		*/
+		class Metrics
+		{
+		private:
+
+			// magic value marking an initialized registry
+			static const uint64_t _Magic = 0x4a5553544d455452ULL;
+
+			// max slots, and max histogram bounds
+			static const size_t _MaxSlots = 256;
+			static const size_t _MaxBounds = 64;
+
+			__MetricsHeader* _Header = nullptr;
+			__MetricDescriptor* _Descriptors = nullptr;
+			uint64_t* _Bounds = nullptr;
+			std::atomic<uint64_t>* _Values = nullptr;
+
+			// default slots: a power of 2 at least the number of CPUs
+			static inline size_t _DefaultSlots()
+			{
+				size_t slots = 1;
+				while (slots < std::thread::hardware_concurrency() && slots < _MaxSlots) slots *= 2;
+				return slots;
+			}
+
+			// bytes of each region
+			static inline size_t _DescriptorsSize(size_t maxMetrics) { return maxMetrics * sizeof(__MetricDescriptor); }
+			static inline size_t _BoundsSize(size_t maxWords) { return (maxWords * sizeof(uint64_t) + _CacheLineSize - 1) / _CacheLineSize * _CacheLineSize; }
+			static inline size_t _SlotWords(size_t maxWords) { return (maxWords + 7) / 8 * 8; }
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t maxMetrics, size_t maxWords, size_t slots)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Metrics offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__MetricsHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__MetricsHeader* header = (__MetricsHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain metrics!");
+					maxMetrics = header->MaxMetrics;
+					maxWords = header->MaxWords;
+					slots = header->Slots;
+				}
+				if (memory.GetSize() - offset < RequiredSize(maxMetrics, maxWords, slots)) throw std::runtime_error("Exceeded shared memory size!");
+
+				char* base = (char*)(header + 1);
+				_Descriptors = (__MetricDescriptor*)base;
+				_Bounds = (uint64_t*)(base + _DescriptorsSize(maxMetrics));
+				_Values = (std::atomic<uint64_t>*)(base + _DescriptorsSize(maxMetrics) + _BoundsSize(maxWords));
+				if (create)
+				{
+					new (header) __MetricsHeader();
+					header->MaxMetrics = (uint32_t)maxMetrics;
+					header->MaxWords = (uint32_t)maxWords;
+					header->Slots = (uint32_t)slots;
+					header->SlotWords = (uint32_t)_SlotWords(maxWords);
+					for (size_t i = 0; i < maxMetrics; ++i) new (_Descriptors + i) __MetricDescriptor();
+					memset((void*)_Bounds, 0, _BoundsSize(maxWords));
+					for (size_t i = 0; i < slots * _SlotWords(maxWords); ++i) new (_Values + i) std::atomic<uint64_t>(0);
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+			}
+
+			// find a registered metric by name, or null
+			const __MetricDescriptor* _Find(const std::string& name) const
+			{
+				uint32_t count = _Header->Count.load(std::memory_order_acquire);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const __MetricDescriptor& descriptor = _Descriptors[i];
+					if (descriptor.Type.load(std::memory_order_acquire) != 0 && strncmp(descriptor.Name, name.c_str(), sizeof(descriptor.Name)) == 0) return &descriptor;
+				}
+				return nullptr;
+			}
+
+			// get a metric, registering it if it is new. registering is rare, so it takes a lock
+			const __MetricDescriptor* _Register(const std::string& name, MetricType type, const std::vector<uint64_t>& bounds)
+			{
+				if (!IsValid()) throw std::runtime_error("Metrics are not valid!");
+				if (name.empty() || name.size() >= sizeof(__MetricDescriptor::Name)) throw std::runtime_error("Metric name must be 1 to 47 characters!");
+				uint32_t words = type == MetricType::Histogram ? (uint32_t)bounds.size() + 2 : 1;
+
+				const __MetricDescriptor* descriptor = _Find(name);
+				if (!descriptor)
+				{
+					// the lock holds the owner's pid, so one that died while registering is taken over. that is safe:
+					// a registration publishes the new count last, so one cut short is redone
+					_LockOwned(_Header->Lock);
+					descriptor = _Find(name);
+					uint32_t count = _Header->Count.load(std::memory_order_relaxed);
+					uint32_t used = _Header->UsedWords.load(std::memory_order_relaxed);
+					if (!descriptor && count < _Header->MaxMetrics && words <= _Header->MaxWords - used)
+					{
+						__MetricDescriptor* created = _Descriptors + count;
+						memcpy(created->Name, name.c_str(), name.size() + 1);
+						created->Index = used;
+						created->Words = words;
+						for (size_t i = 0; i < bounds.size(); ++i) _Bounds[used + i] = bounds[i];
+						created->Type.store((uint32_t)type, std::memory_order_release);
+						_Header->UsedWords.store(used + words, std::memory_order_relaxed);
+						_Header->Count.store(count + 1, std::memory_order_release);
+						descriptor = created;
+					}
+					_UnlockOwned(_Header->Lock);
+					if (!descriptor) throw std::runtime_error("Metrics registry is full!");
+				}
+				if (descriptor->Type.load(std::memory_order_relaxed) != (uint32_t)type || descriptor->Words != words ||
+					(bounds.size() && memcmp(_Bounds + descriptor->Index, bounds.data(), bounds.size() * sizeof(uint64_t)) != 0))
+				{
+					throw std::runtime_error("Metric already registered with a different type or buckets!");
+				}
+				return descriptor;
+			}
+
+			// sum a value word over all slots
+			uint64_t _Sum(uint32_t index) const
+			{
+				uint64_t sum = 0;
+				for (uint32_t slot = 0; slot < _Header->Slots; ++slot) sum += _Values[(size_t)slot * _Header->SlotWords + index].load(std::memory_order_relaxed);
+				return sum;
+			}
+
+		public:
+
+			/*!
+			* \class	Counter
+			*
+			* \brief	Handle to update a counter. Cheap to copy; keep it instead of looking the counter up by name.
+			*/
+			class Counter
+			{
+			private:
+				friend class Metrics;
+				std::atomic<uint64_t>* _Value = nullptr;
+				uint32_t _SlotWords = 0;
+				uint32_t _SlotMask = 0;
+
+			public:
+
+				// add to counter
+				inline void Add(uint64_t value = 1)
+				{
+					_Value[(size_t)(_CurrentCpu() & _SlotMask) * _SlotWords].fetch_add(value, std::memory_order_relaxed);
+				}
+
+				// add one to counter
+				inline void Increment() { Add(1); }
+
+				// return if handle refers to a counter
+				inline bool IsValid() const { return _Value != nullptr; }
+			};
+
+			/*!
+			* \class	Gauge
+			*
+			* \brief	Handle to update a gauge. Cheap to copy.
+			*/
+			class Gauge
+			{
+			private:
+				friend class Metrics;
+				std::atomic<uint64_t>* _Value = nullptr;
+
+			public:
+
+				// set gauge value
+				inline void Set(int64_t value) { _Value->store((uint64_t)value, std::memory_order_relaxed); }
+
+				// add to gauge value (negative to subtract)
+				inline void Add(int64_t value) { _Value->fetch_add((uint64_t)value, std::memory_order_relaxed); }
+
+				// get gauge value
+				inline int64_t Get() const { return (int64_t)_Value->load(std::memory_order_relaxed); }
+
+				// return if handle refers to a gauge
+				inline bool IsValid() const { return _Value != nullptr; }
+			};
+
+			/*!
+			* \class	Histogram
+			*
+			* \brief	Handle to record observations in a histogram. Cheap to copy.
+			*/
+			class Histogram
+			{
+			private:
+				friend class Metrics;
+				std::atomic<uint64_t>* _Values = nullptr;
+				const uint64_t* _Bounds = nullptr;
+				uint32_t _BoundsCount = 0;
+				uint32_t _SlotWords = 0;
+				uint32_t _SlotMask = 0;
+
+			public:
+
+				// record an observation: count it in the first bucket whose bound is >= value, and add it to the sum
+				inline void Observe(uint64_t value)
+				{
+					uint32_t bucket = 0;
+					while (bucket < _BoundsCount && value > _Bounds[bucket]) ++bucket;
+					std::atomic<uint64_t>* slot = _Values + (size_t)(_CurrentCpu() & _SlotMask) * _SlotWords;
+					slot[bucket].fetch_add(1, std::memory_order_relaxed);
+					slot[_BoundsCount + 1].fetch_add(value, std::memory_order_relaxed);
+				}
+
+				// return if handle refers to a histogram
+				inline bool IsValid() const { return _Values != nullptr; }
+			};
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			*
+			* \brief	Get how many bytes of shared memory a metrics registry needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	maxMetrics			Max number of metrics.
+			* \param	maxWords			Max value words of all metrics: 1 per counter or gauge, bounds + 2 per histogram.
+			* \param	slots				(Optional) Number of per-CPU slots, or 0 for the default (CPU count rounded up to a power of 2).
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			{
+				if (slots == 0) slots = _DefaultSlots();
+				return sizeof(__MetricsHeader) + _DescriptorsSize(maxMetrics) + _BoundsSize(maxWords) + slots * _SlotWords(maxWords) * sizeof(uint64_t);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			*
+			* \brief	Initialize a new, empty metrics registry in a shared memory. Only one process should create it,
+			* 			others Connect. The shared memory must outlive the registry and the handles taken from it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the registry in.
+			* \param	offset				Offset of the registry in the shared memory, aligned to 64 bytes.
+			* \param	maxMetrics			Max number of metrics.
+			* \param	maxWords			Max value words of all metrics: 1 per counter or gauge, bounds + 2 per histogram.
+			* \param	slots				(Optional) Number of per-CPU slots, a power of 2, or 0 for the default.
+			* 								Fewer slots than CPUs saves memory but lets some cores share a slot.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			{
+				if (slots == 0) slots = _DefaultSlots();
+				if (slots > _MaxSlots || (slots & (slots - 1))) throw std::runtime_error("Metrics slots must be a power of 2, at most 256!");
+				if (maxMetrics == 0 || maxWords == 0 || maxMetrics > UINT32_MAX || maxWords > UINT32_MAX) throw std::runtime_error("Invalid metrics capacity!");
+				_Attach(memory, offset, true, maxMetrics, maxWords, slots);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a metrics registry another process created, to register and update metrics or to scrape them.
+			* 			A scraper may map the memory read only (Options::ReadOnly).
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the registry is in.
+			* \param	offset				Offset of the registry in the shared memory.
+			* Note: throws std::runtime_error if there is no registry at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0, 0);
+			}
+
+			// return if registry is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get number of registered metrics
+			inline size_t GetCount() const { return _Header->Count.load(std::memory_order_acquire); }
+
+			/*!
+			* \fn	Counter GetCounter(const std::string& name)
+			*
+			* \brief	Get a counter by name, registering it if no process did yet.
+			*
+			* \date		10/19/2026
+			*
+			* \param	name				Metric name, up to 47 characters.
+			*
+			* \return	Handle to update the counter.
+			* Note: throws std::runtime_error if the registry is full or name is taken by another kind of metric.
+			*/
+			Counter GetCounter(const std::string& name)
+			{
+				const __MetricDescriptor* descriptor = _Register(name, MetricType::Counter, std::vector<uint64_t>());
+				Counter counter;
+				counter._Value = _Values + descriptor->Index;
+				counter._SlotWords = _Header->SlotWords;
+				counter._SlotMask = _Header->Slots - 1;
+				return counter;
+			}
+
+			/*!
+			* \fn	Gauge GetGauge(const std::string& name)
+			*
+			* \brief	Get a gauge by name, registering it if no process did yet.
+			*
+			* \date		10/19/2026
+			*
+			* \param	name				Metric name, up to 47 characters.
+			*
+			* \return	Handle to update the gauge.
+			* Note: throws std::runtime_error if the registry is full or name is taken by another kind of metric.
+			*/
+			Gauge GetGauge(const std::string& name)
+			{
+				const __MetricDescriptor* descriptor = _Register(name, MetricType::Gauge, std::vector<uint64_t>());
+				Gauge gauge;
+				gauge._Value = _Values + descriptor->Index;
+				return gauge;
+			}
+
+			/*!
+			* \fn	Histogram GetHistogram(const std::string& name, const std::vector<uint64_t>& bounds)
+			*
+			* \brief	Get a histogram by name, registering it if no process did yet.
+			*
+			* \date		10/19/2026
+			*
+			* \param	name				Metric name, up to 47 characters.
+			* \param	bounds				Bucket upper bounds (inclusive), ascending, up to 64. Values above the last bound
+			* 								are counted in an extra bucket. Must match the bounds it was registered with.
+			*
+			* \return	Handle to record observations.
+			* Note: throws std::runtime_error if the registry is full, bounds are invalid or name is taken by another metric.
+			*/
+			Histogram GetHistogram(const std::string& name, const std::vector<uint64_t>& bounds)
+			{
+				if (bounds.empty() || bounds.size() > _MaxBounds) throw std::runtime_error("Histogram must have 1 to 64 bounds!");
+				for (size_t i = 1; i < bounds.size(); ++i)
+				{
+					if (bounds[i] <= bounds[i - 1]) throw std::runtime_error("Histogram bounds must be ascending!");
+				}
+				const __MetricDescriptor* descriptor = _Register(name, MetricType::Histogram, bounds);
+				Histogram histogram;
+				histogram._Values = _Values + descriptor->Index;
+				histogram._Bounds = _Bounds + descriptor->Index;
+				histogram._BoundsCount = (uint32_t)bounds.size();
+				histogram._SlotWords = _Header->SlotWords;
+				histogram._SlotMask = _Header->Slots - 1;
+				return histogram;
+			}
+
+			/*!
+			* \fn	std::vector<MetricValue> Scrape() const
+			*
+			* \brief	Read all metrics, summing their per-CPU slots. Does not stop writers, so values of different
+			* 			metrics (or a histogram's buckets and sum) may be a few updates apart.
+			*
+			* \date		10/19/2026
+			*
+			* \return	All registered metrics, in registration order.
+			*/
+			std::vector<MetricValue> Scrape() const
+			{
+				std::vector<MetricValue> values;
+				uint32_t count = _Header->Count.load(std::memory_order_acquire);
+				values.reserve(count);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const __MetricDescriptor& descriptor = _Descriptors[i];
+					MetricValue value;
+					value.Name.assign(descriptor.Name, strnlen(descriptor.Name, sizeof(descriptor.Name)));
+					value.Type = (MetricType)descriptor.Type.load(std::memory_order_acquire);
+					if (value.Type == MetricType::Histogram)
+					{
+						uint32_t buckets = descriptor.Words - 1;
+						value.Bounds.assign(_Bounds + descriptor.Index, _Bounds + descriptor.Index + buckets - 1);
+						value.Buckets.resize(buckets);
+						for (uint32_t bucket = 0; bucket < buckets; ++bucket)
+						{
+							value.Buckets[bucket] = _Sum(descriptor.Index + bucket);
+							value.Value += (int64_t)value.Buckets[bucket];
+						}
+						value.Sum = _Sum(descriptor.Index + buckets);
+					}
+					else if (value.Type == MetricType::Gauge)
+					{
+						value.Value = (int64_t)_Values[descriptor.Index].load(std::memory_order_relaxed);
+					}
+					else
+					{
+						value.Value = (int64_t)_Sum(descriptor.Index);
+					}
+					values.push_back(std::move(value));
+				}
+				return values;
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\MpmcQueue.h::
+
+/*!
+* \file	Source\SharedMemory\MpmcQueue.h.
+*
+* \brief	Bounded lock-free multi producer / multi consumer queue inside a shared memory.
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	__MpmcQueueHeader
+		*
+		* \brief	Used internally, header of a queue in shared memory. Slots follow right after it.
+		*/
+		struct __MpmcQueueHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			uint64_t SlotSize;
+			alignas(_CacheLineSize) std::atomic<uint64_t> EnqueuePosition;
+			alignas(_CacheLineSize) std::atomic<uint64_t> DequeuePosition;
+		};
+
+		/*!
+		* \struct	__MpmcSlot
+		*
+		* \brief	Used internally, slot header. Sequence tells whose turn it is: equal to the slot position when free
+		* 			for a producer, position + 1 when holding data for a consumer. Data follows the header.
+		*/
+		struct __MpmcSlot
+		{
+			std::atomic<uint64_t> Sequence;
+			uint64_t Size;
+		};
+
+		/*!
+		* \class	MpmcQueue
+		*
+		* \brief	A bounded queue in shared memory that any number of processes can push to and pop from.
+		* 			Uses a sequence number per slot (Dmitry Vyukov's design): producers and consumers claim positions
+		* 			with a CAS on their own counter and then only touch their slot, so there are no locks and no pointers.
+		* 			Slots have a fixed max size and are cache line aligned. To pass bigger data, push offsets
+		* 			into another part of the shared memory (for example an Arena).
+		*
+		* \date		10/19/2026
+		*/
+		class MpmcQueue
+		{
+		private:
+
+			// magic value marking an initialized queue
+			static const uint64_t _Magic = 0x4a5553544d504d43ULL;
+
+			__MpmcQueueHeader* _Header = nullptr;
+			char* _Slots = nullptr;
+			uint64_t _Mask = 0;
+			uint64_t _SlotSize = 0;
+			uint64_t _Stride = 0;
+
+			// get slot stride for a slot size
+			static inline uint64_t _StrideFor(size_t slotSize)
+			{
+				return (sizeof(__MpmcSlot) + slotSize + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1);
+			}
+
+			// get slot by position
+			inline __MpmcSlot* _Slot(uint64_t position) const
+			{
+				return (__MpmcSlot*)(_Slots + (position & _Mask) * _Stride);
+			}
+
+			// pop an item into a buffer of bufferSize bytes
+			bool _TryPop(void* data, size_t bufferSize, size_t& size)
+			{
+				uint64_t position = _Header->DequeuePosition.load(std::memory_order_relaxed);
+				__MpmcSlot* slot;
+				while (true)
+				{
+					slot = _Slot(position);
+					uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+					int64_t difference = (int64_t)(sequence - (position + 1));
+					if (difference == 0)
+					{
+						if (_Header->DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = _Header->DequeuePosition.load(std::memory_order_relaxed);
+					}
+				}
+				size = (size_t)slot->Size;
+				memcpy(data, (char*)slot + sizeof(__MpmcSlot), size < bufferSize ? size : bufferSize);
+				slot->Sequence.store(position + _Mask + 1, std::memory_order_release);
+				return true;
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity, size_t slotSize)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Queue offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__MpmcQueueHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__MpmcQueueHeader* header = (__MpmcQueueHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a queue!");
+					capacity = (size_t)header->Capacity;
+					slotSize = (size_t)header->SlotSize;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity, slotSize)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Header = header;
+				_Slots = (char*)header + sizeof(__MpmcQueueHeader);
+				_Mask = capacity - 1;
+				_SlotSize = slotSize;
+				_Stride = _StrideFor(slotSize);
+				if (create)
+				{
+					new (header) __MpmcQueueHeader();
+					header->Capacity = capacity;
+					header->SlotSize = slotSize;
+					for (uint64_t i = 0; i < capacity; ++i)
+					{
+						__MpmcSlot* slot = new (_Slot(i)) __MpmcSlot();
+						slot->Sequence.store(i, std::memory_order_relaxed);
+					}
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity, size_t slotSize)
+			*
+			* \brief	Get how many bytes of shared memory a queue needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Number of slots.
+			* \param	slotSize			Max bytes per item.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity, size_t slotSize)
+			{
+				return sizeof(__MpmcQueueHeader) + capacity * (size_t)_StrideFor(slotSize);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize)
+			*
+			* \brief	Initialize a new, empty queue in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the queue.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the queue in.
+			* \param	offset				Offset of the queue in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Number of slots. Must be a power of 2, at least 2.
+			* \param	slotSize			Max bytes per item.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1))) throw std::runtime_error("Queue capacity must be a power of 2, at least 2!");
+				if (slotSize == 0) throw std::runtime_error("Queue slot size must not be 0!");
+				_Attach(memory, offset, true, capacity, slotSize);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a queue another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the queue is in.
+			* \param	offset				Offset of the queue in the shared memory.
+			* Note: throws std::runtime_error if there is no queue at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0);
+			}
+
+			// return if queue is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get number of slots
+			inline size_t GetCapacity() const { return (size_t)(_Mask + 1); }
+
+			// get max bytes per item
+			inline size_t GetSlotSize() const { return (size_t)_SlotSize; }
+
+			/*!
+			* \fn	bool TryPush(const void* data, size_t size)
+			*
+			* \brief	Push an item, if there is a free slot.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Item data.
+			* \param	size 				Item size, at most slot size.
+			*
+			* \return	False if queue is full.
+			*/
+			bool TryPush(const void* data, size_t size)
+			{
+				if (size > _SlotSize) throw std::runtime_error("Item is too big for queue slot!");
+				uint64_t position = _Header->EnqueuePosition.load(std::memory_order_relaxed);
+				__MpmcSlot* slot;
+				while (true)
+				{
+					slot = _Slot(position);
+					uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+					int64_t difference = (int64_t)(sequence - position);
+					if (difference == 0)
+					{
+						if (_Header->EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = _Header->EnqueuePosition.load(std::memory_order_relaxed);
+					}
+				}
+				memcpy((char*)slot + sizeof(__MpmcSlot), data, size);
+				slot->Size = size;
+				slot->Sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+
+			/*!
+			* \fn	bool TryPop(void* data, size_t& size)
+			*
+			* \brief	Pop an item, if there is one.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Buffer to copy item into, at least slot size bytes.
+			* \param	size 				Item size.
+			*
+			* \return	False if queue is empty.
+			*/
+			bool TryPop(void* data, size_t& size)
+			{
+				return _TryPop(data, (size_t)_SlotSize, size);
+			}
+
+			// push a trivially copyable value
+			template <typename T>
+			inline bool TryPush(const T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Queue items must be trivially copyable");
+				return TryPush(&value, sizeof(T));
+			}
+
+			// pop a trivially copyable value. item should have been pushed with the same type
+			template <typename T>
+			inline bool TryPop(T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Queue items must be trivially copyable");
+				size_t size;
+				return _TryPop(&value, sizeof(T), size);
+			}
+
+			// get approximate number of items in queue
+			inline size_t GetCount() const
+			{
+				uint64_t dequeue = _Header->DequeuePosition.load(std::memory_order_relaxed);
+				uint64_t enqueue = _Header->EnqueuePosition.load(std::memory_order_relaxed);
+				return enqueue > dequeue ? (size_t)(enqueue - dequeue) : 0;
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\Mutex.h::
+
+/*!
+* \file	Source\SharedMemory\Mutex.h.
+*
+* \brief	Cross-process mutex and reader-writer lock placed inside a shared memory, that survive their holder crashing.
+*/
+// #pragma once
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+// #include "Futex.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	LockStatistics
+		*
+		* \brief	Contention counters of a Mutex or SharedMutex, for profiling. Shared by all processes using the lock.
+		*
+		* \date		10/19/2026
+		*/
+		struct LockStatistics
+		{
+			// times the lock was taken exclusively / shared
+			uint64_t Acquisitions = 0;
+			uint64_t SharedAcquisitions = 0;
+
+			// times taking it had to wait, and total time spent waiting
+			uint64_t Contended = 0;
+			uint64_t WaitNanoseconds = 0;
+
+			// times a holder was found dead and the lock was recovered
+			uint64_t OwnerDeaths = 0;
+		};
+
+		/*!
+		* \struct	__LockCounters
+		*
+		* \brief	Used internally, contention counters in shared memory.
+		*/
+		struct __LockCounters
+		{
+			std::atomic<uint64_t> Acquisitions;
+			std::atomic<uint64_t> Contended;
+			std::atomic<uint64_t> WaitNanoseconds;
+			std::atomic<uint64_t> OwnerDeaths;
+		};
+
+		// how often waiters wake up to check if the holder died, in microseconds
+		const int64_t _OwnerCheckMicroseconds = 10000;
+
+		/*!
+		* \struct	__MutexHeader
+		*
+		* \brief	Used internally, a mutex in shared memory.
+		* 			On linux it is a robust, process shared pthread mutex; on windows, a word holding the owner pid.
+		*/
+		struct __MutexHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+#ifdef _WIN32
+			std::atomic<uint32_t> Owner;
+#else
+			pthread_mutex_t Mutex;
+#endif
+			alignas(_CacheLineSize) __LockCounters Counters;
+		};
+
+		/*!
+		* \class	Mutex
+		*
+		* \brief	A mutex in shared memory, to guard a region of it across processes without file locks.
+		* 			Taking a free mutex is a single atomic instruction with no syscall; waiters sleep on a futex.
+		* 			If a holder dies, the kernel hands the mutex to the next waiter (robust futex), which runs the
+		* 			handler set with OnOwnerDied to repair the guarded data before carrying on.
+		* 			Not recursive. Also usable with std::lock_guard / std::unique_lock.
+		*
+		* \date		10/19/2026
+		*/
+		class Mutex
+		{
+		private:
+
+			// magic value marking an initialized mutex
+			static const uint64_t _Magic = 0x4a5553544d555458ULL;
+
+			__MutexHeader* _Header = nullptr;
+			std::function<void()> _OwnerDied;
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Mutex offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < RequiredSize()) throw std::runtime_error("Exceeded shared memory size!");
+				__MutexHeader* header = (__MutexHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __MutexHeader();
+#ifdef _WIN32
+					header->Owner.store(0, std::memory_order_relaxed);
+#else
+					pthread_mutexattr_t attributes;
+					pthread_mutexattr_init(&attributes);
+					pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+					pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+					int error = pthread_mutex_init(&header->Mutex, &attributes);
+					pthread_mutexattr_destroy(&attributes);
+					if (error != 0) throw std::runtime_error("Failed to initialize mutex!");
+#endif
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				else if (header->Magic.load(std::memory_order_acquire) != _Magic)
+				{
+					throw std::runtime_error("Shared memory does not contain a mutex!");
+				}
+				_Header = header;
+			}
+
+			// take over from a dead holder: mark the mutex usable again and let the caller repair the data
+			void _Recover()
+			{
+#ifndef _WIN32
+				pthread_mutex_consistent(&_Header->Mutex);
+#endif
+				_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+				if (_OwnerDied) _OwnerDied();
+			}
+
+			// try once, return 1 if taken, 2 if taken from a dead holder, 0 if busy
+			int _TryLock(bool checkOwner = true)
+			{
+#ifdef _WIN32
+				uint32_t owner = 0;
+				uint32_t self = (uint32_t)_CurrentProcessId();
+				if (_Header->Owner.compare_exchange_strong(owner, self, std::memory_order_acquire)) return 1;
+				if (checkOwner && _IsProcessDead((int32_t)owner) && _Header->Owner.compare_exchange_strong(owner, self, std::memory_order_acquire)) return 2;
+				return 0;
+#else
+				(void)checkOwner;
+				int error = pthread_mutex_trylock(&_Header->Mutex);
+				if (error == 0) return 1;
+				if (error == EOWNERDEAD) return 2;
+				if (error == EBUSY) return 0;
+				throw std::runtime_error("Failed to lock mutex!");
+#endif
+			}
+
+		public:
+
+			// get how many bytes of shared memory a mutex needs
+			static inline size_t RequiredSize()
+			{
+				return sizeof(__MutexHeader);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset)
+			*
+			* \brief	Initialize a new, unlocked mutex in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the mutex.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the mutex in.
+			* \param	offset				Offset of the mutex in the shared memory, aligned to 64 bytes.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, true);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a mutex another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the mutex is in.
+			* \param	offset				Offset of the mutex in the shared memory.
+			* Note: throws std::runtime_error if there is no mutex at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false);
+			}
+
+			// return if mutex is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// set a function to run, holding the mutex, when taking it from a holder that died while holding it.
+			// use it to repair or reset the data the mutex guards, which may have been left half updated
+			inline void OnOwnerDied(std::function<void()> handler) { _OwnerDied = std::move(handler); }
+
+			/*!
+			* \fn	void Lock()
+			*
+			* \brief	Take the mutex, waiting for it if needed. If the holder died, recovers it (see OnOwnerDied).
+			*
+			* \date		10/19/2026
+			*/
+			void Lock()
+			{
+				int taken = _TryLock();
+				if (taken == 0)
+				{
+					auto start = std::chrono::steady_clock::now();
+#ifdef _WIN32
+					bool timedOut = false;
+					while ((taken = _TryLock(timedOut)) == 0)
+					{
+						uint32_t owner = _Header->Owner.load(std::memory_order_relaxed);
+						timedOut = owner != 0 && !WaitOnAddress(&_Header->Owner, owner, _OwnerCheckMicroseconds);
+					}
+#else
+					int error = pthread_mutex_lock(&_Header->Mutex);
+					if (error != 0 && error != EOWNERDEAD) throw std::runtime_error("Failed to lock mutex!");
+					taken = error == EOWNERDEAD ? 2 : 1;
+#endif
+					_Header->Counters.Contended.fetch_add(1, std::memory_order_relaxed);
+					_Header->Counters.WaitNanoseconds.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+				}
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				if (taken == 2) _Recover();
+			}
+
+			// take the mutex if it is free (or its holder died), without waiting
+			bool TryLock()
+			{
+				int taken = _TryLock();
+				if (taken == 0) return false;
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				if (taken == 2) _Recover();
+				return true;
+			}
+
+			// release the mutex
+			void Unlock()
+			{
+#ifdef _WIN32
+				_Header->Owner.store(0, std::memory_order_release);
+#else
+				pthread_mutex_unlock(&_Header->Mutex);
+#endif
+			}
+
+			// std::lock_guard / std::unique_lock interface
+			inline void lock() { Lock(); }
+			inline bool try_lock() { return TryLock(); }
+			inline void unlock() { Unlock(); }
+
+			// get contention counters
+			LockStatistics GetStatistics() const
+			{
+				LockStatistics statistics;
+				statistics.Acquisitions = _Header->Counters.Acquisitions.load(std::memory_order_relaxed);
+				statistics.Contended = _Header->Counters.Contended.load(std::memory_order_relaxed);
+				statistics.WaitNanoseconds = _Header->Counters.WaitNanoseconds.load(std::memory_order_relaxed);
+				statistics.OwnerDeaths = _Header->Counters.OwnerDeaths.load(std::memory_order_relaxed);
+				return statistics;
+			}
+		};
+
+		/*!
+		* \struct	__SharedMutexHeader
+		*
+		* \brief	Used internally, header of a reader-writer lock in shared memory. Reader slots follow right after it.
+		* 			Writer holds the pid of the process holding it exclusively, or 0. Repair is set while data a dead
+		* 			writer left is waiting for an OnOwnerDied handler.
+		*/
+		struct __SharedMutexHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t SlotsCount;
+			alignas(_CacheLineSize) std::atomic<uint32_t> Writer;
+			std::atomic<uint32_t> Waiters;
+			std::atomic<uint32_t> Repair;
+			alignas(_CacheLineSize) __LockCounters Counters;
+		};
+
+		/*!
+		* \struct	__SharedMutexSlot
+		*
+		* \brief	Used internally, a reader slot: how many threads of process Pid hold the lock shared.
+		*/
+		struct __SharedMutexSlot
+		{
+			alignas(_CacheLineSize) std::atomic<uint32_t> Pid;
+			std::atomic<uint32_t> Readers;
+			std::atomic<uint64_t> Acquisitions;
+			std::atomic<uint64_t> Contended;
+			std::atomic<uint64_t> WaitNanoseconds;
+		};
+
+		/*!
+		* \class	SharedMutex
+		*
+		* \brief	A reader-writer lock in shared memory. Every process gets its own reader slot, on its own cache line,
+		* 			so readers in different processes never write to a common line: taking it shared when no writer is
+		* 			around is one atomic add on the process's slot, with no syscall. A writer announces itself first,
+		* 			so new readers step aside, then waits for all slots to drain (writers are preferred).
+		* 			Holders that die are detected by pid: a dead writer's lock is taken over (see OnOwnerDied) and a
+		* 			dead process's shared holds are dropped. A reader that finds the writer dead takes the lock
+		* 			exclusively to recover it too, so readers never carry on before the data was repaired.
+		* 			Each process uses its own SharedMutex object. Not recursive, and a thread holding it shared must
+		* 			not take it exclusively. Also usable with std::unique_lock / std::shared_lock.
+		*
+		* \date		10/19/2026
+		*/
+		class SharedMutex
+		{
+		private:
+
+			// magic value marking an initialized lock
+			static const uint64_t _Magic = 0x4a55535452574c4bULL;
+
+			__SharedMutexHeader* _Header = nullptr;
+			__SharedMutexSlot* _Slots = nullptr;
+			__SharedMutexSlot* _Slot = nullptr;
+			uint32_t _Pid = 0;
+			std::function<void()> _OwnerDied;
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t slots)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Shared mutex offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__SharedMutexHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__SharedMutexHeader* header = (__SharedMutexHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a shared mutex!");
+					slots = (size_t)header->SlotsCount;
+				}
+				if (memory.GetSize() - offset < RequiredSize(slots)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Slots = (__SharedMutexSlot*)(header + 1);
+				if (create)
+				{
+					new (header) __SharedMutexHeader();
+					header->SlotsCount = slots;
+					for (size_t i = 0; i < slots; ++i) new (_Slots + i) __SharedMutexSlot();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+				_Pid = (uint32_t)_CurrentProcessId();
+			}
+
+			// get this process's reader slot, claiming a free one (or one of a dead process) the first time
+			__SharedMutexSlot* _ReaderSlot()
+			{
+				if (_Slot) return _Slot;
+				uint32_t self = _Pid;
+				for (int pass = 0; pass < 3; ++pass)
+				{
+					for (size_t i = 0; i < _Header->SlotsCount; ++i)
+					{
+						__SharedMutexSlot* slot = _Slots + i;
+						uint32_t pid = slot->Pid.load(std::memory_order_acquire);
+						if (pass == 0 && pid != self) continue;
+						if (pass == 1 && pid != 0) continue;
+						if (pass == 2 && !_IsProcessDead((int32_t)pid)) continue;
+						if (pid == self || slot->Pid.compare_exchange_strong(pid, self, std::memory_order_acq_rel))
+						{
+							if (pass == 2) _DropReaders(slot);
+							_Slot = slot;
+							return slot;
+						}
+					}
+				}
+				throw std::runtime_error("No free reader slot in shared mutex!");
+			}
+
+			// drop shared holds a dead process left in a slot we just took over
+			void _DropReaders(__SharedMutexSlot* slot)
+			{
+				if (slot->Readers.exchange(0, std::memory_order_acq_rel) != 0)
+				{
+					_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+					if (_Header->Writer.load(std::memory_order_seq_cst) != 0) WakeAll(&slot->Readers);
+				}
+			}
+
+			// wait while a writer holds the lock. takes over from a dead writer and returns true if it did
+			bool _WaitWriter(uint32_t owner, uint32_t self)
+			{
+				_Header->Waiters.fetch_add(1, std::memory_order_seq_cst);
+				bool timedOut = !WaitOnAddress(&_Header->Writer, owner, _OwnerCheckMicroseconds);
+				_Header->Waiters.fetch_sub(1, std::memory_order_relaxed);
+				if (timedOut && _IsProcessDead((int32_t)owner))
+				{
+					// the new owner is us (writer) or nobody (reader)
+					if (_Header->Writer.compare_exchange_strong(owner, self, std::memory_order_acq_rel))
+					{
+						_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// holding the writer, wait for readers to drain, dropping the holds of dead processes
+			void _WaitReaders(bool& contended, std::chrono::steady_clock::time_point& start)
+			{
+				for (size_t i = 0; i < _Header->SlotsCount; ++i)
+				{
+					__SharedMutexSlot* slot = _Slots + i;
+					uint32_t readers;
+					while ((readers = slot->Readers.load(std::memory_order_seq_cst)) != 0)
+					{
+						if (!contended)
+						{
+							contended = true;
+							start = std::chrono::steady_clock::now();
+						}
+						if (WaitOnAddress(&slot->Readers, readers, _OwnerCheckMicroseconds)) continue;
+						uint32_t pid = slot->Pid.load(std::memory_order_acquire);
+						if (_IsProcessDead((int32_t)pid) && slot->Readers.compare_exchange_strong(readers, 0, std::memory_order_acq_rel))
+						{
+							_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				}
+			}
+
+			// holding the lock exclusively, repair what a dead writer left: run our handler, or if we have none
+			// leave the repair to the next process taking the lock exclusively that has one
+			void _Repair(bool ownerDied)
+			{
+				if (!ownerDied && _Header->Repair.load(std::memory_order_relaxed) == 0) return;
+				if (!_OwnerDied)
+				{
+					_Header->Repair.store(1, std::memory_order_relaxed);
+					return;
+				}
+				_OwnerDied();
+				_Header->Repair.store(0, std::memory_order_relaxed);
+			}
+
+			// add how long we waited to a set of counters
+			static inline void _CountWait(std::atomic<uint64_t>& contended, std::atomic<uint64_t>& waitNanoseconds, std::chrono::steady_clock::time_point start)
+			{
+				contended.fetch_add(1, std::memory_order_relaxed);
+				waitNanoseconds.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t slots)
+			*
+			* \brief	Get how many bytes of shared memory a shared mutex needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	slots				Max number of processes taking it shared at the same time.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t slots)
+			{
+				return sizeof(__SharedMutexHeader) + slots * sizeof(__SharedMutexSlot);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t slots)
+			*
+			* \brief	Initialize a new, unlocked shared mutex in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the lock.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the lock in.
+			* \param	offset				Offset of the lock in the shared memory, aligned to 64 bytes.
+			* \param	slots				Max number of processes taking it shared. Slots of dead processes are reused.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t slots)
+			{
+				if (slots == 0) throw std::runtime_error("Shared mutex needs at least one reader slot!");
+				_Attach(memory, offset, true, slots);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a shared mutex another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the lock is in.
+			* \param	offset				Offset of the lock in the shared memory.
+			* Note: throws std::runtime_error if there is no shared mutex at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0);
+			}
+
+			// return if lock is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// set a function to run, holding the lock exclusively, when taking it from a writer that died while holding it.
+			// if the process that finds the dead writer has none, the next process taking the lock exclusively runs its own
+			inline void OnOwnerDied(std::function<void()> handler) { _OwnerDied = std::move(handler); }
+
+			/*!
+			* \fn	void Lock()
+			*
+			* \brief	Take the lock exclusively, waiting for the current writer and then for all readers to leave.
+			*
+			* \date		10/19/2026
+			*/
+			void Lock()
+			{
+				uint32_t self = _Pid;
+				bool contended = false, recovered = false;
+				auto start = std::chrono::steady_clock::time_point();
+
+				// announce ourselves as the writer, so new readers back off
+				while (true)
+				{
+					uint32_t owner = 0;
+					if (_Header->Writer.compare_exchange_strong(owner, self, std::memory_order_seq_cst)) break;
+					if (!contended)
+					{
+						contended = true;
+						start = std::chrono::steady_clock::now();
+					}
+					if (_WaitWriter(owner, self))
+					{
+						recovered = true;
+						break;
+					}
+				}
+
+				_WaitReaders(contended, start);
+				if (contended) _CountWait(_Header->Counters.Contended, _Header->Counters.WaitNanoseconds, start);
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				_Repair(recovered);
+			}
+
+			// take the lock exclusively if there is no writer and no reader, without waiting
+			bool TryLock()
+			{
+				uint32_t owner = 0;
+				if (!_Header->Writer.compare_exchange_strong(owner, _Pid, std::memory_order_seq_cst)) return false;
+				for (size_t i = 0; i < _Header->SlotsCount; ++i)
+				{
+					if (_Slots[i].Readers.load(std::memory_order_seq_cst) != 0)
+					{
+						Unlock();
+						return false;
+					}
+				}
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				_Repair(false);
+				return true;
+			}
+
+			// release the exclusive lock
+			void Unlock()
+			{
+				_Header->Writer.store(0, std::memory_order_seq_cst);
+				if (_Header->Waiters.load(std::memory_order_seq_cst) != 0) WakeAll(&_Header->Writer);
+			}
+
+			/*!
+			* \fn	void LockShared()
+			*
+			* \brief	Take the lock shared, waiting while a writer holds or waits for it.
+			*
+			* \date		10/19/2026
+			*/
+			void LockShared()
+			{
+				__SharedMutexSlot* slot = _ReaderSlot();
+				slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+				uint32_t owner = _Header->Writer.load(std::memory_order_seq_cst);
+				if (owner != 0)
+				{
+					// step aside until the writer is done. if it died we now hold the lock exclusively, and recover it
+					// like a writer would before letting readers in over what it left
+					auto start = std::chrono::steady_clock::now();
+					uint32_t self = _Pid;
+					do
+					{
+						UnlockShared();
+						if (_WaitWriter(owner, self))
+						{
+							bool contended = true;
+							_WaitReaders(contended, start);
+							_Repair(true);
+							Unlock();
+						}
+						slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+					} while ((owner = _Header->Writer.load(std::memory_order_seq_cst)) != 0);
+					_CountWait(slot->Contended, slot->WaitNanoseconds, start);
+				}
+				slot->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// take the lock shared if no writer holds or waits for it, without waiting
+			bool TryLockShared()
+			{
+				__SharedMutexSlot* slot = _ReaderSlot();
+				slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+				if (_Header->Writer.load(std::memory_order_seq_cst) != 0)
+				{
+					UnlockShared();
+					return false;
+				}
+				slot->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			// release a shared hold. wakes the writer if it waits for this slot to drain
+			void UnlockShared()
+			{
+				if (_Slot->Readers.fetch_sub(1, std::memory_order_seq_cst) == 1 && _Header->Writer.load(std::memory_order_seq_cst) != 0)
+				{
+					WakeAll(&_Slot->Readers);
+				}
+			}
+
+			// std::unique_lock / std::shared_lock interface
+			inline void lock() { Lock(); }
+			inline bool try_lock() { return TryLock(); }
+			inline void unlock() { Unlock(); }
+			inline void lock_shared() { LockShared(); }
+			inline bool try_lock_shared() { return TryLockShared(); }
+			inline void unlock_shared() { UnlockShared(); }
+
+			// get contention counters, summing all reader slots
+			LockStatistics GetStatistics() const
+			{
+				LockStatistics statistics;
+				statistics.Acquisitions = _Header->Counters.Acquisitions.load(std::memory_order_relaxed);
+				statistics.Contended = _Header->Counters.Contended.load(std::memory_order_relaxed);
+				statistics.WaitNanoseconds = _Header->Counters.WaitNanoseconds.load(std::memory_order_relaxed);
+				statistics.OwnerDeaths = _Header->Counters.OwnerDeaths.load(std::memory_order_relaxed);
+				for (size_t i = 0; i < _Header->SlotsCount; ++i)
+				{
+					statistics.SharedAcquisitions += _Slots[i].Acquisitions.load(std::memory_order_relaxed);
+					statistics.Contended += _Slots[i].Contended.load(std::memory_order_relaxed);
+					statistics.WaitNanoseconds += _Slots[i].WaitNanoseconds.load(std::memory_order_relaxed);
+				}
+				return statistics;
+			}
+		};
+	}
+}
+
+
+
+
+// ::SharedMemory\RpcChannel.h::
+
+/*!
+* \file	Source\SharedMemory\RpcChannel.h.
+*
+* \brief	Request / response messaging between processes through a shared memory, with futex wakeups.
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+// #include "Futex.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	__RpcHeader
+		*
+		* \brief	Used internally, header of an rpc channel in shared memory.
+		* 			Followed by the pending requests bitmask, the server event, and the client slots.
+		*/
+		struct __RpcHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t MaxClients;
+			uint64_t SlotSize;
+		};
+
+		/*!
+		* \struct	__RpcClientSlot
+		*
+		* \brief	Used internally, a client's state, followed by its request and response buffers.
+		* 			State is the word clients wait on for responses. Pid is the owner, 0 when the slot is free;
+		* 			a slot is taken by swapping the pid, so two processes can never both take it.
+		*/
+		struct __RpcClientSlot
+		{
+			alignas(_CacheLineSize) std::atomic<uint32_t> State;
+			std::atomic<uint32_t> ClientWaiting;
+			std::atomic<int32_t> Pid;
+			std::atomic<uint64_t> RequestSize;
+			std::atomic<uint64_t> ResponseSize;
+		};
+
+		/*!
+		* \class	RpcChannel
+		*
+		* \brief	Local request / response calls through a shared memory, as a faster alternative to loopback sockets.
+		* 			Every client registers its own pair of request and response slots, so clients never contend.
+		* 			Requests and responses are written and read in place (ReserveRequest, handler writes into the response),
+		* 			so payloads are not copied. One server thread serves all clients: clients flag their slot in a pending
+		* 			bitmask and notify the server through an Event, and the server wakes a client with a futex only
+		* 			if it stopped spinning and parked.
+		* 			Each process uses its own RpcChannel object, either to serve or to call (after Register).
+		*
+		* \date		10/19/2026
+		*/
+		class RpcChannel
+		{
+		private:
+
+			// magic value marking an initialized channel
+			static const uint64_t _Magic = 0x4a55535452504343ULL;
+
+			// client slot states
+			static const uint32_t _Free = 0;
+			static const uint32_t _Idle = 1;
+			static const uint32_t _Request = 2;
+			static const uint32_t _Response = 3;
+
+			// client left while its request was with the server; the server frees the slot once it answered
+			static const uint32_t _Abandoned = 4;
+
+			// response size telling the client the handler failed
+			static const uint64_t _Failed = (uint64_t)-1;
+
+			__RpcHeader* _Header = nullptr;
+			std::atomic<uint64_t>* _Pending = nullptr;
+			char* _Slots = nullptr;
+			uint64_t _Stride = 0;
+			uint64_t _BufferStride = 0;
+			Event _ServerEvent;
+
+			// client side: our slot and index, iterations to spin before parking, and if a timed out call is still pending
+			__RpcClientSlot* _Slot = nullptr;
+			uint64_t _Index = 0;
+			uint32_t _Spin = 2000;
+			bool _Outstanding = false;
+
+			// get number of pending bitmask words
+			static inline uint64_t _PendingWords(size_t maxClients)
+			{
+				return (maxClients + 63) / 64;
+			}
+
+			// get offset of server event from header
+			static inline size_t _EventOffset(size_t maxClients)
+			{
+				return sizeof(__RpcHeader) + (size_t)((_PendingWords(maxClients) * 8 + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1));
+			}
+
+			// get buffer stride for a slot size
+			static inline uint64_t _BufferStrideFor(size_t slotSize)
+			{
+				return (slotSize + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1);
+			}
+
+			inline __RpcClientSlot* _ClientSlot(uint64_t index) const
+			{
+				return (__RpcClientSlot*)(_Slots + index * _Stride);
+			}
+			static inline char* _RequestBuffer(__RpcClientSlot* slot)
+			{
+				return (char*)slot + sizeof(__RpcClientSlot);
+			}
+			inline char* _ResponseBuffer(__RpcClientSlot* slot) const
+			{
+				return (char*)slot + sizeof(__RpcClientSlot) + _BufferStride;
+			}
+
+			// free a slot nobody wants the answer of anymore. the pid is cleared only if a Register did not take the slot meanwhile
+			static inline void _Release(__RpcClientSlot* slot)
+			{
+				int32_t owner = slot->Pid.load(std::memory_order_relaxed);
+				slot->State.store(_Free, std::memory_order_release);
+				slot->Pid.compare_exchange_strong(owner, 0, std::memory_order_release);
+			}
+
+			// wait for the late response of a timed out call, and drop it. return false if still not answered
+			bool _Drain(int64_t timeoutMicroseconds)
+			{
+				if (_Outstanding && _WaitResponse(timeoutMicroseconds)) _Outstanding = false;
+				return !_Outstanding;
+			}
+
+			// wait for the response to our request. spins first, then parks on the state word
+			bool _WaitResponse(int64_t timeoutMicroseconds)
+			{
+				for (uint32_t i = 0; i < _Spin; ++i)
+				{
+					if (_Slot->State.load(std::memory_order_acquire) == _Response) return true;
+					_CpuRelax();
+				}
+
+				// announce we park before checking again; the server sets the state before checking for waiters
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+				_Slot->ClientWaiting.store(1, std::memory_order_seq_cst);
+				uint32_t state;
+				bool ret = true;
+				while ((state = _Slot->State.load(std::memory_order_seq_cst)) != _Response)
+				{
+					int64_t remaining = -1;
+					if (timeoutMicroseconds >= 0)
+					{
+						remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+						if (remaining <= 0) { ret = false; break; }
+					}
+					WaitOnAddress(&_Slot->State, state, remaining);
+				}
+				_Slot->ClientWaiting.store(0, std::memory_order_relaxed);
+				return ret;
+			}
+
+			// return if any client has a pending request
+			inline bool _HasPending() const
+			{
+				for (uint64_t i = 0; i < _PendingWords(_Header->MaxClients); ++i)
+				{
+					if (_Pending[i].load(std::memory_order_relaxed)) return true;
+				}
+				return false;
+			}
+
+			// answer one client request
+			template <typename Handler>
+			void _Answer(__RpcClientSlot* slot, Handler& handler)
+			{
+				uint64_t size = _Failed;
+				try
+				{
+					size = (uint64_t)handler((const void*)_RequestBuffer(slot), (size_t)slot->RequestSize.load(std::memory_order_relaxed),
+						(void*)_ResponseBuffer(slot), (size_t)_Header->SlotSize);
+					if (size > _Header->SlotSize) size = _Failed;
+				}
+				catch (...)
+				{
+					size = _Failed;
+				}
+				slot->ResponseSize.store(size, std::memory_order_relaxed);
+
+				// client abandoned the request while we handled it? nobody wants the answer, free the slot
+				uint32_t state = _Request;
+				if (!slot->State.compare_exchange_strong(state, _Response, std::memory_order_seq_cst))
+				{
+					_Release(slot);
+					return;
+				}
+				if (slot->ClientWaiting.load(std::memory_order_seq_cst)) Wake(&slot->State);
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t maxClients, size_t slotSize)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Rpc channel offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__RpcHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__RpcHeader* header = (__RpcHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain an rpc channel!");
+					maxClients = (size_t)header->MaxClients;
+					slotSize = (size_t)header->SlotSize;
+				}
+				if (memory.GetSize() - offset < RequiredSize(maxClients, slotSize)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Pending = (std::atomic<uint64_t>*)(header + 1);
+				_BufferStride = _BufferStrideFor(slotSize);
+				_Stride = sizeof(__RpcClientSlot) + 2 * _BufferStride;
+				_Slots = (char*)header + _EventOffset(maxClients) + Event::RequiredSize();
+				if (create)
+				{
+					new (header) __RpcHeader();
+					header->MaxClients = maxClients;
+					header->SlotSize = slotSize;
+					for (uint64_t i = 0; i < _PendingWords(maxClients); ++i) new (_Pending + i) std::atomic<uint64_t>(0);
+					_ServerEvent.CreateNew(memory, offset + _EventOffset(maxClients));
+					for (uint64_t i = 0; i < maxClients; ++i) new (_ClientSlot(i)) __RpcClientSlot();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				else
+				{
+					_ServerEvent.Connect(memory, offset + _EventOffset(maxClients));
+				}
+				_Header = header;
+				if (std::thread::hardware_concurrency() <= 1) _Spin = 0;
+			}
+
+		public:
+
+			RpcChannel() = default;
+
+			// clients own a slot, so channels can't be copied
+			RpcChannel(const RpcChannel&) = delete;
+			RpcChannel& operator=(const RpcChannel&) = delete;
+
+			~RpcChannel()
+			{
+				Unregister();
+			}
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t maxClients, size_t slotSize)
+			*
+			* \brief	Get how many bytes of shared memory an rpc channel needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	maxClients			Max clients registered at once.
+			* \param	slotSize			Max bytes per request and per response.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t maxClients, size_t slotSize)
+			{
+				return _EventOffset(maxClients) + Event::RequiredSize() + maxClients * (size_t)(sizeof(__RpcClientSlot) + 2 * _BufferStrideFor(slotSize));
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t maxClients, size_t slotSize)
+			*
+			* \brief	Initialize a new rpc channel in a shared memory. Usually done by the server, clients Connect.
+			* 			The shared memory must outlive the channel.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the channel in.
+			* \param	offset				Offset of the channel in the shared memory, aligned to 64 bytes.
+			* \param	maxClients			Max clients registered at once.
+			* \param	slotSize			Max bytes per request and per response.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t maxClients, size_t slotSize)
+			{
+				if (maxClients == 0 || slotSize == 0) throw std::runtime_error("Rpc channel max clients and slot size must not be 0!");
+				_Attach(memory, offset, true, maxClients, slotSize);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to an rpc channel another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the channel is in.
+			* \param	offset				Offset of the channel in the shared memory.
+			* Note: throws std::runtime_error if there is no rpc channel at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0);
+			}
+
+			// return if channel is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get max bytes per request and per response
+			inline size_t GetSlotSize() const { return (size_t)_Header->SlotSize; }
+
+			// set iterations clients spin waiting for a response before parking, 0 to park right away
+			inline void SetSpin(uint32_t spin) { _Spin = spin; _ServerEvent.SetSpin(spin); }
+
+			/*!
+			* \fn	bool Register()
+			*
+			* \brief	Take a client slot, to make calls with this object. Slots of dead client processes are reclaimed;
+			* 			if one died during a call, its slot is left to the server to free once it answered.
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if all client slots are taken.
+			*/
+			bool Register()
+			{
+				if (_Slot) return true;
+				int32_t self = _CurrentProcessId();
+				for (int pass = 0; pass < 2; ++pass)
+				{
+					for (uint64_t i = 0; i < _Header->MaxClients; ++i)
+					{
+						__RpcClientSlot* slot = _ClientSlot(i);
+						int32_t owner = slot->Pid.load(std::memory_order_acquire);
+						if (owner != 0 && !(pass == 1 && _IsProcessDead(owner))) continue;
+						uint32_t state = slot->State.load(std::memory_order_acquire);
+
+						// dead client's request may still be with the server, which would answer into the slot.
+						// the server frees it once it answered
+						if (owner != 0 && state == _Request)
+						{
+							slot->State.compare_exchange_strong(state, _Abandoned, std::memory_order_acq_rel);
+							continue;
+						}
+						if (state == _Abandoned || (owner == 0 && state != _Free)) continue;
+
+						// take the slot by swapping the pid we saw, then publish it as idle
+						if (!slot->Pid.compare_exchange_strong(owner, self, std::memory_order_acq_rel)) continue;
+						slot->ClientWaiting.store(0, std::memory_order_relaxed);
+						slot->State.store(_Idle, std::memory_order_release);
+						_Slot = slot;
+						_Index = i;
+						_Outstanding = false;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// release the client slot. if a timed out request is still with the server, the slot is left to it,
+			// and it frees the slot once it answered, so the late answer never lands in a slot someone else took
+			void Unregister()
+			{
+				if (!_Slot) return;
+				uint32_t state = _Request;
+				if (!_Outstanding || !_Slot->State.compare_exchange_strong(state, _Abandoned, std::memory_order_acq_rel))
+				{
+					_Slot->State.store(_Free, std::memory_order_relaxed);
+					_Slot->Pid.store(0, std::memory_order_release);
+				}
+				_Slot = nullptr;
+			}
+
+			/*!
+			* \fn	void* ReserveRequest(int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Get the request buffer to write the next request into (GetSlotSize() bytes). Registered clients only.
+			* 			If the last call timed out, first waits for its late response and drops it, since the server
+			* 			still reads the old request from this buffer until it answered.
+			*
+			* \date		10/19/2026
+			*
+			* \param	timeoutMicroseconds	(Optional) Max time to wait for a late response, or -1 to wait forever.
+			*
+			* \return	The request buffer.
+			* Note: throws std::runtime_error if the late response did not come in time.
+			*/
+			void* ReserveRequest(int64_t timeoutMicroseconds = -1)
+			{
+				if (!_Slot) throw std::runtime_error("Must register to call an rpc channel!");
+				if (!_Drain(timeoutMicroseconds)) throw std::runtime_error("Rpc server is still handling the timed out request!");
+				return _RequestBuffer(_Slot);
+			}
+
+			/*!
+			* \fn	bool Call(size_t requestSize, const void*& response, size_t& responseSize, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Send the request written into ReserveRequest() and wait for the response. Registered clients only.
+			*
+			* \date		10/19/2026
+			*
+			* \param	requestSize			Bytes of request written.
+			* \param	response			Set to the response, in place. Valid until the next call.
+			* \param	responseSize		Set to the response size.
+			* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+			*
+			* \return	False if timed out. The next ReserveRequest waits for the late response first, and drops it.
+			* Note: throws std::runtime_error if the server handler failed, or if the request was written without
+			* 		ReserveRequest after a timed out call.
+			*/
+			bool Call(size_t requestSize, const void*& response, size_t& responseSize, int64_t timeoutMicroseconds = -1)
+			{
+				if (!_Slot) throw std::runtime_error("Must register to call an rpc channel!");
+				if (requestSize > _Header->SlotSize) throw std::runtime_error("Request is too big for rpc slot!");
+				if (_Outstanding) throw std::runtime_error("Must ReserveRequest after a timed out rpc call!");
+
+				_Slot->RequestSize.store(requestSize, std::memory_order_relaxed);
+				_Slot->State.store(_Request, std::memory_order_release);
+				_Pending[_Index / 64].fetch_or((uint64_t)1 << (_Index % 64), std::memory_order_release);
+				_ServerEvent.NotifyOne();
+
+				if (!_WaitResponse(timeoutMicroseconds))
+				{
+					_Outstanding = true;
+					return false;
+				}
+				uint64_t size = _Slot->ResponseSize.load(std::memory_order_relaxed);
+				if (size == _Failed) throw std::runtime_error("Rpc server failed to handle request!");
+				response = _ResponseBuffer(_Slot);
+				responseSize = (size_t)size;
+				return true;
+			}
+
+			// copy a request in, call, and copy the response out. after a timed out call, waits for the late response
+			// (within the same timeout) before the request is copied in, and returns false if it did not come
+			bool Call(const void* request, size_t requestSize, std::string& response, int64_t timeoutMicroseconds = -1)
+			{
+				if (!_Slot) throw std::runtime_error("Must register to call an rpc channel!");
+				if (requestSize > GetSlotSize()) throw std::runtime_error("Request is too big for rpc slot!");
+				if (!_Drain(timeoutMicroseconds)) return false;
+				memcpy(ReserveRequest(), request, requestSize);
+				const void* data;
+				size_t size;
+				if (!Call(requestSize, data, size, timeoutMicroseconds)) return false;
+				response.assign((const char*)data, size);
+				return true;
+			}
+
+			/*!
+			* \fn	template <typename Handler> size_t Serve(Handler handler, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Answer all pending requests, waiting up to timeout for some if there are none. Server only,
+			* 			call it in a loop. Handler is called as handler(const void* request, size_t requestSize,
+			* 			void* response, size_t maxResponseSize) and returns the response size; it writes the response
+			* 			in place. If it throws (or returns more than max size), the client's Call throws.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Request handler.
+			* \param	timeoutMicroseconds	(Optional) Max time to wait for requests, or -1 to wait forever.
+			*
+			* \return	Number of requests answered.
+			*/
+			template <typename Handler>
+			size_t Serve(Handler handler, int64_t timeoutMicroseconds = -1)
+			{
+				if (!_HasPending() && !_ServerEvent.WaitFor([this]() { return _HasPending(); }, timeoutMicroseconds)) return 0;
+
+				size_t served = 0;
+				for (uint64_t word = 0; word < _PendingWords(_Header->MaxClients); ++word)
+				{
+					uint64_t bits = _Pending[word].exchange(0, std::memory_order_acquire);
+					while (bits)
+					{
+						int bit = 0;
+						while (!(bits & ((uint64_t)1 << bit))) ++bit;
+						bits &= ~((uint64_t)1 << bit);
+						__RpcClientSlot* slot = _ClientSlot(word * 64 + bit);
+						uint32_t state = slot->State.load(std::memory_order_acquire);
+
+						// abandoned before we got to it, free without handling
+						if (state == _Abandoned)
+						{
+							_Release(slot);
+							continue;
+						}
+						if (state != _Request) continue;
+						_Answer(slot, handler);
+						++served;
+					}
+				}
+				return served;
+			}
+		};
+	}
+}
 
-			} while (dwSize > 0);
 
-			// return response
-			return ret;
-		}
 
+
+// ::SharedMemory\Snapshot.h::
+
+/*!
+* \file	Source\SharedMemory\Snapshot.h.
+*
+* \brief	Publish a value from one writer to many readers through shared memory, without locks (seqlock).
+*/
+// #pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+// #include "SharedMemory.h"
+// #include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
 		/*!
-		* \fn	HttpResponse Send(std::string url, int port = 80)
-		*
-		* \brief	Send an Http request.
+		* \struct	__SnapshotHeader
 		*
-		* \author	Ronen Ness
-		* \date	10/19/2018
+		* \brief	Used internally, header of a snapshot in shared memory. Value words follow right after it.
+		* 			Sequence is odd while a write is in progress, and grows by 2 with every write.
+		*/
+		struct __SnapshotHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t ValueSize;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Sequence;
+		};
+
+		/*!
+		* \class	Snapshot
 		*
-		* \param	url 				Full url to send request to.
-		* \param	method				Request type (GET / POST / PUT /...)
-		* \param	content				(Optional) Content to send.
-		* \param	additionalHeaders	(Optional) Additional headers.
-		* \param	port				(Optional) Port to connect to.
+		* \brief	A value of a trivially copyable type T in shared memory, written by one process and read by many.
+		* 			Uses a seqlock: the writer bumps a sequence number before and after writing, and readers retry
+		* 			if it changed while they copied. Readers always get a consistent copy, never block the writer,
+		* 			and make no syscalls. The value is copied as atomic 64 bit words, so concurrent copies are well
+		* 			defined. Best for small to medium values that are read much more often than written.
+		* 			Only one process may write at a time.
 		*
-		* \return	A HttpResponse.
+		* \date		10/19/2026
 		*/
-		HttpResponse Send(const std::string& url,
-			const std::string& method = "GET",
-			const std::string& content = std::string(),
-			const std::unordered_map<std::string, std::string>& additionalHeaders = std::unordered_map<std::string, std::string>(),
-			USHORT port = 80)
+		template <typename T>
+		class Snapshot
 		{
-			// split host and and action parts.
-			// first check if URL contains "http:", then we find the first / that is not part of the http:// part and split based on it.
-			bool gotHttp = url.substr(0, 5).find("http:") == 0;
-			auto hostEnd = url.find('/', gotHttp ? strlen("http://")+1 : 0);
-			auto host = hostEnd == std::string::npos ? url : url.substr(0, hostEnd);
-			auto action = hostEnd == std::string::npos ? "/" : url.substr(hostEnd);
-			
-			// if host contains /, for example from http://, remove it.
-			auto hostStart = host.rfind("/");
-			if (hostStart != std::string::npos) { host = host.substr(hostStart + 1); }
+			static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
 
-			// convert headers to string
-			auto headers = Just::String::From::Map(additionalHeaders, ":", "\n");
+		private:
 
-			// send http request
-			return Send(host, method, action, content, headers, port);
+			// magic value marking an initialized snapshot
+			static const uint64_t _Magic = 0x4a5553545345514cULL;
+
+			// value size, in 64 bit words
+			static const size_t _Words = (sizeof(T) + 7) / 8;
+
+			__SnapshotHeader* _Header = nullptr;
+			std::atomic<uint64_t>* _Value = nullptr;
+
+			// copy value words out. must be validated by the sequence afterwards
+			inline void _CopyOut(T& out) const
+			{
+				uint64_t words[_Words];
+				for (size_t i = 0; i < _Words; ++i) words[i] = _Value[i].load(std::memory_order_relaxed);
+				memcpy(&out, words, sizeof(T));
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Snapshot offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < RequiredSize()) throw std::runtime_error("Exceeded shared memory size!");
+				__SnapshotHeader* header = (__SnapshotHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __SnapshotHeader();
+					header->ValueSize = sizeof(T);
+					for (size_t i = 0; i < _Words; ++i) new ((std::atomic<uint64_t>*)(header + 1) + i) std::atomic<uint64_t>(0);
+				}
+				else if (header->Magic.load(std::memory_order_acquire) != _Magic || header->ValueSize != sizeof(T))
+				{
+					throw std::runtime_error("Shared memory does not contain a snapshot of this type!");
+				}
+				_Header = header;
+				_Value = (std::atomic<uint64_t>*)(header + 1);
+			}
+
+		public:
+
+			// get how many bytes of shared memory a snapshot needs
+			static inline size_t RequiredSize()
+			{
+				return sizeof(__SnapshotHeader) + _Words * sizeof(uint64_t);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, const T& value = T())
+			*
+			* \brief	Initialize a new snapshot in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the snapshot.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the snapshot in.
+			* \param	offset				Offset of the snapshot in the shared memory, aligned to 64 bytes.
+			* \param	value				(Optional) Initial value.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset, const T& value = T())
+			{
+				_Attach(memory, offset, true);
+				Write(value);
+				_Header->Magic.store(_Magic, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a snapshot another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the snapshot is in.
+			* \param	offset				Offset of the snapshot in the shared memory.
+			* Note: throws std::runtime_error if there is no snapshot of this type at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false);
+			}
+
+			// return if snapshot is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			/*!
+			* \fn	void Write(const T& value)
+			*
+			* \brief	Publish a new value. Never waits for readers.
+			*
+			* \date		10/19/2026
+			*
+			* \param	value				Value to publish.
+			*/
+			void Write(const T& value)
+			{
+				uint64_t words[_Words] = {};
+				memcpy(words, &value, sizeof(T));
+
+				uint64_t sequence = _Header->Sequence.load(std::memory_order_relaxed);
+				_Header->Sequence.store(sequence + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				for (size_t i = 0; i < _Words; ++i) _Value[i].store(words[i], std::memory_order_relaxed);
+				_Header->Sequence.store(sequence + 2, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	bool TryRead(T& out) const
+			*
+			* \brief	Try to read a consistent copy of the value once.
+			*
+			* \date		10/19/2026
+			*
+			* \param	out					Value to read into.
+			*
+			* \return	False if a write was in progress, out is then undefined.
+			*/
+			bool TryRead(T& out) const
+			{
+				uint64_t before = _Header->Sequence.load(std::memory_order_acquire);
+				if (before & 1) return false;
+				_CopyOut(out);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return _Header->Sequence.load(std::memory_order_relaxed) == before;
+			}
+
+			/*!
+			* \fn	T Read() const
+			*
+			* \brief	Read a consistent copy of the value, retrying while writes are in progress.
+			*
+			* \date		10/19/2026
+			*
+			* \return	Current value.
+			*/
+			T Read() const
+			{
+				T ret;
+				for (unsigned attempt = 0; !TryRead(ret); ++attempt)
+				{
+					// writer may be preempted in the middle of a write, don't burn its CPU
+					if (attempt >= 64) std::this_thread::yield();
+				}
+				return ret;
+			}
+
+			// get number of writes so far (changes whenever the value does)
+			inline uint64_t GetVersion() const
+			{
+				return _Header->Sequence.load(std::memory_order_acquire) / 2;
+			}
+		};
+	}
+}
+
+
+
+
+// ::DLLs\Load.h::
+
+/*!
+ * \file	Source\DLLs\Load.h.
+ *
+ * \brief	Dynamically load dlls.
+ */
+// #pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace Just
+{
+	namespace DLLs
+	{
+#ifdef _WIN32
+		typedef HMODULE __LibraryHandle;
+
+		// used internally, platform primitives to open a library, get a symbol and close it
+		inline __LibraryHandle _OpenLibrary(const std::string& path) { return LoadLibraryA(path.c_str()); }
+		inline void* _GetSymbol(__LibraryHandle handle, const char* name) { return (void*)GetProcAddress(handle, name); }
+		inline void _CloseLibrary(__LibraryHandle handle) { FreeLibrary(handle); }
+#else
+		typedef void* __LibraryHandle;
+
+		// used internally, platform primitives to open a library, get a symbol and close it
+		inline __LibraryHandle _OpenLibrary(const std::string& path) { return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL); }
+		inline void* _GetSymbol(__LibraryHandle handle, const char* name) { return dlsym(handle, name); }
+		inline void _CloseLibrary(__LibraryHandle handle) { dlclose(handle); }
+#endif
+
+		/*!
+		 * \struct	__StringHash
+		 *
+		 * \brief	Used internally, transparent string hash so maps keyed by std::string can be
+		 * 			searched with a string_view without allocating.
+		 */
+		struct __StringHash
+		{
+			using is_transparent = void;
+			inline size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+		};
+
+		// used internally, string keyed map with heterogeneous lookup
+		template <typename T>
+		using __StringMap = std::unordered_map<std::string, T, __StringHash, std::equal_to<>>;
+
+		/*!
+		 * \struct	__Library
+		 *
+		 * \brief	Used internally, a loaded library, its reference count and the symbols resolved from it.
+		 * 			Symbols that were not found are cached too, as null.
+		 */
+		struct __Library
+		{
+			__LibraryHandle Handle;
+			size_t RefCount = 0;
+			__StringMap<void*> Symbols;
+		};
+
+		// process-wide cache of loaded libraries. lookups take a shared lock, updating it an exclusive one.
+		// libraries are opened and closed outside the lock
+		inline std::shared_mutex _librariesMutex;
+		inline __StringMap<std::unique_ptr<__Library>> _libraries;
+
+		// used internally, add a library the caller opened (without holding the cache lock) to cache with one reference.
+		// if another thread added it while it was being opened the cached one is kept, gets a reference if addReference,
+		// and duplicate is set so the caller closes its own handle once the lock is released. must hold the cache lock exclusively
+		inline __Library& _AddOpened(std::string_view dllPath, __LibraryHandle handle, bool addReference, bool& duplicate)
+		{
+			auto found = _libraries.find(dllPath);
+			duplicate = found != _libraries.end();
+			if (duplicate)
+			{
+				if (addReference) found->second->RefCount++;
+				return *found->second;
+			}
+			auto library = std::make_unique<__Library>();
+			library->Handle = handle;
+			library->RefCount = 1;
+			return *_libraries.emplace(std::string(dllPath), std::move(library)).first->second;
+		}
+
+		// used internally, get a symbol of a cached library, resolving and caching it on first use. must hold the cache lock exclusively
+		inline void* _Resolve(__Library& library, std::string_view methodName)
+		{
+			auto symbol = library.Symbols.find(methodName);
+			if (symbol != library.Symbols.end()) return symbol->second;
+			std::string name(methodName);
+			void* ret = _GetSymbol(library.Handle, name.c_str());
+			library.Symbols.emplace(std::move(name), ret);
+			return ret;
 		}
 
 		/*!
-		 * \fn	HttpResponse SendForm(const std::string& url, const std::string& type = "POST", const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		 * \fn	inline bool Load(const std::string& dllPath)
 		 *
-		 * \brief	Sends an HTTP form.
+		 * \brief	Loads a DLL from path, or add a reference to it if already loaded.
+		 * 			Every successful Load should be matched by an Unload.
 		 *
 		 * \author	Ronen Ness
-		 * \date	10/19/2018
+		 * \date	10/18/2018
+		 *
+		 * \param	dllPath	Full path of the DLL file.
+		 *
+		 * \return	True if succeed to load DLL, false otherwise.
+		 */
+		inline bool Load(const std::string& dllPath)
+		{
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				auto found = _libraries.find(dllPath);
+				if (found != _libraries.end())
+				{
+					found->second->RefCount++;
+					return true;
+				}
+			}
+
+			// open without the lock: it runs the library's static constructors, which may call back into Load / GetMethod,
+			// and other threads can load other libraries meanwhile
+			__LibraryHandle handle = _OpenLibrary(dllPath);
+			if (!handle) return false;
+			bool duplicate;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				_AddOpened(dllPath, handle, true, duplicate);
+			}
+			if (duplicate) _CloseLibrary(handle);
+			return true;
+		}
+
+		/*!
+		 * \fn	inline bool Unload(std::string_view dllPath)
+		 *
+		 * \brief	Release a reference to a loaded DLL. When the last reference is released the DLL is closed,
+		 * 			and pointers previously returned by GetMethod for it must no longer be used.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	dllPath	Full path of the DLL file, as passed to Load.
+		 *
+		 * \return	True if DLL was loaded.
+		 */
+		inline bool Unload(std::string_view dllPath)
+		{
+			__LibraryHandle handle;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				auto found = _libraries.find(dllPath);
+				if (found == _libraries.end()) return false;
+				if (--found->second->RefCount != 0) return true;
+				handle = found->second->Handle;
+				_libraries.erase(found);
+			}
+
+			// close without the lock, it runs the library's static destructors
+			_CloseLibrary(handle);
+			return true;
+		}
+
+		/*!
+		 * \fn	inline bool IsLoaded(std::string_view dllPath)
+		 *
+		 * \brief	Check if a DLL is loaded.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	dllPath	Full path of the DLL file, as passed to Load.
+		 *
+		 * \return	True if loaded.
+		 */
+		inline bool IsLoaded(std::string_view dllPath)
+		{
+			std::shared_lock<std::shared_mutex> lock(_librariesMutex);
+			return _libraries.find(dllPath) != _libraries.end();
+		}
+
+		/*!
+		 * \fn	inline void* GetMethod(std::string_view dllPath, std::string_view methodName)
+		 *
+		 * \brief	Gets a method from DLL. Resolved methods are cached, so repeated lookups only take a shared lock
+		 * 			and don't allocate. If the DLL is not loaded yet it is loaded, as if Load was called.
+		 *
+		 * \author	Ronen Ness
+		 * \date	10/18/2018
+		 *
+		 * \param	dllPath   	Full path of the DLL file.
+		 * \param	methodName	Name of the method to get.
+		 *
+		 * \return	Method pointer, or null if failed to load DLL or get method.
+		 */
+		inline void* GetMethod(std::string_view dllPath, std::string_view methodName)
+		{
+			// fast path: library loaded and symbol already resolved
+			{
+				std::shared_lock<std::shared_mutex> lock(_librariesMutex);
+				auto library = _libraries.find(dllPath);
+				if (library != _libraries.end())
+				{
+					auto symbol = library->second->Symbols.find(methodName);
+					if (symbol != library->second->Symbols.end()) return symbol->second;
+				}
+			}
+
+			// library loaded, resolve and cache symbol
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				auto library = _libraries.find(dllPath);
+				if (library != _libraries.end()) return _Resolve(*library->second, methodName);
+			}
+
+			// load library first, without the lock (see Load)
+			__LibraryHandle handle = _OpenLibrary(std::string(dllPath));
+			if (!handle) return NULL;
+			bool duplicate;
+			void* ret;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				ret = _Resolve(_AddOpened(dllPath, handle, false, duplicate), methodName);
+			}
+			if (duplicate) _CloseLibrary(handle);
+			return ret;
+		}
+	}
+}
+
+
+
+
+// ::DLLs\LoadMany.h::
+
+/*!
+ * \file	Source\DLLs\LoadMany.h.
+ *
+ * \brief	Load many dlls at once, reading their files ahead in parallel.
+ */
+// #pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+// #include "Load.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <link.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace Just
+{
+	namespace DLLs
+	{
+		/*!
+		 * \struct	LoadResult
 		 *
-		 * \param	url		  	URL of the document.
-		 * \param	method	  	(Optional) The method of HTTP request.
-		 * \param	data	  	(Optional) The form data to send.
-		 * \param	port	  	(Optional) Port to connect to.
+		 * \brief	Result of loading a single library with LoadMany.
 		 *
-		 * \return	A HttpResponse.
+		 * \date	10/19/2026
 		 */
-		HttpResponse SendForm(const std::string& url,
-			const std::string& method = "POST",
-			const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(),
-			USHORT port = 80)
+		struct LoadResult
 		{
-			auto headers = std::unordered_map<std::string, std::string>();
-			headers["Content-Type"] = "application/x-www-form-urlencoded";
-			auto content = Just::String::From::Map(data, "=", "&");
-			return Send(url, method, content, headers, port);
-		}
+			// library path
+			std::string Path;
+
+			// did library load
+			bool Success = false;
+
+			// time spent reading the file ahead, and loading it (mapping, relocating, running initializers), in seconds.
+			// load time includes waiting for the dynamic loader lock, if other threads were loading libraries too
+			double PrefetchTime = 0;
+			double LoadTime = 0;
+
+			// relocations the library needs (from its dynamic section), and how many of them are relative (cheap).
+			// not collected on Windows
+			size_t Relocations = 0;
+			size_t RelativeRelocations = 0;
+		};
 
 		/*!
-		 * \fn	HttpResponse Get(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
+		 * \struct	LoadManyResult
 		 *
-		 * \brief	Send HTTP GET request.
+		 * \brief	Result of LoadMany.
 		 *
-		 * \author	Ronen Ness
-		 * \date	10/19/2018
+		 * \date	10/19/2026
+		 */
+		struct LoadManyResult
+		{
+			// per library results, in the order of the given paths
+			std::vector<LoadResult> Libraries;
+
+			// total wall time, in seconds
+			double WallTime = 0;
+
+			// return if all libraries loaded
+			inline bool IsSuccess() const
+			{
+				for (const auto& library : Libraries) if (!library.Success) return false;
+				return true;
+			}
+		};
+
+		/*!
+		 * \fn	inline void _ParallelFor(size_t count, size_t maxParallel, const std::function<void(size_t)>& work)
 		 *
-		 * \param	url				 	URL of the document.
-		 * \param	port			 	(Optional) Port to connect to.
+		 * \brief	Used internally, run work(0..count-1) on up to maxParallel threads.
 		 *
-		 * \return	A HttpResponse.
+		 * \date	10/19/2026
 		 */
-		HttpResponse Get(const std::string& url, USHORT port = 80)
+		inline void _ParallelFor(size_t count, size_t maxParallel, const std::function<void(size_t)>& work)
 		{
-			static std::string method = "GET";
-			static std::unordered_map<std::string, std::string> headers;
-			return Send(url, method, std::string(), headers, port);
+			std::atomic<size_t> next(0);
+			auto worker = [&]() {
+				size_t index;
+				while ((index = next.fetch_add(1)) < count) work(index);
+			};
+			std::vector<std::thread> threads;
+			for (size_t i = 1; i < (std::min)(maxParallel, count); ++i) threads.emplace_back(worker);
+			worker();
+			for (auto& thread : threads) thread.join();
 		}
 
 		/*!
-		* \fn	HttpResponse Post(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
-		*
-		* \brief	Send HTTP POST request.
-		*
-		* \author	Ronen Ness
-		* \date	10/19/2018
-		*
-		* \param	url				 	URL of the document.
-		* \param	data				(Optional) Data to send with request.
-		* \param	port			 	(Optional) Port to connect to.
-		*
-		* \return	A HttpResponse.
-		*/
-		HttpResponse Post(const std::string& url,
-			const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(),
-			USHORT port = 80)
+		 * \fn	inline void _PrefetchFile(const std::string& path)
+		 *
+		 * \brief	Used internally, read a file into the page cache so mapping it later does not wait on disk.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline void _PrefetchFile(const std::string& path)
 		{
-			static std::string method = "POST";
-			return SendForm(url, method, data, port);
+#ifndef _WIN32
+			int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd == -1) return;
+			struct stat info;
+			if (fstat(fd, &info) == 0 && info.st_size > 0)
+			{
+				posix_fadvise(fd, 0, info.st_size, POSIX_FADV_WILLNEED);
+				readahead(fd, 0, (size_t)info.st_size);
+			}
+			close(fd);
+#else
+			(void)path;
+#endif
 		}
 
 		/*!
-		* \fn	HttpResponse Put(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
-		*
-		* \brief	Send HTTP PUT request.
-		*
-		* \author	Ronen Ness
-		* \date	10/19/2018
-		*
-		* \param	url				 	URL of the document.
-		* \param	data				(Optional) Data to send with request.
-		* \param	port			 	(Optional) Port to connect to.
-		*
-		* \return	A HttpResponse.
-		*/
-		HttpResponse Put(const std::string& url,
-			const std::unordered_map<std::string, std::string> data = std::unordered_map<std::string, std::string>(),
-			USHORT port = 80)
+		 * \fn	inline void _CountRelocations(__LibraryHandle handle, LoadResult& result)
+		 *
+		 * \brief	Used internally, count relocations of a loaded library from its dynamic section.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline void _CountRelocations(__LibraryHandle handle, LoadResult& result)
 		{
-			static std::string method = "PUT";
-			return SendForm(url, method, data, port);
+#ifndef _WIN32
+			struct link_map* map = NULL;
+			if (dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0 || !map || !map->l_ld) return;
+
+			size_t relaSize = 0, relaEntry = sizeof(ElfW(Rela)), relSize = 0, relEntry = sizeof(ElfW(Rel));
+			size_t pltSize = 0, pltType = DT_RELA;
+			for (const ElfW(Dyn)* entry = map->l_ld; entry->d_tag != DT_NULL; ++entry)
+			{
+				switch (entry->d_tag)
+				{
+				case DT_RELASZ: relaSize = entry->d_un.d_val; break;
+				case DT_RELAENT: relaEntry = entry->d_un.d_val; break;
+				case DT_RELSZ: relSize = entry->d_un.d_val; break;
+				case DT_RELENT: relEntry = entry->d_un.d_val; break;
+				case DT_PLTRELSZ: pltSize = entry->d_un.d_val; break;
+				case DT_PLTREL: pltType = entry->d_un.d_val; break;
+				case DT_RELACOUNT:
+				case DT_RELCOUNT: result.RelativeRelocations += entry->d_un.d_val; break;
+				}
+			}
+			result.Relocations = (relaEntry ? relaSize / relaEntry : 0) + (relEntry ? relSize / relEntry : 0);
+			result.Relocations += pltSize / (pltType == DT_RELA ? sizeof(ElfW(Rela)) : sizeof(ElfW(Rel)));
+#else
+			(void)handle;
+			(void)result;
+#endif
 		}
 
 		/*!
-		* \fn	HttpResponse Delete(const std::string& url, const std::unordered_map<std::string, std::string> additionalHeaders = std::unordered_map<std::string, std::string>(), USHORT port = 80)
-		*
-		* \brief	Send HTTP DELETE request.
-		*
-		* \author	Ronen Ness
-		* \date	10/19/2018
-		*
-		* \param	url				 	URL of the document.
-		* \param	port			 	(Optional) Port to connect to.
-		*
-		* \return	A HttpResponse.
-		*/
-		HttpResponse Delete(const std::string& url, USHORT port = 80)
+		 * \fn	inline LoadManyResult LoadMany(const std::vector<std::string>& paths, size_t maxParallel = 0)
+		 *
+		 * \brief	Loads many DLLs (like calling Load on each, in order), to cut startup time.
+		 * 			Files are read ahead on worker threads, and each library is loaded on the calling thread as soon as
+		 * 			its file was read, so loading overlaps with reading the files still queued instead of waiting on
+		 * 			disk one file at a time.
+		 * 			Loads themselves are not parallel: the dynamic loader holds a process wide lock while it maps,
+		 * 			relocates and runs initializers (glibc and Windows both do), so loading from more threads only
+		 * 			adds waiting. Libraries may depend on each other, the loader resolves dependencies in any order.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	paths	   	Full paths of DLL files.
+		 * \param	maxParallel	(Optional) Max threads reading files ahead, 0 for number of CPUs (at least 4, since they wait on I/O).
+		 *
+		 * \return	Per library load times and relocation counts.
+		 */
+		inline LoadManyResult LoadMany(const std::vector<std::string>& paths, size_t maxParallel = 0)
 		{
-			static std::string method = "DELETE";
-			return Send(url, method, std::string(), std::unordered_map<std::string, std::string>(), port = port);
+			auto start = std::chrono::steady_clock::now();
+			LoadManyResult ret;
+			ret.Libraries.resize(paths.size());
+			if (maxParallel == 0) maxParallel = (std::max)(4u, std::thread::hardware_concurrency());
+
+			// read files ahead, in order, marking each one done
+			std::vector<char> prefetched(paths.size(), 0);
+			std::mutex prefetchedMutex;
+			std::condition_variable prefetchedWake;
+			std::thread prefetcher([&]() {
+				_ParallelFor(paths.size(), maxParallel, [&](size_t i) {
+					auto prefetchStart = std::chrono::steady_clock::now();
+					_PrefetchFile(paths[i]);
+					ret.Libraries[i].PrefetchTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - prefetchStart).count();
+					{
+						std::lock_guard<std::mutex> lock(prefetchedMutex);
+						prefetched[i] = 1;
+					}
+					prefetchedWake.notify_all();
+				});
+			});
+
+			// load each one once it was read, while the next ones are still being read
+			for (size_t i = 0; i < paths.size(); ++i)
+			{
+				{
+					std::unique_lock<std::mutex> lock(prefetchedMutex);
+					prefetchedWake.wait(lock, [&]() { return prefetched[i] != 0; });
+				}
+				LoadResult& result = ret.Libraries[i];
+				result.Path = paths[i];
+				auto loadStart = std::chrono::steady_clock::now();
+				result.Success = Load(paths[i]);
+				result.LoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+				if (!result.Success) continue;
+
+				std::shared_lock<std::shared_mutex> lock(_librariesMutex);
+				auto found = _libraries.find(paths[i]);
+				if (found != _libraries.end()) _CountRelocations(found->second->Handle, result);
+			}
+			prefetcher.join();
+
+			ret.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			return ret;
 		}
 	}
 }
-#endif
 
 
 
-// ::SharedMemory\SharedMemory.h::
+
+// ::DLLs\Plugin.h::
 
 /*!
-* \file	Source\SharedMemory\SharedMemory.h.
-*
-* \brief	Creating and using Shared Memory between processes.
-*/
+ * \file	Source\DLLs\Plugin.h.
+ *
+ * \brief	Typed plugin interfaces with eagerly bound function tables and hot reload.
+ */
 // #pragma once
-#ifdef _WIN32
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
 #include <string>
-#include <windows.h>
-// #include "../Strings/To/All.h"
+#include <thread>
+#include <type_traits>
+#include <utility>
+// #include "Load.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 namespace Just
 {
-	namespace SharedMemory
+	namespace DLLs
 	{
-		/**
-		* Manage a shared memory connection.
-		*/
-		class Client
-		{
-		private:
+		// used internally, plugin reader counters are padded to this, so threads calling a plugin don't share cache lines
+		constexpr size_t _PluginCacheLineSize = 64;
 
-			// file handle
-			HANDLE _MapFile;
+		// used internally, plugin reader slots. threads are spread over them, more threads than slots just share a few
+		constexpr size_t _PluginReaderSlots = 64;
 
-			// buffer
-			LPCTSTR _Buffer;
+		// used internally, get a small index for the calling thread, assigned in order of first use
+		inline size_t _PluginThreadIndex()
+		{
+			static std::atomic<size_t> threads(0);
+			thread_local size_t index = threads.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
 
-			// shared memory size
-			int _BufferSize;
+		/*!
+		 * \class	__PluginBinder
+		 *
+		 * \brief	Used internally, passed to Interface::Bind to resolve the interface function pointers from a library.
+		 */
+		class __PluginBinder
+		{
+			__LibraryHandle _Handle;
+			std::string _Missing;
 
 		public:
 
-			/**
-			* Constructor.
-			*/
-			Client() : _MapFile(NULL), _Buffer(NULL), _BufferSize(0) {}
+			__PluginBinder(__LibraryHandle handle) : _Handle(handle) {}
 
-			/**
-			* Destructor.
-			*/
-			~Client()
+			// resolve a required function. if missing, loading the plugin fails
+			template <typename Function>
+			void operator()(const char* name, Function& function)
 			{
-				Close();
+				static_assert(std::is_pointer<Function>::value && std::is_function<typename std::remove_pointer<Function>::type>::value, "Plugin interface members must be function pointers");
+				void* symbol = _GetSymbol(_Handle, name);
+				if (!symbol) _Missing += (_Missing.empty() ? "" : ", ") + std::string(name);
+				function = reinterpret_cast<Function>(symbol);
 			}
 
-			/*!
-			* \fn	bool CreateNew(const std::string& path, int bufferSize)
-			*
-			* \brief	Create a new shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	path 				Shared memory file path.
-			* \param	bufferSize			Shared memory buffer size.
-			*
-			* \return	If succeed to create the shared memory.
-			*/
-			bool CreateNew(const std::string& path, int bufferSize)
+			// resolve an optional function, left null if missing
+			template <typename Function>
+			void Optional(const char* name, Function& function)
 			{
-				// if already init throw exception
-				if (IsValid()) throw new std::exception("Shared Memory already connected!");
-
-				// convert path to wide string
-				LPCWSTR converted;
-				String::To::LpcwStr(path, converted);
-
-				// create shared memory
-				_MapFile = CreateFileMapping(
-					INVALID_HANDLE_VALUE,    // use paging file
-					NULL,                    // default security
-					PAGE_READWRITE,          // read/write access
-					0,                       // maximum object size (high-order DWORD)
-					bufferSize,              // maximum object size (low-order DWORD)
-					converted);				 // name of mapping object
-				delete[] converted;
+				static_assert(std::is_pointer<Function>::value && std::is_function<typename std::remove_pointer<Function>::type>::value, "Plugin interface members must be function pointers");
+				function = reinterpret_cast<Function>(_GetSymbol(_Handle, name));
+			}
 
-				// if had error stop here
-				if (_MapFile == NULL)
-				{
-					return false;
-				}
+			// get comma separated names of required functions that were not found
+			inline const std::string& GetMissing() const { return _Missing; }
+		};
 
-				// get mapping
-				_Buffer = (LPTSTR)MapViewOfFile(_MapFile,
-					FILE_MAP_ALL_ACCESS, 
-					0,
-					0,
-					bufferSize);
+		/*!
+		 * \class	Plugin
+		 *
+		 * \brief	A plugin library exposing a typed interface.
+		 * 			Interface is a struct of function pointers with a Bind method naming the symbol of each:
+		 *
+		 * 				struct Strategy
+		 * 				{
+		 * 					int (*Compute)(int);
+		 * 					template <typename Binder> void Bind(Binder& bind) { bind("compute", Compute); }
+		 * 				};
+		 *
+		 * 			All functions are resolved in one pass when the library is loaded, so calls go through
+		 * 			the table with no lookup. The library can be reloaded while in use: the new table is swapped
+		 * 			in atomically, and the old library is closed only after a grace period in which all calls
+		 * 			that started on it finished (RCU with two reader counters per thread slot). Each thread counts
+		 * 			its calls in its own slot, on its own cache line, so concurrent calls from many threads don't
+		 * 			bounce a shared counter between cores; only a reload reads all slots.
+		 * 			On hot paths, Acquire a Guard once for a batch of calls: calls through it are plain indirect
+		 * 			calls. Call acquires a guard per call, which costs a few atomic operations more.
+		 * 			The library file is copied to a temp path before loading, so a new version gets its own handle
+		 * 			and the original file can be overwritten while loaded.
+		 *
+		 * \date	10/19/2026
+		 */
+		template <typename Interface>
+		class Plugin
+		{
+			// a loaded version of the library
+			struct __Table
+			{
+				Interface Functions;
+				__LibraryHandle Handle;
+				std::string LoadedPath;
+			};
 
-				// if failed, close the file handle and stop here
-				if (_Buffer == NULL)
+			// reader counters of the threads using a slot, one per epoch parity
+			struct alignas(_PluginCacheLineSize) __ReaderSlot
+			{
+				std::atomic<size_t> Readers[2];
+			};
+
+			std::string _Path;
+			std::atomic<__Table*> _Current;
+			std::atomic<unsigned> _Epoch;
+			__ReaderSlot _Slots[_PluginReaderSlots];
+			std::filesystem::file_time_type _LoadedTime;
+			uintmax_t _LoadedSize = 0;
+			std::string _Error;
+			unsigned _Reloads = 0;
+			std::mutex _Mutex;
+
+			// background watcher
+			std::thread _Watcher;
+			std::mutex _WatcherMutex;
+			std::condition_variable _WatcherWake;
+			bool _StopWatching = false;
+
+			// copy library to a unique temp path, load it and bind interface
+			__Table* _LoadTable()
+			{
+				std::error_code error;
+				_LoadedTime = std::filesystem::last_write_time(_Path, error);
+				_LoadedSize = std::filesystem::file_size(_Path, error);
+				if (error)
 				{
-					Close();
-					return false;
+					_Error = "Failed to read plugin file: " + _Path;
+					return nullptr;
 				}
 
-				// success
-				_BufferSize = bufferSize;
-				return true;
-			}
-
-			/*!
-			* \fn	bool Connect(const std::string& path, int bufferSize)
-			*
-			* \brief	Connect to existing shared memory other processed previously opened.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	path 				Shared memory file path.
-			* \param	bufferSize			Shared memory buffer size.
-			*
-			* \return	If succeed to connect to the shared memory.
-			*/
-			bool Connect(const std::string& path, int bufferSize)
-			{
-				// if already init throw exception
-				if (IsValid()) throw new std::exception("Shared Memory already connected!");
-
-				// convert path to wide string
-				LPCWSTR converted;
-				String::To::LpcwStr(path, converted);
-
-				// create shared memory
-				_MapFile = OpenFileMapping(
-					FILE_MAP_ALL_ACCESS,   // read/write access
-					FALSE,                 // do not inherit the name
-					converted);            // name of mapping object
-				delete[] converted;
-
-				// if had error stop here
-				if (_MapFile == NULL)
+				static std::atomic<unsigned> copies(0);
+#ifdef _WIN32
+				unsigned long processId = GetCurrentProcessId();
+#else
+				unsigned long processId = (unsigned long)getpid();
+#endif
+				std::filesystem::path loadedPath = std::filesystem::temp_directory_path(error) /
+					("just_plugin_" + std::to_string(processId) + "_" + std::to_string(copies++) + "_" + std::filesystem::path(_Path).filename().string());
+				if (error || !std::filesystem::copy_file(_Path, loadedPath, std::filesystem::copy_options::overwrite_existing, error))
 				{
-					return false;
+					_Error = "Failed to copy plugin file: " + _Path;
+					return nullptr;
 				}
 
-				// get mapping
-				_Buffer = (LPTSTR)MapViewOfFile(_MapFile,
-					FILE_MAP_ALL_ACCESS,
-					0,
-					0,
-					bufferSize);
-
-				// if failed, close the file handle and stop here
-				if (_Buffer == NULL)
+				__LibraryHandle handle = _OpenLibrary(loadedPath.string());
+#ifndef _WIN32
+				// mapped library stays valid after unlink, so don't leave copies behind
+				std::filesystem::remove(loadedPath, error);
+#endif
+				if (!handle)
 				{
-					Close();
-					return false;
+					std::filesystem::remove(loadedPath, error);
+#ifdef _WIN32
+					_Error = "Failed to load plugin: " + _Path;
+#else
+					const char* reason = dlerror();
+					_Error = "Failed to load plugin: " + (reason ? std::string(reason) : _Path);
+#endif
+					return nullptr;
 				}
 
-				// success
-				_BufferSize = bufferSize;
-				return true;
+				__Table* table = new __Table();
+				table->Handle = handle;
+				table->LoadedPath = loadedPath.string();
+				__PluginBinder binder(handle);
+				table->Functions.Bind(binder);
+				if (!binder.GetMissing().empty())
+				{
+					_Error = "Plugin is missing functions: " + binder.GetMissing();
+					_FreeTable(table);
+					return nullptr;
+				}
+				_Error.clear();
+				return table;
 			}
 
-			/*!
-			* \fn	bool ConnectOrCreate(const std::string& path, int bufferSize)
-			*
-			* \brief	Try to connect to existing shared memory and if fail, try to create it.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	path 				Shared memory file path.
-			* \param	bufferSize			Shared memory buffer size.
-			*
-			* \return	If succeed to connect / create the shared memory.
-			*/
-			bool ConnectOrCreate(const std::string& path, int bufferSize)
+			// close a table's library and delete it
+			static void _FreeTable(__Table* table)
 			{
-				return CreateNew(path, bufferSize) || Connect(path, bufferSize);
+				if (!table) return;
+				_CloseLibrary(table->Handle);
+				std::error_code error;
+				std::filesystem::remove(table->LoadedPath, error);
+				delete table;
 			}
 
-			/*!
-			* \fn	void Write(void* data, int dataLen = 0, int offset = 0)
-			*
-			* \brief	Write to shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	data 				Data buffer to write.
-			* \param	dataLen				Data buffer size, in bytes. Must match data buffer. Default to shared memory size.
-			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			void WriteBuffer(const void* data, int dataLen = 0, int offset = 0)
+			// wait until all readers that may still see the previous table are done
+			void _WaitForReaders()
 			{
-				if (!IsValid()) throw new std::exception("Cannot call write when shared memory is not valid!");
-				if (dataLen == 0) dataLen = _BufferSize;
-				if (offset + dataLen > _BufferSize) throw new std::exception("Exceeded shared memory size!");
-				CopyMemory((PVOID)(_Buffer + offset), data, dataLen);
+				// flip epoch twice, each time waiting for the counters of the epoch we left to drain in all slots
+				for (int i = 0; i < 2; ++i)
+				{
+					unsigned epoch = _Epoch.load(std::memory_order_relaxed);
+					_Epoch.store(epoch + 1, std::memory_order_seq_cst);
+					for (auto& slot : _Slots)
+					{
+						while (slot.Readers[epoch & 1].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+					}
+				}
 			}
 
-			/*!
-			* \fn	inline void Write(int val, int offset = 0)
-			*
-			* \brief	Write an integer into shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				Integer value to write.
-			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void WriteInt(int val, int offset = 0)
+			// swap in a new table and free the old one after a grace period
+			void _Swap(__Table* table)
 			{
-				WriteBuffer(&val, sizeof(val), offset);
+				__Table* old = _Current.exchange(table, std::memory_order_acq_rel);
+				if (old)
+				{
+					_WaitForReaders();
+					_FreeTable(old);
+				}
 			}
 
+		public:
+
 			/*!
-			* \fn	inline void Write(bool val, int offset = 0)
-			*
-			* \brief	Write a bool into shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				Bool value to write.
-			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void WriteBool(bool val, int offset = 0)
+			 * \class	Guard
+			 *
+			 * \brief	Read side of the plugin: while a guard is alive, the table it points to stays loaded.
+			 * 			Calls through a held guard are plain indirect calls, so this is the API for hot paths:
+			 * 			acquire once, make a batch of calls, release. Keep guards short lived (a batch, a request,
+			 * 			a frame), a reload waits for them to be released.
+			 */
+			class Guard
 			{
-				WriteBuffer(&val, sizeof(val), offset);
-			}
+				std::atomic<size_t>* _Counter;
+				const __Table* _Table;
+
+			public:
+
+				Guard(std::atomic<size_t>* counter, const __Table* table) : _Counter(counter), _Table(table) {}
+				Guard(Guard&& other) noexcept : _Counter(other._Counter), _Table(other._Table) { other._Counter = nullptr; }
+				Guard(const Guard&) = delete;
+				Guard& operator=(const Guard&) = delete;
+				~Guard() { if (_Counter) _Counter->fetch_sub(1, std::memory_order_release); }
+
+				// return if plugin is loaded
+				inline explicit operator bool() const { return _Table != nullptr; }
+
+				// access the interface
+				inline const Interface* operator->() const { return &_Table->Functions; }
+				inline const Interface& operator*() const { return _Table->Functions; }
+			};
 
 			/*!
-			* \fn	inline void Write(char val, int offset = 0)
-			*
-			* \brief	Write a char into shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				Char value to write.
-			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void WriteChar(char val, int offset = 0)
+			 * \fn	Plugin(const std::string& path)
+			 *
+			 * \brief	Constructor. Loads the plugin, check IsLoaded / GetError for the result.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	path	Path of the plugin library.
+			 */
+			Plugin(const std::string& path) : _Path(path), _Current(nullptr), _Epoch(0)
 			{
-				WriteBuffer(&val, sizeof(val), offset);
+				for (auto& slot : _Slots)
+				{
+					slot.Readers[0] = 0;
+					slot.Readers[1] = 0;
+				}
+				std::lock_guard<std::mutex> lock(_Mutex);
+				_Current = _LoadTable();
 			}
 
-			/*!
-			* \fn	inline void WriteStr(const LPCWSTR& val, int offset = 0)
-			*
-			* \brief	Write a string into shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				String value to write.
-			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void WriteStr(const LPCWSTR& val, int offset = 0)
+			Plugin(const Plugin&) = delete;
+			Plugin& operator=(const Plugin&) = delete;
+
+			~Plugin()
 			{
-				WriteBuffer(val, (int)(_tcslen(val) * sizeof(TCHAR)), offset);
+				StopWatching();
+				std::lock_guard<std::mutex> lock(_Mutex);
+				_Swap(nullptr);
 			}
 
 			/*!
-			* \fn	void Read(void* data, int dataLen = 0, int offset = 0)
-			*
-			* \brief	Read from shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	data 				Data buffer to read into. Must be allocated and released by caller.
-			* \param	dataLen				Data buffer size, in bytes. Must match data buffer. Default to shared memory size.
-			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			void ReadBuffer(void* data, int dataLen = 0, int offset = 0) const
+			 * \fn	Guard Acquire()
+			 *
+			 * \brief	Get the current interface table, protected from being unloaded until the guard is released.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	A guard; false if plugin is not loaded.
+			 */
+			inline Guard Acquire()
 			{
-				if (!IsValid()) throw new std::exception("Cannot call read when shared memory is not valid!");
-				if (dataLen == 0) dataLen = _BufferSize;
-				if (offset + dataLen > _BufferSize) throw new std::exception("Exceeded shared memory size!");
-				CopyMemory(data, (PVOID)(_Buffer + offset), dataLen);
+				__ReaderSlot& slot = _Slots[_PluginThreadIndex() % _PluginReaderSlots];
+				while (true)
+				{
+					unsigned epoch = _Epoch.load(std::memory_order_seq_cst);
+					std::atomic<size_t>* counter = &slot.Readers[epoch & 1];
+					counter->fetch_add(1, std::memory_order_seq_cst);
+
+					// epoch changed before we registered? the writer may not wait for this counter, retry
+					if (_Epoch.load(std::memory_order_seq_cst) == epoch)
+					{
+						return Guard(counter, _Current.load(std::memory_order_acquire));
+					}
+					counter->fetch_sub(1, std::memory_order_release);
+				}
 			}
 
 			/*!
-			* \fn	inline void Read(int& out, int offset = 0) const
-			*
-			* \brief	Read an integer from shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	out 				Integer value to read into.
-			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void ReadInt(int& out, int offset = 0) const
+			 * \fn	template <typename Function, typename... Args> auto Call(Function Interface::* function, Args&&... args)
+			 *
+			 * \brief	Call an interface function, like: plugin.Call(&Strategy::Compute, 5).
+			 * 			The plugin must be loaded and the function bound. Convenient for occasional calls; it acquires
+			 * 			a guard per call (about 20ns against 3ns for a plain indirect call), so in loops Acquire a
+			 * 			guard once and call through it instead.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	function	Interface member to call.
+			 * \param	args		Arguments.
+			 *
+			 * \return	Function return value.
+			 */
+			template <typename Function, typename... Args>
+			inline auto Call(Function Interface::* function, Args&&... args)
 			{
-				ReadBuffer(&out, sizeof(out), offset);
+				Guard guard = Acquire();
+				return ((*guard).*function)(std::forward<Args>(args)...);
 			}
 
 			/*!
-			* \fn	inline void Read(bool& out, int offset = 0) const
-			*
-			* \brief	Read a bool from shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				Bool value to read into.
-			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void ReadBool(bool& out, int offset = 0) const
+			 * \fn	bool Reload()
+			 *
+			 * \brief	Load the plugin file again and swap it in. Calls in progress finish on the old version.
+			 * 			If loading fails the current version stays loaded.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	True if new version was loaded.
+			 */
+			bool Reload()
 			{
-				ReadBuffer(&out, sizeof(out), offset);
+				std::lock_guard<std::mutex> lock(_Mutex);
+				__Table* table = _LoadTable();
+				if (!table) return false;
+				_Swap(table);
+				_Reloads++;
+				return true;
 			}
 
 			/*!
-			* \fn	inline void Read(char& out, int offset = 0) const
-			*
-			* \brief	Read a bool from shared memory.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				Char value to read into.
-			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void ReadChar(char& out, int offset = 0) const
+			 * \fn	bool ReloadIfChanged()
+			 *
+			 * \brief	Reload the plugin if its file modification time or size changed since it was loaded.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	True if a new version was loaded.
+			 */
+			bool ReloadIfChanged()
 			{
-				ReadBuffer(&out, sizeof(out), offset);
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					std::error_code error;
+					auto time = std::filesystem::last_write_time(_Path, error);
+					if (error) return false;
+					auto size = std::filesystem::file_size(_Path, error);
+					if (error || (_Current.load() && time == _LoadedTime && size == _LoadedSize)) return false;
+				}
+				return Reload();
 			}
 
 			/*!
-			* \fn	inline void ReadStr(TCHAR* out, int maxLen = 0) const
-			*
-			* \brief	Read the whole shared memory as a string.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \param	val 				Char* value to read into. Must be a buffer in the size of the shared memory.
-			* \param	maxLen 				Expected string len to read. If not provided, will read whole shared memory buffer.
-			* Note: if exceed shared memory size will throw exception.
-			*/
-			inline void ReadStr(TCHAR* out, int maxLen = 0) const
+			 * \fn	void Watch(std::chrono::milliseconds interval = std::chrono::milliseconds(500))
+			 *
+			 * \brief	Start a thread that calls ReloadIfChanged periodically.
+			 * 			Writers should replace the file atomically (write a new file and rename it over the old one).
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	interval	(Optional) How often to check the file.
+			 */
+			void Watch(std::chrono::milliseconds interval = std::chrono::milliseconds(500))
 			{
-				ReadBuffer(out, maxLen * (sizeof(TCHAR) / sizeof(char)));
+				StopWatching();
+				_StopWatching = false;
+				_Watcher = std::thread([this, interval]() {
+					std::unique_lock<std::mutex> lock(_WatcherMutex);
+					while (!_WatcherWake.wait_for(lock, interval, [this]() { return _StopWatching; }))
+					{
+						lock.unlock();
+						ReloadIfChanged();
+						lock.lock();
+					}
+				});
 			}
 
-			/*!
-			* \fn	inline bool IsValid() const
-			*
-			* \brief	Check if valid and can be used to read / write.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \return	If shared memory is initialized and ready.
-			*/
-			inline bool IsValid() const { return _MapFile != NULL && _Buffer != NULL; }
-			
-			/*!
-			* \fn	inline int GetSize() const
-			*
-			* \brief	Get shared memory buffer size.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*
-			* \return	Shared memory buffer size.
-			*/
-			inline int GetSize() const { return _BufferSize; }
-
-			/*!
-			* \fn	void Close()
-			*
-			* \brief	Close this handle. 
-			* 			When all handles of a shared memory are closed, the platform may release it.
-			*
-			* \author	Ronen Ness
-			* \date		11/13/2018
-			*/
-			void Close()
+			// stop the watcher thread, if running
+			void StopWatching()
 			{
-				if (_Buffer) UnmapViewOfFile(_Buffer);
-				if (_MapFile) CloseHandle(_MapFile);
-				_Buffer = NULL;
-				_MapFile = NULL;
-				_BufferSize = 0;
+				if (!_Watcher.joinable()) return;
+				{
+					std::lock_guard<std::mutex> lock(_WatcherMutex);
+					_StopWatching = true;
+				}
+				_WatcherWake.notify_all();
+				_Watcher.join();
 			}
-		};
-	}
-}
-#endif
-
-
-
-// ::DLLs\Load.h::
-
-/*!
- * \file	Source\DLLs\Load.h.
- *
- * \brief	Dynamically load dlls.
- */
-// #pragma once
-#ifdef _WIN32
-#include <string>
-#include <windows.h>
-
-namespace Just
-{
-	namespace DLLs
-	{
-		/*!
-		 * \fn	bool Load(const std::string& dllPath)
-		 *
-		 * \brief	Loads a DLL from path.
-		 *
-		 * \author	Ronen Ness
-		 * \date	10/18/2018
-		 *
-		 * \param	dllPath	Full path of the DLL file.
-		 *
-		 * \return	True if succeed to load DLL, false otherwise.
-		 */
-		bool Load(const std::string& dllPath)
-		{
-			return LoadLibrary(LPCWSTR(dllPath.c_str())) != NULL;
-		}
 
-		/*!
-		 * \fn	void* GetMethodFromDLL(const std::string& dllPath, const std::string& methodName)
-		 *
-		 * \brief	Gets a method from DLL.
-		 *
-		 * \author	Ronen Ness
-		 * \date	10/18/2018
-		 *
-		 * \param	dllPath   	Full path of the DLL file.
-		 * \param	methodName	Name of the method to get.
-		 *
-		 * \return	Method pointer, or null if failed to load DLL or get method.
-		 */
-		void* GetMethod(const std::string& dllPath, const std::string& methodName)
-		{
-			// load library
-			HINSTANCE hGetProcIDDLL = LoadLibrary(LPCWSTR(dllPath.c_str()));
+			// return if plugin is loaded
+			inline bool IsLoaded() const { return _Current.load(std::memory_order_acquire) != nullptr; }
 
-			// if failed to load dll return null
-			if (!hGetProcIDDLL) {
-				return NULL;
+			// get last load error, or empty string
+			inline std::string GetError()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				return _Error;
 			}
 
-			// get function from DLL
-			return GetProcAddress(hGetProcIDDLL, methodName.c_str());
-		}
+			// get how many times the plugin was reloaded
+			inline unsigned GetReloadsCount()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				return _Reloads;
+			}
+		};
 	}
 }
-#endif
+
 
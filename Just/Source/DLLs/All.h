@@ -1,2 +1,4 @@
 #pragma once
-#include "Load.h"
\ No newline at end of file
+#include "Load.h"
+#include "Plugin.h"
+#include "LoadMany.h"
\ No newline at end of file
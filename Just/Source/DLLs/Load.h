@@ -4,18 +4,108 @@
  * \brief	Dynamically load dlls.
  */
 #pragma once
-#ifdef _WIN32
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
 
 namespace Just
 {
 	namespace DLLs
 	{
+#ifdef _WIN32
+		typedef HMODULE __LibraryHandle;
+
+		// used internally, platform primitives to open a library, get a symbol and close it
+		inline __LibraryHandle _OpenLibrary(const std::string& path) { return LoadLibraryA(path.c_str()); }
+		inline void* _GetSymbol(__LibraryHandle handle, const char* name) { return (void*)GetProcAddress(handle, name); }
+		inline void _CloseLibrary(__LibraryHandle handle) { FreeLibrary(handle); }
+#else
+		typedef void* __LibraryHandle;
+
+		// used internally, platform primitives to open a library, get a symbol and close it
+		inline __LibraryHandle _OpenLibrary(const std::string& path) { return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL); }
+		inline void* _GetSymbol(__LibraryHandle handle, const char* name) { return dlsym(handle, name); }
+		inline void _CloseLibrary(__LibraryHandle handle) { dlclose(handle); }
+#endif
+
+		/*!
+		 * \struct	__StringHash
+		 *
+		 * \brief	Used internally, transparent string hash so maps keyed by std::string can be
+		 * 			searched with a string_view without allocating.
+		 */
+		struct __StringHash
+		{
+			using is_transparent = void;
+			inline size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+		};
+
+		// used internally, string keyed map with heterogeneous lookup
+		template <typename T>
+		using __StringMap = std::unordered_map<std::string, T, __StringHash, std::equal_to<>>;
+
+		/*!
+		 * \struct	__Library
+		 *
+		 * \brief	Used internally, a loaded library, its reference count and the symbols resolved from it.
+		 * 			Symbols that were not found are cached too, as null.
+		 */
+		struct __Library
+		{
+			__LibraryHandle Handle;
+			size_t RefCount = 0;
+			__StringMap<void*> Symbols;
+		};
+
+		// process-wide cache of loaded libraries. lookups take a shared lock, updating it an exclusive one.
+		// libraries are opened and closed outside the lock
+		inline std::shared_mutex _librariesMutex;
+		inline __StringMap<std::unique_ptr<__Library>> _libraries;
+
+		// used internally, add a library the caller opened (without holding the cache lock) to cache with one reference.
+		// if another thread added it while it was being opened the cached one is kept, gets a reference if addReference,
+		// and duplicate is set so the caller closes its own handle once the lock is released. must hold the cache lock exclusively
+		inline __Library& _AddOpened(std::string_view dllPath, __LibraryHandle handle, bool addReference, bool& duplicate)
+		{
+			auto found = _libraries.find(dllPath);
+			duplicate = found != _libraries.end();
+			if (duplicate)
+			{
+				if (addReference) found->second->RefCount++;
+				return *found->second;
+			}
+			auto library = std::make_unique<__Library>();
+			library->Handle = handle;
+			library->RefCount = 1;
+			return *_libraries.emplace(std::string(dllPath), std::move(library)).first->second;
+		}
+
+		// used internally, get a symbol of a cached library, resolving and caching it on first use. must hold the cache lock exclusively
+		inline void* _Resolve(__Library& library, std::string_view methodName)
+		{
+			auto symbol = library.Symbols.find(methodName);
+			if (symbol != library.Symbols.end()) return symbol->second;
+			std::string name(methodName);
+			void* ret = _GetSymbol(library.Handle, name.c_str());
+			library.Symbols.emplace(std::move(name), ret);
+			return ret;
+		}
+
 		/*!
-		 * \fn	bool Load(const std::string& dllPath)
+		 * \fn	inline bool Load(const std::string& dllPath)
 		 *
-		 * \brief	Loads a DLL from path.
+		 * \brief	Loads a DLL from path, or add a reference to it if already loaded.
+		 * 			Every successful Load should be matched by an Unload.
 		 *
 		 * \author	Ronen Ness
 		 * \date	10/18/2018
@@ -24,15 +114,82 @@ namespace Just
 		 *
 		 * \return	True if succeed to load DLL, false otherwise.
 		 */
-		bool Load(const std::string& dllPath)
+		inline bool Load(const std::string& dllPath)
 		{
-			return LoadLibrary(LPCWSTR(dllPath.c_str())) != NULL;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				auto found = _libraries.find(dllPath);
+				if (found != _libraries.end())
+				{
+					found->second->RefCount++;
+					return true;
+				}
+			}
+
+			// open without the lock: it runs the library's static constructors, which may call back into Load / GetMethod,
+			// and other threads can load other libraries meanwhile
+			__LibraryHandle handle = _OpenLibrary(dllPath);
+			if (!handle) return false;
+			bool duplicate;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				_AddOpened(dllPath, handle, true, duplicate);
+			}
+			if (duplicate) _CloseLibrary(handle);
+			return true;
 		}
 
 		/*!
-		 * \fn	void* GetMethodFromDLL(const std::string& dllPath, const std::string& methodName)
+		 * \fn	inline bool Unload(std::string_view dllPath)
+		 *
+		 * \brief	Release a reference to a loaded DLL. When the last reference is released the DLL is closed,
+		 * 			and pointers previously returned by GetMethod for it must no longer be used.
 		 *
-		 * \brief	Gets a method from DLL.
+		 * \date	10/19/2026
+		 *
+		 * \param	dllPath	Full path of the DLL file, as passed to Load.
+		 *
+		 * \return	True if DLL was loaded.
+		 */
+		inline bool Unload(std::string_view dllPath)
+		{
+			__LibraryHandle handle;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				auto found = _libraries.find(dllPath);
+				if (found == _libraries.end()) return false;
+				if (--found->second->RefCount != 0) return true;
+				handle = found->second->Handle;
+				_libraries.erase(found);
+			}
+
+			// close without the lock, it runs the library's static destructors
+			_CloseLibrary(handle);
+			return true;
+		}
+
+		/*!
+		 * \fn	inline bool IsLoaded(std::string_view dllPath)
+		 *
+		 * \brief	Check if a DLL is loaded.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	dllPath	Full path of the DLL file, as passed to Load.
+		 *
+		 * \return	True if loaded.
+		 */
+		inline bool IsLoaded(std::string_view dllPath)
+		{
+			std::shared_lock<std::shared_mutex> lock(_librariesMutex);
+			return _libraries.find(dllPath) != _libraries.end();
+		}
+
+		/*!
+		 * \fn	inline void* GetMethod(std::string_view dllPath, std::string_view methodName)
+		 *
+		 * \brief	Gets a method from DLL. Resolved methods are cached, so repeated lookups only take a shared lock
+		 * 			and don't allocate. If the DLL is not loaded yet it is loaded, as if Load was called.
 		 *
 		 * \author	Ronen Ness
 		 * \date	10/18/2018
@@ -42,19 +199,37 @@ namespace Just
 		 *
 		 * \return	Method pointer, or null if failed to load DLL or get method.
 		 */
-		void* GetMethod(const std::string& dllPath, const std::string& methodName)
+		inline void* GetMethod(std::string_view dllPath, std::string_view methodName)
 		{
-			// load library
-			HINSTANCE hGetProcIDDLL = LoadLibrary(LPCWSTR(dllPath.c_str()));
+			// fast path: library loaded and symbol already resolved
+			{
+				std::shared_lock<std::shared_mutex> lock(_librariesMutex);
+				auto library = _libraries.find(dllPath);
+				if (library != _libraries.end())
+				{
+					auto symbol = library->second->Symbols.find(methodName);
+					if (symbol != library->second->Symbols.end()) return symbol->second;
+				}
+			}
 
-			// if failed to load dll return null
-			if (!hGetProcIDDLL) {
-				return NULL;
+			// library loaded, resolve and cache symbol
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				auto library = _libraries.find(dllPath);
+				if (library != _libraries.end()) return _Resolve(*library->second, methodName);
 			}
 
-			// get function from DLL
-			return GetProcAddress(hGetProcIDDLL, methodName.c_str());
+			// load library first, without the lock (see Load)
+			__LibraryHandle handle = _OpenLibrary(std::string(dllPath));
+			if (!handle) return NULL;
+			bool duplicate;
+			void* ret;
+			{
+				std::unique_lock<std::shared_mutex> lock(_librariesMutex);
+				ret = _Resolve(_AddOpened(dllPath, handle, false, duplicate), methodName);
+			}
+			if (duplicate) _CloseLibrary(handle);
+			return ret;
 		}
 	}
 }
-#endif
\ No newline at end of file
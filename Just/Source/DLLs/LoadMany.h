@@ -0,0 +1,225 @@
+/*!
+ * \file	Source\DLLs\LoadMany.h.
+ *
+ * \brief	Load many dlls at once, reading their files ahead in parallel.
+ */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Load.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <link.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace Just
+{
+	namespace DLLs
+	{
+		/*!
+		 * \struct	LoadResult
+		 *
+		 * \brief	Result of loading a single library with LoadMany.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct LoadResult
+		{
+			// library path
+			std::string Path;
+
+			// did library load
+			bool Success = false;
+
+			// time spent reading the file ahead, and loading it (mapping, relocating, running initializers), in seconds.
+			// load time includes waiting for the dynamic loader lock, if other threads were loading libraries too
+			double PrefetchTime = 0;
+			double LoadTime = 0;
+
+			// relocations the library needs (from its dynamic section), and how many of them are relative (cheap).
+			// not collected on Windows
+			size_t Relocations = 0;
+			size_t RelativeRelocations = 0;
+		};
+
+		/*!
+		 * \struct	LoadManyResult
+		 *
+		 * \brief	Result of LoadMany.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct LoadManyResult
+		{
+			// per library results, in the order of the given paths
+			std::vector<LoadResult> Libraries;
+
+			// total wall time, in seconds
+			double WallTime = 0;
+
+			// return if all libraries loaded
+			inline bool IsSuccess() const
+			{
+				for (const auto& library : Libraries) if (!library.Success) return false;
+				return true;
+			}
+		};
+
+		/*!
+		 * \fn	inline void _ParallelFor(size_t count, size_t maxParallel, const std::function<void(size_t)>& work)
+		 *
+		 * \brief	Used internally, run work(0..count-1) on up to maxParallel threads.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline void _ParallelFor(size_t count, size_t maxParallel, const std::function<void(size_t)>& work)
+		{
+			std::atomic<size_t> next(0);
+			auto worker = [&]() {
+				size_t index;
+				while ((index = next.fetch_add(1)) < count) work(index);
+			};
+			std::vector<std::thread> threads;
+			for (size_t i = 1; i < (std::min)(maxParallel, count); ++i) threads.emplace_back(worker);
+			worker();
+			for (auto& thread : threads) thread.join();
+		}
+
+		/*!
+		 * \fn	inline void _PrefetchFile(const std::string& path)
+		 *
+		 * \brief	Used internally, read a file into the page cache so mapping it later does not wait on disk.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline void _PrefetchFile(const std::string& path)
+		{
+#ifndef _WIN32
+			int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd == -1) return;
+			struct stat info;
+			if (fstat(fd, &info) == 0 && info.st_size > 0)
+			{
+				posix_fadvise(fd, 0, info.st_size, POSIX_FADV_WILLNEED);
+				readahead(fd, 0, (size_t)info.st_size);
+			}
+			close(fd);
+#else
+			(void)path;
+#endif
+		}
+
+		/*!
+		 * \fn	inline void _CountRelocations(__LibraryHandle handle, LoadResult& result)
+		 *
+		 * \brief	Used internally, count relocations of a loaded library from its dynamic section.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline void _CountRelocations(__LibraryHandle handle, LoadResult& result)
+		{
+#ifndef _WIN32
+			struct link_map* map = NULL;
+			if (dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0 || !map || !map->l_ld) return;
+
+			size_t relaSize = 0, relaEntry = sizeof(ElfW(Rela)), relSize = 0, relEntry = sizeof(ElfW(Rel));
+			size_t pltSize = 0, pltType = DT_RELA;
+			for (const ElfW(Dyn)* entry = map->l_ld; entry->d_tag != DT_NULL; ++entry)
+			{
+				switch (entry->d_tag)
+				{
+				case DT_RELASZ: relaSize = entry->d_un.d_val; break;
+				case DT_RELAENT: relaEntry = entry->d_un.d_val; break;
+				case DT_RELSZ: relSize = entry->d_un.d_val; break;
+				case DT_RELENT: relEntry = entry->d_un.d_val; break;
+				case DT_PLTRELSZ: pltSize = entry->d_un.d_val; break;
+				case DT_PLTREL: pltType = entry->d_un.d_val; break;
+				case DT_RELACOUNT:
+				case DT_RELCOUNT: result.RelativeRelocations += entry->d_un.d_val; break;
+				}
+			}
+			result.Relocations = (relaEntry ? relaSize / relaEntry : 0) + (relEntry ? relSize / relEntry : 0);
+			result.Relocations += pltSize / (pltType == DT_RELA ? sizeof(ElfW(Rela)) : sizeof(ElfW(Rel)));
+#else
+			(void)handle;
+			(void)result;
+#endif
+		}
+
+		/*!
+		 * \fn	inline LoadManyResult LoadMany(const std::vector<std::string>& paths, size_t maxParallel = 0)
+		 *
+		 * \brief	Loads many DLLs (like calling Load on each, in order), to cut startup time.
+		 * 			Files are read ahead on worker threads, and each library is loaded on the calling thread as soon as
+		 * 			its file was read, so loading overlaps with reading the files still queued instead of waiting on
+		 * 			disk one file at a time.
+		 * 			Loads themselves are not parallel: the dynamic loader holds a process wide lock while it maps,
+		 * 			relocates and runs initializers (glibc and Windows both do), so loading from more threads only
+		 * 			adds waiting. Libraries may depend on each other, the loader resolves dependencies in any order.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	paths	   	Full paths of DLL files.
+		 * \param	maxParallel	(Optional) Max threads reading files ahead, 0 for number of CPUs (at least 4, since they wait on I/O).
+		 *
+		 * \return	Per library load times and relocation counts.
+		 */
+		inline LoadManyResult LoadMany(const std::vector<std::string>& paths, size_t maxParallel = 0)
+		{
+			auto start = std::chrono::steady_clock::now();
+			LoadManyResult ret;
+			ret.Libraries.resize(paths.size());
+			if (maxParallel == 0) maxParallel = (std::max)(4u, std::thread::hardware_concurrency());
+
+			// read files ahead, in order, marking each one done
+			std::vector<char> prefetched(paths.size(), 0);
+			std::mutex prefetchedMutex;
+			std::condition_variable prefetchedWake;
+			std::thread prefetcher([&]() {
+				_ParallelFor(paths.size(), maxParallel, [&](size_t i) {
+					auto prefetchStart = std::chrono::steady_clock::now();
+					_PrefetchFile(paths[i]);
+					ret.Libraries[i].PrefetchTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - prefetchStart).count();
+					{
+						std::lock_guard<std::mutex> lock(prefetchedMutex);
+						prefetched[i] = 1;
+					}
+					prefetchedWake.notify_all();
+				});
+			});
+
+			// load each one once it was read, while the next ones are still being read
+			for (size_t i = 0; i < paths.size(); ++i)
+			{
+				{
+					std::unique_lock<std::mutex> lock(prefetchedMutex);
+					prefetchedWake.wait(lock, [&]() { return prefetched[i] != 0; });
+				}
+				LoadResult& result = ret.Libraries[i];
+				result.Path = paths[i];
+				auto loadStart = std::chrono::steady_clock::now();
+				result.Success = Load(paths[i]);
+				result.LoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+				if (!result.Success) continue;
+
+				std::shared_lock<std::shared_mutex> lock(_librariesMutex);
+				auto found = _libraries.find(paths[i]);
+				if (found != _libraries.end()) _CountRelocations(found->second->Handle, result);
+			}
+			prefetcher.join();
+
+			ret.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			return ret;
+		}
+	}
+}
@@ -0,0 +1,435 @@
+/*!
+ * \file	Source\DLLs\Plugin.h.
+ *
+ * \brief	Typed plugin interfaces with eagerly bound function tables and hot reload.
+ */
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "Load.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace Just
+{
+	namespace DLLs
+	{
+		// used internally, plugin reader counters are padded to this, so threads calling a plugin don't share cache lines
+		constexpr size_t _PluginCacheLineSize = 64;
+
+		// used internally, plugin reader slots. threads are spread over them, more threads than slots just share a few
+		constexpr size_t _PluginReaderSlots = 64;
+
+		// used internally, get a small index for the calling thread, assigned in order of first use
+		inline size_t _PluginThreadIndex()
+		{
+			static std::atomic<size_t> threads(0);
+			thread_local size_t index = threads.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
+
+		/*!
+		 * \class	__PluginBinder
+		 *
+		 * \brief	Used internally, passed to Interface::Bind to resolve the interface function pointers from a library.
+		 */
+		class __PluginBinder
+		{
+			__LibraryHandle _Handle;
+			std::string _Missing;
+
+		public:
+
+			__PluginBinder(__LibraryHandle handle) : _Handle(handle) {}
+
+			// resolve a required function. if missing, loading the plugin fails
+			template <typename Function>
+			void operator()(const char* name, Function& function)
+			{
+				static_assert(std::is_pointer<Function>::value && std::is_function<typename std::remove_pointer<Function>::type>::value, "Plugin interface members must be function pointers");
+				void* symbol = _GetSymbol(_Handle, name);
+				if (!symbol) _Missing += (_Missing.empty() ? "" : ", ") + std::string(name);
+				function = reinterpret_cast<Function>(symbol);
+			}
+
+			// resolve an optional function, left null if missing
+			template <typename Function>
+			void Optional(const char* name, Function& function)
+			{
+				static_assert(std::is_pointer<Function>::value && std::is_function<typename std::remove_pointer<Function>::type>::value, "Plugin interface members must be function pointers");
+				function = reinterpret_cast<Function>(_GetSymbol(_Handle, name));
+			}
+
+			// get comma separated names of required functions that were not found
+			inline const std::string& GetMissing() const { return _Missing; }
+		};
+
+		/*!
+		 * \class	Plugin
+		 *
+		 * \brief	A plugin library exposing a typed interface.
+		 * 			Interface is a struct of function pointers with a Bind method naming the symbol of each:
+		 *
+		 * 				struct Strategy
+		 * 				{
+		 * 					int (*Compute)(int);
+		 * 					template <typename Binder> void Bind(Binder& bind) { bind("compute", Compute); }
+		 * 				};
+		 *
+		 * 			All functions are resolved in one pass when the library is loaded, so calls go through
+		 * 			the table with no lookup. The library can be reloaded while in use: the new table is swapped
+		 * 			in atomically, and the old library is closed only after a grace period in which all calls
+		 * 			that started on it finished (RCU with two reader counters per thread slot). Each thread counts
+		 * 			its calls in its own slot, on its own cache line, so concurrent calls from many threads don't
+		 * 			bounce a shared counter between cores; only a reload reads all slots.
+		 * 			On hot paths, Acquire a Guard once for a batch of calls: calls through it are plain indirect
+		 * 			calls. Call acquires a guard per call, which costs a few atomic operations more.
+		 * 			The library file is copied to a temp path before loading, so a new version gets its own handle
+		 * 			and the original file can be overwritten while loaded.
+		 *
+		 * \date	10/19/2026
+		 */
+		template <typename Interface>
+		class Plugin
+		{
+			// a loaded version of the library
+			struct __Table
+			{
+				Interface Functions;
+				__LibraryHandle Handle;
+				std::string LoadedPath;
+			};
+
+			// reader counters of the threads using a slot, one per epoch parity
+			struct alignas(_PluginCacheLineSize) __ReaderSlot
+			{
+				std::atomic<size_t> Readers[2];
+			};
+
+			std::string _Path;
+			std::atomic<__Table*> _Current;
+			std::atomic<unsigned> _Epoch;
+			__ReaderSlot _Slots[_PluginReaderSlots];
+			std::filesystem::file_time_type _LoadedTime;
+			uintmax_t _LoadedSize = 0;
+			std::string _Error;
+			unsigned _Reloads = 0;
+			std::mutex _Mutex;
+
+			// background watcher
+			std::thread _Watcher;
+			std::mutex _WatcherMutex;
+			std::condition_variable _WatcherWake;
+			bool _StopWatching = false;
+
+			// copy library to a unique temp path, load it and bind interface
+			__Table* _LoadTable()
+			{
+				std::error_code error;
+				_LoadedTime = std::filesystem::last_write_time(_Path, error);
+				_LoadedSize = std::filesystem::file_size(_Path, error);
+				if (error)
+				{
+					_Error = "Failed to read plugin file: " + _Path;
+					return nullptr;
+				}
+
+				static std::atomic<unsigned> copies(0);
+#ifdef _WIN32
+				unsigned long processId = GetCurrentProcessId();
+#else
+				unsigned long processId = (unsigned long)getpid();
+#endif
+				std::filesystem::path loadedPath = std::filesystem::temp_directory_path(error) /
+					("just_plugin_" + std::to_string(processId) + "_" + std::to_string(copies++) + "_" + std::filesystem::path(_Path).filename().string());
+				if (error || !std::filesystem::copy_file(_Path, loadedPath, std::filesystem::copy_options::overwrite_existing, error))
+				{
+					_Error = "Failed to copy plugin file: " + _Path;
+					return nullptr;
+				}
+
+				__LibraryHandle handle = _OpenLibrary(loadedPath.string());
+#ifndef _WIN32
+				// mapped library stays valid after unlink, so don't leave copies behind
+				std::filesystem::remove(loadedPath, error);
+#endif
+				if (!handle)
+				{
+					std::filesystem::remove(loadedPath, error);
+#ifdef _WIN32
+					_Error = "Failed to load plugin: " + _Path;
+#else
+					const char* reason = dlerror();
+					_Error = "Failed to load plugin: " + (reason ? std::string(reason) : _Path);
+#endif
+					return nullptr;
+				}
+
+				__Table* table = new __Table();
+				table->Handle = handle;
+				table->LoadedPath = loadedPath.string();
+				__PluginBinder binder(handle);
+				table->Functions.Bind(binder);
+				if (!binder.GetMissing().empty())
+				{
+					_Error = "Plugin is missing functions: " + binder.GetMissing();
+					_FreeTable(table);
+					return nullptr;
+				}
+				_Error.clear();
+				return table;
+			}
+
+			// close a table's library and delete it
+			static void _FreeTable(__Table* table)
+			{
+				if (!table) return;
+				_CloseLibrary(table->Handle);
+				std::error_code error;
+				std::filesystem::remove(table->LoadedPath, error);
+				delete table;
+			}
+
+			// wait until all readers that may still see the previous table are done
+			void _WaitForReaders()
+			{
+				// flip epoch twice, each time waiting for the counters of the epoch we left to drain in all slots
+				for (int i = 0; i < 2; ++i)
+				{
+					unsigned epoch = _Epoch.load(std::memory_order_relaxed);
+					_Epoch.store(epoch + 1, std::memory_order_seq_cst);
+					for (auto& slot : _Slots)
+					{
+						while (slot.Readers[epoch & 1].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+					}
+				}
+			}
+
+			// swap in a new table and free the old one after a grace period
+			void _Swap(__Table* table)
+			{
+				__Table* old = _Current.exchange(table, std::memory_order_acq_rel);
+				if (old)
+				{
+					_WaitForReaders();
+					_FreeTable(old);
+				}
+			}
+
+		public:
+
+			/*!
+			 * \class	Guard
+			 *
+			 * \brief	Read side of the plugin: while a guard is alive, the table it points to stays loaded.
+			 * 			Calls through a held guard are plain indirect calls, so this is the API for hot paths:
+			 * 			acquire once, make a batch of calls, release. Keep guards short lived (a batch, a request,
+			 * 			a frame), a reload waits for them to be released.
+			 */
+			class Guard
+			{
+				std::atomic<size_t>* _Counter;
+				const __Table* _Table;
+
+			public:
+
+				Guard(std::atomic<size_t>* counter, const __Table* table) : _Counter(counter), _Table(table) {}
+				Guard(Guard&& other) noexcept : _Counter(other._Counter), _Table(other._Table) { other._Counter = nullptr; }
+				Guard(const Guard&) = delete;
+				Guard& operator=(const Guard&) = delete;
+				~Guard() { if (_Counter) _Counter->fetch_sub(1, std::memory_order_release); }
+
+				// return if plugin is loaded
+				inline explicit operator bool() const { return _Table != nullptr; }
+
+				// access the interface
+				inline const Interface* operator->() const { return &_Table->Functions; }
+				inline const Interface& operator*() const { return _Table->Functions; }
+			};
+
+			/*!
+			 * \fn	Plugin(const std::string& path)
+			 *
+			 * \brief	Constructor. Loads the plugin, check IsLoaded / GetError for the result.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	path	Path of the plugin library.
+			 */
+			Plugin(const std::string& path) : _Path(path), _Current(nullptr), _Epoch(0)
+			{
+				for (auto& slot : _Slots)
+				{
+					slot.Readers[0] = 0;
+					slot.Readers[1] = 0;
+				}
+				std::lock_guard<std::mutex> lock(_Mutex);
+				_Current = _LoadTable();
+			}
+
+			Plugin(const Plugin&) = delete;
+			Plugin& operator=(const Plugin&) = delete;
+
+			~Plugin()
+			{
+				StopWatching();
+				std::lock_guard<std::mutex> lock(_Mutex);
+				_Swap(nullptr);
+			}
+
+			/*!
+			 * \fn	Guard Acquire()
+			 *
+			 * \brief	Get the current interface table, protected from being unloaded until the guard is released.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	A guard; false if plugin is not loaded.
+			 */
+			inline Guard Acquire()
+			{
+				__ReaderSlot& slot = _Slots[_PluginThreadIndex() % _PluginReaderSlots];
+				while (true)
+				{
+					unsigned epoch = _Epoch.load(std::memory_order_seq_cst);
+					std::atomic<size_t>* counter = &slot.Readers[epoch & 1];
+					counter->fetch_add(1, std::memory_order_seq_cst);
+
+					// epoch changed before we registered? the writer may not wait for this counter, retry
+					if (_Epoch.load(std::memory_order_seq_cst) == epoch)
+					{
+						return Guard(counter, _Current.load(std::memory_order_acquire));
+					}
+					counter->fetch_sub(1, std::memory_order_release);
+				}
+			}
+
+			/*!
+			 * \fn	template <typename Function, typename... Args> auto Call(Function Interface::* function, Args&&... args)
+			 *
+			 * \brief	Call an interface function, like: plugin.Call(&Strategy::Compute, 5).
+			 * 			The plugin must be loaded and the function bound. Convenient for occasional calls; it acquires
+			 * 			a guard per call (about 20ns against 3ns for a plain indirect call), so in loops Acquire a
+			 * 			guard once and call through it instead.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	function	Interface member to call.
+			 * \param	args		Arguments.
+			 *
+			 * \return	Function return value.
+			 */
+			template <typename Function, typename... Args>
+			inline auto Call(Function Interface::* function, Args&&... args)
+			{
+				Guard guard = Acquire();
+				return ((*guard).*function)(std::forward<Args>(args)...);
+			}
+
+			/*!
+			 * \fn	bool Reload()
+			 *
+			 * \brief	Load the plugin file again and swap it in. Calls in progress finish on the old version.
+			 * 			If loading fails the current version stays loaded.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	True if new version was loaded.
+			 */
+			bool Reload()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				__Table* table = _LoadTable();
+				if (!table) return false;
+				_Swap(table);
+				_Reloads++;
+				return true;
+			}
+
+			/*!
+			 * \fn	bool ReloadIfChanged()
+			 *
+			 * \brief	Reload the plugin if its file modification time or size changed since it was loaded.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	True if a new version was loaded.
+			 */
+			bool ReloadIfChanged()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					std::error_code error;
+					auto time = std::filesystem::last_write_time(_Path, error);
+					if (error) return false;
+					auto size = std::filesystem::file_size(_Path, error);
+					if (error || (_Current.load() && time == _LoadedTime && size == _LoadedSize)) return false;
+				}
+				return Reload();
+			}
+
+			/*!
+			 * \fn	void Watch(std::chrono::milliseconds interval = std::chrono::milliseconds(500))
+			 *
+			 * \brief	Start a thread that calls ReloadIfChanged periodically.
+			 * 			Writers should replace the file atomically (write a new file and rename it over the old one).
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	interval	(Optional) How often to check the file.
+			 */
+			void Watch(std::chrono::milliseconds interval = std::chrono::milliseconds(500))
+			{
+				StopWatching();
+				_StopWatching = false;
+				_Watcher = std::thread([this, interval]() {
+					std::unique_lock<std::mutex> lock(_WatcherMutex);
+					while (!_WatcherWake.wait_for(lock, interval, [this]() { return _StopWatching; }))
+					{
+						lock.unlock();
+						ReloadIfChanged();
+						lock.lock();
+					}
+				});
+			}
+
+			// stop the watcher thread, if running
+			void StopWatching()
+			{
+				if (!_Watcher.joinable()) return;
+				{
+					std::lock_guard<std::mutex> lock(_WatcherMutex);
+					_StopWatching = true;
+				}
+				_WatcherWake.notify_all();
+				_Watcher.join();
+			}
+
+			// return if plugin is loaded
+			inline bool IsLoaded() const { return _Current.load(std::memory_order_acquire) != nullptr; }
+
+			// get last load error, or empty string
+			inline std::string GetError()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				return _Error;
+			}
+
+			// get how many times the plugin was reloaded
+			inline unsigned GetReloadsCount()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				return _Reloads;
+			}
+		};
+	}
+}
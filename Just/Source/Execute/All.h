@@ -1,3 +1,8 @@
 #pragma once
 #include "Command.h"
-#include "Scripts.h"
\ No newline at end of file
+#include "Scripts.h"
+#include "Report.h"
+#include "Pipeline.h"
+#include "CachedRun.h"
+#include "SpawnServer.h"
+#include "Graph.h"
\ No newline at end of file
@@ -0,0 +1,479 @@
+/*!
+ * \file	Source\Execute\CachedRun.h.
+ *
+ * \brief	Memoize results of deterministic commands in an on-disk cache.
+ */
+#pragma once
+
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "Command.h"
+#include "Pipeline.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \class	__ContentHasher
+		 *
+		 * \brief	Used internally, streaming 128-bit non-cryptographic hash used for cache keys.
+		 *
+		 * \date	10/19/2026
+		 */
+		class __ContentHasher
+		{
+			uint64_t _A = 0x9E3779B97F4A7C15ULL;
+			uint64_t _B = 0xC2B2AE3D27D4EB4FULL;
+			uint64_t _Length = 0;
+
+			static inline uint64_t _Mix(uint64_t k)
+			{
+				k ^= k >> 33; k *= 0xFF51AFD7ED558CCDULL;
+				k ^= k >> 33; k *= 0xC4CEB9FE1A85EC53ULL;
+				k ^= k >> 33;
+				return k;
+			}
+
+			inline void _Word(uint64_t word)
+			{
+				_A = (_A ^ _Mix(word)) * 0x100000001B3ULL;
+				_A = (_A << 27) | (_A >> 37);
+				_B = (_B + _Mix(word ^ 0x5851F42D4C957F2DULL)) * 0x9FB21C651E98DF25ULL;
+				_B ^= _B >> 29;
+			}
+
+		public:
+
+			// add data to hash
+			void Update(const void* data, size_t size)
+			{
+				const unsigned char* bytes = (const unsigned char*)data;
+				_Length += size;
+				while (size >= 8)
+				{
+					uint64_t word;
+					memcpy(&word, bytes, 8);
+					_Word(word);
+					bytes += 8;
+					size -= 8;
+				}
+				if (size)
+				{
+					uint64_t word = 0;
+					memcpy(&word, bytes, size);
+					_Word(word ^ ((uint64_t)size << 56));
+				}
+			}
+
+			// add a length-prefixed string to hash, so concatenated fields can't collide
+			inline void Update(const std::string& str)
+			{
+				uint64_t size = str.size();
+				Update(&size, sizeof(size));
+				Update(str.data(), str.size());
+			}
+
+			// get final hash as 32 hex characters
+			std::string Digest() const
+			{
+				uint64_t a = _Mix(_A ^ _Length), b = _Mix(_B + a);
+				char out[33];
+				snprintf(out, sizeof(out), "%016llx%016llx", (unsigned long long)a, (unsigned long long)b);
+				return std::string(out);
+			}
+		};
+
+		/*!
+		 * \class	CachedRun
+		 *
+		 * \brief	Opt-in memoization for deterministic commands (code generators, linters, etc.).
+		 * 			A run is keyed on its argv, the working directory, selected environment variables, its stdin
+		 * 			and the content of the input files it declares. Results are stored as files named by the key hash, and
+		 * 			a hit returns the stored ProcessOutput without spawning anything.
+		 * 			When the cache exceeds its size limit, least recently used entries are evicted.
+		 * 			Safe to use from multiple threads; multiple processes may share a directory.
+		 *
+		 * \date	10/19/2026
+		 */
+		class CachedRun
+		{
+		public:
+
+			// cache statistics
+			struct Stats
+			{
+				// lookups that were served from cache / had to execute
+				uint64_t Hits = 0;
+				uint64_t Misses = 0;
+
+				// entries written / evicted
+				uint64_t Stores = 0;
+				uint64_t Evictions = 0;
+
+				// wall time the hits took when they were originally executed, in seconds
+				double TimeSaved = 0;
+			};
+
+			/*!
+			 * \fn	CachedRun(const std::string& directory, uint64_t maxBytes = 256 * 1024 * 1024, const std::vector<std::string>& environmentKeys = std::vector<std::string>())
+			 *
+			 * \brief	Constructor.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	directory	   	Cache directory. Created if missing.
+			 * \param	maxBytes	   	(Optional) Max total size of cache entries.
+			 * \param	environmentKeys	(Optional) Names of environment variables that affect results and are part of the key.
+			 */
+			CachedRun(const std::string& directory, uint64_t maxBytes = 256 * 1024 * 1024, const std::vector<std::string>& environmentKeys = std::vector<std::string>())
+				: _Directory(directory), _MaxBytes(maxBytes), _EnvironmentKeys(environmentKeys)
+			{
+				std::error_code error;
+				std::filesystem::create_directories(_Directory, error);
+				_TotalBytes = _Scan(nullptr);
+			}
+
+			/*!
+			 * \fn	ProcessOutput Run(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles = std::vector<std::string>(), const std::string& input = std::string())
+			 *
+			 * \brief	Executes a program directly (see Execute::Run), or return its cached result.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	argv	  	Program and its arguments.
+			 * \param	inputFiles	(Optional) Files the program reads. Their content is part of the key.
+			 * \param	input	  	(Optional) Data to write to program's stdin.
+			 *
+			 * \return	A ProcessOutput, either cached or fresh.
+			 */
+			ProcessOutput Run(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles = std::vector<std::string>(), const std::string& input = std::string())
+			{
+				return _Cached(argv, inputFiles, input, [&]() { return Execute::Run(argv, input, CapturePolicy(), _Options); });
+			}
+
+			/*!
+			 * \fn	ProcessOutput Command(const std::string& command, const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			 *
+			 * \brief	Executes a shell command (see Execute::Command), or return its cached result.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	command   	The command to execute.
+			 * \param	inputFiles	(Optional) Files the command reads. Their content is part of the key.
+			 *
+			 * \return	A ProcessOutput, either cached or fresh.
+			 */
+			ProcessOutput Command(const std::string& command, const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			{
+				return _Cached({ "/bin/sh", "-c", command }, inputFiles, std::string(), [&]() { return Execute::Command(command, CapturePolicy(), _Options); });
+			}
+
+			/*!
+			 * \fn	ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string(), const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			 *
+			 * \brief	Executes a script (see Execute::Script), or return its cached result.
+			 * 			The script file itself is always part of the key.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	scriptType	Type of the script (python / ruby / perl / ...).
+			 * \param	scriptPath	Full path of the script file to execute.
+			 * \param	params	  	(Optional) Script params.
+			 * \param	inputFiles	(Optional) Other files the script reads.
+			 *
+			 * \return	A ProcessOutput, either cached or fresh.
+			 */
+			ProcessOutput Script(const std::string& scriptType, const std::string& scriptPath, const std::string& params = std::string(), const std::vector<std::string>& inputFiles = std::vector<std::string>())
+			{
+				std::vector<std::string> files(inputFiles);
+				files.push_back(scriptPath);
+				return Command(scriptType + " \"" + scriptPath + "\" " + params, files);
+			}
+
+			// set scheduling and resource hints for executed processes. hints are not part of the key
+			inline void SetOptions(const Options& options) { _Options = options; }
+
+			// set if runs that did not succeed are cached too (default: true, failures of a deterministic tool are results as well)
+			inline void SetCacheFailures(bool cacheFailures) { _CacheFailures = cacheFailures; }
+
+			// get cache statistics
+			inline Stats GetStats() const
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				return _Stats;
+			}
+
+			// get current estimated size of cache entries, in bytes
+			inline uint64_t GetSize() const { return _TotalBytes.load(); }
+
+			/*!
+			 * \fn	void Clear()
+			 *
+			 * \brief	Delete all cache entries.
+			 *
+			 * \date	10/19/2026
+			 */
+			void Clear()
+			{
+				std::error_code error;
+				for (auto& entry : std::filesystem::directory_iterator(_Directory, error))
+				{
+					if (entry.is_directory(error)) std::filesystem::remove_all(entry.path(), error);
+				}
+				_TotalBytes = 0;
+			}
+
+		private:
+
+			// entry file header
+			struct __EntryHeader
+			{
+				uint32_t Magic;
+				uint32_t Version;
+				int32_t ReturnCode;
+				int32_t DidFinish;
+				ProcessUsage Usage;
+				uint64_t OutputSize;
+			};
+			static_assert(std::is_trivially_copyable<ProcessUsage>::value, "ProcessUsage is stored as raw bytes.");
+			static constexpr uint32_t _Magic = 0x4A435231; // 'JCR1'
+			static constexpr uint32_t _Version = 1;
+
+			// temp files older than this are left over by a crashed writer even if their pid was reused
+			static constexpr auto _StaleTempAge = std::chrono::hours(1);
+
+			// content hash of a file, cached by (path, size, mtime) so unchanged files are not hashed again
+			struct __FileHash
+			{
+				off_t Size;
+				struct timespec ModifyTime;
+				std::string Hash;
+			};
+
+			std::string _Directory;
+			uint64_t _MaxBytes;
+			std::vector<std::string> _EnvironmentKeys;
+			bool _CacheFailures = true;
+			Options _Options;
+			std::atomic<uint64_t> _TotalBytes{ 0 };
+			std::atomic<uint64_t> _TempCounter{ 0 };
+			mutable std::mutex _Mutex;
+			Stats _Stats;
+			std::unordered_map<std::string, __FileHash> _FileHashes;
+
+			// hash file content, or return empty string if file is missing
+			std::string _HashFile(const std::string& path)
+			{
+				struct stat info;
+				if (stat(path.c_str(), &info) != 0) return std::string();
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					auto found = _FileHashes.find(path);
+					if (found != _FileHashes.end() && found->second.Size == info.st_size &&
+						found->second.ModifyTime.tv_sec == info.st_mtim.tv_sec && found->second.ModifyTime.tv_nsec == info.st_mtim.tv_nsec)
+					{
+						return found->second.Hash;
+					}
+				}
+
+				FILE* file = fopen(path.c_str(), "rb");
+				if (!file) return std::string();
+				__ContentHasher hasher;
+				std::vector<char> buffer(1024 * 1024);
+				size_t count;
+				while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0) hasher.Update(buffer.data(), count);
+				fclose(file);
+
+				std::string ret = hasher.Digest();
+				std::lock_guard<std::mutex> lock(_Mutex);
+				_FileHashes[path] = __FileHash{ info.st_size, info.st_mtim, ret };
+				return ret;
+			}
+
+			// build the key hash of a run
+			std::string _Key(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles, const std::string& input)
+			{
+				__ContentHasher hasher;
+				hasher.Update(std::string("argv"));
+				for (const auto& arg : argv) hasher.Update(arg);
+
+				// relative paths in argv and input files mean something else in another directory
+				std::error_code error;
+				hasher.Update(std::string("cwd"));
+				hasher.Update(std::filesystem::current_path(error).string());
+				hasher.Update(std::string("env"));
+				for (const auto& key : _EnvironmentKeys)
+				{
+					const char* value = getenv(key.c_str());
+					hasher.Update(key);
+					hasher.Update(value ? std::string("=") + value : std::string("unset"));
+				}
+				hasher.Update(std::string("stdin"));
+				hasher.Update(input);
+				hasher.Update(std::string("files"));
+				for (const auto& path : inputFiles)
+				{
+					hasher.Update(path);
+					hasher.Update(_HashFile(path));
+				}
+				return hasher.Digest();
+			}
+
+			// get entry file path from key
+			inline std::string _EntryPath(const std::string& key) const
+			{
+				return _Directory + "/" + key.substr(0, 2) + "/" + key.substr(2);
+			}
+
+			// try to load an entry; touches it on success so it counts as recently used
+			bool _Load(const std::string& path, ProcessOutput& out) const
+			{
+				FILE* file = fopen(path.c_str(), "rb");
+				if (!file) return false;
+				__EntryHeader header;
+				bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.Magic == _Magic && header.Version == _Version;
+				if (ok)
+				{
+					out.Output.resize((size_t)header.OutputSize);
+					ok = header.OutputSize == 0 || fread(&out.Output[0], 1, (size_t)header.OutputSize, file) == header.OutputSize;
+				}
+				fclose(file);
+				if (!ok) return false;
+
+				out.ReturnCode = header.ReturnCode;
+				out.DidFinish = header.DidFinish != 0;
+				out.Usage = header.Usage;
+				utimensat(AT_FDCWD, path.c_str(), NULL, 0);
+				return true;
+			}
+
+			// store an entry, writing to a temp file and renaming so readers never see partial entries
+			void _Store(const std::string& key, const ProcessOutput& output)
+			{
+				std::string path = _EntryPath(key);
+				std::error_code error;
+				std::filesystem::create_directories(_Directory + "/" + key.substr(0, 2), error);
+
+				std::string tempPath = path + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(_TempCounter++);
+				FILE* file = fopen(tempPath.c_str(), "wb");
+				if (!file) return;
+				__EntryHeader header{};
+				header.Magic = _Magic;
+				header.Version = _Version;
+				header.ReturnCode = output.ReturnCode;
+				header.DidFinish = output.DidFinish ? 1 : 0;
+				header.Usage = output.Usage;
+				header.OutputSize = output.Output.size();
+				bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+					fwrite(output.Output.data(), 1, output.Output.size(), file) == output.Output.size();
+				ok = (fclose(file) == 0) && ok;
+				if (!ok || rename(tempPath.c_str(), path.c_str()) != 0)
+				{
+					remove(tempPath.c_str());
+					return;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					_Stats.Stores++;
+				}
+				if ((_TotalBytes += sizeof(header) + output.Output.size()) > _MaxBytes) _Evict();
+			}
+
+			// return if a temp file (<key>.tmp<pid>_<n>) was left by a writer that crashed: its pid is gone, or it is too old
+			static bool _IsStaleTemp(const std::string& name, std::filesystem::file_time_type modified)
+			{
+				size_t found = name.rfind(".tmp");
+				pid_t pid = (pid_t)strtol(name.c_str() + found + 4, nullptr, 10);
+				if (pid > 0 && kill(pid, 0) == -1 && errno == ESRCH) return true;
+				return std::filesystem::file_time_type::clock::now() - modified > _StaleTempAge;
+			}
+
+			// scan all entries, returning their total size and optionally listing them.
+			// deletes temp files crashed writers left; skips the ones other processes are still writing
+			uint64_t _Scan(std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>>* entries)
+			{
+				uint64_t total = 0;
+				std::error_code error;
+				for (auto it = std::filesystem::recursive_directory_iterator(_Directory, error);
+					!error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+				{
+					if (!it->is_regular_file(error)) continue;
+					std::string name = it->path().filename().string();
+					if (name.find(".tmp") != std::string::npos)
+					{
+						std::error_code tempError;
+						auto modified = it->last_write_time(tempError);
+						if (!tempError && _IsStaleTemp(name, modified)) std::filesystem::remove(it->path(), tempError);
+						continue;
+					}
+					total += it->file_size(error);
+					if (entries) entries->push_back(std::make_pair(it->last_write_time(error), it->path()));
+				}
+				return total;
+			}
+
+			// evict least recently used entries until cache is at 90% of its limit
+			void _Evict()
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+				std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+				uint64_t total = _Scan(&entries);
+				std::sort(entries.begin(), entries.end());
+
+				uint64_t target = _MaxBytes / 10 * 9;
+				std::error_code error;
+				for (const auto& entry : entries)
+				{
+					if (total <= target) break;
+					uint64_t size = std::filesystem::file_size(entry.second, error);
+					if (!error && std::filesystem::remove(entry.second, error))
+					{
+						total -= size;
+						_Stats.Evictions++;
+					}
+				}
+				_TotalBytes = total;
+			}
+
+			// lookup or execute and store
+			template <typename Runner>
+			ProcessOutput _Cached(const std::vector<std::string>& argv, const std::vector<std::string>& inputFiles, const std::string& input, Runner execute)
+			{
+				std::string key = _Key(argv, inputFiles, input);
+				ProcessOutput ret;
+				if (_Load(_EntryPath(key), ret))
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					_Stats.Hits++;
+					_Stats.TimeSaved += ret.Usage.WallTime;
+					return ret;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(_Mutex);
+					_Stats.Misses++;
+				}
+				ret = execute();
+				if (ret.DidFinish && (_CacheFailures || ret.IsSuccess())) _Store(key, ret);
+				return ret;
+			}
+		};
+	}
+}
+#endif
@@ -5,15 +5,77 @@
  */
 #pragma once
 
-#ifdef _WIN32
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#endif
 
 namespace Just
 {
 	namespace Execute
 	{
+		/*!
+		 * \struct	ProcessUsage
+		 *
+		 * \brief	Resources an executed process consumed.
+		 * 			On Windows only the wall time is collected.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct ProcessUsage
+		{
+			// wall-clock time from spawn until the process was collected, in seconds
+			double WallTime = 0;
+
+			// CPU time spent in user mode and in kernel mode, in seconds
+			double UserTime = 0;
+			double SystemTime = 0;
+
+			// peak resident set size, in kilobytes
+			long long MaxRss = 0;
+
+			// page faults serviced without I/O (minor) and with I/O (major)
+			long long MinorFaults = 0;
+			long long MajorFaults = 0;
+
+			// block input / output operations
+			long long BlockReads = 0;
+			long long BlockWrites = 0;
+
+			// voluntary (waiting on something) and involuntary (preempted) context switches
+			long long VoluntarySwitches = 0;
+			long long InvoluntarySwitches = 0;
+
+			// bytes passed to read / write syscalls, and bytes that actually went to / from storage
+			long long ReadChars = 0;
+			long long WriteChars = 0;
+			long long StorageReadBytes = 0;
+			long long StorageWriteBytes = 0;
+
+			// return total CPU time (user + system)
+			inline double CpuTime() const { return UserTime + SystemTime; }
+		};
+
 		/*!
 		 * \struct	ProcessOutput
 		 *
@@ -33,12 +95,290 @@ namespace Just
 			// did process finish executing
 			bool DidFinish = false;
 
+			// resources the process consumed
+			ProcessUsage Usage;
+
+			// how many output bytes were dropped due to capture policy (Output holds the head followed by the tail)
+			unsigned long long DroppedBytes = 0;
+
+			// if output was spilled to a file due to capture policy, path of the file holding the complete output
+			std::string SpillPath;
+
 			// return if executed successfully and was a success
 			inline bool IsSuccess() const { return DidFinish && ReturnCode == 0; }
 		};
 
 		/*!
-		 * \fn	ProcessOutput Command(const std::string& command)
+		 * \struct	CapturePolicy
+		 *
+		 * \brief	How much of a process output to keep in memory.
+		 * 			By default everything is kept. With a byte budget, the first HeadBytes and the last
+		 * 			(MaxBytes - HeadBytes) bytes are kept, and the middle is dropped and counted, so memory
+		 * 			per executed process is bounded while the most useful parts are kept.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct CapturePolicy
+		{
+			// max output bytes to keep in memory, or 0 for unlimited
+			size_t MaxBytes = 0;
+
+			// how many of the MaxBytes are taken from the start of the output; the rest is taken from the end
+			size_t HeadBytes = 0;
+
+			// if not 0, once output exceeds this many bytes the complete output is written to a temp file.
+			// must not exceed MaxBytes (if it does, MaxBytes is used instead).
+			size_t SpillThreshold = 0;
+
+			// directory to create spill files in
+			std::string SpillDirectory = "/tmp";
+
+			// create a policy that keeps the first head bytes and the last tail bytes
+			static inline CapturePolicy HeadTail(size_t head, size_t tail)
+			{
+				CapturePolicy ret;
+				ret.MaxBytes = head + tail;
+				ret.HeadBytes = head;
+				return ret;
+			}
+		};
+
+		/*!
+		 * \class	__OutputCapture
+		 *
+		 * \brief	Used internally, collect process output according to a capture policy.
+		 * 			The tail is kept in a fixed-size ring buffer.
+		 */
+		class __OutputCapture
+		{
+			CapturePolicy _Policy;
+			size_t _HeadLimit;
+			size_t _TailLimit;
+			std::string _Head;
+			std::string _Tail;
+			size_t _TailPosition = 0;
+			unsigned long long _Total = 0;
+			FILE* _SpillFile = NULL;
+			std::string _SpillPath;
+
+			// create a temp file to spill output to
+			bool _OpenSpillFile()
+			{
+#ifdef _WIN32
+				char* name = _tempnam(_Policy.SpillDirectory.c_str(), "just_output_");
+				if (!name) return false;
+				_SpillPath = name;
+				free(name);
+				_SpillFile = fopen(_SpillPath.c_str(), "wb");
+#else
+				std::string pattern = _Policy.SpillDirectory + "/just_output_XXXXXX";
+				int fd = mkstemp(&pattern[0]);
+				if (fd == -1) return false;
+				_SpillPath = pattern;
+				_SpillFile = fdopen(fd, "wb");
+				if (!_SpillFile) close(fd);
+#endif
+				return _SpillFile != NULL;
+			}
+
+			// keep data in the tail ring buffer
+			void _AppendTail(const char* data, size_t size)
+			{
+				if (_TailLimit == 0) return;
+				if (size >= _TailLimit)
+				{
+					_Tail.assign(data + size - _TailLimit, _TailLimit);
+					_TailPosition = 0;
+					return;
+				}
+				if (_Tail.size() < _TailLimit)
+				{
+					size_t toAppend = (std::min)(size, _TailLimit - _Tail.size());
+					_Tail.append(data, toAppend);
+					data += toAppend;
+					size -= toAppend;
+					if (size == 0) return;
+				}
+				while (size)
+				{
+					size_t toCopy = (std::min)(size, _TailLimit - _TailPosition);
+					_Tail.replace(_TailPosition, toCopy, data, toCopy);
+					_TailPosition = (_TailPosition + toCopy) % _TailLimit;
+					data += toCopy;
+					size -= toCopy;
+				}
+			}
+
+		public:
+
+			__OutputCapture(const CapturePolicy& policy) : _Policy(policy)
+			{
+				_HeadLimit = (std::min)(policy.HeadBytes, policy.MaxBytes);
+				_TailLimit = policy.MaxBytes - _HeadLimit;
+				if (_Policy.MaxBytes && _Policy.SpillThreshold > _Policy.MaxBytes) _Policy.SpillThreshold = _Policy.MaxBytes;
+				_Tail.reserve(_TailLimit);
+			}
+
+			~__OutputCapture()
+			{
+				if (_SpillFile) fclose(_SpillFile);
+			}
+
+			// add output data
+			void Append(const char* data, size_t size)
+			{
+				// start spilling? write everything we have so far (nothing was dropped yet)
+				if (_Policy.SpillThreshold && !_SpillFile && _SpillPath.empty() && _Total + size > _Policy.SpillThreshold)
+				{
+					if (_OpenSpillFile()) fwrite(_Head.data(), 1, _Head.size(), _SpillFile);
+				}
+				if (_SpillFile) fwrite(data, 1, size, _SpillFile);
+				_Total += size;
+
+				// unlimited
+				if (_Policy.MaxBytes == 0)
+				{
+					_Head.append(data, size);
+					return;
+				}
+
+				// until budget is used, everything goes to head so output stays in order
+				if (_Head.size() < _Policy.MaxBytes && _Total - size == _Head.size())
+				{
+					size_t toAppend = (std::min)(size, _Policy.MaxBytes - _Head.size());
+					_Head.append(data, toAppend);
+					data += toAppend;
+					size -= toAppend;
+					if (size == 0) return;
+
+					// budget exceeded: move whatever is beyond the head limit into the tail ring
+					std::string overflow = _Head.substr(_HeadLimit);
+					_Head.resize(_HeadLimit);
+					_AppendTail(overflow.data(), overflow.size());
+				}
+				_AppendTail(data, size);
+			}
+
+			// move captured output into process output
+			void Finish(ProcessOutput& output)
+			{
+				output.Output = std::move(_Head);
+				if (_TailPosition == 0) output.Output += _Tail;
+				else
+				{
+					output.Output.append(_Tail, _TailPosition, std::string::npos);
+					output.Output.append(_Tail, 0, _TailPosition);
+				}
+				output.DroppedBytes = _Total - output.Output.size();
+				if (_SpillFile)
+				{
+					fclose(_SpillFile);
+					_SpillFile = NULL;
+					output.SpillPath = _SpillPath;
+				}
+			}
+		};
+
+		/*!
+		 * \struct	Options
+		 *
+		 * \brief	Scheduling and resource hints applied to an executed process before it runs its program:
+		 * 			CPU affinity, nice value, I/O priority, scheduling policy and address space / CPU time limits.
+		 * 			Unset fields are inherited from us. Applied on linux only.
+		 * 			If a hint can't be applied (for example raising priority without permission), the process
+		 * 			is not executed and reports exit code 127, like a program that failed to exec.
+		 * 			Trivially copyable, so it can be passed to a child that shares our memory or sent to the spawn server.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct Options
+		{
+			// I/O scheduling class (see ioprio_set)
+			enum class IoClass : int
+			{
+				Unset = 0,
+				RealTime = 1,
+				BestEffort = 2,
+				Idle = 3,
+			};
+
+			// CPU scheduling policy (see sched_setscheduler)
+			enum class Policy : int
+			{
+				Unset = -1,
+				Other = 0,
+				Fifo = 1,
+				RoundRobin = 2,
+				Batch = 3,
+				Idle = 5,
+			};
+
+			// max CPUs the affinity mask can hold
+			static const int MaxCpus = 1024;
+
+			// CPUs the process may run on, as a bit mask. empty mask = inherit
+			unsigned long long CpuMask[MaxCpus / 64] = {};
+
+			// nice value (-20 to 19), if SetNice is true
+			bool SetNice = false;
+			int Nice = 0;
+
+			// I/O priority class, and level inside the class (0 = highest, 7 = lowest)
+			IoClass IoPriorityClass = IoClass::Unset;
+			int IoPriorityLevel = 4;
+
+			// scheduling policy, and static priority for Fifo / RoundRobin (1 to 99)
+			Policy SchedPolicy = Policy::Unset;
+			int SchedPriority = 0;
+
+			// max virtual memory in bytes (RLIMIT_AS), or 0 to inherit
+			unsigned long long MaxAddressSpace = 0;
+
+			// max CPU time in seconds (RLIMIT_CPU), or 0 to inherit
+			unsigned long long MaxCpuSeconds = 0;
+
+			// allow running on a CPU
+			inline Options& AddCpu(int cpu)
+			{
+				if (cpu >= 0 && cpu < MaxCpus) CpuMask[cpu / 64] |= 1ULL << (cpu % 64);
+				return *this;
+			}
+
+			// check if CPU is in affinity mask
+			inline bool HasCpu(int cpu) const
+			{
+				return cpu >= 0 && cpu < MaxCpus && (CpuMask[cpu / 64] & (1ULL << (cpu % 64))) != 0;
+			}
+
+			// return if affinity mask is set
+			inline bool HasAffinity() const
+			{
+				for (auto word : CpuMask) if (word) return true;
+				return false;
+			}
+
+			// return if no hint is set
+			inline bool IsEmpty() const
+			{
+				return !HasAffinity() && !SetNice && IoPriorityClass == IoClass::Unset && SchedPolicy == Policy::Unset && MaxAddressSpace == 0 && MaxCpuSeconds == 0;
+			}
+
+			// create options for background work: lowest nice, idle I/O class and batch scheduling
+			static inline Options Background()
+			{
+				Options ret;
+				ret.SetNice = true;
+				ret.Nice = 19;
+				ret.IoPriorityClass = IoClass::Idle;
+				ret.IoPriorityLevel = 7;
+				ret.SchedPolicy = Policy::Batch;
+				return ret;
+			}
+		};
+
+#ifdef _WIN32
+		/*!
+		 * \fn	ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
 		 *
 		 * \brief	Executes a command.
 		 *
@@ -46,14 +386,19 @@ namespace Just
 		 * \date	10/20/2018
 		 *
 		 * \param	command	The command to execute.
+		 * \param	capture	(Optional) How much of the output to keep.
+		 * \param	options	(Optional) Scheduling and resource hints (ignored on Windows).
 		 *
 		 * \return	A ProcessOutput.
 		 */
-		ProcessOutput Command(const std::string& command)
+		ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
 		{
+			(void)options;
 			ProcessOutput ret;
+			__OutputCapture output(capture);
 			char   psBuffer[128];
 			FILE   *pPipe;
+			auto start = std::chrono::steady_clock::now();
 
 			// run the command
 			if ((pPipe = _popen(command.c_str(), "rt")) == NULL)
@@ -64,8 +409,9 @@ namespace Just
 			// read output
 			while (fgets(psBuffer, 128, pPipe))
 			{
-				ret.Output += psBuffer;
+				output.Append(psBuffer, strlen(psBuffer));
 			}
+			output.Finish(ret);
 
 			// close pipe and print return value of pPipe.
 			if (feof(pPipe))
@@ -75,8 +421,610 @@ namespace Just
 			}
 
 			// return data on execution
+			ret.Usage.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			return ret;
+		}
+#else
+		/*!
+		 * \enum	SpawnMethod
+		 *
+		 * \brief	How child processes are spawned on linux.
+		 * 			Forking copies the page tables of the parent, so its cost grows with the parent's RSS.
+		 * 			The other methods don't copy the address space and their latency does not depend on it.
+		 */
+		enum class SpawnMethod
+		{
+			// classic fork + exec
+			Fork,
+
+			// clone(CLONE_VM | CLONE_VFORK): child borrows parent memory until exec
+			VFork,
+
+			// posix_spawn (on glibc, a vfork-style clone as well)
+			PosixSpawn,
+
+			// ask the pre-forked spawn server to launch the child (see SpawnServer.h).
+			// falls back to PosixSpawn if server is not running.
+			Server,
+		};
+
+		// spawn method to use for all executed processes. atomic, since it may change while other threads spawn
+		inline std::atomic<SpawnMethod> _spawnMethod(SpawnMethod::PosixSpawn);
+
+		/*!
+		 * \fn	inline void SetSpawnMethod(SpawnMethod method)
+		 *
+		 * \brief	Sets how child processes are spawned for all execute functions.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	method	Spawn method.
+		 */
+		inline void SetSpawnMethod(SpawnMethod method)
+		{
+			_spawnMethod.store(method, std::memory_order_release);
+		}
+
+		/*!
+		 * \fn	inline SpawnMethod GetSpawnMethod()
+		 *
+		 * \brief	Gets how child processes are spawned.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \return	Spawn method.
+		 */
+		inline SpawnMethod GetSpawnMethod()
+		{
+			return _spawnMethod.load(std::memory_order_acquire);
+		}
+
+		/*!
+		 * \struct	__Child
+		 *
+		 * \brief	Used internally, a spawned child process.
+		 * 			Children launched by the spawn server are not our children, their exit status
+		 * 			is reported through StatusFd instead.
+		 */
+		struct __Child
+		{
+			// process id, or -1 if failed to spawn
+			pid_t Pid = -1;
+
+			// socket to read exit status from, or -1 if this is our own child
+			int StatusFd = -1;
+
+			// true if program could not be executed; reported as exit code 127 like the shell does
+			bool ExecFailed = false;
+
+			inline bool IsValid() const { return Pid != -1 || ExecFailed; }
+		};
+
+		/*!
+		 * \struct	__ChildStatus
+		 *
+		 * \brief	Used internally, exit status and resource usage of a collected child.
+		 */
+		struct __ChildStatus
+		{
+			int Status;
+			struct rusage Usage;
+			long long ReadChars;
+			long long WriteChars;
+			long long StorageReadBytes;
+			long long StorageWriteBytes;
+		};
+
+		/*!
+		 * \fn	inline void _ReadProcIo(pid_t pid, __ChildStatus& status)
+		 *
+		 * \brief	Used internally, read I/O counters of a process from /proc/<pid>/io.
+		 * 			Must be called before the process is reaped.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	pid   	Process id.
+		 * \param	status	Status to fill.
+		 */
+		inline void _ReadProcIo(pid_t pid, __ChildStatus& status)
+		{
+			char path[64];
+			snprintf(path, sizeof(path), "/proc/%d/io", (int)pid);
+			FILE* file = fopen(path, "r");
+			if (!file) return;
+
+			char name[64];
+			long long value;
+			while (fscanf(file, "%63[^:]: %lld\n", name, &value) == 2)
+			{
+				std::string key(name);
+				if (key == "rchar") status.ReadChars = value;
+				else if (key == "wchar") status.WriteChars = value;
+				else if (key == "read_bytes") status.StorageReadBytes = value;
+				else if (key == "write_bytes") status.StorageWriteBytes = value;
+			}
+			fclose(file);
+		}
+
+		/*!
+		 * \fn	inline bool _WaitChild(pid_t pid, __ChildStatus& status)
+		 *
+		 * \brief	Used internally, wait for one of our child processes to exit and reap it.
+		 * 			The child is first waited without being reaped, so its /proc entry can still be read.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	pid   	Child process id.
+		 * \param	status	Status to fill.
+		 *
+		 * \return	True if child was reaped.
+		 */
+		inline bool _WaitChild(pid_t pid, __ChildStatus& status)
+		{
+			memset(&status, 0, sizeof(status));
+
+			// wait for exit, but leave the child as a zombie so we can read its I/O counters
+			siginfo_t info;
+			while (waitid(P_PID, (id_t)pid, &info, WEXITED | WNOWAIT) == -1 && errno == EINTR) {}
+			_ReadProcIo(pid, status);
+
+			// reap it and get its resource usage
+			pid_t result;
+			while ((result = wait4(pid, &status.Status, 0, &status.Usage)) == -1 && errno == EINTR) {}
+			return result == pid;
+		}
+
+		/*!
+		 * \fn	inline void _CollectProcess(const __Child& child, std::chrono::steady_clock::time_point start, ProcessOutput& ret)
+		 *
+		 * \brief	Used internally, wait for a child process to exit and fill its return code and resource usage.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	child	Spawned child.
+		 * \param	start	When the child was spawned.
+		 * \param	ret  	Output to fill.
+		 */
+		inline void _CollectProcess(const __Child& child, std::chrono::steady_clock::time_point start, ProcessOutput& ret)
+		{
+			__ChildStatus status;
+			bool collected;
+			if (child.ExecFailed)
+			{
+				memset(&status, 0, sizeof(status));
+				status.Status = 127 << 8;
+				collected = true;
+			}
+			else if (child.StatusFd == -1)
+			{
+				collected = _WaitChild(child.Pid, status);
+			}
+			else
+			{
+				ssize_t count;
+				while ((count = read(child.StatusFd, &status, sizeof(status))) == -1 && errno == EINTR) {}
+				collected = count == (ssize_t)sizeof(status);
+				close(child.StatusFd);
+			}
+			ret.Usage.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (!collected) return;
+
+			const struct rusage& usage = status.Usage;
+			ret.Usage.UserTime = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+			ret.Usage.SystemTime = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+			ret.Usage.MaxRss = usage.ru_maxrss;
+			ret.Usage.MinorFaults = usage.ru_minflt;
+			ret.Usage.MajorFaults = usage.ru_majflt;
+			ret.Usage.BlockReads = usage.ru_inblock;
+			ret.Usage.BlockWrites = usage.ru_oublock;
+			ret.Usage.VoluntarySwitches = usage.ru_nvcsw;
+			ret.Usage.InvoluntarySwitches = usage.ru_nivcsw;
+			ret.Usage.ReadChars = status.ReadChars;
+			ret.Usage.WriteChars = status.WriteChars;
+			ret.Usage.StorageReadBytes = status.StorageReadBytes;
+			ret.Usage.StorageWriteBytes = status.StorageWriteBytes;
+
+			// killed by signal are reported like the shell does (128 + signal)
+			if (WIFEXITED(status.Status)) ret.ReturnCode = WEXITSTATUS(status.Status);
+			else if (WIFSIGNALED(status.Status)) ret.ReturnCode = 128 + WTERMSIG(status.Status);
+			ret.DidFinish = true;
+		}
+
+		/*!
+		 * \fn	inline std::string _ResolveProgram(const std::string& program)
+		 *
+		 * \brief	Used internally, search a program in PATH (like execvp does).
+		 * 			Done in the parent, so the child only has to call execve.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	program	Program name or path.
+		 *
+		 * \return	Path to program, or the program as-is if not found (exec will fail on it).
+		 */
+		inline std::string _ResolveProgram(const std::string& program)
+		{
+			if (program.empty() || program.find('/') != std::string::npos) return program;
+			const char* path = getenv("PATH");
+			std::string paths = path ? path : "/usr/local/bin:/bin:/usr/bin";
+			size_t begin = 0;
+			while (begin <= paths.size())
+			{
+				size_t end = paths.find(':', begin);
+				if (end == std::string::npos) end = paths.size();
+				std::string folder = paths.substr(begin, end - begin);
+				std::string candidate = (folder.empty() ? std::string(".") : folder) + "/" + program;
+				if (access(candidate.c_str(), X_OK) == 0) return candidate;
+				begin = end + 1;
+			}
+			return program;
+		}
+
+		/*!
+		 * \fn	inline void _SetCloseOnExec(int fd, bool value)
+		 *
+		 * \brief	Used internally, set or clear the close-on-exec flag of a file descriptor.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	fd   	File descriptor.
+		 * \param	value	Whether to close on exec.
+		 */
+		inline void _SetCloseOnExec(int fd, bool value)
+		{
+			int flags = fcntl(fd, F_GETFD);
+			if (flags == -1) return;
+			fcntl(fd, F_SETFD, value ? (flags | FD_CLOEXEC) : (flags & ~FD_CLOEXEC));
+		}
+
+		/*!
+		 * \struct	__ExecArgs
+		 *
+		 * \brief	Used internally, everything a child needs to exec, prepared before spawning
+		 * 			so the child itself only makes async-signal-safe calls.
+		 */
+		struct __ExecArgs
+		{
+			const char* Path;
+			char* const* Argv;
+			char* const* Envp;
+			int StdinFd;
+			int StdoutFd;
+			sigset_t SignalMask;
+
+			// scheduling and resource hints to apply, or NULL for none
+			const Options* Hints;
+
+			// set by a child that shares our memory if exec failed
+			volatile int Error;
+		};
+
+		/*!
+		 * \fn	inline bool _ApplyOptions(const Options& options)
+		 *
+		 * \brief	Used internally, runs in the spawned child: apply scheduling and resource hints to the calling process.
+		 * 			Only makes raw syscalls, so it is safe to call in a child that shares our memory.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	options	Hints to apply.
+		 *
+		 * \return	True if all hints were applied (errno is set otherwise).
+		 */
+		inline bool _ApplyOptions(const Options& options)
+		{
+			if (options.MaxAddressSpace)
+			{
+				struct rlimit limit;
+				limit.rlim_cur = limit.rlim_max = (rlim_t)options.MaxAddressSpace;
+				if (setrlimit(RLIMIT_AS, &limit) != 0) return false;
+			}
+			if (options.MaxCpuSeconds)
+			{
+				struct rlimit limit;
+				limit.rlim_cur = limit.rlim_max = (rlim_t)options.MaxCpuSeconds;
+				if (setrlimit(RLIMIT_CPU, &limit) != 0) return false;
+			}
+			if (options.SchedPolicy != Options::Policy::Unset)
+			{
+				struct sched_param param;
+				param.sched_priority = options.SchedPriority;
+				if (sched_setscheduler(0, (int)options.SchedPolicy, &param) != 0) return false;
+			}
+			if (options.SetNice && setpriority(PRIO_PROCESS, 0, options.Nice) != 0) return false;
+			if (options.IoPriorityClass != Options::IoClass::Unset)
+			{
+				// IOPRIO_WHO_PROCESS, class in the top bits (IOPRIO_CLASS_SHIFT = 13)
+				int priority = ((int)options.IoPriorityClass << 13) | (options.IoPriorityLevel & 7);
+				if (syscall(SYS_ioprio_set, 1, 0, priority) != 0) return false;
+			}
+			if (options.HasAffinity() && syscall(SYS_sched_setaffinity, 0, sizeof(options.CpuMask), options.CpuMask) != 0) return false;
+			return true;
+		}
+
+		/*!
+		 * \fn	inline void _ExecChild(const __ExecArgs& args)
+		 *
+		 * \brief	Used internally, runs in the spawned child: set standard streams, apply hints and exec.
+		 * 			Never returns; if hints or exec fail the child exits with code 127.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	args	Exec args.
+		 */
+		inline void _ExecChild(const __ExecArgs& args)
+		{
+			if (args.StdinFd != -1)
+			{
+				if (args.StdinFd == STDIN_FILENO) _SetCloseOnExec(args.StdinFd, false);
+				else dup2(args.StdinFd, STDIN_FILENO);
+			}
+			if (args.StdoutFd != -1)
+			{
+				if (args.StdoutFd == STDOUT_FILENO) _SetCloseOnExec(args.StdoutFd, false);
+				else dup2(args.StdoutFd, STDOUT_FILENO);
+			}
+			if (args.Hints && !_ApplyOptions(*args.Hints))
+			{
+				const_cast<__ExecArgs&>(args).Error = errno;
+				_exit(127);
+			}
+			pthread_sigmask(SIG_SETMASK, &args.SignalMask, NULL);
+			execve(args.Path, args.Argv, args.Envp);
+			const_cast<__ExecArgs&>(args).Error = errno;
+			_exit(127);
+		}
+
+		/*!
+		 * \fn	inline int _CloneChildEntry(void* arg)
+		 *
+		 * \brief	Used internally, entry point of a child spawned with clone(CLONE_VM | CLONE_VFORK).
+		 * 			The child shares our memory but has its own copy of signal handlers, which are reset
+		 * 			before signals are unblocked so none of our handlers can run in it.
+		 *
+		 * \date	10/19/2026
+		 */
+		inline int _CloneChildEntry(void* arg)
+		{
+			const __ExecArgs& args = *(const __ExecArgs*)arg;
+			for (int sig = 1; sig < NSIG; ++sig)
+			{
+				struct sigaction action;
+				if (sigaction(sig, NULL, &action) == 0 && action.sa_handler != SIG_IGN && action.sa_handler != SIG_DFL)
+				{
+					action.sa_handler = SIG_DFL;
+					action.sa_flags = 0;
+					sigaction(sig, &action, NULL);
+				}
+			}
+			_ExecChild(args);
+			return 127;
+		}
+
+		// hook to launch a process through the spawn server, set while it is running (see SpawnServer.h).
+		// atomic, since the server starts and stops while other threads spawn
+		typedef __Child (*__SpawnServerLaunch)(const std::string& path, const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options);
+		inline std::atomic<__SpawnServerLaunch> _spawnServerLaunch(nullptr);
+
+		/*!
+		 * \fn	inline __Child _Spawn(const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options = Options())
+		 *
+		 * \brief	Used internally, spawn a child process running argv (searched in PATH), using the current spawn method.
+		 * 			All descriptors we create are close-on-exec, so the child only inherits its
+		 * 			standard streams. If exec fails the child exits with code 127.
+		 * 			posix_spawn can't apply our hints, so VFork is used instead when any hint is set.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	argv		Program and its arguments.
+		 * \param	stdinFd 	Descriptor to use as child's stdin, or -1 to inherit ours.
+		 * \param	stdoutFd	Descriptor to use as child's stdout, or -1 to inherit ours.
+		 * \param	options 	(Optional) Scheduling and resource hints for the child.
+		 *
+		 * \return	Spawned child (invalid on failure).
+		 */
+		inline __Child _Spawn(const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options = Options())
+		{
+			__Child ret;
+			if (argv.empty()) return ret;
+			std::string path = _ResolveProgram(argv[0]);
+			SpawnMethod method = _spawnMethod.load(std::memory_order_acquire);
+
+			// launch through spawn server if running
+			if (method == SpawnMethod::Server)
+			{
+				auto launch = _spawnServerLaunch.load(std::memory_order_acquire);
+				if (launch)
+				{
+					ret = launch(path, argv, stdinFd, stdoutFd, options);
+					if (ret.IsValid()) return ret;
+				}
+				method = SpawnMethod::PosixSpawn;
+			}
+			bool hasHints = !options.IsEmpty();
+			if (method == SpawnMethod::PosixSpawn && hasHints) method = SpawnMethod::VFork;
+
+			// prepare everything exec needs before spawning
+			std::vector<char*> args;
+			for (const auto& arg : argv) args.push_back(const_cast<char*>(arg.c_str()));
+			args.push_back(NULL);
+			__ExecArgs exec;
+			exec.Path = path.c_str();
+			exec.Argv = args.data();
+			exec.Envp = environ;
+			exec.StdinFd = stdinFd;
+			exec.StdoutFd = stdoutFd;
+			exec.Hints = hasHints ? &options : NULL;
+
+			if (method == SpawnMethod::PosixSpawn)
+			{
+				posix_spawn_file_actions_t actions;
+				posix_spawn_file_actions_init(&actions);
+				if (stdinFd != -1) posix_spawn_file_actions_adddup2(&actions, stdinFd, STDIN_FILENO);
+				if (stdoutFd != -1) posix_spawn_file_actions_adddup2(&actions, stdoutFd, STDOUT_FILENO);
+				pid_t pid;
+				int error = posix_spawn(&pid, exec.Path, &actions, NULL, exec.Argv, exec.Envp);
+				posix_spawn_file_actions_destroy(&actions);
+
+				if (error == 0) ret.Pid = pid;
+				else ret.ExecFailed = error != ENOMEM && error != EAGAIN;
+				return ret;
+			}
+
+			// block all signals while spawning so no handler runs in the child before exec
+			sigset_t all;
+			sigfillset(&all);
+			pthread_sigmask(SIG_SETMASK, &all, &exec.SignalMask);
+			if (method == SpawnMethod::VFork)
+			{
+				const size_t stackSize = 64 * 1024;
+				std::vector<char> stack(stackSize);
+				exec.Error = 0;
+				ret.Pid = clone(_CloneChildEntry, stack.data() + stackSize, CLONE_VM | CLONE_VFORK | SIGCHLD, &exec);
+
+				// child shares our memory, so we know if exec failed; reap it right away
+				if (ret.Pid > 0 && exec.Error != 0)
+				{
+					__ChildStatus status;
+					_WaitChild(ret.Pid, status);
+					ret.Pid = -1;
+					ret.ExecFailed = true;
+				}
+			}
+			else
+			{
+				ret.Pid = fork();
+				if (ret.Pid == 0) _ExecChild(exec);
+			}
+			pthread_sigmask(SIG_SETMASK, &exec.SignalMask, NULL);
+			if (ret.Pid < 0) ret.Pid = -1;
+			return ret;
+		}
+
+		/*!
+		 * \fn	inline void _Communicate(int inFd, const std::string& input, int outFd, __OutputCapture& output)
+		 *
+		 * \brief	Used internally, write input to a child while reading its output, until the output is closed.
+		 * 			Both descriptors are closed when done. SIGPIPE raised by writing to a child that
+		 * 			stopped reading is swallowed.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	inFd  	Write end of child's stdin, or -1 for none.
+		 * \param	input 	Data to write to child's stdin.
+		 * \param	outFd 	Read end of child's stdout.
+		 * \param	output	Capture to append output to.
+		 */
+		inline void _Communicate(int inFd, const std::string& input, int outFd, __OutputCapture& output)
+		{
+			// block SIGPIPE while writing, remembering if one was already pending
+			sigset_t blockSet, oldSet, pending;
+			sigemptyset(&blockSet);
+			sigaddset(&blockSet, SIGPIPE);
+			pthread_sigmask(SIG_BLOCK, &blockSet, &oldSet);
+			sigpending(&pending);
+			bool wasPending = sigismember(&pending, SIGPIPE);
+
+			// nothing to write? close stdin right away so child sees EOF
+			size_t written = 0;
+			if (inFd != -1 && input.empty())
+			{
+				close(inFd);
+				inFd = -1;
+			}
+			if (inFd != -1) fcntl(inFd, F_SETFL, fcntl(inFd, F_GETFL) | O_NONBLOCK);
+
+			char buffer[64 * 1024];
+			while (outFd != -1)
+			{
+				struct pollfd fds[2];
+				int count = 0;
+				fds[count].fd = outFd; fds[count].events = POLLIN; fds[count].revents = 0; count++;
+				if (inFd != -1) { fds[count].fd = inFd; fds[count].events = POLLOUT; fds[count].revents = 0; count++; }
+				if (poll(fds, count, -1) < 0)
+				{
+					if (errno == EINTR) continue;
+					break;
+				}
+
+				// feed input
+				if (count > 1 && fds[1].revents)
+				{
+					ssize_t result = write(inFd, input.data() + written, input.size() - written);
+					if (result > 0) written += (size_t)result;
+					if ((result < 0 && errno != EAGAIN && errno != EINTR) || written == input.size())
+					{
+						close(inFd);
+						inFd = -1;
+					}
+				}
+
+				// read output
+				if (fds[0].revents)
+				{
+					ssize_t result = read(outFd, buffer, sizeof(buffer));
+					if (result > 0) output.Append(buffer, (size_t)result);
+					else if (result == 0 || (errno != EAGAIN && errno != EINTR))
+					{
+						close(outFd);
+						outFd = -1;
+					}
+				}
+			}
+			if (inFd != -1) close(inFd);
+			if (outFd != -1) close(outFd);
+
+			// consume SIGPIPE we caused and restore mask
+			sigpending(&pending);
+			if (!wasPending && sigismember(&pending, SIGPIPE))
+			{
+				struct timespec zero = { 0, 0 };
+				sigtimedwait(&blockSet, NULL, &zero);
+			}
+			pthread_sigmask(SIG_SETMASK, &oldSet, NULL);
+		}
+
+		/*!
+		 * \fn	inline ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		 *
+		 * \brief	Executes a command via /bin/sh, capturing its stdout and resource usage.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	command	The command to execute.
+		 * \param	capture	(Optional) How much of the output to keep.
+		 * \param	options	(Optional) Scheduling and resource hints for the process.
+		 *
+		 * \return	A ProcessOutput.
+		 */
+		inline ProcessOutput Command(const std::string& command, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		{
+			ProcessOutput ret;
+
+			// create pipe for child output
+			int fds[2];
+			if (pipe2(fds, O_CLOEXEC) != 0)
+			{
+				return ret;
+			}
+
+			// run the command
+			auto start = std::chrono::steady_clock::now();
+			__Child child = _Spawn({ "/bin/sh", "-c", command }, -1, fds[1], options);
+			close(fds[1]);
+			if (!child.IsValid())
+			{
+				close(fds[0]);
+				return ret;
+			}
+
+			// read output, wait for process and return data on execution
+			__OutputCapture output(capture);
+			_Communicate(-1, std::string(), fds[0], output);
+			output.Finish(ret);
+			_CollectProcess(child, start, ret);
 			return ret;
 		}
+#endif
 	}
 }
-#endif
\ No newline at end of file
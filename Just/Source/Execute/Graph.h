@@ -0,0 +1,473 @@
+/*!
+ * \file	Source\Execute\Graph.h.
+ *
+ * \brief	Execute a graph of dependent jobs in parallel, skipping jobs that are up to date.
+ */
+#pragma once
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Command.h"
+#include "Pipeline.h"
+#include "CachedRun.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \class	Graph
+		 *
+		 * \brief	A tiny embedded make: jobs declare their dependencies, input and output files, and run
+		 * 			on a bounded number of threads. Ready jobs on the longest remaining path (critical path)
+		 * 			start first, using durations recorded on previous runs as estimates.
+		 * 			A job is skipped when its outputs are up to date, either by modification time or by
+		 * 			content hash of its inputs.
+		 *
+		 * \date	10/19/2026
+		 */
+		class Graph
+		{
+		public:
+
+			// how to decide if a job is up to date
+			enum class UpToDateCheck
+			{
+				// outputs exist and are newer than all inputs, and no dependency ran
+				ModifyTime,
+
+				// outputs exist and the command and input contents did not change since it last succeeded
+				Hash,
+			};
+
+			// a job to execute
+			struct Job
+			{
+				// unique job name
+				std::string Name;
+
+				// program and arguments to run without a shell; if empty, Command is used
+				std::vector<std::string> Argv;
+
+				// shell command to run if Argv is empty
+				std::string Command;
+
+				// names of jobs that must succeed before this job starts
+				std::vector<std::string> Dependencies;
+
+				// files this job reads and writes. jobs without outputs always run
+				std::vector<std::string> Inputs;
+				std::vector<std::string> Outputs;
+
+				// how much of the job output to keep
+				CapturePolicy Capture;
+
+				// scheduling and resource hints for the job process
+				Execute::Options Options;
+			};
+
+			// what happened to a job
+			enum class JobStatus
+			{
+				NotRun,
+				Skipped,
+				Succeeded,
+				Failed,
+				Blocked,
+			};
+
+			// result of a single job
+			struct JobResult
+			{
+				std::string Name;
+				JobStatus Status = JobStatus::NotRun;
+				ProcessOutput Output;
+			};
+
+			// result of running the graph
+			struct Result
+			{
+				// true if no job failed or was blocked
+				bool Success = false;
+
+				// error in the graph itself (unknown dependency, cycle), empty if none
+				std::string Error;
+
+				// results in the order jobs were added
+				std::vector<JobResult> Jobs;
+
+				// total wall time, in seconds
+				double WallTime = 0;
+			};
+
+			/*!
+			 * \fn	Graph(const std::string& stateFile = std::string(), UpToDateCheck check = UpToDateCheck::ModifyTime)
+			 *
+			 * \brief	Constructor.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	stateFile	(Optional) File to load and save job durations and hashes, used as scheduling hints
+			 * 						and for hash based up-to-date checks. If empty, nothing is persisted.
+			 * \param	check		(Optional) How to decide if a job is up to date.
+			 */
+			Graph(const std::string& stateFile = std::string(), UpToDateCheck check = UpToDateCheck::ModifyTime)
+				: _StateFile(stateFile), _Check(check)
+			{
+				_LoadState();
+			}
+
+			/*!
+			 * \fn	void Add(const Job& job)
+			 *
+			 * \brief	Add a job. Dependencies may be added after the jobs that depend on them.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	job	Job to add.
+			 */
+			void Add(const Job& job)
+			{
+				_Jobs.push_back(job);
+			}
+
+			/*!
+			 * \fn	void AddCommand(const std::string& name, const std::string& command, const std::vector<std::string>& dependencies = std::vector<std::string>(), const std::vector<std::string>& inputs = std::vector<std::string>(), const std::vector<std::string>& outputs = std::vector<std::string>())
+			 *
+			 * \brief	Add a job that runs a shell command.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	name			Unique job name.
+			 * \param	command			Shell command.
+			 * \param	dependencies	(Optional) Names of jobs to run first.
+			 * \param	inputs			(Optional) Files the job reads.
+			 * \param	outputs			(Optional) Files the job writes.
+			 */
+			void AddCommand(const std::string& name, const std::string& command, const std::vector<std::string>& dependencies = std::vector<std::string>(), const std::vector<std::string>& inputs = std::vector<std::string>(), const std::vector<std::string>& outputs = std::vector<std::string>())
+			{
+				Job job;
+				job.Name = name;
+				job.Command = command;
+				job.Dependencies = dependencies;
+				job.Inputs = inputs;
+				job.Outputs = outputs;
+				Add(job);
+			}
+
+			/*!
+			 * \fn	Result Run(size_t maxParallel = 0, bool keepGoing = false)
+			 *
+			 * \brief	Run all jobs that are not up to date.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	maxParallel	(Optional) Max jobs to run at once, 0 for number of CPUs.
+			 * \param	keepGoing  	(Optional) If true keep starting independent jobs after a failure (like make -k).
+			 *
+			 * \return	A Result.
+			 */
+			Result Run(size_t maxParallel = 0, bool keepGoing = false)
+			{
+				auto start = std::chrono::steady_clock::now();
+				Result ret;
+				ret.Jobs.resize(_Jobs.size());
+				for (size_t i = 0; i < _Jobs.size(); ++i) ret.Jobs[i].Name = _Jobs[i].Name;
+				if (!_BuildEdges(ret.Error)) return ret;
+
+				// critical path priorities: own estimated duration + longest path through dependents
+				std::vector<double> priority(_Jobs.size(), -1);
+				std::function<double(size_t)> pathLength = [&](size_t job) -> double {
+					if (priority[job] >= 0) return priority[job];
+					double longest = 0;
+					for (size_t dependent : _Dependents[job]) longest = (std::max)(longest, pathLength(dependent));
+					return priority[job] = _EstimatedDuration(_Jobs[job].Name) + longest;
+				};
+				for (size_t i = 0; i < _Jobs.size(); ++i) pathLength(i);
+
+				// ready queue, highest priority first
+				auto compare = [&](size_t a, size_t b) { return priority[a] < priority[b]; };
+				std::priority_queue<size_t, std::vector<size_t>, decltype(compare)> ready(compare);
+				std::vector<size_t> remaining(_Jobs.size());
+				std::vector<bool> dependencyRan(_Jobs.size(), false);
+				for (size_t i = 0; i < _Jobs.size(); ++i)
+				{
+					remaining[i] = _Jobs[i].Dependencies.size();
+					if (remaining[i] == 0) ready.push(i);
+				}
+
+				std::mutex& mutex = _StateMutex;
+				std::condition_variable changed;
+				size_t running = 0, done = 0;
+				bool failed = false;
+
+				// mark job and everything depending on it as blocked
+				std::function<void(size_t)> block = [&](size_t job) {
+					for (size_t dependent : _Dependents[job])
+					{
+						if (ret.Jobs[dependent].Status != JobStatus::NotRun) continue;
+						ret.Jobs[dependent].Status = JobStatus::Blocked;
+						done++;
+						block(dependent);
+					}
+				};
+
+				auto worker = [&]() {
+					std::unique_lock<std::mutex> lock(mutex);
+					while (true)
+					{
+						changed.wait(lock, [&]() { return done == _Jobs.size() || (!ready.empty() && (keepGoing || !failed)) || (running == 0 && (failed && !keepGoing)); });
+						if (done == _Jobs.size() || ready.empty() || (failed && !keepGoing)) break;
+
+						size_t job = ready.top();
+						ready.pop();
+						running++;
+						bool forceRun = dependencyRan[job];
+						lock.unlock();
+
+						// run job unless up to date
+						JobResult& result = ret.Jobs[job];
+						std::string hash;
+						bool upToDate = _IsUpToDate(_Jobs[job], forceRun, hash);
+						if (upToDate)
+						{
+							result.Status = JobStatus::Skipped;
+						}
+						else
+						{
+							const Job& info = _Jobs[job];
+							result.Output = info.Argv.empty() ? Execute::Command(info.Command, info.Capture, info.Options) : Execute::Run(info.Argv, std::string(), info.Capture, info.Options);
+							result.Status = result.Output.IsSuccess() ? JobStatus::Succeeded : JobStatus::Failed;
+						}
+
+						lock.lock();
+						if (!upToDate)
+						{
+							_State[_Jobs[job].Name].Duration = result.Output.Usage.WallTime;
+							if (result.Status == JobStatus::Succeeded && !hash.empty()) _State[_Jobs[job].Name].Hash = hash;
+						}
+						running--;
+						done++;
+						if (result.Status == JobStatus::Failed)
+						{
+							failed = true;
+							block(job);
+						}
+						else
+						{
+							for (size_t dependent : _Dependents[job])
+							{
+								if (!upToDate) dependencyRan[dependent] = true;
+								if (--remaining[dependent] == 0 && ret.Jobs[dependent].Status == JobStatus::NotRun) ready.push(dependent);
+							}
+						}
+						changed.notify_all();
+					}
+					changed.notify_all();
+				};
+
+				if (maxParallel == 0) maxParallel = (std::max)(1u, std::thread::hardware_concurrency());
+				std::vector<std::thread> workers;
+				for (size_t i = 0; i < (std::min)(maxParallel, _Jobs.size()); ++i) workers.emplace_back(worker);
+				for (auto& thread : workers) thread.join();
+
+				_SaveState();
+				ret.Success = true;
+				for (const auto& job : ret.Jobs)
+				{
+					if (job.Status != JobStatus::Skipped && job.Status != JobStatus::Succeeded) ret.Success = false;
+				}
+				ret.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				return ret;
+			}
+
+			// get number of jobs
+			inline size_t Size() const { return _Jobs.size(); }
+
+		private:
+
+			// persisted per-job state
+			struct __JobState
+			{
+				double Duration = -1;
+				std::string Hash;
+			};
+
+			std::string _StateFile;
+			UpToDateCheck _Check;
+			std::vector<Job> _Jobs;
+			std::vector<std::vector<size_t>> _Dependents;
+			std::unordered_map<std::string, __JobState> _State;
+
+			// guards state and scheduling while jobs run
+			std::mutex _StateMutex;
+
+			// build dependents lists and validate graph
+			bool _BuildEdges(std::string& error)
+			{
+				std::unordered_map<std::string, size_t> indices;
+				for (size_t i = 0; i < _Jobs.size(); ++i)
+				{
+					if (!indices.emplace(_Jobs[i].Name, i).second)
+					{
+						error = "Duplicate job: " + _Jobs[i].Name;
+						return false;
+					}
+				}
+				_Dependents.assign(_Jobs.size(), std::vector<size_t>());
+				std::vector<size_t> inDegree(_Jobs.size(), 0);
+				for (size_t i = 0; i < _Jobs.size(); ++i)
+				{
+					for (const auto& dependency : _Jobs[i].Dependencies)
+					{
+						auto found = indices.find(dependency);
+						if (found == indices.end())
+						{
+							error = "Unknown dependency '" + dependency + "' of job: " + _Jobs[i].Name;
+							return false;
+						}
+						_Dependents[found->second].push_back(i);
+						inDegree[i]++;
+					}
+				}
+
+				// check for cycles (Kahn's algorithm)
+				std::vector<size_t> queue;
+				for (size_t i = 0; i < _Jobs.size(); ++i) if (inDegree[i] == 0) queue.push_back(i);
+				size_t visited = 0;
+				while (visited < queue.size())
+				{
+					for (size_t dependent : _Dependents[queue[visited++]])
+					{
+						if (--inDegree[dependent] == 0) queue.push_back(dependent);
+					}
+				}
+				if (visited != _Jobs.size())
+				{
+					error = "Jobs graph has a cycle";
+					return false;
+				}
+				return true;
+			}
+
+			// estimated job duration: last recorded, or average of recorded jobs, or 1 second
+			double _EstimatedDuration(const std::string& name) const
+			{
+				auto found = _State.find(name);
+				if (found != _State.end() && found->second.Duration >= 0) return found->second.Duration;
+				double total = 0;
+				size_t count = 0;
+				for (const auto& state : _State)
+				{
+					if (state.second.Duration >= 0) { total += state.second.Duration; count++; }
+				}
+				return count ? total / count : 1.0;
+			}
+
+			// check if job outputs are up to date; in hash mode also returns the job's current hash
+			bool _IsUpToDate(const Job& job, bool dependencyRan, std::string& hash)
+			{
+				if (_Check == UpToDateCheck::Hash)
+				{
+					__ContentHasher hasher;
+					for (const auto& arg : job.Argv) hasher.Update(arg);
+					hasher.Update(job.Command);
+					for (const auto& input : job.Inputs)
+					{
+						hasher.Update(input);
+						FILE* file = fopen(input.c_str(), "rb");
+						if (!file) { hasher.Update(std::string("missing")); continue; }
+						std::vector<char> buffer(1024 * 1024);
+						size_t count;
+						while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0) hasher.Update(buffer.data(), count);
+						fclose(file);
+					}
+					hash = hasher.Digest();
+				}
+				if (job.Outputs.empty()) return false;
+
+				// all outputs must exist
+				struct timespec oldestOutput = { 0, 0 };
+				bool first = true;
+				for (const auto& output : job.Outputs)
+				{
+					struct stat info;
+					if (stat(output.c_str(), &info) != 0) return false;
+					if (first || _Before(info.st_mtim, oldestOutput)) oldestOutput = info.st_mtim;
+					first = false;
+				}
+
+				if (_Check == UpToDateCheck::Hash)
+				{
+					std::lock_guard<std::mutex> lock(_StateMutex);
+					auto found = _State.find(job.Name);
+					return found != _State.end() && found->second.Hash == hash;
+				}
+
+				// modify time: no dependency ran and no input is newer than the oldest output
+				if (dependencyRan) return false;
+				for (const auto& input : job.Inputs)
+				{
+					struct stat info;
+					if (stat(input.c_str(), &info) != 0) return false;
+					if (_Before(oldestOutput, info.st_mtim)) return false;
+				}
+				return true;
+			}
+
+			// compare timestamps
+			static inline bool _Before(const struct timespec& a, const struct timespec& b)
+			{
+				return a.tv_sec < b.tv_sec || (a.tv_sec == b.tv_sec && a.tv_nsec < b.tv_nsec);
+			}
+
+			// load state file: one 'name<TAB>duration<TAB>hash' line per job
+			void _LoadState()
+			{
+				if (_StateFile.empty()) return;
+				std::ifstream file(_StateFile);
+				std::string line;
+				while (std::getline(file, line))
+				{
+					std::istringstream fields(line);
+					std::string name, duration, hash;
+					if (!std::getline(fields, name, '\t') || !std::getline(fields, duration, '\t')) continue;
+					std::getline(fields, hash, '\t');
+					__JobState state;
+					state.Duration = atof(duration.c_str());
+					state.Hash = hash;
+					_State[name] = state;
+				}
+			}
+
+			// save state file, writing to a temp file and renaming
+			void _SaveState()
+			{
+				if (_StateFile.empty()) return;
+				std::string tempFile = _StateFile + ".tmp";
+				{
+					std::ofstream file(tempFile, std::ios::trunc);
+					for (const auto& state : _State)
+					{
+						file << state.first << '\t' << state.second.Duration << '\t' << state.second.Hash << '\n';
+					}
+					if (!file.good()) return;
+				}
+				rename(tempFile.c_str(), _StateFile.c_str());
+			}
+		};
+	}
+}
+#endif
@@ -0,0 +1,161 @@
+/*!
+ * \file	Source\Execute\Pipeline.h.
+ *
+ * \brief	Execute programs and chains of programs directly, without a shell.
+ */
+#pragma once
+
+#ifndef _WIN32
+#include <string>
+#include <vector>
+#include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \struct	PipelineOutput
+		 *
+		 * \brief	Output of an executed pipeline.
+		 *
+		 * \date	10/19/2026
+		 */
+		struct PipelineOutput
+		{
+			// output text of the last stage
+			std::string Output;
+
+			// bytes of last stage output dropped due to capture policy, and spill file path (see ProcessOutput)
+			unsigned long long DroppedBytes = 0;
+			std::string SpillPath;
+
+			// return code, status and usage of every stage, in order (their Output is empty)
+			std::vector<ProcessOutput> Stages;
+
+			// return code of the last stage, or -1 if there are no stages
+			inline int ReturnCode() const { return Stages.empty() ? -1 : Stages.back().ReturnCode; }
+
+			// return if all stages executed and succeeded (like 'set -o pipefail')
+			inline bool IsSuccess() const
+			{
+				if (Stages.empty()) return false;
+				for (const auto& stage : Stages) if (!stage.IsSuccess()) return false;
+				return true;
+			}
+		};
+
+		/*!
+		 * \fn	inline PipelineOutput Pipeline(const std::vector<std::vector<std::string>>& stages, const std::string& input = std::string(), size_t pipeCapacity = 0, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		 *
+		 * \brief	Executes a chain of programs connected with pipes, like 'a | b | c' in the shell,
+		 * 			but without spawning a shell or quoting arguments.
+		 * 			Stages are argv vectors, the program is searched in PATH.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	stages			Argv of every stage, in order.
+		 * \param	input			(Optional) Data to write to the first stage's stdin. Stdin is closed after it.
+		 * \param	pipeCapacity	(Optional) If not 0, resize every pipe to this many bytes (F_SETPIPE_SZ).
+		 * 							Larger pipes mean less context switches between stages for bulk data.
+		 * 							The kernel caps it at /proc/sys/fs/pipe-max-size.
+		 * \param	capture			(Optional) How much of the last stage output to keep.
+		 * \param	options			(Optional) Scheduling and resource hints applied to every stage.
+		 *
+		 * \return	Output of the last stage and status of every stage.
+		 */
+		inline PipelineOutput Pipeline(const std::vector<std::vector<std::string>>& stages, const std::string& input = std::string(), size_t pipeCapacity = 0, const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		{
+			PipelineOutput ret;
+			if (stages.empty()) return ret;
+			ret.Stages.resize(stages.size());
+
+			// create the first stage input pipe and the last stage output pipe
+			int inputPipe[2], outputPipe[2];
+			if (pipe2(inputPipe, O_CLOEXEC) != 0) return ret;
+			if (pipe2(outputPipe, O_CLOEXEC) != 0)
+			{
+				close(inputPipe[0]);
+				close(inputPipe[1]);
+				return ret;
+			}
+			if (pipeCapacity)
+			{
+				fcntl(inputPipe[1], F_SETPIPE_SZ, (int)pipeCapacity);
+				fcntl(outputPipe[1], F_SETPIPE_SZ, (int)pipeCapacity);
+			}
+
+			// spawn stages, each reading from previous stage pipe
+			std::vector<__Child> children(stages.size());
+			auto start = std::chrono::steady_clock::now();
+			int stageInput = inputPipe[0];
+			for (size_t i = 0; i < stages.size(); ++i)
+			{
+				int stageOutput = outputPipe[1];
+				int nextInput = -1;
+				if (i + 1 < stages.size())
+				{
+					int fds[2];
+					if (pipe2(fds, O_CLOEXEC) == 0)
+					{
+						if (pipeCapacity) fcntl(fds[1], F_SETPIPE_SZ, (int)pipeCapacity);
+						stageOutput = fds[1];
+						nextInput = fds[0];
+					}
+				}
+
+				// failed to create pipe? stop here, the stages we started will see EOF
+				if (i + 1 < stages.size() && nextInput == -1) break;
+				children[i] = _Spawn(stages[i], stageInput, stageOutput, options);
+
+				// close our copies so EOF propagates when a stage exits
+				close(stageInput);
+				if (stageOutput != outputPipe[1]) close(stageOutput);
+				stageInput = nextInput;
+			}
+			close(outputPipe[1]);
+			if (stageInput != -1) close(stageInput);
+
+			// feed input and read last stage output
+			__OutputCapture output(capture);
+			_Communicate(inputPipe[1], input, outputPipe[0], output);
+			ProcessOutput captured;
+			output.Finish(captured);
+			ret.Output = std::move(captured.Output);
+			ret.DroppedBytes = captured.DroppedBytes;
+			ret.SpillPath = captured.SpillPath;
+
+			// collect all stages
+			for (size_t i = 0; i < stages.size(); ++i)
+			{
+				if (children[i].IsValid()) _CollectProcess(children[i], start, ret.Stages[i]);
+			}
+			return ret;
+		}
+
+		/*!
+		 * \fn	inline ProcessOutput Run(const std::vector<std::string>& argv, const std::string& input = std::string(), const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		 *
+		 * \brief	Executes a program directly, without a shell.
+		 *
+		 * \date	10/19/2026
+		 *
+		 * \param	argv   	Program and its arguments. Program is searched in PATH.
+		 * \param	input  	(Optional) Data to write to program's stdin. Stdin is closed after it.
+		 * \param	capture	(Optional) How much of the output to keep.
+		 * \param	options	(Optional) Scheduling and resource hints for the program.
+		 *
+		 * \return	A ProcessOutput.
+		 */
+		inline ProcessOutput Run(const std::vector<std::string>& argv, const std::string& input = std::string(), const CapturePolicy& capture = CapturePolicy(), const Options& options = Options())
+		{
+			PipelineOutput output = Pipeline({ argv }, input, 0, capture, options);
+			ProcessOutput ret = output.Stages[0];
+			ret.Output = std::move(output.Output);
+			ret.DroppedBytes = output.DroppedBytes;
+			ret.SpillPath = std::move(output.SpillPath);
+			return ret;
+		}
+	}
+}
+#endif
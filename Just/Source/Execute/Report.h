@@ -0,0 +1,183 @@
+/*!
+ * \file	Source\Execute\Report.h.
+ *
+ * \brief	Aggregate resource usage across a batch of executed processes.
+ */
+#pragma once
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \class	UsageReport
+		 *
+		 * \brief	Collect the resource usage of many executed processes and report totals, peaks
+		 * 			and the most expensive runs.
+		 *
+		 * \date	10/19/2026
+		 */
+		class UsageReport
+		{
+		public:
+
+			// a single recorded run
+			struct Entry
+			{
+				// label given when added
+				std::string Label;
+
+				// return code and usage of the run
+				int ReturnCode = -1;
+				ProcessUsage Usage;
+			};
+
+			/*!
+			 * \fn	void Add(const std::string& label, const ProcessOutput& output)
+			 *
+			 * \brief	Record a run.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	label 	Label to show in report (command, step name, etc.).
+			 * \param	output	Process output to take usage from.
+			 */
+			void Add(const std::string& label, const ProcessOutput& output)
+			{
+				Entry entry;
+				entry.Label = label;
+				entry.ReturnCode = output.ReturnCode;
+				entry.Usage = output.Usage;
+				_Entries.push_back(entry);
+				if (!output.IsSuccess()) _Failures++;
+			}
+
+			/*!
+			 * \fn	ProcessUsage Total() const
+			 *
+			 * \brief	Get usage summed across all runs.
+			 * 			MaxRss is the peak of a single run, not a sum.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	Summed usage.
+			 */
+			ProcessUsage Total() const
+			{
+				ProcessUsage ret;
+				for (const auto& entry : _Entries)
+				{
+					const ProcessUsage& usage = entry.Usage;
+					ret.WallTime += usage.WallTime;
+					ret.UserTime += usage.UserTime;
+					ret.SystemTime += usage.SystemTime;
+					ret.MaxRss = (std::max)(ret.MaxRss, usage.MaxRss);
+					ret.MinorFaults += usage.MinorFaults;
+					ret.MajorFaults += usage.MajorFaults;
+					ret.BlockReads += usage.BlockReads;
+					ret.BlockWrites += usage.BlockWrites;
+					ret.VoluntarySwitches += usage.VoluntarySwitches;
+					ret.InvoluntarySwitches += usage.InvoluntarySwitches;
+					ret.ReadChars += usage.ReadChars;
+					ret.WriteChars += usage.WriteChars;
+					ret.StorageReadBytes += usage.StorageReadBytes;
+					ret.StorageWriteBytes += usage.StorageWriteBytes;
+				}
+				return ret;
+			}
+
+			/*!
+			 * \fn	std::vector<Entry> Top(size_t count, bool byCpu = false) const
+			 *
+			 * \brief	Get the most expensive runs.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	count	Max number of entries to return.
+			 * \param	byCpu	(Optional) If true sort by CPU time, otherwise by wall time.
+			 *
+			 * \return	Entries sorted from most to least expensive.
+			 */
+			std::vector<Entry> Top(size_t count, bool byCpu = false) const
+			{
+				std::vector<Entry> ret(_Entries);
+				std::stable_sort(ret.begin(), ret.end(), [byCpu](const Entry& a, const Entry& b) {
+					return byCpu ? a.Usage.CpuTime() > b.Usage.CpuTime() : a.Usage.WallTime > b.Usage.WallTime;
+				});
+				if (ret.size() > count) ret.resize(count);
+				return ret;
+			}
+
+			/*!
+			 * \fn	std::string ToString(size_t top = 10) const
+			 *
+			 * \brief	Format report as a text table: totals followed by the most expensive runs.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \param	top	(Optional) How many runs to list, sorted by wall time.
+			 *
+			 * \return	Report text.
+			 */
+			std::string ToString(size_t top = 10) const
+			{
+				std::ostringstream out;
+				out << std::fixed << std::setprecision(3);
+				out << "runs: " << _Entries.size() << ", failed: " << _Failures << "\n";
+				_WriteHeader(out);
+				_WriteRow(out, "TOTAL", Total());
+				for (const auto& entry : Top(top))
+				{
+					_WriteRow(out, entry.Label, entry.Usage);
+				}
+				return out.str();
+			}
+
+			// get all recorded runs
+			inline const std::vector<Entry>& Entries() const { return _Entries; }
+
+			// get how many recorded runs did not succeed
+			inline size_t Failures() const { return _Failures; }
+
+			// clear all recorded runs
+			inline void Clear() { _Entries.clear(); _Failures = 0; }
+
+		private:
+
+			// recorded runs
+			std::vector<Entry> _Entries;
+
+			// how many runs failed
+			size_t _Failures = 0;
+
+			// write table header
+			static void _WriteHeader(std::ostringstream& out)
+			{
+				out << std::left << std::setw(32) << "label" << std::right
+					<< std::setw(10) << "wall(s)" << std::setw(10) << "user(s)" << std::setw(10) << "sys(s)"
+					<< std::setw(12) << "maxrss(KB)" << std::setw(10) << "minflt" << std::setw(8) << "majflt"
+					<< std::setw(10) << "blk-in" << std::setw(10) << "blk-out" << std::setw(10) << "vcsw" << std::setw(10) << "ivcsw"
+					<< std::setw(14) << "read(B)" << std::setw(14) << "write(B)" << "\n";
+			}
+
+			// write a single table row
+			static void _WriteRow(std::ostringstream& out, const std::string& label, const ProcessUsage& usage)
+			{
+				std::string shortLabel = label.size() > 31 ? label.substr(0, 28) + "..." : label;
+				out << std::left << std::setw(32) << shortLabel << std::right
+					<< std::setw(10) << usage.WallTime << std::setw(10) << usage.UserTime << std::setw(10) << usage.SystemTime
+					<< std::setw(12) << usage.MaxRss << std::setw(10) << usage.MinorFaults << std::setw(8) << usage.MajorFaults
+					<< std::setw(10) << usage.BlockReads << std::setw(10) << usage.BlockWrites
+					<< std::setw(10) << usage.VoluntarySwitches << std::setw(10) << usage.InvoluntarySwitches
+					<< std::setw(14) << usage.StorageReadBytes << std::setw(14) << usage.StorageWriteBytes << "\n";
+			}
+		};
+	}
+}
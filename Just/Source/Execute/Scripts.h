@@ -5,7 +5,6 @@
  */
 #pragma once
 
-#ifdef _WIN32
 #include "Command.h"
 
 namespace Just
@@ -88,5 +87,4 @@ namespace Just
 			return Script(type, scriptPath, params);
 		}
 	}
-}
-#endif
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,401 @@
+/*!
+ * \file	Source\Execute\SpawnServer.h.
+ *
+ * \brief	A small pre-forked helper process that spawns children on our behalf.
+ */
+#pragma once
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <mutex>
+#include <type_traits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Command.h"
+
+namespace Just
+{
+	namespace Execute
+	{
+		/*!
+		 * \namespace	SpawnServer
+		 *
+		 * \brief	Spawn server: a process forked while we are still small, which launches children for us
+		 * 			when asked over a socket. Forking a small process is cheap, so launch latency does not
+		 * 			grow with our RSS. Children's exit status and resource usage are sent back to us, so
+		 * 			executed processes report the same output as when spawned locally.
+		 * 			To use it, call Start() early in main (before allocating a lot of memory or starting threads),
+		 * 			then SetSpawnMethod(SpawnMethod::Server).
+		 *
+		 * \date	10/19/2026
+		 */
+		namespace SpawnServer
+		{
+			// control socket to the server, server pid, and lock for sending requests
+			inline int _control = -1;
+			inline pid_t _serverPid = -1;
+			inline std::mutex _mutex;
+
+			// request flags
+			const uint32_t _HasStdin = 1;
+			const uint32_t _HasStdout = 2;
+			const uint32_t _HasHints = 4;
+
+			// request header, followed by path, cwd, argv and environment as null-terminated strings
+			struct __Request
+			{
+				uint32_t Flags;
+				uint32_t Argc;
+				uint32_t Envc;
+				Options Hints;
+			};
+			static_assert(std::is_trivially_copyable<Options>::value, "Options are sent to the server as raw bytes");
+
+			/*!
+			 * \fn	inline bool _SendFds(int socket, const void* data, size_t size, const int* fds, int fdsCount)
+			 *
+			 * \brief	Used internally, send a message with file descriptors attached.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline bool _SendFds(int socket, const void* data, size_t size, const int* fds, int fdsCount)
+			{
+				struct iovec iov;
+				iov.iov_base = const_cast<void*>(data);
+				iov.iov_len = size;
+
+				char control[CMSG_SPACE(sizeof(int) * 3)];
+				memset(control, 0, sizeof(control));
+				struct msghdr message;
+				memset(&message, 0, sizeof(message));
+				message.msg_iov = &iov;
+				message.msg_iovlen = 1;
+				message.msg_control = control;
+				message.msg_controllen = CMSG_SPACE(sizeof(int) * fdsCount);
+
+				struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+				header->cmsg_level = SOL_SOCKET;
+				header->cmsg_type = SCM_RIGHTS;
+				header->cmsg_len = CMSG_LEN(sizeof(int) * fdsCount);
+				memcpy(CMSG_DATA(header), fds, sizeof(int) * fdsCount);
+
+				ssize_t result;
+				while ((result = sendmsg(socket, &message, MSG_NOSIGNAL)) == -1 && errno == EINTR) {}
+				return result == (ssize_t)size;
+			}
+
+			/*!
+			 * \fn	inline void _HandleRequest(int control, const sigset_t& childMask, std::unordered_map<pid_t, int>& replies)
+			 *
+			 * \brief	Used internally, runs in the server: receive a launch request and fork the child.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline bool _HandleRequest(int control, const sigset_t& childMask, std::unordered_map<pid_t, int>& replies)
+			{
+				// get message size first
+				char peek;
+				ssize_t size = recv(control, &peek, 1, MSG_PEEK | MSG_TRUNC);
+				if (size <= 0) return size < 0 && errno == EINTR;
+
+				// receive message with its descriptors
+				std::vector<char> data((size_t)size + 1, 0);
+				struct iovec iov;
+				iov.iov_base = data.data();
+				iov.iov_len = (size_t)size;
+				char controlBuffer[CMSG_SPACE(sizeof(int) * 3)];
+				struct msghdr message;
+				memset(&message, 0, sizeof(message));
+				message.msg_iov = &iov;
+				message.msg_iovlen = 1;
+				message.msg_control = controlBuffer;
+				message.msg_controllen = sizeof(controlBuffer);
+				if (recvmsg(control, &message, MSG_CMSG_CLOEXEC) != size) return true;
+
+				int fds[3] = { -1, -1, -1 };
+				int fdsCount = 0;
+				struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+				if (header && header->cmsg_type == SCM_RIGHTS)
+				{
+					fdsCount = (int)((header->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+					memcpy(fds, CMSG_DATA(header), sizeof(int) * (fdsCount > 3 ? 3 : fdsCount));
+				}
+				if (fdsCount < 1 || (size_t)size < sizeof(__Request))
+				{
+					for (int i = 0; i < fdsCount && i < 3; ++i) close(fds[i]);
+					return true;
+				}
+
+				// parse request
+				__Request request;
+				memcpy(&request, data.data(), sizeof(request));
+				int reply = fds[0];
+				int next = 1;
+				int stdinFd = (request.Flags & _HasStdin) && next < fdsCount ? fds[next++] : -1;
+				int stdoutFd = (request.Flags & _HasStdout) && next < fdsCount ? fds[next++] : -1;
+
+				std::vector<char*> strings;
+				char* position = data.data() + sizeof(request);
+				char* end = data.data() + size;
+				while (position < end)
+				{
+					strings.push_back(position);
+					position += strlen(position) + 1;
+				}
+
+				pid_t pid = -1;
+				if (strings.size() == 2 + (size_t)request.Argc + request.Envc)
+				{
+					std::vector<char*> argv(strings.begin() + 2, strings.begin() + 2 + request.Argc);
+					argv.push_back(NULL);
+					std::vector<char*> envp(strings.begin() + 2 + request.Argc, strings.end());
+					envp.push_back(NULL);
+
+					__ExecArgs exec;
+					exec.Path = strings[0];
+					exec.Argv = argv.data();
+					exec.Envp = envp.data();
+					exec.StdinFd = stdinFd;
+					exec.StdoutFd = stdoutFd;
+					exec.SignalMask = childMask;
+					exec.Hints = (request.Flags & _HasHints) ? &request.Hints : NULL;
+					const char* cwd = strings[1];
+
+					// we are small, so a plain fork is cheap here
+					pid = fork();
+					if (pid == 0)
+					{
+						if (chdir(cwd) != 0) _exit(127);
+						_ExecChild(exec);
+					}
+				}
+				if (stdinFd != -1) close(stdinFd);
+				if (stdoutFd != -1) close(stdoutFd);
+
+				// tell client the child pid, and remember where to send its exit status
+				int32_t sent = (int32_t)pid;
+				if (send(reply, &sent, sizeof(sent), MSG_NOSIGNAL) != sizeof(sent) || pid <= 0)
+				{
+					close(reply);
+				}
+				else
+				{
+					replies[pid] = reply;
+				}
+				return true;
+			}
+
+			/*!
+			 * \fn	inline void _CollectChildren(std::unordered_map<pid_t, int>& replies)
+			 *
+			 * \brief	Used internally, runs in the server: reap exited children and report their status.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline void _CollectChildren(std::unordered_map<pid_t, int>& replies)
+			{
+				while (true)
+				{
+					siginfo_t info;
+					memset(&info, 0, sizeof(info));
+					if (waitid(P_ALL, 0, &info, WEXITED | WNOHANG | WNOWAIT) != 0 || info.si_pid == 0) break;
+
+					__ChildStatus status;
+					_WaitChild(info.si_pid, status);
+					auto found = replies.find(info.si_pid);
+					if (found != replies.end())
+					{
+						send(found->second, &status, sizeof(status), MSG_NOSIGNAL);
+						close(found->second);
+						replies.erase(found);
+					}
+				}
+			}
+
+			/*!
+			 * \fn	inline void _ServerMain(int control)
+			 *
+			 * \brief	Used internally, main loop of the server process. Exits when control socket is closed.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline void _ServerMain(int control)
+			{
+				// don't keep any descriptor of our parent open, except the control socket and standard streams
+				std::vector<int> inherited;
+				DIR* dir = opendir("/proc/self/fd");
+				if (dir)
+				{
+					struct dirent* entry;
+					while ((entry = readdir(dir)) != NULL)
+					{
+						int fd = atoi(entry->d_name);
+						if (fd > STDERR_FILENO && fd != control && fd != dirfd(dir)) inherited.push_back(fd);
+					}
+					closedir(dir);
+				}
+				for (int fd : inherited) close(fd);
+
+				// get notified on child exit via a signalfd; children get an empty signal mask
+				sigset_t childMask, childSignal;
+				sigemptyset(&childMask);
+				sigemptyset(&childSignal);
+				sigaddset(&childSignal, SIGCHLD);
+				for (int sig = 1; sig < NSIG; ++sig) signal(sig, SIG_DFL);
+				signal(SIGPIPE, SIG_IGN);
+				sigprocmask(SIG_SETMASK, &childSignal, NULL);
+				int childEvents = signalfd(-1, &childSignal, SFD_CLOEXEC | SFD_NONBLOCK);
+
+				std::unordered_map<pid_t, int> replies;
+				while (true)
+				{
+					struct pollfd fds[2];
+					fds[0].fd = control; fds[0].events = POLLIN; fds[0].revents = 0;
+					fds[1].fd = childEvents; fds[1].events = POLLIN; fds[1].revents = 0;
+					if (poll(fds, 2, -1) < 0 && errno != EINTR) break;
+
+					if (fds[1].revents)
+					{
+						struct signalfd_siginfo info;
+						while (read(childEvents, &info, sizeof(info)) > 0) {}
+						_CollectChildren(replies);
+					}
+					if (fds[0].revents && !_HandleRequest(control, childMask, replies)) break;
+				}
+				_exit(0);
+			}
+
+			/*!
+			 * \fn	inline __Child _Launch(const std::string& path, const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options)
+			 *
+			 * \brief	Used internally, ask the server to launch a child.
+			 * 			Our environment and working directory are sent along, so the child sees them as if we spawned it.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline __Child _Launch(const std::string& path, const std::vector<std::string>& argv, int stdinFd, int stdoutFd, const Options& options)
+			{
+				__Child ret;
+
+				// build request
+				char cwd[4096];
+				if (!getcwd(cwd, sizeof(cwd))) return ret;
+				size_t envc = 0;
+				while (environ[envc]) envc++;
+				__Request request;
+				request.Flags = (stdinFd != -1 ? _HasStdin : 0) | (stdoutFd != -1 ? _HasStdout : 0) | (options.IsEmpty() ? 0 : _HasHints);
+				request.Hints = options;
+				request.Argc = (uint32_t)argv.size();
+				request.Envc = (uint32_t)envc;
+
+				std::string data((const char*)&request, sizeof(request));
+				data.append(path).push_back('\0');
+				data.append(cwd).push_back('\0');
+				for (const auto& arg : argv) data.append(arg).push_back('\0');
+				for (size_t i = 0; i < envc; ++i) data.append(environ[i]).push_back('\0');
+
+				// per-request socket to get the child pid and exit status on
+				int reply[2];
+				if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, reply) != 0) return ret;
+				int fds[3];
+				int fdsCount = 0;
+				fds[fdsCount++] = reply[1];
+				if (stdinFd != -1) fds[fdsCount++] = stdinFd;
+				if (stdoutFd != -1) fds[fdsCount++] = stdoutFd;
+
+				bool sent;
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					sent = _control != -1 && _SendFds(_control, data.data(), data.size(), fds, fdsCount);
+				}
+				close(reply[1]);
+
+				int32_t pid = -1;
+				ssize_t count = -1;
+				if (sent)
+				{
+					while ((count = read(reply[0], &pid, sizeof(pid))) == -1 && errno == EINTR) {}
+				}
+				if (count != sizeof(pid) || pid <= 0)
+				{
+					close(reply[0]);
+					return ret;
+				}
+				ret.Pid = pid;
+				ret.StatusFd = reply[0];
+				return ret;
+			}
+
+			/*!
+			 * \fn	inline bool Start()
+			 *
+			 * \brief	Fork the spawn server. Call it early, while this process is still small.
+			 *
+			 * \date	10/19/2026
+			 *
+			 * \return	True if server is running.
+			 */
+			inline bool Start()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_control != -1) return true;
+
+				int sockets[2];
+				if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0) return false;
+				pid_t pid = fork();
+				if (pid == -1)
+				{
+					close(sockets[0]);
+					close(sockets[1]);
+					return false;
+				}
+				if (pid == 0)
+				{
+					close(sockets[0]);
+					_ServerMain(sockets[1]);
+				}
+				close(sockets[1]);
+				_control = sockets[0];
+				_serverPid = pid;
+				_spawnServerLaunch.store(_Launch, std::memory_order_release);
+				return true;
+			}
+
+			/*!
+			 * \fn	inline void Stop()
+			 *
+			 * \brief	Stop the spawn server. Children it launched keep running,
+			 * 			but their exit status will not be reported.
+			 *
+			 * \date	10/19/2026
+			 */
+			inline void Stop()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_control == -1) return;
+				_spawnServerLaunch.store(nullptr, std::memory_order_release);
+				close(_control);
+				_control = -1;
+				while (waitpid(_serverPid, NULL, 0) == -1 && errno == EINTR) {}
+				_serverPid = -1;
+			}
+
+			// return if spawn server is running
+			inline bool IsRunning()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _control != -1;
+			}
+		}
+	}
+}
+#endif
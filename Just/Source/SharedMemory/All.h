@@ -1,2 +1,14 @@
 #pragma once
-#include "SharedMemory.h"
\ No newline at end of file
+#include "SharedMemory.h"
+#include "SpscRing.h"
+#include "MpmcQueue.h"
+#include "Snapshot.h"
+#include "Futex.h"
+#include "Arena.h"
+#include "HashMap.h"
+#include "BroadcastRing.h"
+#include "RpcChannel.h"
+#include "Metrics.h"
+#include "Mutex.h"
+#include "Layout.h"
+#include "Copy.h"
\ No newline at end of file
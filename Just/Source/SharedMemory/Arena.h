@@ -0,0 +1,709 @@
+/*!
+* \file	Source\SharedMemory\Arena.h.
+*
+* \brief	Allocator for variable size objects inside a shared memory, with offset pointers and STL adapters.
+*/
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+#include "Futex.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \class	OffsetPtr
+		*
+		* \brief	A pointer that stores the distance from itself to its target instead of an address.
+		* 			When both the pointer and its target are in the same shared memory, it stays valid in every process,
+		* 			no matter where each one mapped the memory. Usable as the pointer type of STL allocators.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename T>
+		class OffsetPtr
+		{
+		private:
+
+			// distance in bytes from this to the target. 1 means null, since nothing can start inside the pointer itself
+			int64_t _Offset = 1;
+
+			inline void _Set(const void* target)
+			{
+				// computed on integers: the target is not inside this object, as compilers would assume for pointer arithmetic
+				_Offset = target ? (int64_t)((uintptr_t)target - (uintptr_t)this) : 1;
+			}
+
+		public:
+
+			typedef T element_type;
+			typedef typename std::remove_cv<T>::type value_type;
+			typedef ptrdiff_t difference_type;
+			typedef typename std::add_lvalue_reference<T>::type reference;
+			typedef OffsetPtr<T> pointer;
+			typedef std::random_access_iterator_tag iterator_category;
+
+			template <typename U>
+			using rebind = OffsetPtr<U>;
+
+			OffsetPtr() = default;
+			OffsetPtr(std::nullptr_t) {}
+			OffsetPtr(T* target) { _Set(target); }
+			OffsetPtr(const OffsetPtr& other) { _Set(other.Get()); }
+
+			// implicit where U* converts to T*, explicit otherwise (like static_cast from void*)
+			template <typename U, typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type = 0>
+			OffsetPtr(const OffsetPtr<U>& other) { _Set(static_cast<T*>(other.Get())); }
+			template <typename U, typename std::enable_if<!std::is_convertible<U*, T*>::value, int>::type = 0>
+			explicit OffsetPtr(const OffsetPtr<U>& other) { _Set(static_cast<T*>(other.Get())); }
+
+			OffsetPtr& operator=(const OffsetPtr& other) { _Set(other.Get()); return *this; }
+			OffsetPtr& operator=(T* target) { _Set(target); return *this; }
+			OffsetPtr& operator=(std::nullptr_t) { _Offset = 1; return *this; }
+
+			// get raw pointer, valid in this process only
+			inline T* Get() const
+			{
+				return _Offset == 1 ? nullptr : (T*)((uintptr_t)this + (uintptr_t)_Offset);
+			}
+
+			static inline OffsetPtr pointer_to(reference target) { return OffsetPtr(std::addressof(target)); }
+
+			inline T* operator->() const { return Get(); }
+			template <typename U = T, typename std::enable_if<!std::is_void<U>::value, int>::type = 0>
+			inline U& operator*() const { return *Get(); }
+			template <typename U = T, typename std::enable_if<!std::is_void<U>::value, int>::type = 0>
+			inline U& operator[](ptrdiff_t index) const { return Get()[index]; }
+			explicit inline operator bool() const { return _Offset != 1; }
+
+			inline OffsetPtr& operator+=(ptrdiff_t count) { _Set(Get() + count); return *this; }
+			inline OffsetPtr& operator-=(ptrdiff_t count) { _Set(Get() - count); return *this; }
+			inline OffsetPtr& operator++() { return *this += 1; }
+			inline OffsetPtr& operator--() { return *this -= 1; }
+			inline OffsetPtr operator++(int) { OffsetPtr ret(*this); ++*this; return ret; }
+			inline OffsetPtr operator--(int) { OffsetPtr ret(*this); --*this; return ret; }
+			friend inline OffsetPtr operator+(const OffsetPtr& ptr, ptrdiff_t count) { return OffsetPtr(ptr.Get() + count); }
+			friend inline OffsetPtr operator+(ptrdiff_t count, const OffsetPtr& ptr) { return OffsetPtr(ptr.Get() + count); }
+			friend inline OffsetPtr operator-(const OffsetPtr& ptr, ptrdiff_t count) { return OffsetPtr(ptr.Get() - count); }
+			friend inline ptrdiff_t operator-(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() - b.Get(); }
+
+			friend inline bool operator==(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() == b.Get(); }
+			friend inline bool operator!=(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() != b.Get(); }
+			friend inline bool operator<(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() < b.Get(); }
+			friend inline bool operator>(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() > b.Get(); }
+			friend inline bool operator<=(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() <= b.Get(); }
+			friend inline bool operator>=(const OffsetPtr& a, const OffsetPtr& b) { return a.Get() >= b.Get(); }
+			friend inline bool operator==(const OffsetPtr& a, std::nullptr_t) { return !a; }
+			friend inline bool operator!=(const OffsetPtr& a, std::nullptr_t) { return (bool)a; }
+		};
+
+		// number of small size classes: 16, 32, ... 4096 bytes
+		const size_t _ArenaClasses = 9;
+
+		// biggest allocation served by the size classes
+		const size_t _ArenaMaxSmall = (size_t)16 << (_ArenaClasses - 1);
+
+		// free list heads pack a 24 bit ABA tag above a 40 bit offset, so arenas are limited to 1TB
+		const uint64_t _ArenaOffsetBits = 40;
+		const uint64_t _ArenaOffsetMask = ((uint64_t)1 << _ArenaOffsetBits) - 1;
+
+		/*!
+		* \struct	__ArenaHeader
+		*
+		* \brief	Used internally, header of an arena in shared memory. All offsets are from the header.
+		* 			Top is the start of never used memory, Classes are lock-free free lists of small blocks,
+		* 			and LargeHead is a free list of big blocks sorted by offset, guarded by LargeLock.
+		*/
+		struct __ArenaHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Size;
+			std::atomic<uint64_t> Root;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Top;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Used;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Classes[_ArenaClasses];
+			alignas(_CacheLineSize) std::atomic<uint32_t> LargeLock;
+			std::atomic<uint64_t> LargeHead;
+		};
+
+		/*!
+		* \struct	__ArenaBlock
+		*
+		* \brief	Used internally, header in front of every block. Next is used only while the block is free.
+		*/
+		struct __ArenaBlock
+		{
+			// block size including this header
+			uint64_t Size;
+
+			// size class, or _ArenaLarge
+			uint32_t Class;
+
+			// _ArenaBlockCheck, to catch freeing pointers that were not allocated
+			uint32_t Check;
+
+			// offset of next free block
+			std::atomic<uint64_t> Next;
+		};
+
+		const uint32_t _ArenaLarge = 0xff;
+		const uint32_t _ArenaBlockCheck = 0x4a534142;
+
+		// payload starts after size, class and check, so blocks are 16 bytes aligned
+		const uint64_t _ArenaBlockHeaderSize = 16;
+
+		// get block at offset
+		inline __ArenaBlock* _ArenaBlockAt(__ArenaHeader* header, uint64_t offset)
+		{
+			return (__ArenaBlock*)((char*)header + offset);
+		}
+
+		// take block size bytes of never used memory, 0 if arena is full
+		inline uint64_t _ArenaBump(__ArenaHeader* header, uint64_t size)
+		{
+			uint64_t top = header->Top.load(std::memory_order_relaxed);
+			do
+			{
+				if (header->Size - top < size) return 0;
+			} while (!header->Top.compare_exchange_weak(top, top + size, std::memory_order_relaxed));
+			return top;
+		}
+
+		// lock / unlock the large blocks list. the lock holds the owner's pid and is taken over from a dead process;
+		// every change to the list is a single store that leaves it whole, so at worst the dead one's block leaks
+		inline void _ArenaLockLarge(__ArenaHeader* header)
+		{
+			_LockOwned(header->LargeLock);
+		}
+		inline void _ArenaUnlockLarge(__ArenaHeader* header)
+		{
+			_UnlockOwned(header->LargeLock);
+		}
+
+		/*!
+		* \fn	inline void* _ArenaAllocate(__ArenaHeader* header, size_t size)
+		*
+		* \brief	Used internally, allocate from an arena header. Shared by Arena and ArenaAllocator.
+		*
+		* \date		10/19/2026
+		*/
+		inline void* _ArenaAllocate(__ArenaHeader* header, size_t size)
+		{
+			if (size == 0) size = 1;
+			if (size > header->Size) return nullptr;
+			uint64_t offset = 0, blockSize;
+
+			if (size <= _ArenaMaxSmall)
+			{
+				// pop from the size class free list
+				uint32_t sizeClass = 0;
+				while (((size_t)16 << sizeClass) < size) ++sizeClass;
+				blockSize = ((uint64_t)16 << sizeClass) + _ArenaBlockHeaderSize;
+				std::atomic<uint64_t>& head = header->Classes[sizeClass];
+				uint64_t current = head.load(std::memory_order_acquire);
+				while ((current & _ArenaOffsetMask) != 0)
+				{
+					// next may be garbage if another process popped and reused the block meanwhile, the tag makes the CAS fail then
+					uint64_t next = _ArenaBlockAt(header, current & _ArenaOffsetMask)->Next.load(std::memory_order_relaxed);
+					uint64_t tag = (current >> _ArenaOffsetBits) + 1;
+					if (head.compare_exchange_weak(current, (tag << _ArenaOffsetBits) | (next & _ArenaOffsetMask), std::memory_order_acquire))
+					{
+						offset = current & _ArenaOffsetMask;
+						break;
+					}
+				}
+				if (offset == 0) offset = _ArenaBump(header, blockSize);
+				if (offset == 0) return nullptr;
+				__ArenaBlock* block = _ArenaBlockAt(header, offset);
+				block->Size = blockSize;
+				block->Class = sizeClass;
+				block->Check = _ArenaBlockCheck;
+			}
+			else
+			{
+				// first fit from the large free list, splitting off what is left if it is worth keeping
+				blockSize = ((uint64_t)size + _ArenaBlockHeaderSize + 15) & ~(uint64_t)15;
+				_ArenaLockLarge(header);
+				std::atomic<uint64_t>* link = &header->LargeHead;
+				while (link->load(std::memory_order_relaxed))
+				{
+					__ArenaBlock* block = _ArenaBlockAt(header, link->load(std::memory_order_relaxed));
+					if (block->Size >= blockSize)
+					{
+						offset = link->load(std::memory_order_relaxed);
+						uint64_t next = block->Next.load(std::memory_order_relaxed);
+						if (block->Size - blockSize > _ArenaMaxSmall + _ArenaBlockHeaderSize)
+						{
+							__ArenaBlock* rest = _ArenaBlockAt(header, offset + blockSize);
+							rest->Size = block->Size - blockSize;
+							rest->Class = _ArenaLarge;
+							rest->Check = 0;
+							rest->Next.store(next, std::memory_order_relaxed);
+							link->store(offset + blockSize, std::memory_order_relaxed);
+						}
+						else
+						{
+							blockSize = block->Size;
+							link->store(next, std::memory_order_relaxed);
+						}
+						break;
+					}
+					link = &block->Next;
+				}
+				_ArenaUnlockLarge(header);
+				if (offset == 0) offset = _ArenaBump(header, blockSize);
+				if (offset == 0) return nullptr;
+				__ArenaBlock* block = _ArenaBlockAt(header, offset);
+				block->Size = blockSize;
+				block->Class = _ArenaLarge;
+				block->Check = _ArenaBlockCheck;
+			}
+
+			header->Used.fetch_add(blockSize, std::memory_order_relaxed);
+			return (char*)header + offset + _ArenaBlockHeaderSize;
+		}
+
+		/*!
+		* \fn	inline void _ArenaFree(__ArenaHeader* header, void* data)
+		*
+		* \brief	Used internally, free a block of an arena header. Shared by Arena and ArenaAllocator.
+		*
+		* \date		10/19/2026
+		*/
+		inline void _ArenaFree(__ArenaHeader* header, void* data)
+		{
+			if (!data) return;
+			uint64_t offset = (uint64_t)((char*)data - (char*)header) - _ArenaBlockHeaderSize;
+			__ArenaBlock* block = _ArenaBlockAt(header, offset);
+			if ((char*)data < (char*)header + sizeof(__ArenaHeader) || offset >= header->Size || block->Check != _ArenaBlockCheck)
+			{
+				throw std::runtime_error("Pointer was not allocated from this arena!");
+			}
+			block->Check = 0;
+			header->Used.fetch_sub(block->Size, std::memory_order_relaxed);
+
+			if (block->Class < _ArenaClasses)
+			{
+				std::atomic<uint64_t>& head = header->Classes[block->Class];
+				uint64_t current = head.load(std::memory_order_relaxed);
+				do
+				{
+					block->Next.store(current & _ArenaOffsetMask, std::memory_order_relaxed);
+				} while (!head.compare_exchange_weak(current, (((current >> _ArenaOffsetBits) + 1) << _ArenaOffsetBits) | offset, std::memory_order_release));
+				return;
+			}
+
+			// insert sorted, merging with free neighbours
+			_ArenaLockLarge(header);
+			std::atomic<uint64_t>* link = &header->LargeHead;
+			__ArenaBlock* previous = nullptr;
+			uint64_t next;
+			while ((next = link->load(std::memory_order_relaxed)) && next < offset)
+			{
+				previous = _ArenaBlockAt(header, next);
+				link = &previous->Next;
+			}
+			if (next && offset + block->Size == next)
+			{
+				__ArenaBlock* nextBlock = _ArenaBlockAt(header, next);
+				block->Size += nextBlock->Size;
+				next = nextBlock->Next.load(std::memory_order_relaxed);
+			}
+			if (previous && (uint64_t)((char*)previous - (char*)header) + previous->Size == offset)
+			{
+				// unlink the merged next block before previous grows over it, so the list never overlaps
+				previous->Next.store(next, std::memory_order_relaxed);
+				previous->Size += block->Size;
+			}
+			else
+			{
+				block->Next.store(next, std::memory_order_relaxed);
+				link->store(offset, std::memory_order_relaxed);
+			}
+			_ArenaUnlockLarge(header);
+		}
+
+		/*!
+		* \class	Arena
+		*
+		* \brief	Allocates variable size objects inside a shared memory, so they can be used in place by every process
+		* 			attached to it. Allocations up to 4KB come from lock-free free lists per power of 2 size class;
+		* 			bigger ones from a first-fit free list that merges neighbours, under a spinlock.
+		* 			All state lives in the shared memory, so any process may allocate and free. If a process dies
+		* 			holding the spinlock, others take it over; the block it was allocating or freeing is lost.
+		* 			Link objects with OffsetPtr (not raw pointers), or pass offsets (ToOffset / FromOffset) through
+		* 			queues. Use ArenaAllocator, Vector and String to keep STL containers in the arena.
+		*
+		* \date		10/19/2026
+		*/
+		class Arena
+		{
+		private:
+
+			// magic value marking an initialized arena
+			static const uint64_t _Magic = 0x4a55535441524e41ULL;
+
+			__ArenaHeader* _Header = nullptr;
+
+		public:
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t size = 0)
+			*
+			* \brief	Initialize a new, empty arena in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the arena.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the arena in.
+			* \param	offset				Offset of the arena in the shared memory, aligned to 64 bytes.
+			* \param	size				(Optional) Arena size in bytes, including its header. 0 for the rest of the memory.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t size = 0)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Arena offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize()) throw std::runtime_error("Exceeded shared memory size!");
+				if (size == 0) size = memory.GetSize() - offset;
+				if (size < sizeof(__ArenaHeader) || memory.GetSize() - offset < size) throw std::runtime_error("Exceeded shared memory size!");
+				if (size > _ArenaOffsetMask) throw std::runtime_error("Arena size is limited to 1TB!");
+
+				__ArenaHeader* header = new (memory.GetBuffer() + offset) __ArenaHeader();
+				header->Size = size & ~(uint64_t)15;
+				header->Top.store(sizeof(__ArenaHeader), std::memory_order_relaxed);
+				header->Magic.store(_Magic, std::memory_order_release);
+				_Header = header;
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to an arena another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the arena is in.
+			* \param	offset				Offset of the arena in the shared memory.
+			* Note: throws std::runtime_error if there is no arena at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Arena offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__ArenaHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__ArenaHeader* header = (__ArenaHeader*)(memory.GetBuffer() + offset);
+				if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain an arena!");
+				if (memory.GetSize() - offset < header->Size) throw std::runtime_error("Exceeded shared memory size!");
+				_Header = header;
+			}
+
+			// return if arena is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			/*!
+			* \fn	void* Allocate(size_t size)
+			*
+			* \brief	Allocate memory in the arena, 16 bytes aligned.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size				Bytes to allocate.
+			*
+			* \return	Allocated memory, or nullptr if the arena is full.
+			*/
+			inline void* Allocate(size_t size)
+			{
+				return _ArenaAllocate(_Header, size);
+			}
+
+			/*!
+			* \fn	void Free(void* data)
+			*
+			* \brief	Free memory allocated from the arena, by any process.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data				Memory to free, may be nullptr.
+			* Note: throws std::runtime_error if data was not allocated from this arena.
+			*/
+			inline void Free(void* data)
+			{
+				_ArenaFree(_Header, data);
+			}
+
+			// construct an object in the arena. throws std::bad_alloc if arena is full
+			template <typename T, typename... Args>
+			T* New(Args&&... args)
+			{
+				static_assert(alignof(T) <= 16, "Arena objects must be aligned to at most 16 bytes");
+				void* data = Allocate(sizeof(T));
+				if (!data) throw std::bad_alloc();
+				try
+				{
+					return new (data) T(std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					Free(data);
+					throw;
+				}
+			}
+
+			// destruct and free an object made with New
+			template <typename T>
+			void Delete(T* object)
+			{
+				if (!object) return;
+				object->~T();
+				Free((void*)object);
+			}
+
+			// get offset of memory in the arena, to pass to other processes. 0 for nullptr
+			inline uint64_t ToOffset(const void* data) const
+			{
+				return data ? (uint64_t)((const char*)data - (const char*)_Header) : 0;
+			}
+
+			// get memory from an offset given by ToOffset
+			inline void* FromOffset(uint64_t offset) const
+			{
+				return offset ? (char*)_Header + offset : nullptr;
+			}
+
+			// set the root object, that processes connecting to the arena start from
+			inline void SetRoot(const void* data)
+			{
+				_Header->Root.store(ToOffset(data), std::memory_order_release);
+			}
+
+			// get the root object, nullptr if not set
+			template <typename T = void>
+			inline T* GetRoot() const
+			{
+				return (T*)FromOffset(_Header->Root.load(std::memory_order_acquire));
+			}
+
+			// get bytes in allocated blocks, including block headers and size class rounding
+			inline size_t GetUsedBytes() const { return (size_t)_Header->Used.load(std::memory_order_relaxed); }
+
+			// get bytes never allocated so far
+			inline size_t GetUntouchedBytes() const { return (size_t)(_Header->Size - _Header->Top.load(std::memory_order_relaxed)); }
+
+			// get arena header, used by ArenaAllocator
+			inline __ArenaHeader* GetHeader() const { return _Header; }
+		};
+
+		/*!
+		* \class	ArenaAllocator
+		*
+		* \brief	STL allocator that allocates from an Arena. It refers to the arena with an OffsetPtr, so containers
+		* 			placed in the arena (with Arena::New) can be used by any attached process.
+		* 			Elements that allocate themselves (like String in a Vector) need the allocator passed on construction.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename T>
+		class ArenaAllocator
+		{
+		private:
+
+			template <typename U>
+			friend class ArenaAllocator;
+
+			OffsetPtr<__ArenaHeader> _Header;
+
+		public:
+
+			typedef T value_type;
+			typedef OffsetPtr<T> pointer;
+			typedef OffsetPtr<const T> const_pointer;
+			typedef OffsetPtr<void> void_pointer;
+			typedef OffsetPtr<const void> const_void_pointer;
+			typedef size_t size_type;
+			typedef ptrdiff_t difference_type;
+			typedef std::true_type propagate_on_container_copy_assignment;
+			typedef std::true_type propagate_on_container_move_assignment;
+			typedef std::true_type propagate_on_container_swap;
+
+			template <typename U>
+			struct rebind { typedef ArenaAllocator<U> other; };
+
+			ArenaAllocator(const Arena& arena) : _Header(arena.GetHeader()) {}
+			ArenaAllocator(const ArenaAllocator& other) : _Header(other._Header) {}
+			template <typename U>
+			ArenaAllocator(const ArenaAllocator<U>& other) : _Header(other._Header) {}
+			ArenaAllocator& operator=(const ArenaAllocator& other) { _Header = other._Header; return *this; }
+
+			// allocate n elements. throws std::bad_alloc if arena is full
+			pointer allocate(size_t n)
+			{
+				static_assert(alignof(T) <= 16, "Arena objects must be aligned to at most 16 bytes");
+				if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+				void* data = _ArenaAllocate(_Header.Get(), n * sizeof(T));
+				if (!data) throw std::bad_alloc();
+				return pointer((T*)data);
+			}
+
+			// free elements
+			void deallocate(pointer data, size_t)
+			{
+				_ArenaFree(_Header.Get(), (void*)data.Get());
+			}
+
+			template <typename U>
+			friend inline bool operator==(const ArenaAllocator& a, const ArenaAllocator<U>& b) { return a._Header.Get() == b._Header.Get(); }
+			template <typename U>
+			friend inline bool operator!=(const ArenaAllocator& a, const ArenaAllocator<U>& b) { return a._Header.Get() != b._Header.Get(); }
+		};
+
+		// a vector that lives in an arena
+		template <typename T>
+		using Vector = std::vector<T, ArenaAllocator<T>>;
+
+		/*!
+		* \class	String
+		*
+		* \brief	A string that lives in an arena, with its characters linked by an OffsetPtr.
+		* 			std::basic_string can't be used for this, since standard libraries don't support offset pointers
+		* 			in strings, so this covers the common string operations and converts to std::string_view.
+		*
+		* \date		10/19/2026
+		*/
+		class String
+		{
+		private:
+
+			ArenaAllocator<char> _Allocator;
+			OffsetPtr<char> _Data;
+			size_t _Size = 0;
+			size_t _Capacity = 0;
+
+			// grow capacity to at least required characters (plus null terminator), copying tail after the content.
+			// tail may be in the old buffer (like s.append(s.view())), so it is copied before the old buffer is freed
+			void _Grow(size_t required, std::string_view tail = std::string_view())
+			{
+				if (required <= _Capacity) return;
+				size_t capacity = _Capacity * 2 > required ? _Capacity * 2 : required;
+				if (capacity < 15) capacity = 15;
+				OffsetPtr<char> data = _Allocator.allocate(capacity + 1);
+				if (_Size) memcpy(data.Get(), _Data.Get(), _Size);
+				if (tail.size()) memcpy(data.Get() + _Size, tail.data(), tail.size());
+				data[_Size + tail.size()] = 0;
+				if (_Data) _Allocator.deallocate(_Data, _Capacity + 1);
+				_Data = data;
+				_Capacity = capacity;
+			}
+
+		public:
+
+			typedef char value_type;
+			typedef ArenaAllocator<char> allocator_type;
+			typedef size_t size_type;
+			typedef char* iterator;
+			typedef const char* const_iterator;
+
+			String(const ArenaAllocator<char>& allocator) : _Allocator(allocator) {}
+			String(std::string_view value, const ArenaAllocator<char>& allocator) : _Allocator(allocator) { assign(value); }
+			String(const char* value, const ArenaAllocator<char>& allocator) : _Allocator(allocator) { assign(value); }
+			String(const String& other) : _Allocator(other._Allocator) { assign(other.view()); }
+			String(String&& other) noexcept : _Allocator(other._Allocator), _Data(other._Data), _Size(other._Size), _Capacity(other._Capacity)
+			{
+				other._Data = nullptr;
+				other._Size = other._Capacity = 0;
+			}
+			~String()
+			{
+				if (_Data) _Allocator.deallocate(_Data, _Capacity + 1);
+			}
+
+			String& operator=(const String& other) { if (this != &other) assign(other.view()); return *this; }
+			String& operator=(String&& other) noexcept
+			{
+				if (this == &other) return *this;
+				if (_Allocator != other._Allocator) { assign(other.view()); return *this; }
+				if (_Data) _Allocator.deallocate(_Data, _Capacity + 1);
+				_Data = other._Data;
+				_Size = other._Size;
+				_Capacity = other._Capacity;
+				other._Data = nullptr;
+				other._Size = other._Capacity = 0;
+				return *this;
+			}
+			String& operator=(std::string_view value) { return assign(value); }
+
+			// replace content. value may be part of this string, it is never longer than the buffer then
+			String& assign(std::string_view value)
+			{
+				_Size = 0;
+				return append(value);
+			}
+
+			// append characters. value may be part of this string
+			String& append(std::string_view value)
+			{
+				if (_Size + value.size() > _Capacity) _Grow(_Size + value.size(), value);
+				else if (value.size()) memmove(_Data.Get() + _Size, value.data(), value.size());
+				_Size += value.size();
+				if (_Data) _Data[_Size] = 0;
+				return *this;
+			}
+			String& operator+=(std::string_view value) { return append(value); }
+			String& operator+=(char value) { return append(std::string_view(&value, 1)); }
+			inline void push_back(char value) { append(std::string_view(&value, 1)); }
+
+			// make room for capacity characters
+			inline void reserve(size_t capacity) { _Grow(capacity); }
+
+			// resize, filling new characters with fill
+			void resize(size_t size, char fill = 0)
+			{
+				_Grow(size);
+				if (size > _Size) memset(_Data.Get() + _Size, fill, size - _Size);
+				_Size = size;
+				if (_Data) _Data[_Size] = 0;
+			}
+
+			inline void clear() { resize(0); }
+
+			inline const char* c_str() const { return _Data ? _Data.Get() : ""; }
+			inline const char* data() const { return c_str(); }
+			inline char* data() { return _Data ? _Data.Get() : (char*)""; }
+			inline size_t size() const { return _Size; }
+			inline size_t length() const { return _Size; }
+			inline size_t capacity() const { return _Capacity; }
+			inline bool empty() const { return _Size == 0; }
+			inline char& operator[](size_t index) { return _Data[index]; }
+			inline const char& operator[](size_t index) const { return _Data[index]; }
+			inline iterator begin() { return data(); }
+			inline iterator end() { return data() + _Size; }
+			inline const_iterator begin() const { return c_str(); }
+			inline const_iterator end() const { return c_str() + _Size; }
+			inline ArenaAllocator<char> get_allocator() const { return _Allocator; }
+
+			inline std::string_view view() const { return std::string_view(c_str(), _Size); }
+			inline operator std::string_view() const { return view(); }
+			inline std::string str() const { return std::string(c_str(), _Size); }
+
+			friend inline bool operator==(const String& a, std::string_view b) { return a.view() == b; }
+			friend inline bool operator!=(const String& a, std::string_view b) { return a.view() != b; }
+			friend inline bool operator<(const String& a, const String& b) { return a.view() < b.view(); }
+		};
+	}
+}
@@ -0,0 +1,495 @@
+/*!
+* \file	Source\SharedMemory\BroadcastRing.h.
+*
+* \brief	Ring that broadcasts records from one producer to many consumer processes, each with its own cursor.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	BroadcastMode
+		*
+		* \brief	What the producer does when the slowest reader is a whole ring behind.
+		*/
+		enum class BroadcastMode : uint32_t
+		{
+			// writes fail until the slowest subscribed reader catches up
+			Backpressure = 0,
+
+			// writes never fail; readers that fall a whole ring behind skip ahead and count the lost records
+			Lossy = 1,
+		};
+
+		/*!
+		* \struct	__BroadcastHeader
+		*
+		* \brief	Used internally, header of a broadcast ring in shared memory.
+		* 			Reader cursors follow it (one cache line each), then the slots.
+		*/
+		struct __BroadcastHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			uint64_t SlotSize;
+			uint64_t MaxReaders;
+			BroadcastMode Mode;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Cursor;
+		};
+
+		/*!
+		* \struct	__BroadcastReaderSlot
+		*
+		* \brief	Used internally, a reader's cursor (next sequence it reads), written only by that reader.
+		*/
+		struct __BroadcastReaderSlot
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Cursor;
+			std::atomic<uint32_t> Active;
+			std::atomic<int32_t> Pid;
+		};
+
+		/*!
+		* \struct	__BroadcastSlot
+		*
+		* \brief	Used internally, slot header. Sequence is 2 * (record sequence) + 1 while the record is written,
+		* 			and 2 * (record sequence) + 2 once it is complete. Data follows as 64 bit words.
+		*/
+		struct __BroadcastSlot
+		{
+			std::atomic<uint64_t> Sequence;
+			std::atomic<uint64_t> Size;
+		};
+
+		/*!
+		* \class	BroadcastRing
+		*
+		* \brief	Fans a stream of records out from one producer to many consumers through a single ring of
+		* 			fixed size slots (like a disruptor). Every record is written once, and each reader moves its own
+		* 			cursor over the same slots, so adding readers adds no writes. The producer either waits for the
+		* 			slowest subscribed reader (Backpressure), or overwrites (Lossy) and lets readers detect overruns
+		* 			through the per-slot sequence.
+		* 			One process writes; every process that reads calls Subscribe on its own BroadcastRing object.
+		*
+		* \date		10/19/2026
+		*/
+		class BroadcastRing
+		{
+		private:
+
+			// magic value marking an initialized ring
+			static const uint64_t _Magic = 0x4a55535442524443ULL;
+
+			__BroadcastHeader* _Header = nullptr;
+			__BroadcastReaderSlot* _Readers = nullptr;
+			char* _Slots = nullptr;
+			uint64_t _Mask = 0;
+			uint64_t _Stride = 0;
+			bool _Lossy = false;
+
+			// producer side: next sequence to write, and cached slowest reader cursor
+			uint64_t _WriteSequence = 0;
+			uint64_t _CachedMin = 0;
+
+			// reader side: our reader slot, next sequence to read, and records lost to overruns
+			__BroadcastReaderSlot* _Reader = nullptr;
+			uint64_t _ReadSequence = 0;
+			uint64_t _Lost = 0;
+			std::vector<uint64_t> _Buffer;
+
+			// get slot stride for a slot size
+			static inline uint64_t _StrideFor(size_t slotSize)
+			{
+				return (sizeof(__BroadcastSlot) + ((slotSize + 7) & ~(uint64_t)7) + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1);
+			}
+
+			// get slot by sequence
+			inline __BroadcastSlot* _Slot(uint64_t sequence) const
+			{
+				return (__BroadcastSlot*)(_Slots + (sequence & _Mask) * _Stride);
+			}
+
+			// get slot data words
+			static inline std::atomic<uint64_t>* _Words(__BroadcastSlot* slot)
+			{
+				return (std::atomic<uint64_t>*)(slot + 1);
+			}
+
+			// recompute slowest reader cursor, dropping readers whose process died
+			uint64_t _MinCursor(bool dropDead)
+			{
+				// pairs with Subscribe: a reader we don't see starts at or after our published cursor
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				uint64_t ret = _WriteSequence;
+				for (uint64_t i = 0; i < _Header->MaxReaders; ++i)
+				{
+					__BroadcastReaderSlot& reader = _Readers[i];
+					if (reader.Active.load(std::memory_order_seq_cst) != 1) continue;
+					if (dropDead && _IsProcessDead(reader.Pid.load(std::memory_order_relaxed)))
+					{
+						reader.Active.store(0, std::memory_order_release);
+						continue;
+					}
+					uint64_t cursor = reader.Cursor.load(std::memory_order_acquire);
+					if (cursor < ret) ret = cursor;
+				}
+				return ret;
+			}
+
+			// copy record of a complete slot out. in lossy mode the writer may overwrite it meanwhile, so words are atomic
+			inline size_t _CopyOut(__BroadcastSlot* slot, void* data, size_t bufferSize)
+			{
+				size_t size = (size_t)slot->Size.load(std::memory_order_relaxed);
+				if (size > _Header->SlotSize) size = (size_t)_Header->SlotSize;
+				size_t copy = size < bufferSize ? size : bufferSize;
+				if (!_Lossy)
+				{
+					memcpy(data, (const void*)_Words(slot), copy);
+					return size;
+				}
+				std::atomic<uint64_t>* words = _Words(slot);
+				size_t whole = copy / 8;
+				for (size_t i = 0; i < whole; ++i)
+				{
+					uint64_t word = words[i].load(std::memory_order_relaxed);
+					memcpy((char*)data + i * 8, &word, 8);
+				}
+				if (copy % 8)
+				{
+					uint64_t word = words[whole].load(std::memory_order_relaxed);
+					memcpy((char*)data + whole * 8, &word, copy % 8);
+				}
+				return size;
+			}
+
+			// read the record at _ReadSequence. returns 0 if there is none yet, 1 if read, -1 if overrun (and skips ahead)
+			int _ReadOne(void* data, size_t bufferSize, size_t& size)
+			{
+				uint64_t cursor = _Header->Cursor.load(std::memory_order_acquire);
+				if (_ReadSequence >= cursor) return 0;
+				__BroadcastSlot* slot = _Slot(_ReadSequence);
+				uint64_t expected = 2 * _ReadSequence + 2;
+				uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+				if (sequence == expected)
+				{
+					size = _CopyOut(slot, data, bufferSize);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (slot->Sequence.load(std::memory_order_relaxed) == expected)
+					{
+						++_ReadSequence;
+						return 1;
+					}
+				}
+
+				// writer lapped us: skip to the oldest record that may still be there
+				uint64_t oldest = cursor > _Mask ? cursor - _Mask : 0;
+				if (oldest <= _ReadSequence) oldest = _ReadSequence + 1;
+				_Lost += oldest - _ReadSequence;
+				_ReadSequence = oldest;
+				return -1;
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity, size_t slotSize, size_t maxReaders, BroadcastMode mode)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Ring offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__BroadcastHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__BroadcastHeader* header = (__BroadcastHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a broadcast ring!");
+					capacity = (size_t)header->Capacity;
+					slotSize = (size_t)header->SlotSize;
+					maxReaders = (size_t)header->MaxReaders;
+					mode = header->Mode;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity, slotSize, maxReaders)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Readers = (__BroadcastReaderSlot*)(header + 1);
+				_Slots = (char*)(_Readers + maxReaders);
+				_Mask = capacity - 1;
+				_Stride = _StrideFor(slotSize);
+				_Lossy = mode == BroadcastMode::Lossy;
+				if (create)
+				{
+					new (header) __BroadcastHeader();
+					header->Capacity = capacity;
+					header->SlotSize = slotSize;
+					header->MaxReaders = maxReaders;
+					header->Mode = mode;
+					for (size_t i = 0; i < maxReaders; ++i) new (_Readers + i) __BroadcastReaderSlot();
+					for (uint64_t i = 0; i < capacity; ++i) new (_Slot(i)) __BroadcastSlot();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+				_WriteSequence = _CachedMin = header->Cursor.load(std::memory_order_acquire);
+			}
+
+		public:
+
+			BroadcastRing() = default;
+
+			// readers own a reader slot, so rings can't be copied
+			BroadcastRing(const BroadcastRing&) = delete;
+			BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+			~BroadcastRing()
+			{
+				Unsubscribe();
+			}
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity, size_t slotSize, size_t maxReaders)
+			*
+			* \brief	Get how many bytes of shared memory a broadcast ring needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Number of slots.
+			* \param	slotSize			Max bytes per record.
+			* \param	maxReaders			Max readers subscribed at once.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity, size_t slotSize, size_t maxReaders)
+			{
+				return sizeof(__BroadcastHeader) + maxReaders * sizeof(__BroadcastReaderSlot) + capacity * (size_t)_StrideFor(slotSize);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize, size_t maxReaders = 16, BroadcastMode mode = BroadcastMode::Backpressure)
+			*
+			* \brief	Initialize a new, empty broadcast ring in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the ring.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the ring in.
+			* \param	offset				Offset of the ring in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Number of slots. Must be a power of 2, at least 2.
+			* \param	slotSize			Max bytes per record.
+			* \param	maxReaders			(Optional) Max readers subscribed at once.
+			* \param	mode				(Optional) Wait for slow readers, or overwrite.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize, size_t maxReaders = 16, BroadcastMode mode = BroadcastMode::Backpressure)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1))) throw std::runtime_error("Ring capacity must be a power of 2, at least 2!");
+				if (slotSize == 0 || maxReaders == 0) throw std::runtime_error("Ring slot size and max readers must not be 0!");
+				_Attach(memory, offset, true, capacity, slotSize, maxReaders, mode);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a broadcast ring another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the ring is in.
+			* \param	offset				Offset of the ring in the shared memory.
+			* Note: throws std::runtime_error if there is no broadcast ring at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0, 0, BroadcastMode::Backpressure);
+			}
+
+			// return if ring is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get max bytes per record
+			inline size_t GetSlotSize() const { return (size_t)_Header->SlotSize; }
+
+			/*!
+			* \fn	bool TryWrite(const void* data, size_t size)
+			*
+			* \brief	Write a record for all readers. Producer only.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Record data.
+			* \param	size 				Record size, at most slot size.
+			*
+			* \return	False if in Backpressure mode and the slowest reader is a whole ring behind.
+			*/
+			bool TryWrite(const void* data, size_t size)
+			{
+				if (size > _Header->SlotSize) throw std::runtime_error("Record is too big for ring slot!");
+				if (!_Lossy && _WriteSequence - _CachedMin > _Mask)
+				{
+					_CachedMin = _MinCursor(false);
+					if (_WriteSequence - _CachedMin > _Mask) _CachedMin = _MinCursor(true);
+					if (_WriteSequence - _CachedMin > _Mask) return false;
+				}
+
+				__BroadcastSlot* slot = _Slot(_WriteSequence);
+				std::atomic<uint64_t>* words = _Words(slot);
+				if (_Lossy)
+				{
+					// readers may be copying the slot: mark it in progress, then store words atomically
+					slot->Sequence.store(2 * _WriteSequence + 1, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_release);
+					size_t whole = size / 8;
+					for (size_t i = 0; i < whole; ++i)
+					{
+						uint64_t word;
+						memcpy(&word, (const char*)data + i * 8, 8);
+						words[i].store(word, std::memory_order_relaxed);
+					}
+					if (size % 8)
+					{
+						uint64_t word = 0;
+						memcpy(&word, (const char*)data + whole * 8, size % 8);
+						words[whole].store(word, std::memory_order_relaxed);
+					}
+				}
+				else
+				{
+					memcpy((void*)words, data, size);
+				}
+				slot->Size.store(size, std::memory_order_relaxed);
+				slot->Sequence.store(2 * _WriteSequence + 2, std::memory_order_release);
+				_Header->Cursor.store(++_WriteSequence, std::memory_order_release);
+				return true;
+			}
+
+			// write a trivially copyable value
+			template <typename T>
+			inline bool TryWrite(const T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Ring records must be trivially copyable");
+				return TryWrite(&value, sizeof(T));
+			}
+
+			/*!
+			* \fn	bool Subscribe()
+			*
+			* \brief	Start reading with this object. Reading starts from the next record written.
+			* 			In Backpressure mode the producer waits for this reader from now on, until Unsubscribe
+			* 			(or until its process dies).
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if max readers are already subscribed.
+			*/
+			bool Subscribe()
+			{
+				if (_Reader) return true;
+				for (uint64_t i = 0; i < _Header->MaxReaders; ++i)
+				{
+					__BroadcastReaderSlot& reader = _Readers[i];
+					uint32_t expected = 0;
+					if (!reader.Active.compare_exchange_strong(expected, 2, std::memory_order_acquire)) continue;
+
+					// become visible to the producer first, then start from its cursor (see _MinCursor)
+					reader.Pid.store(_CurrentProcessId(), std::memory_order_relaxed);
+					reader.Cursor.store(_Header->Cursor.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+					reader.Active.store(1, std::memory_order_seq_cst);
+					_ReadSequence = _Header->Cursor.load(std::memory_order_seq_cst);
+					reader.Cursor.store(_ReadSequence, std::memory_order_release);
+					_Reader = &reader;
+					_Lost = 0;
+					return true;
+				}
+				return false;
+			}
+
+			// stop reading, so the producer stops waiting for this reader
+			void Unsubscribe()
+			{
+				if (!_Reader) return;
+				_Reader->Active.store(0, std::memory_order_release);
+				_Reader = nullptr;
+			}
+
+			/*!
+			* \fn	bool TryRead(void* data, size_t& size)
+			*
+			* \brief	Read the next record, if there is one. Subscribed readers only.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Buffer to copy record into, at least slot size bytes.
+			* \param	size 				Record size.
+			*
+			* \return	False if there is no new record.
+			*/
+			bool TryRead(void* data, size_t& size)
+			{
+				if (!_Reader) throw std::runtime_error("Must subscribe to read from broadcast ring!");
+				int ret;
+				while ((ret = _ReadOne(data, (size_t)_Header->SlotSize, size)) < 0) {}
+				if (ret) _Reader->Cursor.store(_ReadSequence, std::memory_order_release);
+				return ret > 0;
+			}
+
+			// read a trivially copyable value. record should have been written with the same type
+			template <typename T>
+			inline bool TryRead(T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Ring records must be trivially copyable");
+				if (!_Reader) throw std::runtime_error("Must subscribe to read from broadcast ring!");
+				int ret;
+				size_t size;
+				while ((ret = _ReadOne(&value, sizeof(T), size)) < 0) {}
+				if (ret) _Reader->Cursor.store(_ReadSequence, std::memory_order_release);
+				return ret > 0;
+			}
+
+			/*!
+			* \fn	template <typename Handler> size_t Consume(Handler handler, size_t max = (size_t)-1)
+			*
+			* \brief	Read available records, calling handler(const void* data, size_t size) for each.
+			* 			The cursor is stored once for the whole batch.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Callable taking (const void*, size_t). Data is valid only during the call.
+			* \param	max					(Optional) Max records to read.
+			*
+			* \return	Number of records read.
+			*/
+			template <typename Handler>
+			size_t Consume(Handler handler, size_t max = (size_t)-1)
+			{
+				if (!_Reader) throw std::runtime_error("Must subscribe to read from broadcast ring!");
+				_Buffer.resize((size_t)(_Header->SlotSize + 7) / 8);
+				size_t count = 0;
+				while (count < max)
+				{
+					size_t size;
+					int ret = _ReadOne(_Buffer.data(), (size_t)_Header->SlotSize, size);
+					if (ret < 0) continue;
+					if (ret == 0) break;
+					handler((const void*)_Buffer.data(), size);
+					++count;
+				}
+				if (count) _Reader->Cursor.store(_ReadSequence, std::memory_order_release);
+				return count;
+			}
+
+			// get number of records this reader lost to overruns (Lossy mode)
+			inline uint64_t GetLostCount() const { return _Lost; }
+
+			// get number of records written but not read yet by this reader
+			inline uint64_t GetLag() const
+			{
+				uint64_t cursor = _Header->Cursor.load(std::memory_order_acquire);
+				return cursor > _ReadSequence ? cursor - _ReadSequence : 0;
+			}
+		};
+	}
+}
@@ -0,0 +1,180 @@
+/*!
+* \file	Source\SharedMemory\Copy.h.
+*
+* \brief	Bulk memory copy that bypasses the caches for large sizes (non-temporal stores), picked at runtime for the CPU.
+*/
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+// JUST_SHM_STREAMING_COPY is defined where BulkCopy has streaming stores (x86-64), elsewhere both modes are memcpy.
+// JUST_SHM_TARGET_AVX2 is internal, undefined at the end of this file
+#if defined(__x86_64__) || defined(_M_X64)
+#define JUST_SHM_STREAMING_COPY 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define JUST_SHM_TARGET_AVX2
+#else
+#define JUST_SHM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	CopyMode
+		*
+		* \brief	How BulkCopy writes the destination.
+		*/
+		enum class CopyMode
+		{
+			// streaming from the threshold up (see SetStreamingThreshold), cached below it
+			Auto = 0,
+
+			// plain memcpy, destination ends up in the cache. best when it is read again soon, or is small
+			Cached = 1,
+
+			// non-temporal stores straight to memory, without evicting what is in the cache. best for large copies
+			// that won't be read again soon by this core (the reader is another process, usually on another core)
+			Streaming = 2,
+		};
+
+		// copies from this size up stream by default. about the point where the copy no longer fits in the caches
+		inline std::atomic<size_t> _StreamingThreshold(4u << 20);
+
+		// set the size from which CopyMode::Auto copies stream, 0 to always stream, SIZE_MAX to never stream
+		inline void SetStreamingThreshold(size_t bytes) { _StreamingThreshold.store(bytes, std::memory_order_relaxed); }
+
+		// get the size from which CopyMode::Auto copies stream
+		inline size_t GetStreamingThreshold() { return _StreamingThreshold.load(std::memory_order_relaxed); }
+
+#ifdef JUST_SHM_STREAMING_COPY
+		/*!
+		* \fn	inline void _StreamCopySse2(char* destination, const char* source, size_t size)
+		*
+		* \brief	Used internally, copy with 16 byte non-temporal stores. SSE2 is part of x86-64, so this always works.
+		*
+		* \date		10/19/2026
+		*/
+		inline void _StreamCopySse2(char* destination, const char* source, size_t size)
+		{
+			// align destination, streaming stores need aligned addresses
+			size_t head = (16 - ((uintptr_t)destination & 15)) & 15;
+			if (head > size) head = size;
+			memcpy(destination, source, head);
+			destination += head;
+			source += head;
+			size -= head;
+
+			for (; size >= 64; size -= 64, destination += 64, source += 64)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)source);
+				__m128i b = _mm_loadu_si128((const __m128i*)(source + 16));
+				__m128i c = _mm_loadu_si128((const __m128i*)(source + 32));
+				__m128i d = _mm_loadu_si128((const __m128i*)(source + 48));
+				_mm_stream_si128((__m128i*)destination, a);
+				_mm_stream_si128((__m128i*)(destination + 16), b);
+				_mm_stream_si128((__m128i*)(destination + 32), c);
+				_mm_stream_si128((__m128i*)(destination + 48), d);
+			}
+			memcpy(destination, source, size);
+
+			// streaming stores are weakly ordered, make them visible before anything written after the copy
+			_mm_sfence();
+		}
+
+		/*!
+		* \fn	inline void _StreamCopyAvx2(char* destination, const char* source, size_t size)
+		*
+		* \brief	Used internally, copy with 32 byte non-temporal stores. Only call it if the CPU supports AVX2.
+		*
+		* \date		10/19/2026
+		*/
+		JUST_SHM_TARGET_AVX2 inline void _StreamCopyAvx2(char* destination, const char* source, size_t size)
+		{
+			size_t head = (32 - ((uintptr_t)destination & 31)) & 31;
+			if (head > size) head = size;
+			memcpy(destination, source, head);
+			destination += head;
+			source += head;
+			size -= head;
+
+			for (; size >= 128; size -= 128, destination += 128, source += 128)
+			{
+				__m256i a = _mm256_loadu_si256((const __m256i*)source);
+				__m256i b = _mm256_loadu_si256((const __m256i*)(source + 32));
+				__m256i c = _mm256_loadu_si256((const __m256i*)(source + 64));
+				__m256i d = _mm256_loadu_si256((const __m256i*)(source + 96));
+				_mm256_stream_si256((__m256i*)destination, a);
+				_mm256_stream_si256((__m256i*)(destination + 32), b);
+				_mm256_stream_si256((__m256i*)(destination + 64), c);
+				_mm256_stream_si256((__m256i*)(destination + 96), d);
+			}
+			memcpy(destination, source, size);
+			_mm_sfence();
+		}
+
+		/*!
+		* \fn	inline bool _HasAvx2()
+		*
+		* \brief	Used internally, return if the CPU (and OS) support AVX2. Checked once.
+		*
+		* \date		10/19/2026
+		*/
+		inline bool _HasAvx2()
+		{
+#ifdef _MSC_VER
+			static const bool supported = []() {
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7) return false;
+				__cpuid(info, 1);
+				bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+				__cpuidex(info, 7, 0);
+				return osSavesAvx && (info[1] & (1 << 5)) != 0;
+			}();
+#else
+			static const bool supported = __builtin_cpu_supports("avx2");
+#endif
+			return supported;
+		}
+#endif
+
+		/*!
+		* \fn	inline void BulkCopy(void* destination, const void* source, size_t size, CopyMode mode = CopyMode::Auto)
+		*
+		* \brief	Copy memory, with non-temporal stores for large sizes so a big transfer does not flush the caches
+		* 			of the copying core (and the lines don't have to be pulled back from it by the process that reads them).
+		* 			Uses AVX2 if the CPU has it, SSE2 otherwise; on other architectures it is a plain memcpy.
+		* 			Ends with a store fence, so it can be published with a release store like a memcpy.
+		*
+		* \date		10/19/2026
+		*
+		* \param	destination			Memory to copy to. Must not overlap source.
+		* \param	source				Memory to copy from.
+		* \param	size				Bytes to copy.
+		* \param	mode				(Optional) Copy strategy, Auto picks by size.
+		*/
+		inline void BulkCopy(void* destination, const void* source, size_t size, CopyMode mode = CopyMode::Auto)
+		{
+#ifdef JUST_SHM_STREAMING_COPY
+			if (mode == CopyMode::Streaming || (mode == CopyMode::Auto && size >= _StreamingThreshold.load(std::memory_order_relaxed)))
+			{
+				if (_HasAvx2()) _StreamCopyAvx2((char*)destination, (const char*)source, size);
+				else _StreamCopySse2((char*)destination, (const char*)source, size);
+				return;
+			}
+#else
+			(void)mode;
+#endif
+			memcpy(destination, source, size);
+		}
+	}
+}
+
+#undef JUST_SHM_TARGET_AVX2
@@ -0,0 +1,323 @@
+/*!
+* \file	Source\SharedMemory\Futex.h.
+*
+* \brief	Cross-process wait / notify on words inside a shared memory, so consumers don't have to poll.
+*/
+#pragma once
+#include <stdint.h>
+#include <limits.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free, "Futex words must be plain lock-free 32 bit atomics");
+
+		/*!
+		* \fn	inline void _CpuRelax()
+		*
+		* \brief	Used internally, hint the CPU we are spinning (pause instruction where there is one).
+		*
+		* \date		10/19/2026
+		*/
+		inline void _CpuRelax()
+		{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			_mm_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		/*!
+		* \fn	inline bool WaitOnAddress(std::atomic<uint32_t>* address, uint32_t expected, int64_t timeoutMicroseconds = -1)
+		*
+		* \brief	Sleep while a 32 bit word in shared memory equals expected, until another process calls Wake on it.
+		* 			On linux this is a shared (not process private) futex, so it works across processes that map the same
+		* 			memory, even at different addresses. The check and the sleep are atomic, so a Wake that comes after the
+		* 			value changed is never missed. May return spuriously, callers should re-check their condition.
+		* 			On windows there is no cross-process futex, so it polls the word with short sleeps instead.
+		*
+		* \date		10/19/2026
+		*
+		* \param	address				Word in the shared memory to wait on. Must be 4 bytes aligned.
+		* \param	expected			Value to sleep while the word has.
+		* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+		*
+		* \return	False if timed out, true otherwise (woken, value changed, or spurious wakeup).
+		*/
+		inline bool WaitOnAddress(std::atomic<uint32_t>* address, uint32_t expected, int64_t timeoutMicroseconds = -1)
+		{
+#ifndef _WIN32
+			struct timespec timeout;
+			if (timeoutMicroseconds >= 0)
+			{
+				timeout.tv_sec = (time_t)(timeoutMicroseconds / 1000000);
+				timeout.tv_nsec = (long)(timeoutMicroseconds % 1000000) * 1000;
+			}
+			long ret = syscall(SYS_futex, (uint32_t*)address, FUTEX_WAIT, expected, timeoutMicroseconds >= 0 ? &timeout : NULL, NULL, 0);
+			return !(ret == -1 && errno == ETIMEDOUT);
+#else
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+			while (address->load(std::memory_order_acquire) == expected)
+			{
+				if (timeoutMicroseconds >= 0 && std::chrono::steady_clock::now() >= deadline) return false;
+				Sleep(1);
+			}
+			return true;
+#endif
+		}
+
+		/*!
+		* \fn	inline int Wake(std::atomic<uint32_t>* address, int count = 1)
+		*
+		* \brief	Wake processes sleeping in WaitOnAddress on a word. Change the word before calling it.
+		*
+		* \date		10/19/2026
+		*
+		* \param	address				Word in the shared memory to wake waiters of.
+		* \param	count				(Optional) Max waiters to wake, INT_MAX for all.
+		*
+		* \return	Number of waiters woken (always 0 on windows, where waiters poll).
+		*/
+		inline int Wake(std::atomic<uint32_t>* address, int count = 1)
+		{
+#ifndef _WIN32
+			long ret = syscall(SYS_futex, (uint32_t*)address, FUTEX_WAKE, count, NULL, NULL, 0);
+			return ret < 0 ? 0 : (int)ret;
+#else
+			(void)address;
+			(void)count;
+			return 0;
+#endif
+		}
+
+		// wake all processes waiting on a word
+		inline int WakeAll(std::atomic<uint32_t>* address)
+		{
+			return Wake(address, INT_MAX);
+		}
+
+		/*!
+		* \struct	__EventHeader
+		*
+		* \brief	Used internally, header of an event in shared memory.
+		* 			Epoch grows with every notify, Waiters counts processes parked (or about to park) on it.
+		*/
+		struct __EventHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			std::atomic<uint32_t> Epoch;
+			std::atomic<uint32_t> Waiters;
+		};
+
+		/*!
+		* \class	Event
+		*
+		* \brief	Lets consumers of a shared memory structure (ring, queue, snapshot...) sleep until a producer
+		* 			notifies them, instead of polling. It is an event count: take a key with GetKey(), check your
+		* 			condition, and if it is not met Wait(key). A notify that happens after GetKey() is never missed.
+		* 			Waiting first spins for a while, since notifies often come within microseconds, then parks on
+		* 			a futex so idle consumers use no CPU. The spin length adapts: it grows when spinning caught the
+		* 			notify and shrinks when it had to park anyway. Notify costs no syscall when nobody is parked.
+		*
+		* \date		10/19/2026
+		*/
+		class Event
+		{
+		private:
+
+			// magic value marking an initialized event
+			static const uint64_t _Magic = 0x4a55535445564e54ULL;
+
+			// spin length bounds, in iterations
+			static const uint32_t _MinSpin = 16;
+			static const uint32_t _MaxSpin = 16384;
+
+			__EventHeader* _Header = nullptr;
+			uint32_t _Spin = 1024;
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Event offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < RequiredSize()) throw std::runtime_error("Exceeded shared memory size!");
+				__EventHeader* header = (__EventHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __EventHeader();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				else if (header->Magic.load(std::memory_order_acquire) != _Magic)
+				{
+					throw std::runtime_error("Shared memory does not contain an event!");
+				}
+				_Header = header;
+
+				// spinning only helps if the notifier can run meanwhile
+				if (std::thread::hardware_concurrency() <= 1) _Spin = 0;
+			}
+
+		public:
+
+			// get how many bytes of shared memory an event needs
+			static inline size_t RequiredSize()
+			{
+				return sizeof(__EventHeader);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset)
+			*
+			* \brief	Initialize a new event in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the event.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the event in.
+			* \param	offset				Offset of the event in the shared memory, aligned to 64 bytes.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, true);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to an event another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the event is in.
+			* \param	offset				Offset of the event in the shared memory.
+			* Note: throws std::runtime_error if there is no event at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false);
+			}
+
+			// return if event is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get a key to wait with. take it before checking the condition you wait for
+			inline uint32_t GetKey() const
+			{
+				return _Header->Epoch.load(std::memory_order_seq_cst);
+			}
+
+			// set max spin iterations before parking, 0 to park right away. it adapts from there
+			inline void SetSpin(uint32_t spin) { _Spin = spin; }
+
+			/*!
+			* \fn	bool Wait(uint32_t key, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Wait until the event is notified after key was taken.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key from GetKey().
+			* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+			*
+			* \return	False if timed out.
+			*/
+			bool Wait(uint32_t key, int64_t timeoutMicroseconds = -1)
+			{
+				for (uint32_t i = 0; i < _Spin; ++i)
+				{
+					if (_Header->Epoch.load(std::memory_order_acquire) != key)
+					{
+						if (_Spin < _MaxSpin) _Spin *= 2;
+						return true;
+					}
+					_CpuRelax();
+				}
+				if (_Spin > _MinSpin) _Spin /= 2;
+				if (timeoutMicroseconds == 0) return _Header->Epoch.load(std::memory_order_acquire) != key;
+
+				// announce we park before checking the epoch again; notifiers bump the epoch before checking waiters
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+				_Header->Waiters.fetch_add(1, std::memory_order_seq_cst);
+				bool notified = true;
+				while (_Header->Epoch.load(std::memory_order_seq_cst) == key)
+				{
+					int64_t remaining = -1;
+					if (timeoutMicroseconds >= 0)
+					{
+						remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+						if (remaining <= 0) { notified = false; break; }
+					}
+					WaitOnAddress(&_Header->Epoch, key, remaining);
+				}
+				_Header->Waiters.fetch_sub(1, std::memory_order_relaxed);
+				return notified;
+			}
+
+			/*!
+			* \fn	template <typename Condition> bool WaitFor(Condition condition, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Wait until condition() returns true, re-checking it after every notify.
+			*
+			* \date		10/19/2026
+			*
+			* \param	condition			Callable returning bool, for example "queue is not empty".
+			* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+			*
+			* \return	False if timed out before the condition was met.
+			*/
+			template <typename Condition>
+			bool WaitFor(Condition condition, int64_t timeoutMicroseconds = -1)
+			{
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+				while (true)
+				{
+					uint32_t key = GetKey();
+					if (condition()) return true;
+					int64_t remaining = -1;
+					if (timeoutMicroseconds >= 0)
+					{
+						remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+						if (remaining <= 0) return false;
+					}
+					Wait(key, remaining);
+				}
+			}
+
+			// wake one parked waiter (spinning waiters always see the notify)
+			inline void NotifyOne()
+			{
+				_Header->Epoch.fetch_add(1, std::memory_order_seq_cst);
+				if (_Header->Waiters.load(std::memory_order_seq_cst) != 0) Wake(&_Header->Epoch, 1);
+			}
+
+			// wake all waiters
+			inline void NotifyAll()
+			{
+				_Header->Epoch.fetch_add(1, std::memory_order_seq_cst);
+				if (_Header->Waiters.load(std::memory_order_seq_cst) != 0) WakeAll(&_Header->Epoch);
+			}
+		};
+	}
+}
@@ -0,0 +1,423 @@
+/*!
+* \file	Source\SharedMemory\HashMap.h.
+*
+* \brief	Fixed capacity hash map inside a shared memory, read in place by many processes without locks.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+#include "Futex.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	HashMapMode
+		*
+		* \brief	Who may write to a hash map.
+		*/
+		enum class HashMapMode : uint32_t
+		{
+			// one process writes at a time. erased slots are reused by any key
+			SingleWriter = 0,
+
+			// any number of processes write, locking single slots with a CAS. a slot that held a key keeps it
+			// after Erase (only that key can reuse it), so size the map for the number of distinct keys ever set
+			MultiWriter = 1,
+		};
+
+		/*!
+		* \struct	__HashMapHeader
+		*
+		* \brief	Used internally, header of a hash map in shared memory. Slots follow right after it.
+		*/
+		struct __HashMapHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			uint32_t KeySize;
+			uint32_t ValueSize;
+			HashMapMode Mode;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Count;
+		};
+
+		/*!
+		* \class	HashMap
+		*
+		* \brief	A hash map of trivially copyable keys and values with a fixed capacity, in shared memory.
+		* 			Uses linear probing. Every slot has its own version word (a small seqlock), so readers copy just the
+		* 			slot they need and retry if a writer changed it meanwhile; they never lock and never copy the table.
+		* 			Keys are compared bytewise, so key types must not have padding. Hash must give the same results
+		* 			in every process (the default std::hash does for integers, within the same standard library).
+		*
+		* \date		10/19/2026
+		*/
+		template <typename K, typename V, typename Hash = std::hash<K>>
+		class HashMap
+		{
+			static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value, "HashMap keys and values must be trivially copyable");
+
+		private:
+
+			// magic value marking an initialized hash map
+			static const uint64_t _Magic = 0x4a55535448534d50ULL;
+
+			// key and value sizes, in 64 bit words
+			static const size_t _KeyWords = (sizeof(K) + 7) / 8;
+			static const size_t _ValueWords = (sizeof(V) + 7) / 8;
+
+			// slot: version word, then key words, then value words
+			static const size_t _SlotWords = 1 + _KeyWords + _ValueWords;
+
+			// version word: bit 0 set while a writer holds the slot, bits 1-2 slot state, the rest counts writes
+			static const uint64_t _Locked = 1;
+			static const uint64_t _Empty = 0;
+			static const uint64_t _Occupied = 1;
+			static const uint64_t _Deleted = 2;
+
+			__HashMapHeader* _Header = nullptr;
+			std::atomic<uint64_t>* _Slots = nullptr;
+			uint64_t _Mask = 0;
+			bool _MultiWriter = false;
+
+			static inline uint64_t _State(uint64_t version) { return (version >> 1) & 3; }
+
+			// get first slot to probe. mixes the hash so that keys with a common stride don't pile up
+			static inline uint64_t _HashOf(const K& key)
+			{
+				uint64_t hash = (uint64_t)Hash()(key);
+				hash ^= hash >> 33;
+				hash *= 0xff51afd7ed558ccdULL;
+				hash ^= hash >> 33;
+				hash *= 0xc4ceb9fe1a85ec53ULL;
+				hash ^= hash >> 33;
+				return hash;
+			}
+
+			inline std::atomic<uint64_t>* _Slot(uint64_t index) const
+			{
+				return _Slots + (index & _Mask) * _SlotWords;
+			}
+
+			// copy words out / in, relaxed
+			static inline void _Load(const std::atomic<uint64_t>* words, void* out, size_t size)
+			{
+				uint64_t buffer[(_KeyWords > _ValueWords ? _KeyWords : _ValueWords)];
+				for (size_t i = 0; i < (size + 7) / 8; ++i) buffer[i] = words[i].load(std::memory_order_relaxed);
+				memcpy(out, buffer, size);
+			}
+			static inline void _Store(std::atomic<uint64_t>* words, const void* data, size_t size)
+			{
+				uint64_t buffer[(_KeyWords > _ValueWords ? _KeyWords : _ValueWords)] = {};
+				memcpy(buffer, data, size);
+				for (size_t i = 0; i < (size + 7) / 8; ++i) words[i].store(buffer[i], std::memory_order_relaxed);
+			}
+
+			// compare a slot key, relaxed
+			static inline bool _KeyEquals(const std::atomic<uint64_t>* slot, const K& key)
+			{
+				K slotKey;
+				_Load(slot + 1, &slotKey, sizeof(K));
+				return memcmp(&slotKey, &key, sizeof(K)) == 0;
+			}
+
+			// wait until a slot is not held by a writer, and get its version
+			static inline uint64_t _Stable(const std::atomic<uint64_t>* slot)
+			{
+				uint64_t version;
+				for (unsigned attempt = 0; (version = slot->load(std::memory_order_acquire)) & _Locked; ++attempt)
+				{
+					if (attempt >= 64) std::this_thread::yield();
+					else _CpuRelax();
+				}
+				return version;
+			}
+
+			// take a slot for writing, return its version from before
+			inline uint64_t _Lock(std::atomic<uint64_t>* slot)
+			{
+				uint64_t version;
+				if (_MultiWriter)
+				{
+					do
+					{
+						version = _Stable(slot);
+					} while (!slot->compare_exchange_weak(version, version | _Locked, std::memory_order_acquire, std::memory_order_relaxed));
+				}
+				else
+				{
+					version = slot->load(std::memory_order_relaxed);
+					slot->store(version | _Locked, std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_release);
+				return version;
+			}
+
+			// release a slot with a new state
+			static inline void _Unlock(std::atomic<uint64_t>* slot, uint64_t version, uint64_t state)
+			{
+				slot->store((((version >> 3) + 1) << 3) | (state << 1), std::memory_order_release);
+			}
+
+			// write key and value into a locked slot, and release it occupied
+			inline void _Fill(std::atomic<uint64_t>* slot, uint64_t version, const K& key, const V& value)
+			{
+				if (_State(version) == _Empty || !_MultiWriter) _Store(slot + 1, &key, sizeof(K));
+				_Store(slot + 1 + _KeyWords, &value, sizeof(V));
+				if (_State(version) != _Occupied) _Header->Count.fetch_add(1, std::memory_order_relaxed);
+				_Unlock(slot, version, _Occupied);
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity, HashMapMode mode)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Hash map offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__HashMapHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__HashMapHeader* header = (__HashMapHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic || header->KeySize != sizeof(K) || header->ValueSize != sizeof(V))
+					{
+						throw std::runtime_error("Shared memory does not contain a hash map of this type!");
+					}
+					capacity = (size_t)header->Capacity;
+					mode = header->Mode;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Slots = (std::atomic<uint64_t>*)(header + 1);
+				_Mask = capacity - 1;
+				_MultiWriter = mode == HashMapMode::MultiWriter;
+				if (create)
+				{
+					new (header) __HashMapHeader();
+					header->Capacity = capacity;
+					header->KeySize = sizeof(K);
+					header->ValueSize = sizeof(V);
+					header->Mode = mode;
+					for (size_t i = 0; i < capacity * _SlotWords; ++i) new (_Slots + i) std::atomic<uint64_t>(0);
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity)
+			*
+			* \brief	Get how many bytes of shared memory a hash map needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Number of slots.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity)
+			{
+				return sizeof(__HashMapHeader) + capacity * _SlotWords * sizeof(uint64_t);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity, HashMapMode mode = HashMapMode::SingleWriter)
+			*
+			* \brief	Initialize a new, empty hash map in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the map.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the map in.
+			* \param	offset				Offset of the map in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Number of slots. Must be a power of 2. Keep the map under ~70% full for short probes.
+			* \param	mode				(Optional) Single writer, or many writers.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity, HashMapMode mode = HashMapMode::SingleWriter)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1))) throw std::runtime_error("Hash map capacity must be a power of 2, at least 2!");
+				_Attach(memory, offset, true, capacity, mode);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a hash map another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the map is in.
+			* \param	offset				Offset of the map in the shared memory.
+			* Note: throws std::runtime_error if there is no map of these types at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, HashMapMode::SingleWriter);
+			}
+
+			// return if map is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get number of slots
+			inline size_t GetCapacity() const { return (size_t)(_Mask + 1); }
+
+			// get number of keys (approximate while writers are busy)
+			inline size_t GetCount() const { return (size_t)_Header->Count.load(std::memory_order_relaxed); }
+
+			/*!
+			* \fn	bool Find(const K& key, V& value) const
+			*
+			* \brief	Look a key up. Copies only the value, never blocks writers.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key to find.
+			* \param	value				Value to read into.
+			*
+			* \return	False if key is not in map.
+			*/
+			bool Find(const K& key, V& value) const
+			{
+				uint64_t hash = _HashOf(key);
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					const std::atomic<uint64_t>* slot = _Slot(hash + i);
+					while (true)
+					{
+						uint64_t version = _Stable(slot);
+						uint64_t state = _State(version);
+						if (state == _Empty) return false;
+						bool found = state == _Occupied && _KeyEquals(slot, key);
+						if (found) _Load(slot + 1 + _KeyWords, &value, sizeof(V));
+						std::atomic_thread_fence(std::memory_order_acquire);
+						if (slot->load(std::memory_order_relaxed) != version) continue;
+						if (found) return true;
+						break;
+					}
+				}
+				return false;
+			}
+
+			// return if key is in map
+			inline bool Contains(const K& key) const
+			{
+				V value;
+				return Find(key, value);
+			}
+
+			/*!
+			* \fn	bool Set(const K& key, const V& value)
+			*
+			* \brief	Add a key, or replace its value.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key to set.
+			* \param	value				Value to set.
+			*
+			* \return	False if map is full.
+			*/
+			bool Set(const K& key, const V& value)
+			{
+				uint64_t hash = _HashOf(key);
+				std::atomic<uint64_t>* reusable = nullptr;
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					std::atomic<uint64_t>* slot = _Slot(hash + i);
+					uint64_t state = _State(_Stable(slot));
+					if (state != _Empty && _KeyEquals(slot, key))
+					{
+						// in multi writer mode a slot keeps its key forever, so no need to check it again under lock
+						_Fill(slot, _Lock(slot), key, value);
+						return true;
+					}
+					if (state == _Deleted && !_MultiWriter && !reusable) reusable = slot;
+					if (state != _Empty) continue;
+
+					if (reusable) break;
+					uint64_t version = _Lock(slot);
+					if (_State(version) == _Empty || _KeyEquals(slot, key))
+					{
+						_Fill(slot, version, key, value);
+						return true;
+					}
+					// another writer took the slot first, for another key
+					_Unlock(slot, version, _State(version));
+				}
+				if (!reusable) return false;
+				_Fill(reusable, _Lock(reusable), key, value);
+				return true;
+			}
+
+			/*!
+			* \fn	bool Erase(const K& key)
+			*
+			* \brief	Remove a key.
+			*
+			* \date		10/19/2026
+			*
+			* \param	key					Key to remove.
+			*
+			* \return	False if key was not in map.
+			*/
+			bool Erase(const K& key)
+			{
+				uint64_t hash = _HashOf(key);
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					std::atomic<uint64_t>* slot = _Slot(hash + i);
+					uint64_t state = _State(_Stable(slot));
+					if (state == _Empty) return false;
+					if (!_KeyEquals(slot, key)) continue;
+
+					uint64_t version = _Lock(slot);
+					bool erased = _State(version) == _Occupied;
+					if (erased) _Header->Count.fetch_sub(1, std::memory_order_relaxed);
+					_Unlock(slot, version, _Deleted);
+					return erased;
+				}
+				return false;
+			}
+
+			/*!
+			* \fn	template <typename Handler> void ForEach(Handler handler) const
+			*
+			* \brief	Call handler(key, value) for every key. Each pair is consistent, but the map may change while iterating.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Callable taking (const K&, const V&).
+			*/
+			template <typename Handler>
+			void ForEach(Handler handler) const
+			{
+				for (uint64_t i = 0; i <= _Mask; ++i)
+				{
+					const std::atomic<uint64_t>* slot = _Slot(i);
+					K key;
+					V value;
+					uint64_t version;
+					do
+					{
+						version = _Stable(slot);
+						if (_State(version) != _Occupied) break;
+						_Load(slot + 1, &key, sizeof(K));
+						_Load(slot + 1 + _KeyWords, &value, sizeof(V));
+						std::atomic_thread_fence(std::memory_order_acquire);
+					} while (slot->load(std::memory_order_relaxed) != version);
+					if (_State(version) == _Occupied) handler(key, value);
+				}
+			}
+		};
+	}
+}
@@ -0,0 +1,195 @@
+/*!
+* \file	Source\SharedMemory\Layout.h.
+*
+* \brief	Describe the fields of a shared memory region as types, and access them in place with offsets computed at compile time.
+*/
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include "SharedMemory.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	Field
+		*
+		* \brief	A field of a Layout: a tag type naming it (any type, usually an empty struct), its value type, and
+		* 			optionally a larger alignment, for example _CacheLineSize to keep a hot atomic on its own cache line.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename TagType, typename T, size_t Align = alignof(T)>
+		struct Field
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Shared memory fields must be trivially copyable");
+			static_assert(!std::is_reference<T>::value && !std::is_pointer<T>::value, "Shared memory fields cannot be pointers or references, they are not valid in other processes");
+			static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Field alignment must be a power of 2, at least the type's alignment");
+
+			using Tag = TagType;
+			using Type = T;
+			static constexpr size_t Alignment = Align;
+		};
+
+		/*!
+		* \fn	template <typename... Fields> constexpr size_t _LayoutOffset(size_t index)
+		*
+		* \brief	Used internally, get offset of a layout field, each field aligned after the previous one.
+		* 			Index past the last field gives the end of the last field.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename... Fields>
+		constexpr size_t _LayoutOffset(size_t index)
+		{
+			const size_t sizes[] = { sizeof(typename Fields::Type)... };
+			const size_t alignments[] = { Fields::Alignment... };
+			size_t offset = 0;
+			for (size_t i = 0; i < sizeof...(Fields); ++i)
+			{
+				offset = (offset + alignments[i] - 1) / alignments[i] * alignments[i];
+				if (i == index) return offset;
+				offset += sizes[i];
+			}
+			return offset;
+		}
+
+		// used internally, count layout fields tagged Tag
+		template <typename Tag, typename... Fields>
+		constexpr size_t _LayoutMatches()
+		{
+			const bool matches[] = { std::is_same<Tag, typename Fields::Tag>::value... };
+			size_t count = 0;
+			for (bool match : matches) count += match ? 1 : 0;
+			return count;
+		}
+
+		// used internally, get index of the first layout field tagged Tag (0 if none, callers check _LayoutMatches)
+		template <typename Tag, typename... Fields>
+		constexpr size_t _LayoutIndex()
+		{
+			const bool matches[] = { std::is_same<Tag, typename Fields::Tag>::value... };
+			for (size_t i = 0; i < sizeof...(Fields); ++i) if (matches[i]) return i;
+			return 0;
+		}
+
+		// used internally, get max alignment of layout fields
+		template <typename... Fields>
+		constexpr size_t _LayoutAlignment()
+		{
+			const size_t alignments[] = { Fields::Alignment... };
+			size_t max = 1;
+			for (size_t alignment : alignments) if (alignment > max) max = alignment;
+			return max;
+		}
+
+		/*!
+		* \class	Layout
+		*
+		* \brief	A fixed layout of typed fields in a shared memory. Offsets are computed at compile time (each field
+		* 			aligned after the previous one), so there are no hand computed offsets to get wrong, and fields are
+		* 			accessed by reference straight in the mapping: no copy, no bounds check, no lock. The memory size
+		* 			and alignment are checked once, when the layout is attached.
+		* 			Asking for a field that is not in the layout, or an atomic view of a field that can't have one,
+		* 			is a compile error.
+		*
+		* 			using Quote = Layout<Field<struct Bid, double>, Field<struct Ask, double>, Field<struct Updates, uint64_t, 64>>;
+		* 			Quote quote(sm, 0);
+		* 			double spread = quote.Get<Ask>() - quote.Get<Bid>();
+		* 			quote.Atomic<Updates>().fetch_add(1);
+		*
+		* \date		10/19/2026
+		*/
+		template <typename... Fields>
+		class Layout
+		{
+			static_assert(sizeof...(Fields) > 0, "Layout must have at least one field");
+
+		private:
+
+			char* _Base = nullptr;
+
+		public:
+
+			// max alignment of all fields. the layout offset in the shared memory must be aligned to it
+			static constexpr size_t Alignment = _LayoutAlignment<Fields...>();
+
+			// bytes the layout takes, rounded up to its alignment so layouts can be placed back to back
+			static constexpr size_t Size = (_LayoutOffset<Fields...>(sizeof...(Fields)) + Alignment - 1) / Alignment * Alignment;
+
+			// get type of a field
+			template <typename Tag>
+			using TypeOf = typename std::tuple_element<_LayoutIndex<Tag, Fields...>(), std::tuple<typename Fields::Type...>>::type;
+
+			// get offset of a field from the start of the layout
+			template <typename Tag>
+			static constexpr size_t OffsetOf()
+			{
+				static_assert(_LayoutMatches<Tag, Fields...>() == 1, "Field is not in layout, or appears in it more than once");
+				return _LayoutOffset<Fields...>(_LayoutIndex<Tag, Fields...>());
+			}
+
+			// get how many bytes of shared memory the layout needs
+			static inline size_t RequiredSize()
+			{
+				return Size;
+			}
+
+			// create an unattached layout
+			Layout() = default;
+
+			/*!
+			* \fn	Layout(Client& memory, size_t offset = 0)
+			*
+			* \brief	Attach a layout to a shared memory. Does not touch the memory: fields keep whatever they hold
+			* 			(zero in a new shared memory).
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the layout is in. Must outlive the layout.
+			* \param	offset				(Optional) Offset of the layout in the shared memory, aligned to Alignment.
+			* Note: throws std::runtime_error if memory is too small or offset is misaligned.
+			*/
+			Layout(Client& memory, size_t offset = 0)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % Alignment) throw std::runtime_error("Layout offset is not aligned to the layout alignment!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < Size) throw std::runtime_error("Exceeded shared memory size!");
+				_Base = memory.GetBuffer() + offset;
+			}
+
+			// return if layout is attached to a shared memory
+			inline bool IsValid() const { return _Base != nullptr; }
+
+			// get a field by reference, in place in the shared memory.
+			// plain reads and writes are not synchronized with other processes, use Atomic() or a lock for that
+			template <typename Tag>
+			inline TypeOf<Tag>& Get() const
+			{
+				return *std::launder(reinterpret_cast<TypeOf<Tag>*>(_Base + OffsetOf<Tag>()));
+			}
+
+#ifdef __cpp_lib_atomic_ref
+			// get an atomic view (std::atomic_ref) of a field, to read and write it safely with other processes
+			template <typename Tag>
+			inline auto Atomic() const
+			{
+				using Type = TypeOf<Tag>;
+				static_assert(!std::is_array<Type>::value, "Arrays have no atomic view, take one of their elements instead");
+				static_assert(std::atomic_ref<Type>::is_always_lock_free, "Atomic fields must be lock free, or they don't work across processes");
+				static_assert(OffsetOf<Tag>() % std::atomic_ref<Type>::required_alignment == 0 && Alignment % std::atomic_ref<Type>::required_alignment == 0, "Field is not aligned enough for an atomic view, give it a larger alignment");
+				return std::atomic_ref<Type>(Get<Tag>());
+			}
+#endif
+
+			// get pointer to the start of the layout
+			inline char* GetBase() const { return _Base; }
+		};
+	}
+}
@@ -0,0 +1,530 @@
+/*!
+* \file	Source\SharedMemory\Metrics.h.
+*
+* \brief	Named counters, gauges and histograms in a shared memory, updated by workers and read by an external scraper.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \enum	MetricType
+		*
+		* \brief	Kinds of metrics in a metrics registry.
+		*/
+		enum class MetricType : uint32_t
+		{
+			// monotonic count of events, summed over all per-CPU slots
+			Counter = 1,
+
+			// value that goes up and down, last write wins
+			Gauge = 2,
+
+			// count of observed values per bucket, plus their sum
+			Histogram = 3,
+		};
+
+		/*!
+		* \struct	__MetricsHeader
+		*
+		* \brief	Used internally, header of a metrics registry in shared memory.
+		* 			Followed by metric descriptors, then histogram bounds, then the per-CPU slots of values.
+		*/
+		struct __MetricsHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint32_t MaxMetrics;
+			uint32_t MaxWords;
+			uint32_t Slots;
+			uint32_t SlotWords;
+			alignas(_CacheLineSize) std::atomic<uint32_t> Count;
+			std::atomic<uint32_t> UsedWords;
+
+			// registration lock: pid of the process registering a metric, 0 if free
+			std::atomic<uint32_t> Lock;
+		};
+
+		/*!
+		* \struct	__MetricDescriptor
+		*
+		* \brief	Used internally, name and place of a metric. Type is 0 until the metric is fully registered.
+		*/
+		struct __MetricDescriptor
+		{
+			std::atomic<uint32_t> Type;
+			uint32_t Index;
+			uint32_t Words;
+			uint32_t Reserved;
+			char Name[48];
+		};
+
+		static_assert(sizeof(__MetricDescriptor) == 64, "Metric descriptors must take one cache line");
+
+		/*!
+		* \fn	inline uint32_t _CurrentCpu()
+		*
+		* \brief	Used internally, get the CPU the calling thread runs on. Cached per thread and refreshed every
+		* 			64 calls, since it only picks a slot to avoid contention: being stale after a migration is harmless.
+		*
+		* \date		10/19/2026
+		*/
+		inline uint32_t _CurrentCpu()
+		{
+			thread_local uint32_t cpu = 0;
+			thread_local uint32_t calls = 0;
+			if ((calls++ & 63) == 0)
+			{
+#ifdef _WIN32
+				cpu = (uint32_t)GetCurrentProcessorNumber();
+#else
+				int current = sched_getcpu();
+				cpu = current < 0 ? 0 : (uint32_t)current;
+#endif
+			}
+			return cpu;
+		}
+
+		/*!
+		* \struct	MetricValue
+		*
+		* \brief	A metric as read by Metrics::Scrape.
+		*
+		* \date		10/19/2026
+		*/
+		struct MetricValue
+		{
+			std::string Name;
+			MetricType Type;
+
+			// counter total, gauge value, or histogram count of observations
+			int64_t Value = 0;
+
+			// histograms only: sum of observed values, bucket upper bounds (inclusive), and count per bucket.
+			// Buckets has one more entry than Bounds, for values above the last bound
+			uint64_t Sum = 0;
+			std::vector<uint64_t> Bounds;
+			std::vector<uint64_t> Buckets;
+		};
+
+		/*!
+		* \class	Metrics
+		*
+		* \brief	A registry of named metrics in a shared memory. Worker processes register metrics by name (getting the
+		* 			same metric if it already exists) and update them through small handles; a scraper process connects to
+		* 			the same memory and reads them all, with no agent in the workers.
+		* 			Counters and histograms are split into per-CPU slots, each on its own cache lines, so concurrent
+		* 			updates from many cores never fight over a line; updates are single relaxed atomic adds, and the
+		* 			scraper sums the slots. Gauges have a single value.
+		*
+		* \date		10/19/2026
+		*/
+		class Metrics
+		{
+		private:
+
+			// magic value marking an initialized registry
+			static const uint64_t _Magic = 0x4a5553544d455452ULL;
+
+			// max slots, and max histogram bounds
+			static const size_t _MaxSlots = 256;
+			static const size_t _MaxBounds = 64;
+
+			__MetricsHeader* _Header = nullptr;
+			__MetricDescriptor* _Descriptors = nullptr;
+			uint64_t* _Bounds = nullptr;
+			std::atomic<uint64_t>* _Values = nullptr;
+
+			// default slots: a power of 2 at least the number of CPUs
+			static inline size_t _DefaultSlots()
+			{
+				size_t slots = 1;
+				while (slots < std::thread::hardware_concurrency() && slots < _MaxSlots) slots *= 2;
+				return slots;
+			}
+
+			// bytes of each region
+			static inline size_t _DescriptorsSize(size_t maxMetrics) { return maxMetrics * sizeof(__MetricDescriptor); }
+			static inline size_t _BoundsSize(size_t maxWords) { return (maxWords * sizeof(uint64_t) + _CacheLineSize - 1) / _CacheLineSize * _CacheLineSize; }
+			static inline size_t _SlotWords(size_t maxWords) { return (maxWords + 7) / 8 * 8; }
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t maxMetrics, size_t maxWords, size_t slots)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Metrics offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__MetricsHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__MetricsHeader* header = (__MetricsHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain metrics!");
+					maxMetrics = header->MaxMetrics;
+					maxWords = header->MaxWords;
+					slots = header->Slots;
+				}
+				if (memory.GetSize() - offset < RequiredSize(maxMetrics, maxWords, slots)) throw std::runtime_error("Exceeded shared memory size!");
+
+				char* base = (char*)(header + 1);
+				_Descriptors = (__MetricDescriptor*)base;
+				_Bounds = (uint64_t*)(base + _DescriptorsSize(maxMetrics));
+				_Values = (std::atomic<uint64_t>*)(base + _DescriptorsSize(maxMetrics) + _BoundsSize(maxWords));
+				if (create)
+				{
+					new (header) __MetricsHeader();
+					header->MaxMetrics = (uint32_t)maxMetrics;
+					header->MaxWords = (uint32_t)maxWords;
+					header->Slots = (uint32_t)slots;
+					header->SlotWords = (uint32_t)_SlotWords(maxWords);
+					for (size_t i = 0; i < maxMetrics; ++i) new (_Descriptors + i) __MetricDescriptor();
+					memset((void*)_Bounds, 0, _BoundsSize(maxWords));
+					for (size_t i = 0; i < slots * _SlotWords(maxWords); ++i) new (_Values + i) std::atomic<uint64_t>(0);
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+			}
+
+			// find a registered metric by name, or null
+			const __MetricDescriptor* _Find(const std::string& name) const
+			{
+				uint32_t count = _Header->Count.load(std::memory_order_acquire);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const __MetricDescriptor& descriptor = _Descriptors[i];
+					if (descriptor.Type.load(std::memory_order_acquire) != 0 && strncmp(descriptor.Name, name.c_str(), sizeof(descriptor.Name)) == 0) return &descriptor;
+				}
+				return nullptr;
+			}
+
+			// get a metric, registering it if it is new. registering is rare, so it takes a lock
+			const __MetricDescriptor* _Register(const std::string& name, MetricType type, const std::vector<uint64_t>& bounds)
+			{
+				if (!IsValid()) throw std::runtime_error("Metrics are not valid!");
+				if (name.empty() || name.size() >= sizeof(__MetricDescriptor::Name)) throw std::runtime_error("Metric name must be 1 to 47 characters!");
+				uint32_t words = type == MetricType::Histogram ? (uint32_t)bounds.size() + 2 : 1;
+
+				const __MetricDescriptor* descriptor = _Find(name);
+				if (!descriptor)
+				{
+					// the lock holds the owner's pid, so one that died while registering is taken over. that is safe:
+					// a registration publishes the new count last, so one cut short is redone
+					_LockOwned(_Header->Lock);
+					descriptor = _Find(name);
+					uint32_t count = _Header->Count.load(std::memory_order_relaxed);
+					uint32_t used = _Header->UsedWords.load(std::memory_order_relaxed);
+					if (!descriptor && count < _Header->MaxMetrics && words <= _Header->MaxWords - used)
+					{
+						__MetricDescriptor* created = _Descriptors + count;
+						memcpy(created->Name, name.c_str(), name.size() + 1);
+						created->Index = used;
+						created->Words = words;
+						for (size_t i = 0; i < bounds.size(); ++i) _Bounds[used + i] = bounds[i];
+						created->Type.store((uint32_t)type, std::memory_order_release);
+						_Header->UsedWords.store(used + words, std::memory_order_relaxed);
+						_Header->Count.store(count + 1, std::memory_order_release);
+						descriptor = created;
+					}
+					_UnlockOwned(_Header->Lock);
+					if (!descriptor) throw std::runtime_error("Metrics registry is full!");
+				}
+				if (descriptor->Type.load(std::memory_order_relaxed) != (uint32_t)type || descriptor->Words != words ||
+					(bounds.size() && memcmp(_Bounds + descriptor->Index, bounds.data(), bounds.size() * sizeof(uint64_t)) != 0))
+				{
+					throw std::runtime_error("Metric already registered with a different type or buckets!");
+				}
+				return descriptor;
+			}
+
+			// sum a value word over all slots
+			uint64_t _Sum(uint32_t index) const
+			{
+				uint64_t sum = 0;
+				for (uint32_t slot = 0; slot < _Header->Slots; ++slot) sum += _Values[(size_t)slot * _Header->SlotWords + index].load(std::memory_order_relaxed);
+				return sum;
+			}
+
+		public:
+
+			/*!
+			* \class	Counter
+			*
+			* \brief	Handle to update a counter. Cheap to copy; keep it instead of looking the counter up by name.
+			*/
+			class Counter
+			{
+			private:
+				friend class Metrics;
+				std::atomic<uint64_t>* _Value = nullptr;
+				uint32_t _SlotWords = 0;
+				uint32_t _SlotMask = 0;
+
+			public:
+
+				// add to counter
+				inline void Add(uint64_t value = 1)
+				{
+					_Value[(size_t)(_CurrentCpu() & _SlotMask) * _SlotWords].fetch_add(value, std::memory_order_relaxed);
+				}
+
+				// add one to counter
+				inline void Increment() { Add(1); }
+
+				// return if handle refers to a counter
+				inline bool IsValid() const { return _Value != nullptr; }
+			};
+
+			/*!
+			* \class	Gauge
+			*
+			* \brief	Handle to update a gauge. Cheap to copy.
+			*/
+			class Gauge
+			{
+			private:
+				friend class Metrics;
+				std::atomic<uint64_t>* _Value = nullptr;
+
+			public:
+
+				// set gauge value
+				inline void Set(int64_t value) { _Value->store((uint64_t)value, std::memory_order_relaxed); }
+
+				// add to gauge value (negative to subtract)
+				inline void Add(int64_t value) { _Value->fetch_add((uint64_t)value, std::memory_order_relaxed); }
+
+				// get gauge value
+				inline int64_t Get() const { return (int64_t)_Value->load(std::memory_order_relaxed); }
+
+				// return if handle refers to a gauge
+				inline bool IsValid() const { return _Value != nullptr; }
+			};
+
+			/*!
+			* \class	Histogram
+			*
+			* \brief	Handle to record observations in a histogram. Cheap to copy.
+			*/
+			class Histogram
+			{
+			private:
+				friend class Metrics;
+				std::atomic<uint64_t>* _Values = nullptr;
+				const uint64_t* _Bounds = nullptr;
+				uint32_t _BoundsCount = 0;
+				uint32_t _SlotWords = 0;
+				uint32_t _SlotMask = 0;
+
+			public:
+
+				// record an observation: count it in the first bucket whose bound is >= value, and add it to the sum
+				inline void Observe(uint64_t value)
+				{
+					uint32_t bucket = 0;
+					while (bucket < _BoundsCount && value > _Bounds[bucket]) ++bucket;
+					std::atomic<uint64_t>* slot = _Values + (size_t)(_CurrentCpu() & _SlotMask) * _SlotWords;
+					slot[bucket].fetch_add(1, std::memory_order_relaxed);
+					slot[_BoundsCount + 1].fetch_add(value, std::memory_order_relaxed);
+				}
+
+				// return if handle refers to a histogram
+				inline bool IsValid() const { return _Values != nullptr; }
+			};
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			*
+			* \brief	Get how many bytes of shared memory a metrics registry needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	maxMetrics			Max number of metrics.
+			* \param	maxWords			Max value words of all metrics: 1 per counter or gauge, bounds + 2 per histogram.
+			* \param	slots				(Optional) Number of per-CPU slots, or 0 for the default (CPU count rounded up to a power of 2).
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			{
+				if (slots == 0) slots = _DefaultSlots();
+				return sizeof(__MetricsHeader) + _DescriptorsSize(maxMetrics) + _BoundsSize(maxWords) + slots * _SlotWords(maxWords) * sizeof(uint64_t);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			*
+			* \brief	Initialize a new, empty metrics registry in a shared memory. Only one process should create it,
+			* 			others Connect. The shared memory must outlive the registry and the handles taken from it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the registry in.
+			* \param	offset				Offset of the registry in the shared memory, aligned to 64 bytes.
+			* \param	maxMetrics			Max number of metrics.
+			* \param	maxWords			Max value words of all metrics: 1 per counter or gauge, bounds + 2 per histogram.
+			* \param	slots				(Optional) Number of per-CPU slots, a power of 2, or 0 for the default.
+			* 								Fewer slots than CPUs saves memory but lets some cores share a slot.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t maxMetrics, size_t maxWords, size_t slots = 0)
+			{
+				if (slots == 0) slots = _DefaultSlots();
+				if (slots > _MaxSlots || (slots & (slots - 1))) throw std::runtime_error("Metrics slots must be a power of 2, at most 256!");
+				if (maxMetrics == 0 || maxWords == 0 || maxMetrics > UINT32_MAX || maxWords > UINT32_MAX) throw std::runtime_error("Invalid metrics capacity!");
+				_Attach(memory, offset, true, maxMetrics, maxWords, slots);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a metrics registry another process created, to register and update metrics or to scrape them.
+			* 			A scraper may map the memory read only (Options::ReadOnly).
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the registry is in.
+			* \param	offset				Offset of the registry in the shared memory.
+			* Note: throws std::runtime_error if there is no registry at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0, 0);
+			}
+
+			// return if registry is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get number of registered metrics
+			inline size_t GetCount() const { return _Header->Count.load(std::memory_order_acquire); }
+
+			/*!
+			* \fn	Counter GetCounter(const std::string& name)
+			*
+			* \brief	Get a counter by name, registering it if no process did yet.
+			*
+			* \date		10/19/2026
+			*
+			* \param	name				Metric name, up to 47 characters.
+			*
+			* \return	Handle to update the counter.
+			* Note: throws std::runtime_error if the registry is full or name is taken by another kind of metric.
+			*/
+			Counter GetCounter(const std::string& name)
+			{
+				const __MetricDescriptor* descriptor = _Register(name, MetricType::Counter, std::vector<uint64_t>());
+				Counter counter;
+				counter._Value = _Values + descriptor->Index;
+				counter._SlotWords = _Header->SlotWords;
+				counter._SlotMask = _Header->Slots - 1;
+				return counter;
+			}
+
+			/*!
+			* \fn	Gauge GetGauge(const std::string& name)
+			*
+			* \brief	Get a gauge by name, registering it if no process did yet.
+			*
+			* \date		10/19/2026
+			*
+			* \param	name				Metric name, up to 47 characters.
+			*
+			* \return	Handle to update the gauge.
+			* Note: throws std::runtime_error if the registry is full or name is taken by another kind of metric.
+			*/
+			Gauge GetGauge(const std::string& name)
+			{
+				const __MetricDescriptor* descriptor = _Register(name, MetricType::Gauge, std::vector<uint64_t>());
+				Gauge gauge;
+				gauge._Value = _Values + descriptor->Index;
+				return gauge;
+			}
+
+			/*!
+			* \fn	Histogram GetHistogram(const std::string& name, const std::vector<uint64_t>& bounds)
+			*
+			* \brief	Get a histogram by name, registering it if no process did yet.
+			*
+			* \date		10/19/2026
+			*
+			* \param	name				Metric name, up to 47 characters.
+			* \param	bounds				Bucket upper bounds (inclusive), ascending, up to 64. Values above the last bound
+			* 								are counted in an extra bucket. Must match the bounds it was registered with.
+			*
+			* \return	Handle to record observations.
+			* Note: throws std::runtime_error if the registry is full, bounds are invalid or name is taken by another metric.
+			*/
+			Histogram GetHistogram(const std::string& name, const std::vector<uint64_t>& bounds)
+			{
+				if (bounds.empty() || bounds.size() > _MaxBounds) throw std::runtime_error("Histogram must have 1 to 64 bounds!");
+				for (size_t i = 1; i < bounds.size(); ++i)
+				{
+					if (bounds[i] <= bounds[i - 1]) throw std::runtime_error("Histogram bounds must be ascending!");
+				}
+				const __MetricDescriptor* descriptor = _Register(name, MetricType::Histogram, bounds);
+				Histogram histogram;
+				histogram._Values = _Values + descriptor->Index;
+				histogram._Bounds = _Bounds + descriptor->Index;
+				histogram._BoundsCount = (uint32_t)bounds.size();
+				histogram._SlotWords = _Header->SlotWords;
+				histogram._SlotMask = _Header->Slots - 1;
+				return histogram;
+			}
+
+			/*!
+			* \fn	std::vector<MetricValue> Scrape() const
+			*
+			* \brief	Read all metrics, summing their per-CPU slots. Does not stop writers, so values of different
+			* 			metrics (or a histogram's buckets and sum) may be a few updates apart.
+			*
+			* \date		10/19/2026
+			*
+			* \return	All registered metrics, in registration order.
+			*/
+			std::vector<MetricValue> Scrape() const
+			{
+				std::vector<MetricValue> values;
+				uint32_t count = _Header->Count.load(std::memory_order_acquire);
+				values.reserve(count);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const __MetricDescriptor& descriptor = _Descriptors[i];
+					MetricValue value;
+					value.Name.assign(descriptor.Name, strnlen(descriptor.Name, sizeof(descriptor.Name)));
+					value.Type = (MetricType)descriptor.Type.load(std::memory_order_acquire);
+					if (value.Type == MetricType::Histogram)
+					{
+						uint32_t buckets = descriptor.Words - 1;
+						value.Bounds.assign(_Bounds + descriptor.Index, _Bounds + descriptor.Index + buckets - 1);
+						value.Buckets.resize(buckets);
+						for (uint32_t bucket = 0; bucket < buckets; ++bucket)
+						{
+							value.Buckets[bucket] = _Sum(descriptor.Index + bucket);
+							value.Value += (int64_t)value.Buckets[bucket];
+						}
+						value.Sum = _Sum(descriptor.Index + buckets);
+					}
+					else if (value.Type == MetricType::Gauge)
+					{
+						value.Value = (int64_t)_Values[descriptor.Index].load(std::memory_order_relaxed);
+					}
+					else
+					{
+						value.Value = (int64_t)_Sum(descriptor.Index);
+					}
+					values.push_back(std::move(value));
+				}
+				return values;
+			}
+		};
+	}
+}
@@ -0,0 +1,294 @@
+/*!
+* \file	Source\SharedMemory\MpmcQueue.h.
+*
+* \brief	Bounded lock-free multi producer / multi consumer queue inside a shared memory.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	__MpmcQueueHeader
+		*
+		* \brief	Used internally, header of a queue in shared memory. Slots follow right after it.
+		*/
+		struct __MpmcQueueHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			uint64_t SlotSize;
+			alignas(_CacheLineSize) std::atomic<uint64_t> EnqueuePosition;
+			alignas(_CacheLineSize) std::atomic<uint64_t> DequeuePosition;
+		};
+
+		/*!
+		* \struct	__MpmcSlot
+		*
+		* \brief	Used internally, slot header. Sequence tells whose turn it is: equal to the slot position when free
+		* 			for a producer, position + 1 when holding data for a consumer. Data follows the header.
+		*/
+		struct __MpmcSlot
+		{
+			std::atomic<uint64_t> Sequence;
+			uint64_t Size;
+		};
+
+		/*!
+		* \class	MpmcQueue
+		*
+		* \brief	A bounded queue in shared memory that any number of processes can push to and pop from.
+		* 			Uses a sequence number per slot (Dmitry Vyukov's design): producers and consumers claim positions
+		* 			with a CAS on their own counter and then only touch their slot, so there are no locks and no pointers.
+		* 			Slots have a fixed max size and are cache line aligned. To pass bigger data, push offsets
+		* 			into another part of the shared memory (for example an Arena).
+		*
+		* \date		10/19/2026
+		*/
+		class MpmcQueue
+		{
+		private:
+
+			// magic value marking an initialized queue
+			static const uint64_t _Magic = 0x4a5553544d504d43ULL;
+
+			__MpmcQueueHeader* _Header = nullptr;
+			char* _Slots = nullptr;
+			uint64_t _Mask = 0;
+			uint64_t _SlotSize = 0;
+			uint64_t _Stride = 0;
+
+			// get slot stride for a slot size
+			static inline uint64_t _StrideFor(size_t slotSize)
+			{
+				return (sizeof(__MpmcSlot) + slotSize + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1);
+			}
+
+			// get slot by position
+			inline __MpmcSlot* _Slot(uint64_t position) const
+			{
+				return (__MpmcSlot*)(_Slots + (position & _Mask) * _Stride);
+			}
+
+			// pop an item into a buffer of bufferSize bytes
+			bool _TryPop(void* data, size_t bufferSize, size_t& size)
+			{
+				uint64_t position = _Header->DequeuePosition.load(std::memory_order_relaxed);
+				__MpmcSlot* slot;
+				while (true)
+				{
+					slot = _Slot(position);
+					uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+					int64_t difference = (int64_t)(sequence - (position + 1));
+					if (difference == 0)
+					{
+						if (_Header->DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = _Header->DequeuePosition.load(std::memory_order_relaxed);
+					}
+				}
+				size = (size_t)slot->Size;
+				memcpy(data, (char*)slot + sizeof(__MpmcSlot), size < bufferSize ? size : bufferSize);
+				slot->Sequence.store(position + _Mask + 1, std::memory_order_release);
+				return true;
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity, size_t slotSize)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Queue offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__MpmcQueueHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__MpmcQueueHeader* header = (__MpmcQueueHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a queue!");
+					capacity = (size_t)header->Capacity;
+					slotSize = (size_t)header->SlotSize;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity, slotSize)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Header = header;
+				_Slots = (char*)header + sizeof(__MpmcQueueHeader);
+				_Mask = capacity - 1;
+				_SlotSize = slotSize;
+				_Stride = _StrideFor(slotSize);
+				if (create)
+				{
+					new (header) __MpmcQueueHeader();
+					header->Capacity = capacity;
+					header->SlotSize = slotSize;
+					for (uint64_t i = 0; i < capacity; ++i)
+					{
+						__MpmcSlot* slot = new (_Slot(i)) __MpmcSlot();
+						slot->Sequence.store(i, std::memory_order_relaxed);
+					}
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity, size_t slotSize)
+			*
+			* \brief	Get how many bytes of shared memory a queue needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Number of slots.
+			* \param	slotSize			Max bytes per item.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity, size_t slotSize)
+			{
+				return sizeof(__MpmcQueueHeader) + capacity * (size_t)_StrideFor(slotSize);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize)
+			*
+			* \brief	Initialize a new, empty queue in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the queue.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the queue in.
+			* \param	offset				Offset of the queue in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Number of slots. Must be a power of 2, at least 2.
+			* \param	slotSize			Max bytes per item.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity, size_t slotSize)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1))) throw std::runtime_error("Queue capacity must be a power of 2, at least 2!");
+				if (slotSize == 0) throw std::runtime_error("Queue slot size must not be 0!");
+				_Attach(memory, offset, true, capacity, slotSize);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a queue another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the queue is in.
+			* \param	offset				Offset of the queue in the shared memory.
+			* Note: throws std::runtime_error if there is no queue at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0);
+			}
+
+			// return if queue is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get number of slots
+			inline size_t GetCapacity() const { return (size_t)(_Mask + 1); }
+
+			// get max bytes per item
+			inline size_t GetSlotSize() const { return (size_t)_SlotSize; }
+
+			/*!
+			* \fn	bool TryPush(const void* data, size_t size)
+			*
+			* \brief	Push an item, if there is a free slot.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Item data.
+			* \param	size 				Item size, at most slot size.
+			*
+			* \return	False if queue is full.
+			*/
+			bool TryPush(const void* data, size_t size)
+			{
+				if (size > _SlotSize) throw std::runtime_error("Item is too big for queue slot!");
+				uint64_t position = _Header->EnqueuePosition.load(std::memory_order_relaxed);
+				__MpmcSlot* slot;
+				while (true)
+				{
+					slot = _Slot(position);
+					uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+					int64_t difference = (int64_t)(sequence - position);
+					if (difference == 0)
+					{
+						if (_Header->EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = _Header->EnqueuePosition.load(std::memory_order_relaxed);
+					}
+				}
+				memcpy((char*)slot + sizeof(__MpmcSlot), data, size);
+				slot->Size = size;
+				slot->Sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+
+			/*!
+			* \fn	bool TryPop(void* data, size_t& size)
+			*
+			* \brief	Pop an item, if there is one.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Buffer to copy item into, at least slot size bytes.
+			* \param	size 				Item size.
+			*
+			* \return	False if queue is empty.
+			*/
+			bool TryPop(void* data, size_t& size)
+			{
+				return _TryPop(data, (size_t)_SlotSize, size);
+			}
+
+			// push a trivially copyable value
+			template <typename T>
+			inline bool TryPush(const T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Queue items must be trivially copyable");
+				return TryPush(&value, sizeof(T));
+			}
+
+			// pop a trivially copyable value. item should have been pushed with the same type
+			template <typename T>
+			inline bool TryPop(T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Queue items must be trivially copyable");
+				size_t size;
+				return _TryPop(&value, sizeof(T), size);
+			}
+
+			// get approximate number of items in queue
+			inline size_t GetCount() const
+			{
+				uint64_t dequeue = _Header->DequeuePosition.load(std::memory_order_relaxed);
+				uint64_t enqueue = _Header->EnqueuePosition.load(std::memory_order_relaxed);
+				return enqueue > dequeue ? (size_t)(enqueue - dequeue) : 0;
+			}
+		};
+	}
+}
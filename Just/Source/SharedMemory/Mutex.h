@@ -0,0 +1,665 @@
+/*!
+* \file	Source\SharedMemory\Mutex.h.
+*
+* \brief	Cross-process mutex and reader-writer lock placed inside a shared memory, that survive their holder crashing.
+*/
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+#include "Futex.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	LockStatistics
+		*
+		* \brief	Contention counters of a Mutex or SharedMutex, for profiling. Shared by all processes using the lock.
+		*
+		* \date		10/19/2026
+		*/
+		struct LockStatistics
+		{
+			// times the lock was taken exclusively / shared
+			uint64_t Acquisitions = 0;
+			uint64_t SharedAcquisitions = 0;
+
+			// times taking it had to wait, and total time spent waiting
+			uint64_t Contended = 0;
+			uint64_t WaitNanoseconds = 0;
+
+			// times a holder was found dead and the lock was recovered
+			uint64_t OwnerDeaths = 0;
+		};
+
+		/*!
+		* \struct	__LockCounters
+		*
+		* \brief	Used internally, contention counters in shared memory.
+		*/
+		struct __LockCounters
+		{
+			std::atomic<uint64_t> Acquisitions;
+			std::atomic<uint64_t> Contended;
+			std::atomic<uint64_t> WaitNanoseconds;
+			std::atomic<uint64_t> OwnerDeaths;
+		};
+
+		// how often waiters wake up to check if the holder died, in microseconds
+		const int64_t _OwnerCheckMicroseconds = 10000;
+
+		/*!
+		* \struct	__MutexHeader
+		*
+		* \brief	Used internally, a mutex in shared memory.
+		* 			On linux it is a robust, process shared pthread mutex; on windows, a word holding the owner pid.
+		*/
+		struct __MutexHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+#ifdef _WIN32
+			std::atomic<uint32_t> Owner;
+#else
+			pthread_mutex_t Mutex;
+#endif
+			alignas(_CacheLineSize) __LockCounters Counters;
+		};
+
+		/*!
+		* \class	Mutex
+		*
+		* \brief	A mutex in shared memory, to guard a region of it across processes without file locks.
+		* 			Taking a free mutex is a single atomic instruction with no syscall; waiters sleep on a futex.
+		* 			If a holder dies, the kernel hands the mutex to the next waiter (robust futex), which runs the
+		* 			handler set with OnOwnerDied to repair the guarded data before carrying on.
+		* 			Not recursive. Also usable with std::lock_guard / std::unique_lock.
+		*
+		* \date		10/19/2026
+		*/
+		class Mutex
+		{
+		private:
+
+			// magic value marking an initialized mutex
+			static const uint64_t _Magic = 0x4a5553544d555458ULL;
+
+			__MutexHeader* _Header = nullptr;
+			std::function<void()> _OwnerDied;
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Mutex offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < RequiredSize()) throw std::runtime_error("Exceeded shared memory size!");
+				__MutexHeader* header = (__MutexHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __MutexHeader();
+#ifdef _WIN32
+					header->Owner.store(0, std::memory_order_relaxed);
+#else
+					pthread_mutexattr_t attributes;
+					pthread_mutexattr_init(&attributes);
+					pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+					pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+					int error = pthread_mutex_init(&header->Mutex, &attributes);
+					pthread_mutexattr_destroy(&attributes);
+					if (error != 0) throw std::runtime_error("Failed to initialize mutex!");
+#endif
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				else if (header->Magic.load(std::memory_order_acquire) != _Magic)
+				{
+					throw std::runtime_error("Shared memory does not contain a mutex!");
+				}
+				_Header = header;
+			}
+
+			// take over from a dead holder: mark the mutex usable again and let the caller repair the data
+			void _Recover()
+			{
+#ifndef _WIN32
+				pthread_mutex_consistent(&_Header->Mutex);
+#endif
+				_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+				if (_OwnerDied) _OwnerDied();
+			}
+
+			// try once, return 1 if taken, 2 if taken from a dead holder, 0 if busy
+			int _TryLock(bool checkOwner = true)
+			{
+#ifdef _WIN32
+				uint32_t owner = 0;
+				uint32_t self = (uint32_t)_CurrentProcessId();
+				if (_Header->Owner.compare_exchange_strong(owner, self, std::memory_order_acquire)) return 1;
+				if (checkOwner && _IsProcessDead((int32_t)owner) && _Header->Owner.compare_exchange_strong(owner, self, std::memory_order_acquire)) return 2;
+				return 0;
+#else
+				(void)checkOwner;
+				int error = pthread_mutex_trylock(&_Header->Mutex);
+				if (error == 0) return 1;
+				if (error == EOWNERDEAD) return 2;
+				if (error == EBUSY) return 0;
+				throw std::runtime_error("Failed to lock mutex!");
+#endif
+			}
+
+		public:
+
+			// get how many bytes of shared memory a mutex needs
+			static inline size_t RequiredSize()
+			{
+				return sizeof(__MutexHeader);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset)
+			*
+			* \brief	Initialize a new, unlocked mutex in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the mutex.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the mutex in.
+			* \param	offset				Offset of the mutex in the shared memory, aligned to 64 bytes.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, true);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a mutex another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the mutex is in.
+			* \param	offset				Offset of the mutex in the shared memory.
+			* Note: throws std::runtime_error if there is no mutex at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false);
+			}
+
+			// return if mutex is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// set a function to run, holding the mutex, when taking it from a holder that died while holding it.
+			// use it to repair or reset the data the mutex guards, which may have been left half updated
+			inline void OnOwnerDied(std::function<void()> handler) { _OwnerDied = std::move(handler); }
+
+			/*!
+			* \fn	void Lock()
+			*
+			* \brief	Take the mutex, waiting for it if needed. If the holder died, recovers it (see OnOwnerDied).
+			*
+			* \date		10/19/2026
+			*/
+			void Lock()
+			{
+				int taken = _TryLock();
+				if (taken == 0)
+				{
+					auto start = std::chrono::steady_clock::now();
+#ifdef _WIN32
+					bool timedOut = false;
+					while ((taken = _TryLock(timedOut)) == 0)
+					{
+						uint32_t owner = _Header->Owner.load(std::memory_order_relaxed);
+						timedOut = owner != 0 && !WaitOnAddress(&_Header->Owner, owner, _OwnerCheckMicroseconds);
+					}
+#else
+					int error = pthread_mutex_lock(&_Header->Mutex);
+					if (error != 0 && error != EOWNERDEAD) throw std::runtime_error("Failed to lock mutex!");
+					taken = error == EOWNERDEAD ? 2 : 1;
+#endif
+					_Header->Counters.Contended.fetch_add(1, std::memory_order_relaxed);
+					_Header->Counters.WaitNanoseconds.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+				}
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				if (taken == 2) _Recover();
+			}
+
+			// take the mutex if it is free (or its holder died), without waiting
+			bool TryLock()
+			{
+				int taken = _TryLock();
+				if (taken == 0) return false;
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				if (taken == 2) _Recover();
+				return true;
+			}
+
+			// release the mutex
+			void Unlock()
+			{
+#ifdef _WIN32
+				_Header->Owner.store(0, std::memory_order_release);
+#else
+				pthread_mutex_unlock(&_Header->Mutex);
+#endif
+			}
+
+			// std::lock_guard / std::unique_lock interface
+			inline void lock() { Lock(); }
+			inline bool try_lock() { return TryLock(); }
+			inline void unlock() { Unlock(); }
+
+			// get contention counters
+			LockStatistics GetStatistics() const
+			{
+				LockStatistics statistics;
+				statistics.Acquisitions = _Header->Counters.Acquisitions.load(std::memory_order_relaxed);
+				statistics.Contended = _Header->Counters.Contended.load(std::memory_order_relaxed);
+				statistics.WaitNanoseconds = _Header->Counters.WaitNanoseconds.load(std::memory_order_relaxed);
+				statistics.OwnerDeaths = _Header->Counters.OwnerDeaths.load(std::memory_order_relaxed);
+				return statistics;
+			}
+		};
+
+		/*!
+		* \struct	__SharedMutexHeader
+		*
+		* \brief	Used internally, header of a reader-writer lock in shared memory. Reader slots follow right after it.
+		* 			Writer holds the pid of the process holding it exclusively, or 0. Repair is set while data a dead
+		* 			writer left is waiting for an OnOwnerDied handler.
+		*/
+		struct __SharedMutexHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t SlotsCount;
+			alignas(_CacheLineSize) std::atomic<uint32_t> Writer;
+			std::atomic<uint32_t> Waiters;
+			std::atomic<uint32_t> Repair;
+			alignas(_CacheLineSize) __LockCounters Counters;
+		};
+
+		/*!
+		* \struct	__SharedMutexSlot
+		*
+		* \brief	Used internally, a reader slot: how many threads of process Pid hold the lock shared.
+		*/
+		struct __SharedMutexSlot
+		{
+			alignas(_CacheLineSize) std::atomic<uint32_t> Pid;
+			std::atomic<uint32_t> Readers;
+			std::atomic<uint64_t> Acquisitions;
+			std::atomic<uint64_t> Contended;
+			std::atomic<uint64_t> WaitNanoseconds;
+		};
+
+		/*!
+		* \class	SharedMutex
+		*
+		* \brief	A reader-writer lock in shared memory. Every process gets its own reader slot, on its own cache line,
+		* 			so readers in different processes never write to a common line: taking it shared when no writer is
+		* 			around is one atomic add on the process's slot, with no syscall. A writer announces itself first,
+		* 			so new readers step aside, then waits for all slots to drain (writers are preferred).
+		* 			Holders that die are detected by pid: a dead writer's lock is taken over (see OnOwnerDied) and a
+		* 			dead process's shared holds are dropped. A reader that finds the writer dead takes the lock
+		* 			exclusively to recover it too, so readers never carry on before the data was repaired.
+		* 			Each process uses its own SharedMutex object. Not recursive, and a thread holding it shared must
+		* 			not take it exclusively. Also usable with std::unique_lock / std::shared_lock.
+		*
+		* \date		10/19/2026
+		*/
+		class SharedMutex
+		{
+		private:
+
+			// magic value marking an initialized lock
+			static const uint64_t _Magic = 0x4a55535452574c4bULL;
+
+			__SharedMutexHeader* _Header = nullptr;
+			__SharedMutexSlot* _Slots = nullptr;
+			__SharedMutexSlot* _Slot = nullptr;
+			uint32_t _Pid = 0;
+			std::function<void()> _OwnerDied;
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t slots)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Shared mutex offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__SharedMutexHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__SharedMutexHeader* header = (__SharedMutexHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a shared mutex!");
+					slots = (size_t)header->SlotsCount;
+				}
+				if (memory.GetSize() - offset < RequiredSize(slots)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Slots = (__SharedMutexSlot*)(header + 1);
+				if (create)
+				{
+					new (header) __SharedMutexHeader();
+					header->SlotsCount = slots;
+					for (size_t i = 0; i < slots; ++i) new (_Slots + i) __SharedMutexSlot();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				_Header = header;
+				_Pid = (uint32_t)_CurrentProcessId();
+			}
+
+			// get this process's reader slot, claiming a free one (or one of a dead process) the first time
+			__SharedMutexSlot* _ReaderSlot()
+			{
+				if (_Slot) return _Slot;
+				uint32_t self = _Pid;
+				for (int pass = 0; pass < 3; ++pass)
+				{
+					for (size_t i = 0; i < _Header->SlotsCount; ++i)
+					{
+						__SharedMutexSlot* slot = _Slots + i;
+						uint32_t pid = slot->Pid.load(std::memory_order_acquire);
+						if (pass == 0 && pid != self) continue;
+						if (pass == 1 && pid != 0) continue;
+						if (pass == 2 && !_IsProcessDead((int32_t)pid)) continue;
+						if (pid == self || slot->Pid.compare_exchange_strong(pid, self, std::memory_order_acq_rel))
+						{
+							if (pass == 2) _DropReaders(slot);
+							_Slot = slot;
+							return slot;
+						}
+					}
+				}
+				throw std::runtime_error("No free reader slot in shared mutex!");
+			}
+
+			// drop shared holds a dead process left in a slot we just took over
+			void _DropReaders(__SharedMutexSlot* slot)
+			{
+				if (slot->Readers.exchange(0, std::memory_order_acq_rel) != 0)
+				{
+					_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+					if (_Header->Writer.load(std::memory_order_seq_cst) != 0) WakeAll(&slot->Readers);
+				}
+			}
+
+			// wait while a writer holds the lock. takes over from a dead writer and returns true if it did
+			bool _WaitWriter(uint32_t owner, uint32_t self)
+			{
+				_Header->Waiters.fetch_add(1, std::memory_order_seq_cst);
+				bool timedOut = !WaitOnAddress(&_Header->Writer, owner, _OwnerCheckMicroseconds);
+				_Header->Waiters.fetch_sub(1, std::memory_order_relaxed);
+				if (timedOut && _IsProcessDead((int32_t)owner))
+				{
+					// the new owner is us (writer) or nobody (reader)
+					if (_Header->Writer.compare_exchange_strong(owner, self, std::memory_order_acq_rel))
+					{
+						_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// holding the writer, wait for readers to drain, dropping the holds of dead processes
+			void _WaitReaders(bool& contended, std::chrono::steady_clock::time_point& start)
+			{
+				for (size_t i = 0; i < _Header->SlotsCount; ++i)
+				{
+					__SharedMutexSlot* slot = _Slots + i;
+					uint32_t readers;
+					while ((readers = slot->Readers.load(std::memory_order_seq_cst)) != 0)
+					{
+						if (!contended)
+						{
+							contended = true;
+							start = std::chrono::steady_clock::now();
+						}
+						if (WaitOnAddress(&slot->Readers, readers, _OwnerCheckMicroseconds)) continue;
+						uint32_t pid = slot->Pid.load(std::memory_order_acquire);
+						if (_IsProcessDead((int32_t)pid) && slot->Readers.compare_exchange_strong(readers, 0, std::memory_order_acq_rel))
+						{
+							_Header->Counters.OwnerDeaths.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				}
+			}
+
+			// holding the lock exclusively, repair what a dead writer left: run our handler, or if we have none
+			// leave the repair to the next process taking the lock exclusively that has one
+			void _Repair(bool ownerDied)
+			{
+				if (!ownerDied && _Header->Repair.load(std::memory_order_relaxed) == 0) return;
+				if (!_OwnerDied)
+				{
+					_Header->Repair.store(1, std::memory_order_relaxed);
+					return;
+				}
+				_OwnerDied();
+				_Header->Repair.store(0, std::memory_order_relaxed);
+			}
+
+			// add how long we waited to a set of counters
+			static inline void _CountWait(std::atomic<uint64_t>& contended, std::atomic<uint64_t>& waitNanoseconds, std::chrono::steady_clock::time_point start)
+			{
+				contended.fetch_add(1, std::memory_order_relaxed);
+				waitNanoseconds.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t slots)
+			*
+			* \brief	Get how many bytes of shared memory a shared mutex needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	slots				Max number of processes taking it shared at the same time.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t slots)
+			{
+				return sizeof(__SharedMutexHeader) + slots * sizeof(__SharedMutexSlot);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t slots)
+			*
+			* \brief	Initialize a new, unlocked shared mutex in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the lock.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the lock in.
+			* \param	offset				Offset of the lock in the shared memory, aligned to 64 bytes.
+			* \param	slots				Max number of processes taking it shared. Slots of dead processes are reused.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t slots)
+			{
+				if (slots == 0) throw std::runtime_error("Shared mutex needs at least one reader slot!");
+				_Attach(memory, offset, true, slots);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a shared mutex another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the lock is in.
+			* \param	offset				Offset of the lock in the shared memory.
+			* Note: throws std::runtime_error if there is no shared mutex at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0);
+			}
+
+			// return if lock is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// set a function to run, holding the lock exclusively, when taking it from a writer that died while holding it.
+			// if the process that finds the dead writer has none, the next process taking the lock exclusively runs its own
+			inline void OnOwnerDied(std::function<void()> handler) { _OwnerDied = std::move(handler); }
+
+			/*!
+			* \fn	void Lock()
+			*
+			* \brief	Take the lock exclusively, waiting for the current writer and then for all readers to leave.
+			*
+			* \date		10/19/2026
+			*/
+			void Lock()
+			{
+				uint32_t self = _Pid;
+				bool contended = false, recovered = false;
+				auto start = std::chrono::steady_clock::time_point();
+
+				// announce ourselves as the writer, so new readers back off
+				while (true)
+				{
+					uint32_t owner = 0;
+					if (_Header->Writer.compare_exchange_strong(owner, self, std::memory_order_seq_cst)) break;
+					if (!contended)
+					{
+						contended = true;
+						start = std::chrono::steady_clock::now();
+					}
+					if (_WaitWriter(owner, self))
+					{
+						recovered = true;
+						break;
+					}
+				}
+
+				_WaitReaders(contended, start);
+				if (contended) _CountWait(_Header->Counters.Contended, _Header->Counters.WaitNanoseconds, start);
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				_Repair(recovered);
+			}
+
+			// take the lock exclusively if there is no writer and no reader, without waiting
+			bool TryLock()
+			{
+				uint32_t owner = 0;
+				if (!_Header->Writer.compare_exchange_strong(owner, _Pid, std::memory_order_seq_cst)) return false;
+				for (size_t i = 0; i < _Header->SlotsCount; ++i)
+				{
+					if (_Slots[i].Readers.load(std::memory_order_seq_cst) != 0)
+					{
+						Unlock();
+						return false;
+					}
+				}
+				_Header->Counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				_Repair(false);
+				return true;
+			}
+
+			// release the exclusive lock
+			void Unlock()
+			{
+				_Header->Writer.store(0, std::memory_order_seq_cst);
+				if (_Header->Waiters.load(std::memory_order_seq_cst) != 0) WakeAll(&_Header->Writer);
+			}
+
+			/*!
+			* \fn	void LockShared()
+			*
+			* \brief	Take the lock shared, waiting while a writer holds or waits for it.
+			*
+			* \date		10/19/2026
+			*/
+			void LockShared()
+			{
+				__SharedMutexSlot* slot = _ReaderSlot();
+				slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+				uint32_t owner = _Header->Writer.load(std::memory_order_seq_cst);
+				if (owner != 0)
+				{
+					// step aside until the writer is done. if it died we now hold the lock exclusively, and recover it
+					// like a writer would before letting readers in over what it left
+					auto start = std::chrono::steady_clock::now();
+					uint32_t self = _Pid;
+					do
+					{
+						UnlockShared();
+						if (_WaitWriter(owner, self))
+						{
+							bool contended = true;
+							_WaitReaders(contended, start);
+							_Repair(true);
+							Unlock();
+						}
+						slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+					} while ((owner = _Header->Writer.load(std::memory_order_seq_cst)) != 0);
+					_CountWait(slot->Contended, slot->WaitNanoseconds, start);
+				}
+				slot->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// take the lock shared if no writer holds or waits for it, without waiting
+			bool TryLockShared()
+			{
+				__SharedMutexSlot* slot = _ReaderSlot();
+				slot->Readers.fetch_add(1, std::memory_order_seq_cst);
+				if (_Header->Writer.load(std::memory_order_seq_cst) != 0)
+				{
+					UnlockShared();
+					return false;
+				}
+				slot->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			// release a shared hold. wakes the writer if it waits for this slot to drain
+			void UnlockShared()
+			{
+				if (_Slot->Readers.fetch_sub(1, std::memory_order_seq_cst) == 1 && _Header->Writer.load(std::memory_order_seq_cst) != 0)
+				{
+					WakeAll(&_Slot->Readers);
+				}
+			}
+
+			// std::unique_lock / std::shared_lock interface
+			inline void lock() { Lock(); }
+			inline bool try_lock() { return TryLock(); }
+			inline void unlock() { Unlock(); }
+			inline void lock_shared() { LockShared(); }
+			inline bool try_lock_shared() { return TryLockShared(); }
+			inline void unlock_shared() { UnlockShared(); }
+
+			// get contention counters, summing all reader slots
+			LockStatistics GetStatistics() const
+			{
+				LockStatistics statistics;
+				statistics.Acquisitions = _Header->Counters.Acquisitions.load(std::memory_order_relaxed);
+				statistics.Contended = _Header->Counters.Contended.load(std::memory_order_relaxed);
+				statistics.WaitNanoseconds = _Header->Counters.WaitNanoseconds.load(std::memory_order_relaxed);
+				statistics.OwnerDeaths = _Header->Counters.OwnerDeaths.load(std::memory_order_relaxed);
+				for (size_t i = 0; i < _Header->SlotsCount; ++i)
+				{
+					statistics.SharedAcquisitions += _Slots[i].Acquisitions.load(std::memory_order_relaxed);
+					statistics.Contended += _Slots[i].Contended.load(std::memory_order_relaxed);
+					statistics.WaitNanoseconds += _Slots[i].WaitNanoseconds.load(std::memory_order_relaxed);
+				}
+				return statistics;
+			}
+		};
+	}
+}
@@ -0,0 +1,501 @@
+/*!
+* \file	Source\SharedMemory\RpcChannel.h.
+*
+* \brief	Request / response messaging between processes through a shared memory, with futex wakeups.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+#include "Futex.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	__RpcHeader
+		*
+		* \brief	Used internally, header of an rpc channel in shared memory.
+		* 			Followed by the pending requests bitmask, the server event, and the client slots.
+		*/
+		struct __RpcHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t MaxClients;
+			uint64_t SlotSize;
+		};
+
+		/*!
+		* \struct	__RpcClientSlot
+		*
+		* \brief	Used internally, a client's state, followed by its request and response buffers.
+		* 			State is the word clients wait on for responses. Pid is the owner, 0 when the slot is free;
+		* 			a slot is taken by swapping the pid, so two processes can never both take it.
+		*/
+		struct __RpcClientSlot
+		{
+			alignas(_CacheLineSize) std::atomic<uint32_t> State;
+			std::atomic<uint32_t> ClientWaiting;
+			std::atomic<int32_t> Pid;
+			std::atomic<uint64_t> RequestSize;
+			std::atomic<uint64_t> ResponseSize;
+		};
+
+		/*!
+		* \class	RpcChannel
+		*
+		* \brief	Local request / response calls through a shared memory, as a faster alternative to loopback sockets.
+		* 			Every client registers its own pair of request and response slots, so clients never contend.
+		* 			Requests and responses are written and read in place (ReserveRequest, handler writes into the response),
+		* 			so payloads are not copied. One server thread serves all clients: clients flag their slot in a pending
+		* 			bitmask and notify the server through an Event, and the server wakes a client with a futex only
+		* 			if it stopped spinning and parked.
+		* 			Each process uses its own RpcChannel object, either to serve or to call (after Register).
+		*
+		* \date		10/19/2026
+		*/
+		class RpcChannel
+		{
+		private:
+
+			// magic value marking an initialized channel
+			static const uint64_t _Magic = 0x4a55535452504343ULL;
+
+			// client slot states
+			static const uint32_t _Free = 0;
+			static const uint32_t _Idle = 1;
+			static const uint32_t _Request = 2;
+			static const uint32_t _Response = 3;
+
+			// client left while its request was with the server; the server frees the slot once it answered
+			static const uint32_t _Abandoned = 4;
+
+			// response size telling the client the handler failed
+			static const uint64_t _Failed = (uint64_t)-1;
+
+			__RpcHeader* _Header = nullptr;
+			std::atomic<uint64_t>* _Pending = nullptr;
+			char* _Slots = nullptr;
+			uint64_t _Stride = 0;
+			uint64_t _BufferStride = 0;
+			Event _ServerEvent;
+
+			// client side: our slot and index, iterations to spin before parking, and if a timed out call is still pending
+			__RpcClientSlot* _Slot = nullptr;
+			uint64_t _Index = 0;
+			uint32_t _Spin = 2000;
+			bool _Outstanding = false;
+
+			// get number of pending bitmask words
+			static inline uint64_t _PendingWords(size_t maxClients)
+			{
+				return (maxClients + 63) / 64;
+			}
+
+			// get offset of server event from header
+			static inline size_t _EventOffset(size_t maxClients)
+			{
+				return sizeof(__RpcHeader) + (size_t)((_PendingWords(maxClients) * 8 + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1));
+			}
+
+			// get buffer stride for a slot size
+			static inline uint64_t _BufferStrideFor(size_t slotSize)
+			{
+				return (slotSize + _CacheLineSize - 1) & ~(uint64_t)(_CacheLineSize - 1);
+			}
+
+			inline __RpcClientSlot* _ClientSlot(uint64_t index) const
+			{
+				return (__RpcClientSlot*)(_Slots + index * _Stride);
+			}
+			static inline char* _RequestBuffer(__RpcClientSlot* slot)
+			{
+				return (char*)slot + sizeof(__RpcClientSlot);
+			}
+			inline char* _ResponseBuffer(__RpcClientSlot* slot) const
+			{
+				return (char*)slot + sizeof(__RpcClientSlot) + _BufferStride;
+			}
+
+			// free a slot nobody wants the answer of anymore. the pid is cleared only if a Register did not take the slot meanwhile
+			static inline void _Release(__RpcClientSlot* slot)
+			{
+				int32_t owner = slot->Pid.load(std::memory_order_relaxed);
+				slot->State.store(_Free, std::memory_order_release);
+				slot->Pid.compare_exchange_strong(owner, 0, std::memory_order_release);
+			}
+
+			// wait for the late response of a timed out call, and drop it. return false if still not answered
+			bool _Drain(int64_t timeoutMicroseconds)
+			{
+				if (_Outstanding && _WaitResponse(timeoutMicroseconds)) _Outstanding = false;
+				return !_Outstanding;
+			}
+
+			// wait for the response to our request. spins first, then parks on the state word
+			bool _WaitResponse(int64_t timeoutMicroseconds)
+			{
+				for (uint32_t i = 0; i < _Spin; ++i)
+				{
+					if (_Slot->State.load(std::memory_order_acquire) == _Response) return true;
+					_CpuRelax();
+				}
+
+				// announce we park before checking again; the server sets the state before checking for waiters
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutMicroseconds);
+				_Slot->ClientWaiting.store(1, std::memory_order_seq_cst);
+				uint32_t state;
+				bool ret = true;
+				while ((state = _Slot->State.load(std::memory_order_seq_cst)) != _Response)
+				{
+					int64_t remaining = -1;
+					if (timeoutMicroseconds >= 0)
+					{
+						remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+						if (remaining <= 0) { ret = false; break; }
+					}
+					WaitOnAddress(&_Slot->State, state, remaining);
+				}
+				_Slot->ClientWaiting.store(0, std::memory_order_relaxed);
+				return ret;
+			}
+
+			// return if any client has a pending request
+			inline bool _HasPending() const
+			{
+				for (uint64_t i = 0; i < _PendingWords(_Header->MaxClients); ++i)
+				{
+					if (_Pending[i].load(std::memory_order_relaxed)) return true;
+				}
+				return false;
+			}
+
+			// answer one client request
+			template <typename Handler>
+			void _Answer(__RpcClientSlot* slot, Handler& handler)
+			{
+				uint64_t size = _Failed;
+				try
+				{
+					size = (uint64_t)handler((const void*)_RequestBuffer(slot), (size_t)slot->RequestSize.load(std::memory_order_relaxed),
+						(void*)_ResponseBuffer(slot), (size_t)_Header->SlotSize);
+					if (size > _Header->SlotSize) size = _Failed;
+				}
+				catch (...)
+				{
+					size = _Failed;
+				}
+				slot->ResponseSize.store(size, std::memory_order_relaxed);
+
+				// client abandoned the request while we handled it? nobody wants the answer, free the slot
+				uint32_t state = _Request;
+				if (!slot->State.compare_exchange_strong(state, _Response, std::memory_order_seq_cst))
+				{
+					_Release(slot);
+					return;
+				}
+				if (slot->ClientWaiting.load(std::memory_order_seq_cst)) Wake(&slot->State);
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t maxClients, size_t slotSize)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Rpc channel offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__RpcHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__RpcHeader* header = (__RpcHeader*)(memory.GetBuffer() + offset);
+				if (!create)
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain an rpc channel!");
+					maxClients = (size_t)header->MaxClients;
+					slotSize = (size_t)header->SlotSize;
+				}
+				if (memory.GetSize() - offset < RequiredSize(maxClients, slotSize)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Pending = (std::atomic<uint64_t>*)(header + 1);
+				_BufferStride = _BufferStrideFor(slotSize);
+				_Stride = sizeof(__RpcClientSlot) + 2 * _BufferStride;
+				_Slots = (char*)header + _EventOffset(maxClients) + Event::RequiredSize();
+				if (create)
+				{
+					new (header) __RpcHeader();
+					header->MaxClients = maxClients;
+					header->SlotSize = slotSize;
+					for (uint64_t i = 0; i < _PendingWords(maxClients); ++i) new (_Pending + i) std::atomic<uint64_t>(0);
+					_ServerEvent.CreateNew(memory, offset + _EventOffset(maxClients));
+					for (uint64_t i = 0; i < maxClients; ++i) new (_ClientSlot(i)) __RpcClientSlot();
+					header->Magic.store(_Magic, std::memory_order_release);
+				}
+				else
+				{
+					_ServerEvent.Connect(memory, offset + _EventOffset(maxClients));
+				}
+				_Header = header;
+				if (std::thread::hardware_concurrency() <= 1) _Spin = 0;
+			}
+
+		public:
+
+			RpcChannel() = default;
+
+			// clients own a slot, so channels can't be copied
+			RpcChannel(const RpcChannel&) = delete;
+			RpcChannel& operator=(const RpcChannel&) = delete;
+
+			~RpcChannel()
+			{
+				Unregister();
+			}
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t maxClients, size_t slotSize)
+			*
+			* \brief	Get how many bytes of shared memory an rpc channel needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	maxClients			Max clients registered at once.
+			* \param	slotSize			Max bytes per request and per response.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t maxClients, size_t slotSize)
+			{
+				return _EventOffset(maxClients) + Event::RequiredSize() + maxClients * (size_t)(sizeof(__RpcClientSlot) + 2 * _BufferStrideFor(slotSize));
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t maxClients, size_t slotSize)
+			*
+			* \brief	Initialize a new rpc channel in a shared memory. Usually done by the server, clients Connect.
+			* 			The shared memory must outlive the channel.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the channel in.
+			* \param	offset				Offset of the channel in the shared memory, aligned to 64 bytes.
+			* \param	maxClients			Max clients registered at once.
+			* \param	slotSize			Max bytes per request and per response.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t maxClients, size_t slotSize)
+			{
+				if (maxClients == 0 || slotSize == 0) throw std::runtime_error("Rpc channel max clients and slot size must not be 0!");
+				_Attach(memory, offset, true, maxClients, slotSize);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to an rpc channel another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the channel is in.
+			* \param	offset				Offset of the channel in the shared memory.
+			* Note: throws std::runtime_error if there is no rpc channel at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0, 0);
+			}
+
+			// return if channel is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get max bytes per request and per response
+			inline size_t GetSlotSize() const { return (size_t)_Header->SlotSize; }
+
+			// set iterations clients spin waiting for a response before parking, 0 to park right away
+			inline void SetSpin(uint32_t spin) { _Spin = spin; _ServerEvent.SetSpin(spin); }
+
+			/*!
+			* \fn	bool Register()
+			*
+			* \brief	Take a client slot, to make calls with this object. Slots of dead client processes are reclaimed;
+			* 			if one died during a call, its slot is left to the server to free once it answered.
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if all client slots are taken.
+			*/
+			bool Register()
+			{
+				if (_Slot) return true;
+				int32_t self = _CurrentProcessId();
+				for (int pass = 0; pass < 2; ++pass)
+				{
+					for (uint64_t i = 0; i < _Header->MaxClients; ++i)
+					{
+						__RpcClientSlot* slot = _ClientSlot(i);
+						int32_t owner = slot->Pid.load(std::memory_order_acquire);
+						if (owner != 0 && !(pass == 1 && _IsProcessDead(owner))) continue;
+						uint32_t state = slot->State.load(std::memory_order_acquire);
+
+						// dead client's request may still be with the server, which would answer into the slot.
+						// the server frees it once it answered
+						if (owner != 0 && state == _Request)
+						{
+							slot->State.compare_exchange_strong(state, _Abandoned, std::memory_order_acq_rel);
+							continue;
+						}
+						if (state == _Abandoned || (owner == 0 && state != _Free)) continue;
+
+						// take the slot by swapping the pid we saw, then publish it as idle
+						if (!slot->Pid.compare_exchange_strong(owner, self, std::memory_order_acq_rel)) continue;
+						slot->ClientWaiting.store(0, std::memory_order_relaxed);
+						slot->State.store(_Idle, std::memory_order_release);
+						_Slot = slot;
+						_Index = i;
+						_Outstanding = false;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// release the client slot. if a timed out request is still with the server, the slot is left to it,
+			// and it frees the slot once it answered, so the late answer never lands in a slot someone else took
+			void Unregister()
+			{
+				if (!_Slot) return;
+				uint32_t state = _Request;
+				if (!_Outstanding || !_Slot->State.compare_exchange_strong(state, _Abandoned, std::memory_order_acq_rel))
+				{
+					_Slot->State.store(_Free, std::memory_order_relaxed);
+					_Slot->Pid.store(0, std::memory_order_release);
+				}
+				_Slot = nullptr;
+			}
+
+			/*!
+			* \fn	void* ReserveRequest(int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Get the request buffer to write the next request into (GetSlotSize() bytes). Registered clients only.
+			* 			If the last call timed out, first waits for its late response and drops it, since the server
+			* 			still reads the old request from this buffer until it answered.
+			*
+			* \date		10/19/2026
+			*
+			* \param	timeoutMicroseconds	(Optional) Max time to wait for a late response, or -1 to wait forever.
+			*
+			* \return	The request buffer.
+			* Note: throws std::runtime_error if the late response did not come in time.
+			*/
+			void* ReserveRequest(int64_t timeoutMicroseconds = -1)
+			{
+				if (!_Slot) throw std::runtime_error("Must register to call an rpc channel!");
+				if (!_Drain(timeoutMicroseconds)) throw std::runtime_error("Rpc server is still handling the timed out request!");
+				return _RequestBuffer(_Slot);
+			}
+
+			/*!
+			* \fn	bool Call(size_t requestSize, const void*& response, size_t& responseSize, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Send the request written into ReserveRequest() and wait for the response. Registered clients only.
+			*
+			* \date		10/19/2026
+			*
+			* \param	requestSize			Bytes of request written.
+			* \param	response			Set to the response, in place. Valid until the next call.
+			* \param	responseSize		Set to the response size.
+			* \param	timeoutMicroseconds	(Optional) Max time to wait, or -1 to wait forever.
+			*
+			* \return	False if timed out. The next ReserveRequest waits for the late response first, and drops it.
+			* Note: throws std::runtime_error if the server handler failed, or if the request was written without
+			* 		ReserveRequest after a timed out call.
+			*/
+			bool Call(size_t requestSize, const void*& response, size_t& responseSize, int64_t timeoutMicroseconds = -1)
+			{
+				if (!_Slot) throw std::runtime_error("Must register to call an rpc channel!");
+				if (requestSize > _Header->SlotSize) throw std::runtime_error("Request is too big for rpc slot!");
+				if (_Outstanding) throw std::runtime_error("Must ReserveRequest after a timed out rpc call!");
+
+				_Slot->RequestSize.store(requestSize, std::memory_order_relaxed);
+				_Slot->State.store(_Request, std::memory_order_release);
+				_Pending[_Index / 64].fetch_or((uint64_t)1 << (_Index % 64), std::memory_order_release);
+				_ServerEvent.NotifyOne();
+
+				if (!_WaitResponse(timeoutMicroseconds))
+				{
+					_Outstanding = true;
+					return false;
+				}
+				uint64_t size = _Slot->ResponseSize.load(std::memory_order_relaxed);
+				if (size == _Failed) throw std::runtime_error("Rpc server failed to handle request!");
+				response = _ResponseBuffer(_Slot);
+				responseSize = (size_t)size;
+				return true;
+			}
+
+			// copy a request in, call, and copy the response out. after a timed out call, waits for the late response
+			// (within the same timeout) before the request is copied in, and returns false if it did not come
+			bool Call(const void* request, size_t requestSize, std::string& response, int64_t timeoutMicroseconds = -1)
+			{
+				if (!_Slot) throw std::runtime_error("Must register to call an rpc channel!");
+				if (requestSize > GetSlotSize()) throw std::runtime_error("Request is too big for rpc slot!");
+				if (!_Drain(timeoutMicroseconds)) return false;
+				memcpy(ReserveRequest(), request, requestSize);
+				const void* data;
+				size_t size;
+				if (!Call(requestSize, data, size, timeoutMicroseconds)) return false;
+				response.assign((const char*)data, size);
+				return true;
+			}
+
+			/*!
+			* \fn	template <typename Handler> size_t Serve(Handler handler, int64_t timeoutMicroseconds = -1)
+			*
+			* \brief	Answer all pending requests, waiting up to timeout for some if there are none. Server only,
+			* 			call it in a loop. Handler is called as handler(const void* request, size_t requestSize,
+			* 			void* response, size_t maxResponseSize) and returns the response size; it writes the response
+			* 			in place. If it throws (or returns more than max size), the client's Call throws.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Request handler.
+			* \param	timeoutMicroseconds	(Optional) Max time to wait for requests, or -1 to wait forever.
+			*
+			* \return	Number of requests answered.
+			*/
+			template <typename Handler>
+			size_t Serve(Handler handler, int64_t timeoutMicroseconds = -1)
+			{
+				if (!_HasPending() && !_ServerEvent.WaitFor([this]() { return _HasPending(); }, timeoutMicroseconds)) return 0;
+
+				size_t served = 0;
+				for (uint64_t word = 0; word < _PendingWords(_Header->MaxClients); ++word)
+				{
+					uint64_t bits = _Pending[word].exchange(0, std::memory_order_acquire);
+					while (bits)
+					{
+						int bit = 0;
+						while (!(bits & ((uint64_t)1 << bit))) ++bit;
+						bits &= ~((uint64_t)1 << bit);
+						__RpcClientSlot* slot = _ClientSlot(word * 64 + bit);
+						uint32_t state = slot->State.load(std::memory_order_acquire);
+
+						// abandoned before we got to it, free without handling
+						if (state == _Abandoned)
+						{
+							_Release(slot);
+							continue;
+						}
+						if (state != _Request) continue;
+						_Answer(slot, handler);
+						++served;
+					}
+				}
+				return served;
+			}
+		};
+	}
+}
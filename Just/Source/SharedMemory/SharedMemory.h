@@ -4,15 +4,238 @@
 * \brief	Creating and using Shared Memory between processes.
 */
 #pragma once
-#ifdef _WIN32
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include "Copy.h"
+
+#ifdef _WIN32
 #include <windows.h>
 #include "../Strings/To/All.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 namespace Just
 {
 	namespace SharedMemory
 	{
+		/*!
+		* \struct	Options
+		*
+		* \brief	Options for mapping a shared memory, to get predictable access latency.
+		* 			Applied on linux only.
+		*
+		* \date		10/19/2026
+		*/
+		struct Options
+		{
+			// pre-fault all pages when mapping (MAP_POPULATE), so first access doesn't page fault
+			bool Populate = false;
+
+			// use huge pages: MFD_HUGETLB for anonymous memory, transparent huge pages (madvise) for named memory
+			bool HugePages = false;
+
+			// lock pages in RAM (mlock) so they are never swapped out. fails if RLIMIT_MEMLOCK is too low
+			bool LockPages = false;
+
+			// if true, the process that created a named shared memory removes its name when it closes.
+			// processes already connected keep using it, but new processes can't connect anymore, and a ConnectOrCreate
+			// after that creates a new, separate memory. off by default, the name stays until Unlink() is called
+			bool UnlinkOnClose = false;
+
+			// if not 0, the shared memory can grow up to MaxSize bytes with Grow(). Address space for MaxSize is
+			// reserved up front, so the buffer never moves. Processes connecting to it must set MaxSize too
+			// (any non 0 value, the creator's is used)
+			size_t MaxSize = 0;
+
+			// map read only (Connect, ConnectFd, OpenFileBacked), for example to share an immutable dataset.
+			// writing through Write* functions throws
+			bool ReadOnly = false;
+		};
+
+		/*!
+		* \struct	__FileHeader
+		*
+		* \brief	Used internally, header page in front of the buffer of file backed shared memories.
+		* 			DataChecksum is the buffer checksum at the last Snapshot, HeaderChecksum covers the fields before it.
+		*/
+		struct __FileHeader
+		{
+			uint64_t Magic;
+			uint64_t Size;
+			uint64_t Generation;
+			uint64_t DataChecksum;
+			uint64_t HeaderChecksum;
+		};
+
+		// magic value marking a file backed shared memory, and size of its header (a page, so the buffer stays page aligned)
+		const uint64_t _FileMagic = 0x4a55535446494c45ULL;
+		const size_t _FileHeaderSize = 4096;
+
+		/*!
+		* \fn	inline uint64_t _Checksum(const void* data, size_t size)
+		*
+		* \brief	Used internally, fast 64 bit checksum (4 lanes of xxhash64-like rounds, several GB/s).
+		*
+		* \date		10/19/2026
+		*/
+		inline uint64_t _Checksum(const void* data, size_t size)
+		{
+			const uint64_t prime1 = 0x9e3779b185ebca87ULL, prime2 = 0xc2b2ae3d27d4eb4fULL;
+			auto round = [&](uint64_t lane, uint64_t word) {
+				lane += word * prime2;
+				lane = (lane << 31) | (lane >> 33);
+				return lane * prime1;
+			};
+			const char* bytes = (const char*)data;
+			uint64_t lanes[4] = { prime1 + prime2, prime2, 0, (uint64_t)0 - prime1 };
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				for (int lane = 0; lane < 4; ++lane)
+				{
+					uint64_t word;
+					memcpy(&word, bytes + i + lane * 8, 8);
+					lanes[lane] = round(lanes[lane], word);
+				}
+			}
+			uint64_t hash = ((lanes[0] << 1) | (lanes[0] >> 63)) + ((lanes[1] << 7) | (lanes[1] >> 57)) +
+				((lanes[2] << 12) | (lanes[2] >> 52)) + ((lanes[3] << 18) | (lanes[3] >> 46)) + (uint64_t)size;
+			for (; i < size; ++i) hash = round(hash, (unsigned char)bytes[i]);
+			hash ^= hash >> 33;
+			hash *= prime2;
+			hash ^= hash >> 29;
+			return hash;
+		}
+
+#ifndef _WIN32
+		/*!
+		* \struct	__GrowableHeader
+		*
+		* \brief	Used internally, header in front of the buffer of growable shared memories.
+		* 			Size is the current buffer size, and Generation grows every time it changes.
+		*/
+		struct alignas(64) __GrowableHeader
+		{
+			std::atomic<uint64_t> Magic;
+			uint64_t MaxSize;
+			std::atomic<uint64_t> Size;
+			std::atomic<uint64_t> Generation;
+			std::atomic<uint32_t> GrowLock;
+		};
+
+		// magic value marking a growable shared memory
+		const uint64_t _GrowableMagic = 0x4a55535447524f57ULL;
+#endif
+
+		/*!
+		* \fn	inline int32_t _CurrentProcessId()
+		*
+		* \brief	Used internally, get id of the current process, to record who holds something in shared memory.
+		*
+		* \date		10/19/2026
+		*/
+		inline int32_t _CurrentProcessId()
+		{
+#ifdef _WIN32
+			return (int32_t)GetCurrentProcessId();
+#else
+			return (int32_t)getpid();
+#endif
+		}
+
+		/*!
+		* \fn	inline bool _IsProcessDead(int32_t pid)
+		*
+		* \brief	Used internally, return if a process is gone, so what it held in shared memory can be reclaimed.
+		*
+		* \date		10/19/2026
+		*/
+		inline bool _IsProcessDead(int32_t pid)
+		{
+			if (pid <= 0) return false;
+#ifdef _WIN32
+			HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, (DWORD)pid);
+			if (process == NULL) return GetLastError() == ERROR_INVALID_PARAMETER;
+			DWORD code;
+			bool dead = GetExitCodeProcess(process, &code) && code != STILL_ACTIVE;
+			CloseHandle(process);
+			return dead;
+#else
+			return kill(pid, 0) == -1 && errno == ESRCH;
+#endif
+		}
+
+		/*!
+		* \fn	inline void _LockOwned(std::atomic<uint32_t>& lock)
+		*
+		* \brief	Used internally, take a lock word in shared memory. It holds the owner's pid, so a process that died
+		* 			holding it is found and the lock taken over. Only for data that stays consistent at every step.
+		*
+		* \date		10/19/2026
+		*/
+		inline void _LockOwned(std::atomic<uint32_t>& lock)
+		{
+			uint32_t self = (uint32_t)_CurrentProcessId();
+			for (uint32_t spins = 1; ; ++spins)
+			{
+				uint32_t owner = 0;
+				if (lock.compare_exchange_weak(owner, self, std::memory_order_acquire)) return;
+				if (owner && spins % 64 == 0 && _IsProcessDead((int32_t)owner) && lock.compare_exchange_strong(owner, self, std::memory_order_acquire)) return;
+				std::this_thread::yield();
+			}
+		}
+
+		// release a lock taken with _LockOwned
+		inline void _UnlockOwned(std::atomic<uint32_t>& lock)
+		{
+			lock.store(0, std::memory_order_release);
+		}
+
+		/*!
+		* \struct	FieldWrite
+		*
+		* \brief	A field to write with Client::WriteFields: where in the shared memory, and what.
+		*
+		* \date		10/19/2026
+		*/
+		struct FieldWrite
+		{
+			size_t Offset;
+			const void* Data;
+			size_t Size;
+		};
+
+		/*!
+		* \struct	FieldRead
+		*
+		* \brief	A field to read with Client::ReadFields: where in the shared memory, and where to copy it to.
+		*
+		* \date		10/19/2026
+		*/
+		struct FieldRead
+		{
+			size_t Offset;
+			void* Data;
+			size_t Size;
+		};
+
 		/**
 		* Manage a shared memory connection.
 		*/
@@ -20,21 +243,283 @@ namespace Just
 		{
 		private:
 
+#ifdef _WIN32
 			// file handle
 			HANDLE _MapFile;
 
+			// backing file, for file backed memories
+			HANDLE _File = INVALID_HANDLE_VALUE;
+#else
+			// shared memory file descriptor
+			int _Fd;
+
+			// name to unlink on close, if we created it and should unlink it
+			std::string _UnlinkName;
+
+			// growable memories only: reserved address space (starting with the header), bytes of it mapped,
+			// generation we mapped, and options to map more with. reads and writes of any thread may map more,
+			// one at a time under the refresh lock; size and generation are atomic so the others check them without it
+			char* _Base = NULL;
+			size_t _Reserved = 0;
+			mutable size_t _Mapped = 0;
+			mutable std::atomic<uint64_t> _Generation{ 0 };
+			mutable std::mutex _RefreshLock;
+			Options _Options;
+#endif
+
 			// buffer
-			LPCTSTR _Buffer;
+			char* _Buffer;
+
+			// shared memory size (grows lazily with growable memories)
+			mutable std::atomic<size_t> _BufferSize;
 
-			// shared memory size
-			int _BufferSize;
+			// file backed memories only: mapping start (the header page)
+			char* _FileBase = NULL;
+
+			// if mapped read only
+			bool _ReadOnly = false;
+
+			// get file backed memory header
+			inline __FileHeader* _GetFileHeader() const { return (__FileHeader*)_FileBase; }
+
+			// get checksum of a file header's fields
+			static inline uint64_t _HeaderChecksum(const __FileHeader& header)
+			{
+				return _Checksum(&header, offsetof(__FileHeader, HeaderChecksum));
+			}
+
+#ifndef _WIN32
+			// get shm_open name from path (must start with a single slash)
+			static std::string _ShmName(const std::string& path)
+			{
+				return (!path.empty() && path[0] == '/') ? path : "/" + path;
+			}
+
+			// map an open descriptor. on failure closes everything and returns false
+			bool _Map(size_t bufferSize, const Options& options)
+			{
+				int flags = MAP_SHARED | (options.Populate ? MAP_POPULATE : 0);
+				void* buffer = mmap(NULL, bufferSize, PROT_READ | (options.ReadOnly ? 0 : PROT_WRITE), flags, _Fd, 0);
+				if (buffer == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				_Buffer = (char*)buffer;
+				_BufferSize = bufferSize;
+				_ReadOnly = options.ReadOnly;
+#ifdef MADV_HUGEPAGE
+				if (options.HugePages) madvise(_Buffer, _BufferSize, MADV_HUGEPAGE);
+#endif
+				if (options.LockPages && mlock(_Buffer, _BufferSize) != 0)
+				{
+					Close();
+					return false;
+				}
+				return true;
+			}
+
+			// get growable memory header
+			inline __GrowableHeader* _GetHeader() const { return (__GrowableHeader*)_Base; }
+
+			// reserve address space for a growable memory, and map its current size. on failure closes everything
+			bool _MapGrowable(size_t maxSize, size_t bufferSize, const Options& options)
+			{
+				_Reserved = sizeof(__GrowableHeader) + maxSize;
+				void* base = mmap(NULL, _Reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				if (base == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				_Base = (char*)base;
+				_Buffer = _Base + sizeof(__GrowableHeader);
+				_Options = options;
+				_ReadOnly = options.ReadOnly;
+				_Mapped = 0;
+				if (!_MapMore(sizeof(__GrowableHeader) + bufferSize))
+				{
+					Close();
+					return false;
+				}
+				_BufferSize = bufferSize;
+				return true;
+			}
+
+			// map a growable memory up to total bytes (including header), in place inside the reserved space.
+			// called on setup, or with the refresh lock held
+			bool _MapMore(size_t total) const
+			{
+				if (total <= _Mapped) return true;
+				size_t from = _Mapped & ~(size_t)(sysconf(_SC_PAGESIZE) - 1);
+				int flags = MAP_SHARED | MAP_FIXED | (_Options.Populate ? MAP_POPULATE : 0);
+				int protection = PROT_READ | (_Options.ReadOnly ? 0 : PROT_WRITE);
+				if (mmap(_Base + from, total - from, protection, flags, _Fd, (off_t)from) == MAP_FAILED) return false;
+#ifdef MADV_HUGEPAGE
+				if (_Options.HugePages) madvise(_Base + from, total - from, MADV_HUGEPAGE);
+#endif
+				if (_Options.LockPages && mlock(_Base + from, total - from) != 0) return false;
+				_Mapped = total;
+				return true;
+			}
+
+			// create a growable memory on an open, empty descriptor
+			bool _CreateGrowable(size_t bufferSize, const Options& options)
+			{
+				if (options.MaxSize < bufferSize || ftruncate(_Fd, (off_t)(sizeof(__GrowableHeader) + bufferSize)) != 0) return false;
+				if (!_MapGrowable(options.MaxSize, bufferSize, options)) return false;
+				__GrowableHeader* header = new (_Base) __GrowableHeader();
+				header->MaxSize = options.MaxSize;
+				header->Size.store(bufferSize, std::memory_order_relaxed);
+				header->Magic.store(_GrowableMagic, std::memory_order_release);
+				return true;
+			}
+
+			// connect to a growable memory on an open descriptor. on failure closes everything
+			bool _ConnectGrowable(size_t bufferSize, const Options& options)
+			{
+				__GrowableHeader header;
+				if (pread(_Fd, (void*)&header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+					header.Magic.load(std::memory_order_relaxed) != _GrowableMagic)
+				{
+					Close();
+					return false;
+				}
+				if (!_MapGrowable((size_t)header.MaxSize, 0, options)) return false;
+				_Generation = (uint64_t)-1;
+				if (!Refresh() || _BufferSize < bufferSize)
+				{
+					Close();
+					return false;
+				}
+				return true;
+			}
+#endif
+
+			// check a range is inside the buffer. growable memories map more first, if they grew
+			inline bool _InRange(size_t offset, size_t dataLen) const
+			{
+				size_t size = _BufferSize.load(std::memory_order_acquire);
+				if (offset <= size && dataLen <= size - offset) return true;
+#ifndef _WIN32
+				if (_Base && Refresh())
+				{
+					size = _BufferSize.load(std::memory_order_acquire);
+					return offset <= size && dataLen <= size - offset;
+				}
+#endif
+				return false;
+			}
+
+			// check a set of fields is in range, with a single range check for the span they cover
+			template <typename FieldType>
+			bool _FieldsInRange(const FieldType* fields, size_t count) const
+			{
+				if (count == 0) return true;
+				size_t begin = SIZE_MAX, end = 0;
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (fields[i].Size > SIZE_MAX - fields[i].Offset) return false;
+					if (fields[i].Offset < begin) begin = fields[i].Offset;
+					if (fields[i].Offset + fields[i].Size > end) end = fields[i].Offset + fields[i].Size;
+				}
+				return _InRange(begin, end - begin);
+			}
+
+			// open or create a file backed memory and map it, header page first.
+			// when opening, the header is validated before mapping and bufferSize is taken from it
+			bool _MapFileBacked(const std::string& path, size_t bufferSize, bool create, const Options& options)
+			{
+				__FileHeader header = { _FileMagic, (uint64_t)bufferSize, 0, 0, 0 };
+				header.HeaderChecksum = _HeaderChecksum(header);
+#ifdef _WIN32
+				_File = CreateFileA(path.c_str(), GENERIC_READ | (options.ReadOnly ? 0 : GENERIC_WRITE), FILE_SHARE_READ | FILE_SHARE_WRITE,
+					NULL, create ? CREATE_NEW : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+				if (_File == INVALID_HANDLE_VALUE) return false;
+				if (!create)
+				{
+					DWORD read = 0;
+					LARGE_INTEGER fileSize;
+					if (!ReadFile(_File, &header, sizeof(header), &read, NULL) || read != sizeof(header) ||
+						header.Magic != _FileMagic || header.HeaderChecksum != _HeaderChecksum(header) ||
+						!GetFileSizeEx(_File, &fileSize) || (uint64_t)fileSize.QuadPart < _FileHeaderSize + header.Size)
+					{
+						Close();
+						return false;
+					}
+					bufferSize = (size_t)header.Size;
+				}
+				uint64_t total = _FileHeaderSize + (uint64_t)bufferSize;
+				_MapFile = CreateFileMapping(_File, NULL, options.ReadOnly ? PAGE_READONLY : PAGE_READWRITE,
+					(DWORD)(total >> 32), (DWORD)(total & 0xffffffff), NULL);
+				if (_MapFile == NULL)
+				{
+					Close();
+					return false;
+				}
+				_FileBase = (char*)MapViewOfFile(_MapFile, options.ReadOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)total);
+				if (_FileBase == NULL)
+				{
+					Close();
+					return false;
+				}
+#else
+				_Fd = open(path.c_str(), (options.ReadOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0666);
+				if (_Fd == -1) return false;
+				if (create)
+				{
+					if (ftruncate(_Fd, (off_t)(_FileHeaderSize + bufferSize)) != 0)
+					{
+						Close();
+						unlink(path.c_str());
+						return false;
+					}
+				}
+				else
+				{
+					struct stat info;
+					if (pread(_Fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+						header.Magic != _FileMagic || header.HeaderChecksum != _HeaderChecksum(header) ||
+						fstat(_Fd, &info) != 0 || (uint64_t)info.st_size < _FileHeaderSize + header.Size)
+					{
+						Close();
+						return false;
+					}
+					bufferSize = (size_t)header.Size;
+				}
+				int flags = MAP_SHARED | (options.Populate ? MAP_POPULATE : 0);
+				void* base = mmap(NULL, _FileHeaderSize + bufferSize, PROT_READ | (options.ReadOnly ? 0 : PROT_WRITE), flags, _Fd, 0);
+				if (base == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				_FileBase = (char*)base;
+#endif
+				_Buffer = _FileBase + _FileHeaderSize;
+				_BufferSize = bufferSize;
+				_ReadOnly = options.ReadOnly;
+				if (create) memcpy(_FileBase, &header, sizeof(header));
+#ifndef _WIN32
+				if (options.LockPages && mlock(_FileBase, _FileHeaderSize + bufferSize) != 0)
+				{
+					Close();
+					return false;
+				}
+#endif
+				return true;
+			}
 
 		public:
 
 			/**
 			* Constructor.
 			*/
+#ifdef _WIN32
 			Client() : _MapFile(NULL), _Buffer(NULL), _BufferSize(0) {}
+#else
+			Client() : _Fd(-1), _Buffer(NULL), _BufferSize(0) {}
+#endif
 
 			/**
 			* Destructor.
@@ -44,23 +529,66 @@ namespace Just
 				Close();
 			}
 
+			// clients own their mapping, so they can be moved but not copied
+			Client(const Client&) = delete;
+			Client& operator=(const Client&) = delete;
+			Client(Client&& other) noexcept : Client() { *this = std::move(other); }
+			Client& operator=(Client&& other) noexcept
+			{
+				if (this == &other) return *this;
+				Close();
+#ifdef _WIN32
+				_MapFile = other._MapFile;
+				_File = other._File;
+				other._MapFile = NULL;
+				other._File = INVALID_HANDLE_VALUE;
+#else
+				_Fd = other._Fd;
+				_UnlinkName = std::move(other._UnlinkName);
+				_Base = other._Base;
+				_Reserved = other._Reserved;
+				_Mapped = other._Mapped;
+				_Generation.store(other._Generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				_Options = other._Options;
+				other._Fd = -1;
+				other._UnlinkName.clear();
+				other._Base = NULL;
+				other._Reserved = other._Mapped = 0;
+#endif
+				_Buffer = other._Buffer;
+				_BufferSize.store(other._BufferSize.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				_FileBase = other._FileBase;
+				_ReadOnly = other._ReadOnly;
+				other._Buffer = NULL;
+				other._BufferSize = 0;
+				other._FileBase = NULL;
+				return *this;
+			}
+
 			/*!
-			* \fn	bool CreateNew(const std::string& path, int bufferSize)
+			* \fn	bool CreateNew(const std::string& path, size_t bufferSize, const Options& options = Options())
 			*
-			* \brief	Create a new shared memory.
+			* \brief	Create a new shared memory. Fails if a shared memory with this path already exists.
+			* 			On linux path is a shm_open name, a leading slash is added if missing. The name outlives
+			* 			the process unless Options::UnlinkOnClose is set; remove it with Unlink() when done.
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*
 			* \param	path 				Shared memory file path.
 			* \param	bufferSize			Shared memory buffer size.
+			* \param	options				(Optional) Mapping options.
 			*
 			* \return	If succeed to create the shared memory.
 			*/
-			bool CreateNew(const std::string& path, int bufferSize)
+			bool CreateNew(const std::string& path, size_t bufferSize, const Options& options = Options())
 			{
 				// if already init throw exception
-				if (IsValid()) throw new std::exception("Shared Memory already connected!");
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (bufferSize == 0) return false;
+
+#ifdef _WIN32
+				(void)options;
 
 				// convert path to wide string
 				LPCWSTR converted;
@@ -68,23 +596,25 @@ namespace Just
 
 				// create shared memory
 				_MapFile = CreateFileMapping(
-					INVALID_HANDLE_VALUE,    // use paging file
-					NULL,                    // default security
-					PAGE_READWRITE,          // read/write access
-					0,                       // maximum object size (high-order DWORD)
-					bufferSize,              // maximum object size (low-order DWORD)
-					converted);				 // name of mapping object
+					INVALID_HANDLE_VALUE,					// use paging file
+					NULL,									// default security
+					PAGE_READWRITE,							// read/write access
+					(DWORD)((unsigned long long)bufferSize >> 32),	// maximum object size (high-order DWORD)
+					(DWORD)(bufferSize & 0xffffffff),		// maximum object size (low-order DWORD)
+					converted);								// name of mapping object
+				bool alreadyExists = GetLastError() == ERROR_ALREADY_EXISTS;
 				delete[] converted;
 
-				// if had error stop here
-				if (_MapFile == NULL)
+				// if had error or it already existed stop here
+				if (_MapFile == NULL || alreadyExists)
 				{
+					Close();
 					return false;
 				}
 
 				// get mapping
-				_Buffer = (LPTSTR)MapViewOfFile(_MapFile,
-					FILE_MAP_ALL_ACCESS, 
+				_Buffer = (char*)MapViewOfFile(_MapFile,
+					FILE_MAP_ALL_ACCESS,
 					0,
 					0,
 					bufferSize);
@@ -99,10 +629,32 @@ namespace Just
 				// success
 				_BufferSize = bufferSize;
 				return true;
+#else
+				// create and size shared memory
+				std::string name = _ShmName(path);
+				_Fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+				if (_Fd == -1) return false;
+				_UnlinkName = name;
+				if (options.MaxSize)
+				{
+					if (!_CreateGrowable(bufferSize, options))
+					{
+						Close();
+						return false;
+					}
+				}
+				else if (ftruncate(_Fd, (off_t)bufferSize) != 0 || !_Map(bufferSize, options))
+				{
+					Close();
+					return false;
+				}
+				if (!options.UnlinkOnClose) _UnlinkName.clear();
+				return true;
+#endif
 			}
 
 			/*!
-			* \fn	bool Connect(const std::string& path, int bufferSize)
+			* \fn	bool Connect(const std::string& path, size_t bufferSize = 0, const Options& options = Options())
 			*
 			* \brief	Connect to existing shared memory other processed previously opened.
 			*
@@ -110,22 +662,25 @@ namespace Just
 			* \date		11/13/2018
 			*
 			* \param	path 				Shared memory file path.
-			* \param	bufferSize			Shared memory buffer size.
+			* \param	bufferSize			(Optional) Shared memory buffer size. If 0, the whole shared memory is mapped.
+			* \param	options				(Optional) Mapping options.
 			*
 			* \return	If succeed to connect to the shared memory.
 			*/
-			bool Connect(const std::string& path, int bufferSize)
+			bool Connect(const std::string& path, size_t bufferSize = 0, const Options& options = Options())
 			{
 				// if already init throw exception
-				if (IsValid()) throw new std::exception("Shared Memory already connected!");
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
 
+#ifdef _WIN32
 				// convert path to wide string
 				LPCWSTR converted;
 				String::To::LpcwStr(path, converted);
 
 				// create shared memory
+				DWORD access = options.ReadOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
 				_MapFile = OpenFileMapping(
-					FILE_MAP_ALL_ACCESS,   // read/write access
+					access,                // read/write access
 					FALSE,                 // do not inherit the name
 					converted);            // name of mapping object
 				delete[] converted;
@@ -137,8 +692,9 @@ namespace Just
 				}
 
 				// get mapping
-				_Buffer = (LPTSTR)MapViewOfFile(_MapFile,
-					FILE_MAP_ALL_ACCESS,
+				_ReadOnly = options.ReadOnly;
+				_Buffer = (char*)MapViewOfFile(_MapFile,
+					access,
 					0,
 					0,
 					bufferSize);
@@ -151,30 +707,319 @@ namespace Just
 				}
 
 				// success
+				if (bufferSize == 0)
+				{
+					MEMORY_BASIC_INFORMATION info;
+					bufferSize = VirtualQuery(_Buffer, &info, sizeof(info)) ? info.RegionSize : 0;
+				}
 				_BufferSize = bufferSize;
 				return true;
+#else
+				_Fd = shm_open(_ShmName(path).c_str(), (options.ReadOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC, 0);
+				if (_Fd == -1) return false;
+				if (options.MaxSize) return _ConnectGrowable(bufferSize, options);
+
+				// shared memory must be at least as big as requested
+				struct stat info;
+				if (fstat(_Fd, &info) != 0 || info.st_size == 0 || (size_t)info.st_size < bufferSize)
+				{
+					Close();
+					return false;
+				}
+				return _Map(bufferSize ? bufferSize : (size_t)info.st_size, options);
+#endif
 			}
 
 			/*!
-			* \fn	bool ConnectOrCreate(const std::string& path, int bufferSize)
+			* \fn	bool ConnectOrCreate(const std::string& path, size_t bufferSize, const Options& options = Options())
 			*
 			* \brief	Try to connect to existing shared memory and if fail, try to create it.
+			* 			When processes race on the same path one creates it (zero filled) and the others connect;
+			* 			a connect that comes while the creator is still sizing it fails, and can be retried.
+			* 			On linux, don't combine with Options::UnlinkOnClose: once the creator closes the name is gone,
+			* 			and the next ConnectOrCreate creates a new memory that processes still connected to the old
+			* 			one never see.
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*
 			* \param	path 				Shared memory file path.
 			* \param	bufferSize			Shared memory buffer size.
+			* \param	options				(Optional) Mapping options.
 			*
 			* \return	If succeed to connect / create the shared memory.
 			*/
-			bool ConnectOrCreate(const std::string& path, int bufferSize)
+			bool ConnectOrCreate(const std::string& path, size_t bufferSize, const Options& options = Options())
+			{
+				return CreateNew(path, bufferSize, options) || Connect(path, bufferSize, options);
+			}
+
+			/*!
+			* \fn	bool CreateFileBacked(const std::string& path, size_t bufferSize, const Options& options = Options())
+			*
+			* \brief	Create a new shared memory backed by a regular file, so its content survives restarts and reboots.
+			* 			The file holds a header page and then the buffer; other processes share it with OpenFileBacked.
+			* 			Changes reach the file lazily, call Snapshot() to make a consistent, verifiable copy durable.
+			* 			Not supported together with Options::MaxSize or Options::HugePages.
+			*
+			* \date		10/19/2026
+			*
+			* \param	path 				File path. Fails if the file already exists.
+			* \param	bufferSize			Shared memory buffer size.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to create the file and map it.
+			*/
+			bool CreateFileBacked(const std::string& path, size_t bufferSize, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (bufferSize == 0 || options.MaxSize || options.HugePages || options.ReadOnly) return false;
+				return _MapFileBacked(path, bufferSize, true, options);
+			}
+
+			/*!
+			* \fn	bool OpenFileBacked(const std::string& path, const Options& options = Options())
+			*
+			* \brief	Open a shared memory file made by CreateFileBacked, by this or a previous run.
+			* 			Only the header is read; the buffer is mapped as is, so attaching takes about the same time
+			* 			regardless of the dataset size (use Options::Populate to fault it all in upfront instead).
+			* 			With Options::ReadOnly, the file is opened read only, for example to share an immutable dataset.
+			*
+			* \date		10/19/2026
+			*
+			* \param	path 				File path.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to open and map the file, false if it is missing, truncated or its header is corrupted.
+			*/
+			bool OpenFileBacked(const std::string& path, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (options.MaxSize || options.HugePages) return false;
+				return _MapFileBacked(path, 0, false, options);
+			}
+
+			/*!
+			* \fn	bool Snapshot()
+			*
+			* \brief	Make the current content of a file backed shared memory durable: flush the buffer to the file,
+			* 			then record its checksum and a new snapshot generation in the header, and flush that too.
+			* 			After a crash, Verify() tells if the buffer still matches the last completed snapshot.
+			* 			Writers should be quiet while it runs, or the recorded checksum may not match.
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if the memory is not file backed, is read only, or flushing failed.
+			*/
+			bool Snapshot()
+			{
+				if (!_FileBase || _ReadOnly) return false;
+#ifdef _WIN32
+				if (!FlushViewOfFile(_Buffer, _BufferSize) || !FlushFileBuffers(_File)) return false;
+#else
+				if (msync(_Buffer, _BufferSize, MS_SYNC) != 0) return false;
+#endif
+				__FileHeader* header = _GetFileHeader();
+				header->DataChecksum = _Checksum(_Buffer, _BufferSize);
+				header->Generation += 1;
+				header->HeaderChecksum = _HeaderChecksum(*header);
+#ifdef _WIN32
+				return FlushViewOfFile(_FileBase, sizeof(__FileHeader)) && FlushFileBuffers(_File);
+#else
+				return msync(_FileBase, _FileHeaderSize, MS_SYNC) == 0;
+#endif
+			}
+
+			/*!
+			* \fn	bool Verify() const
+			*
+			* \brief	Check a file backed shared memory matches its last snapshot, for example after opening it
+			* 			following a crash. Reads the whole buffer, so it takes time proportional to its size.
+			*
+			* \date		10/19/2026
+			*
+			* \return	True if there was a snapshot and the buffer checksum still matches it.
+			*/
+			bool Verify() const
+			{
+				if (!_FileBase) return false;
+				const __FileHeader* header = _GetFileHeader();
+				return header->Generation != 0 && header->DataChecksum == _Checksum(_Buffer, _BufferSize);
+			}
+
+			// get how many snapshots were taken of a file backed shared memory (0 if none, or not file backed)
+			inline uint64_t GetSnapshotGeneration() const { return _FileBase ? _GetFileHeader()->Generation : 0; }
+
+			// return if shared memory was mapped read only
+			inline bool IsReadOnly() const { return _ReadOnly; }
+
+#ifndef _WIN32
+			/*!
+			* \fn	bool CreateAnonymous(size_t bufferSize, const Options& options = Options())
+			*
+			* \brief	Create a new shared memory without a name (memfd_create).
+			* 			Share it with other processes by passing GetFd() to them (inherit it, or send it over
+			* 			a unix socket), which then call ConnectFd. Released when the last process closes it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	bufferSize			Shared memory buffer size. With HugePages, must be a multiple of the huge page size.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to create the shared memory.
+			*/
+			bool CreateAnonymous(size_t bufferSize, const Options& options = Options())
+			{
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				if (bufferSize == 0) return false;
+				unsigned int flags = MFD_CLOEXEC;
+#ifdef MFD_HUGETLB
+				if (options.HugePages) flags |= MFD_HUGETLB;
+#endif
+				_Fd = memfd_create("just_shared_memory", flags);
+				if (_Fd == -1) return false;
+				if (options.MaxSize)
+				{
+					if (_CreateGrowable(bufferSize, options)) return true;
+					Close();
+					return false;
+				}
+				if (ftruncate(_Fd, (off_t)bufferSize) != 0)
+				{
+					Close();
+					return false;
+				}
+				return _Map(bufferSize, options);
+			}
+
+			/*!
+			* \fn	bool ConnectFd(int fd, size_t bufferSize = 0, const Options& options = Options())
+			*
+			* \brief	Connect to a shared memory by its file descriptor (see CreateAnonymous).
+			* 			The descriptor is duplicated, caller keeps ownership of fd.
+			*
+			* \date		10/19/2026
+			*
+			* \param	fd 					Shared memory file descriptor.
+			* \param	bufferSize			(Optional) Shared memory buffer size. If 0, the whole shared memory is mapped.
+			* \param	options				(Optional) Mapping options.
+			*
+			* \return	If succeed to connect to the shared memory.
+			*/
+			bool ConnectFd(int fd, size_t bufferSize = 0, const Options& options = Options())
 			{
-				return CreateNew(path, bufferSize) || Connect(path, bufferSize);
+				if (IsValid()) throw std::runtime_error("Shared Memory already connected!");
+				_Fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+				if (_Fd == -1) return false;
+				if (options.MaxSize) return _ConnectGrowable(bufferSize, options);
+				struct stat info;
+				if (fstat(_Fd, &info) != 0 || info.st_size == 0 || (size_t)info.st_size < bufferSize)
+				{
+					Close();
+					return false;
+				}
+				return _Map(bufferSize ? bufferSize : (size_t)info.st_size, options);
 			}
 
+			// get shared memory file descriptor, or -1 if not valid
+			inline int GetFd() const { return _Fd; }
+
 			/*!
-			* \fn	void Write(void* data, int dataLen = 0, int offset = 0)
+			* \fn	static bool Unlink(const std::string& path)
+			*
+			* \brief	Remove a shared memory name, for example one left behind by a crashed process.
+			* 			Processes already connected to it are not affected.
+			*
+			* \date		10/19/2026
+			*
+			* \param	path 				Shared memory file path.
+			*
+			* \return	If name existed and was removed.
+			*/
+			static bool Unlink(const std::string& path)
+			{
+				return shm_unlink(_ShmName(path).c_str()) == 0;
+			}
+
+			/*!
+			* \fn	bool Grow(size_t bufferSize)
+			*
+			* \brief	Grow a shared memory created with Options::MaxSize, for all processes using it.
+			* 			The buffer stays at the same address, so pointers into it remain valid. Other processes
+			* 			notice on their next read or write beyond their old size (or Refresh), and map the new part then.
+			* 			Any process may grow it; growing to a smaller size than current does nothing.
+			*
+			* \date		10/19/2026
+			*
+			* \param	bufferSize			New buffer size, at most MaxSize.
+			*
+			* \return	If succeed to grow the shared memory.
+			*/
+			bool Grow(size_t bufferSize)
+			{
+				if (!IsValid() || !_Base) throw std::runtime_error("Shared memory is not growable!");
+				__GrowableHeader* header = _GetHeader();
+				if (bufferSize > header->MaxSize) return false;
+
+				// size the file under a lock, so concurrent growers never shrink it. the lock is taken over from a dead
+				// grower; the size is published after the file is sized, so a grow cut short is just redone
+				bool success = true;
+				_LockOwned(header->GrowLock);
+				if (bufferSize > header->Size.load(std::memory_order_relaxed))
+				{
+					success = ftruncate(_Fd, (off_t)(sizeof(__GrowableHeader) + bufferSize)) == 0;
+					if (success)
+					{
+						header->Size.store(bufferSize, std::memory_order_release);
+						header->Generation.fetch_add(1, std::memory_order_release);
+					}
+				}
+				_UnlockOwned(header->GrowLock);
+				return success && Refresh();
+			}
+
+			/*!
+			* \fn	bool Refresh() const
+			*
+			* \brief	If another process grew the shared memory, map the new part now. Reads and writes do it by themselves,
+			* 			call this before accessing the buffer directly (GetBuffer) beyond GetSize().
+			*
+			* \date		10/19/2026
+			*
+			* \return	False if mapping the new part failed.
+			*/
+			bool Refresh() const
+			{
+				if (!_Base) return true;
+				__GrowableHeader* header = _GetHeader();
+				uint64_t generation = header->Generation.load(std::memory_order_acquire);
+				if (generation == _Generation.load(std::memory_order_acquire)) return true;
+
+				// threads sharing this client map one at a time, the size is published after the new part is mapped
+				std::lock_guard<std::mutex> lock(_RefreshLock);
+				if (generation == _Generation.load(std::memory_order_relaxed)) return true;
+				size_t bufferSize = (size_t)header->Size.load(std::memory_order_acquire);
+				if (!_MapMore(sizeof(__GrowableHeader) + bufferSize)) return false;
+				_BufferSize.store(bufferSize, std::memory_order_release);
+				_Generation.store(generation, std::memory_order_release);
+				return true;
+			}
+
+			// return if shared memory grew since this process last mapped it (cheap, a single load)
+			inline bool IsStale() const
+			{
+				return _Base && _GetHeader()->Generation.load(std::memory_order_relaxed) != _Generation.load(std::memory_order_relaxed);
+			}
+
+			// get how many times shared memory grew, 0 if it is not growable
+			inline uint64_t GetGeneration() const
+			{
+				return _Base ? _GetHeader()->Generation.load(std::memory_order_acquire) : 0;
+			}
+#endif
+
+			/*!
+			* \fn	void WriteBuffer(const void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto)
 			*
 			* \brief	Write to shared memory.
 			*
@@ -184,18 +1029,47 @@ namespace Just
 			* \param	data 				Data buffer to write.
 			* \param	dataLen				Data buffer size, in bytes. Must match data buffer. Default to shared memory size.
 			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
+			* \param	mode				(Optional) Copy strategy. By default large writes use non-temporal stores (see BulkCopy).
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			void WriteBuffer(const void* data, int dataLen = 0, int offset = 0)
+			void WriteBuffer(const void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto)
 			{
-				if (!IsValid()) throw new std::exception("Cannot call write when shared memory is not valid!");
+				if (!IsValid()) throw std::runtime_error("Cannot call write when shared memory is not valid!");
+				if (_ReadOnly) throw std::runtime_error("Cannot call write when shared memory is read only!");
 				if (dataLen == 0) dataLen = _BufferSize;
-				if (offset + dataLen > _BufferSize) throw new std::exception("Exceeded shared memory size!");
-				CopyMemory((PVOID)(_Buffer + offset), data, dataLen);
+				if (!_InRange(offset, dataLen)) throw std::runtime_error("Exceeded shared memory size!");
+				BulkCopy(_Buffer + offset, data, dataLen, mode);
+			}
+
+			/*!
+			* \fn	void WriteFields(const FieldWrite* fields, size_t count)
+			*
+			* \brief	Write many fields at once (scatter): one bounds check for the span they cover, one copy per field,
+			* 			then a single release fence, so a reader that acquires a flag written after this sees them all.
+			*
+			* \date		10/19/2026
+			*
+			* \param	fields 				Fields to write: offset in shared memory, data and size of each.
+			* \param	count				Number of fields.
+			* Note: if any field exceeds shared memory size will throw std::runtime_error, before writing anything.
+			*/
+			void WriteFields(const FieldWrite* fields, size_t count)
+			{
+				if (!IsValid()) throw std::runtime_error("Cannot call write when shared memory is not valid!");
+				if (_ReadOnly) throw std::runtime_error("Cannot call write when shared memory is read only!");
+				if (!_FieldsInRange(fields, count)) throw std::runtime_error("Exceeded shared memory size!");
+				for (size_t i = 0; i < count; ++i) memcpy(_Buffer + fields[i].Offset, fields[i].Data, fields[i].Size);
+				std::atomic_thread_fence(std::memory_order_release);
+			}
+
+			// write many fields at once, see WriteFields above
+			inline void WriteFields(std::initializer_list<FieldWrite> fields)
+			{
+				WriteFields(fields.begin(), fields.size());
 			}
 
 			/*!
-			* \fn	inline void Write(int val, int offset = 0)
+			* \fn	inline void WriteInt(int val, size_t offset = 0)
 			*
 			* \brief	Write an integer into shared memory.
 			*
@@ -204,15 +1078,15 @@ namespace Just
 			*
 			* \param	val 				Integer value to write.
 			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void WriteInt(int val, int offset = 0)
+			inline void WriteInt(int val, size_t offset = 0)
 			{
 				WriteBuffer(&val, sizeof(val), offset);
 			}
 
 			/*!
-			* \fn	inline void Write(bool val, int offset = 0)
+			* \fn	inline void WriteBool(bool val, size_t offset = 0)
 			*
 			* \brief	Write a bool into shared memory.
 			*
@@ -221,15 +1095,15 @@ namespace Just
 			*
 			* \param	val 				Bool value to write.
 			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void WriteBool(bool val, int offset = 0)
+			inline void WriteBool(bool val, size_t offset = 0)
 			{
 				WriteBuffer(&val, sizeof(val), offset);
 			}
 
 			/*!
-			* \fn	inline void Write(char val, int offset = 0)
+			* \fn	inline void WriteChar(char val, size_t offset = 0)
 			*
 			* \brief	Write a char into shared memory.
 			*
@@ -238,32 +1112,33 @@ namespace Just
 			*
 			* \param	val 				Char value to write.
 			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void WriteChar(char val, int offset = 0)
+			inline void WriteChar(char val, size_t offset = 0)
 			{
 				WriteBuffer(&val, sizeof(val), offset);
 			}
 
 			/*!
-			* \fn	inline void WriteStr(const LPCWSTR& val, int offset = 0)
+			* \fn	inline void WriteStr(const wchar_t* val, size_t offset = 0)
 			*
-			* \brief	Write a string into shared memory.
+			* \brief	Write a wide string into shared memory (without the null terminator).
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*
 			* \param	val 				String value to write.
 			* \param	offset				Offset in buffer to write into.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void WriteStr(const LPCWSTR& val, int offset = 0)
+			inline void WriteStr(const wchar_t* val, size_t offset = 0)
 			{
-				WriteBuffer(val, (int)(_tcslen(val) * sizeof(TCHAR)), offset);
+				size_t length = wcslen(val) * sizeof(wchar_t);
+				if (length) WriteBuffer(val, length, offset);
 			}
 
 			/*!
-			* \fn	void Read(void* data, int dataLen = 0, int offset = 0)
+			* \fn	void ReadBuffer(void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto) const
 			*
 			* \brief	Read from shared memory.
 			*
@@ -273,18 +1148,45 @@ namespace Just
 			* \param	data 				Data buffer to read into. Must be allocated and released by caller.
 			* \param	dataLen				Data buffer size, in bytes. Must match data buffer. Default to shared memory size.
 			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
+			* \param	mode				(Optional) Copy strategy. By default large reads use non-temporal stores into data (see BulkCopy).
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			void ReadBuffer(void* data, int dataLen = 0, int offset = 0) const
+			void ReadBuffer(void* data, size_t dataLen = 0, size_t offset = 0, CopyMode mode = CopyMode::Auto) const
 			{
-				if (!IsValid()) throw new std::exception("Cannot call read when shared memory is not valid!");
+				if (!IsValid()) throw std::runtime_error("Cannot call read when shared memory is not valid!");
 				if (dataLen == 0) dataLen = _BufferSize;
-				if (offset + dataLen > _BufferSize) throw new std::exception("Exceeded shared memory size!");
-				CopyMemory(data, (PVOID)(_Buffer + offset), dataLen);
+				if (!_InRange(offset, dataLen)) throw std::runtime_error("Exceeded shared memory size!");
+				BulkCopy(data, _Buffer + offset, dataLen, mode);
+			}
+
+			/*!
+			* \fn	void ReadFields(const FieldRead* fields, size_t count) const
+			*
+			* \brief	Read many fields at once (gather): a single acquire fence, one bounds check for the span they
+			* 			cover, then one copy per field.
+			*
+			* \date		10/19/2026
+			*
+			* \param	fields 				Fields to read: offset in shared memory, buffer to read into and size of each.
+			* \param	count				Number of fields.
+			* Note: if any field exceeds shared memory size will throw std::runtime_error, before reading anything.
+			*/
+			void ReadFields(const FieldRead* fields, size_t count) const
+			{
+				if (!IsValid()) throw std::runtime_error("Cannot call read when shared memory is not valid!");
+				if (!_FieldsInRange(fields, count)) throw std::runtime_error("Exceeded shared memory size!");
+				std::atomic_thread_fence(std::memory_order_acquire);
+				for (size_t i = 0; i < count; ++i) memcpy(fields[i].Data, _Buffer + fields[i].Offset, fields[i].Size);
+			}
+
+			// read many fields at once, see ReadFields above
+			inline void ReadFields(std::initializer_list<FieldRead> fields) const
+			{
+				ReadFields(fields.begin(), fields.size());
 			}
 
 			/*!
-			* \fn	inline void Read(int& out, int offset = 0) const
+			* \fn	inline void ReadInt(int& out, size_t offset = 0) const
 			*
 			* \brief	Read an integer from shared memory.
 			*
@@ -293,15 +1195,15 @@ namespace Just
 			*
 			* \param	out 				Integer value to read into.
 			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void ReadInt(int& out, int offset = 0) const
+			inline void ReadInt(int& out, size_t offset = 0) const
 			{
 				ReadBuffer(&out, sizeof(out), offset);
 			}
 
 			/*!
-			* \fn	inline void Read(bool& out, int offset = 0) const
+			* \fn	inline void ReadBool(bool& out, size_t offset = 0) const
 			*
 			* \brief	Read a bool from shared memory.
 			*
@@ -310,45 +1212,46 @@ namespace Just
 			*
 			* \param	val 				Bool value to read into.
 			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void ReadBool(bool& out, int offset = 0) const
+			inline void ReadBool(bool& out, size_t offset = 0) const
 			{
 				ReadBuffer(&out, sizeof(out), offset);
 			}
 
 			/*!
-			* \fn	inline void Read(char& out, int offset = 0) const
+			* \fn	inline void ReadChar(char& out, size_t offset = 0) const
 			*
-			* \brief	Read a bool from shared memory.
+			* \brief	Read a char from shared memory.
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*
 			* \param	val 				Char value to read into.
 			* \param	offset				Offset in buffer to read from.
-			* Note: if exceed shared memory size will throw exception.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void ReadChar(char& out, int offset = 0) const
+			inline void ReadChar(char& out, size_t offset = 0) const
 			{
 				ReadBuffer(&out, sizeof(out), offset);
 			}
 
 			/*!
-			* \fn	inline void ReadStr(TCHAR* out, int maxLen = 0) const
+			* \fn	inline void ReadStr(wchar_t* out, size_t maxLen = 0, size_t offset = 0) const
 			*
-			* \brief	Read the whole shared memory as a string.
+			* \brief	Read a wide string from shared memory.
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*
-			* \param	val 				Char* value to read into. Must be a buffer in the size of the shared memory.
-			* \param	maxLen 				Expected string len to read. If not provided, will read whole shared memory buffer.
-			* Note: if exceed shared memory size will throw exception.
+			* \param	val 				Buffer to read into. If maxLen is not provided, must be a buffer in the size of the shared memory.
+			* \param	maxLen 				Expected string len to read, in characters. If not provided, will read whole shared memory buffer.
+			* \param	offset				Offset in buffer to read from.
+			* Note: if exceed shared memory size will throw std::runtime_error.
 			*/
-			inline void ReadStr(TCHAR* out, int maxLen = 0) const
+			inline void ReadStr(wchar_t* out, size_t maxLen = 0, size_t offset = 0) const
 			{
-				ReadBuffer(out, maxLen * (sizeof(TCHAR) / sizeof(char)));
+				ReadBuffer(out, maxLen * sizeof(wchar_t), offset);
 			}
 
 			/*!
@@ -361,38 +1264,71 @@ namespace Just
 			*
 			* \return	If shared memory is initialized and ready.
 			*/
+#ifdef _WIN32
 			inline bool IsValid() const { return _MapFile != NULL && _Buffer != NULL; }
-			
+#else
+			inline bool IsValid() const { return _Fd != -1 && _Buffer != NULL; }
+#endif
+
 			/*!
-			* \fn	inline int GetSize() const
+			* \fn	inline size_t GetSize() const
 			*
-			* \brief	Get shared memory buffer size.
+			* \brief	Get shared memory buffer size. For growable memories, the size this process mapped so far.
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*
 			* \return	Shared memory buffer size.
 			*/
-			inline int GetSize() const { return _BufferSize; }
+			inline size_t GetSize() const { return _BufferSize; }
+
+			/*!
+			* \fn	inline char* GetBuffer() const
+			*
+			* \brief	Get the mapped shared memory, to access it directly.
+			*
+			* \date		10/19/2026
+			*
+			* \return	Shared memory buffer, or null if not valid.
+			*/
+			inline char* GetBuffer() const { return _Buffer; }
 
 			/*!
 			* \fn	void Close()
 			*
-			* \brief	Close this handle. 
+			* \brief	Close this handle.
 			* 			When all handles of a shared memory are closed, the platform may release it.
+			* 			On linux, if we created it with Options::UnlinkOnClose its name is removed, otherwise it stays
+			* 			until Unlink() is called.
 			*
 			* \author	Ronen Ness
 			* \date		11/13/2018
 			*/
 			void Close()
 			{
-				if (_Buffer) UnmapViewOfFile(_Buffer);
+#ifdef _WIN32
+				if (_Buffer) UnmapViewOfFile(_FileBase ? _FileBase : _Buffer);
 				if (_MapFile) CloseHandle(_MapFile);
-				_Buffer = NULL;
+				if (_File != INVALID_HANDLE_VALUE) CloseHandle(_File);
 				_MapFile = NULL;
+				_File = INVALID_HANDLE_VALUE;
+#else
+				if (_Base) munmap(_Base, _Reserved);
+				else if (_FileBase) munmap(_FileBase, _FileHeaderSize + _BufferSize);
+				else if (_Buffer) munmap(_Buffer, _BufferSize);
+				if (_Fd != -1) close(_Fd);
+				if (!_UnlinkName.empty()) shm_unlink(_UnlinkName.c_str());
+				_Fd = -1;
+				_UnlinkName.clear();
+				_Base = NULL;
+				_Reserved = _Mapped = 0;
+				_Generation = 0;
+#endif
+				_Buffer = NULL;
 				_BufferSize = 0;
+				_FileBase = NULL;
+				_ReadOnly = false;
 			}
 		};
 	}
 }
-#endif
\ No newline at end of file
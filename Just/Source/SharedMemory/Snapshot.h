@@ -0,0 +1,206 @@
+/*!
+* \file	Source\SharedMemory\Snapshot.h.
+*
+* \brief	Publish a value from one writer to many readers through shared memory, without locks (seqlock).
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include "SharedMemory.h"
+#include "SpscRing.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		/*!
+		* \struct	__SnapshotHeader
+		*
+		* \brief	Used internally, header of a snapshot in shared memory. Value words follow right after it.
+		* 			Sequence is odd while a write is in progress, and grows by 2 with every write.
+		*/
+		struct __SnapshotHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t ValueSize;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Sequence;
+		};
+
+		/*!
+		* \class	Snapshot
+		*
+		* \brief	A value of a trivially copyable type T in shared memory, written by one process and read by many.
+		* 			Uses a seqlock: the writer bumps a sequence number before and after writing, and readers retry
+		* 			if it changed while they copied. Readers always get a consistent copy, never block the writer,
+		* 			and make no syscalls. The value is copied as atomic 64 bit words, so concurrent copies are well
+		* 			defined. Best for small to medium values that are read much more often than written.
+		* 			Only one process may write at a time.
+		*
+		* \date		10/19/2026
+		*/
+		template <typename T>
+		class Snapshot
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+
+		private:
+
+			// magic value marking an initialized snapshot
+			static const uint64_t _Magic = 0x4a5553545345514cULL;
+
+			// value size, in 64 bit words
+			static const size_t _Words = (sizeof(T) + 7) / 8;
+
+			__SnapshotHeader* _Header = nullptr;
+			std::atomic<uint64_t>* _Value = nullptr;
+
+			// copy value words out. must be validated by the sequence afterwards
+			inline void _CopyOut(T& out) const
+			{
+				uint64_t words[_Words];
+				for (size_t i = 0; i < _Words; ++i) words[i] = _Value[i].load(std::memory_order_relaxed);
+				memcpy(&out, words, sizeof(T));
+			}
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Snapshot offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < RequiredSize()) throw std::runtime_error("Exceeded shared memory size!");
+				__SnapshotHeader* header = (__SnapshotHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __SnapshotHeader();
+					header->ValueSize = sizeof(T);
+					for (size_t i = 0; i < _Words; ++i) new ((std::atomic<uint64_t>*)(header + 1) + i) std::atomic<uint64_t>(0);
+				}
+				else if (header->Magic.load(std::memory_order_acquire) != _Magic || header->ValueSize != sizeof(T))
+				{
+					throw std::runtime_error("Shared memory does not contain a snapshot of this type!");
+				}
+				_Header = header;
+				_Value = (std::atomic<uint64_t>*)(header + 1);
+			}
+
+		public:
+
+			// get how many bytes of shared memory a snapshot needs
+			static inline size_t RequiredSize()
+			{
+				return sizeof(__SnapshotHeader) + _Words * sizeof(uint64_t);
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, const T& value = T())
+			*
+			* \brief	Initialize a new snapshot in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the snapshot.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the snapshot in.
+			* \param	offset				Offset of the snapshot in the shared memory, aligned to 64 bytes.
+			* \param	value				(Optional) Initial value.
+			* Note: throws std::runtime_error if memory is too small.
+			*/
+			void CreateNew(Client& memory, size_t offset, const T& value = T())
+			{
+				_Attach(memory, offset, true);
+				Write(value);
+				_Header->Magic.store(_Magic, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a snapshot another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the snapshot is in.
+			* \param	offset				Offset of the snapshot in the shared memory.
+			* Note: throws std::runtime_error if there is no snapshot of this type at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false);
+			}
+
+			// return if snapshot is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			/*!
+			* \fn	void Write(const T& value)
+			*
+			* \brief	Publish a new value. Never waits for readers.
+			*
+			* \date		10/19/2026
+			*
+			* \param	value				Value to publish.
+			*/
+			void Write(const T& value)
+			{
+				uint64_t words[_Words] = {};
+				memcpy(words, &value, sizeof(T));
+
+				uint64_t sequence = _Header->Sequence.load(std::memory_order_relaxed);
+				_Header->Sequence.store(sequence + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				for (size_t i = 0; i < _Words; ++i) _Value[i].store(words[i], std::memory_order_relaxed);
+				_Header->Sequence.store(sequence + 2, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	bool TryRead(T& out) const
+			*
+			* \brief	Try to read a consistent copy of the value once.
+			*
+			* \date		10/19/2026
+			*
+			* \param	out					Value to read into.
+			*
+			* \return	False if a write was in progress, out is then undefined.
+			*/
+			bool TryRead(T& out) const
+			{
+				uint64_t before = _Header->Sequence.load(std::memory_order_acquire);
+				if (before & 1) return false;
+				_CopyOut(out);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return _Header->Sequence.load(std::memory_order_relaxed) == before;
+			}
+
+			/*!
+			* \fn	T Read() const
+			*
+			* \brief	Read a consistent copy of the value, retrying while writes are in progress.
+			*
+			* \date		10/19/2026
+			*
+			* \return	Current value.
+			*/
+			T Read() const
+			{
+				T ret;
+				for (unsigned attempt = 0; !TryRead(ret); ++attempt)
+				{
+					// writer may be preempted in the middle of a write, don't burn its CPU
+					if (attempt >= 64) std::this_thread::yield();
+				}
+				return ret;
+			}
+
+			// get number of writes so far (changes whenever the value does)
+			inline uint64_t GetVersion() const
+			{
+				return _Header->Sequence.load(std::memory_order_acquire) / 2;
+			}
+		};
+	}
+}
@@ -0,0 +1,387 @@
+/*!
+* \file	Source\SharedMemory\SpscRing.h.
+*
+* \brief	Lock-free single producer / single consumer ring buffer of variable length records, inside a shared memory.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include "SharedMemory.h"
+
+namespace Just
+{
+	namespace SharedMemory
+	{
+		// size of a cache line, used to keep indexes written by different processes apart
+		const size_t _CacheLineSize = 64;
+
+		static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory structures need lock-free 64 bit atomics");
+
+		/*!
+		* \struct	__SpscRingHeader
+		*
+		* \brief	Used internally, header of a ring in shared memory. Data follows right after it.
+		* 			Head is written only by the producer and Tail only by the consumer, each on its own cache line.
+		*/
+		struct __SpscRingHeader
+		{
+			alignas(_CacheLineSize) std::atomic<uint64_t> Magic;
+			uint64_t Capacity;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Head;
+			alignas(_CacheLineSize) std::atomic<uint64_t> Tail;
+		};
+
+		/*!
+		* \class	SpscRing
+		*
+		* \brief	A ring buffer for streaming records from one process (or thread) to another through shared memory.
+		* 			Records have variable length and are stored contiguously, each with an 8 bytes frame, so they can
+		* 			be written and read in place (Reserve / Commit, Peek / Pop) without copying.
+		* 			Writes become visible to the reader only on Publish, so a batch of records costs one atomic store,
+		* 			and the reader acknowledges a batch with one store as well.
+		* 			Each side caches the other side's index, so the shared cache lines are touched only when needed.
+		* 			Exactly one producer and one consumer may use a ring at a time. Neither side ever blocks.
+		*
+		* \date		10/19/2026
+		*/
+		class SpscRing
+		{
+		private:
+
+			// magic value marking an initialized ring
+			static const uint64_t _Magic = 0x4a55535453505343ULL;
+
+			// record frame: payload size, followed by payload padded to 8 bytes
+			static const uint64_t _FrameSize = 8;
+
+			// frame size marking padding up to the end of the ring
+			static const uint32_t _WrapMarker = 0xffffffff;
+
+			__SpscRingHeader* _Header = nullptr;
+			char* _Data = nullptr;
+			uint64_t _Mask = 0;
+
+			// producer side: next write position, reserved record size, and cached consumer position
+			uint64_t _WritePosition = 0;
+			uint64_t _Reserved = 0;
+			bool _HasReservation = false;
+			uint64_t _CachedTail = 0;
+
+			// consumer side: next read position, and cached producer position
+			uint64_t _ReadPosition = 0;
+			uint64_t _CachedHead = 0;
+
+			// round up to frame alignment
+			static inline uint64_t _Align(uint64_t size) { return (size + 7) & ~(uint64_t)7; }
+
+			// attach to a header, checking the memory is big enough
+			void _Attach(Client& memory, size_t offset, bool create, size_t capacity)
+			{
+				if (!memory.IsValid()) throw std::runtime_error("Shared memory is not valid!");
+				if (offset % _CacheLineSize) throw std::runtime_error("Ring offset must be aligned to 64 bytes!");
+				if (offset > memory.GetSize() || memory.GetSize() - offset < sizeof(__SpscRingHeader)) throw std::runtime_error("Exceeded shared memory size!");
+				__SpscRingHeader* header = (__SpscRingHeader*)(memory.GetBuffer() + offset);
+				if (create)
+				{
+					new (header) __SpscRingHeader();
+					header->Capacity = capacity;
+					header->Head.store(0, std::memory_order_relaxed);
+					header->Tail.store(0, std::memory_order_relaxed);
+				}
+				else
+				{
+					if (header->Magic.load(std::memory_order_acquire) != _Magic) throw std::runtime_error("Shared memory does not contain a ring!");
+					capacity = (size_t)header->Capacity;
+				}
+				if (memory.GetSize() - offset < RequiredSize(capacity)) throw std::runtime_error("Exceeded shared memory size!");
+
+				_Header = header;
+				_Data = (char*)header + sizeof(__SpscRingHeader);
+				_Mask = capacity - 1;
+				_WritePosition = _CachedHead = header->Head.load(std::memory_order_acquire);
+				_ReadPosition = _CachedTail = header->Tail.load(std::memory_order_acquire);
+				_HasReservation = false;
+				if (create) header->Magic.store(_Magic, std::memory_order_release);
+			}
+
+		public:
+
+			/*!
+			* \fn	static inline size_t RequiredSize(size_t capacity)
+			*
+			* \brief	Get how many bytes of shared memory a ring needs.
+			*
+			* \date		10/19/2026
+			*
+			* \param	capacity			Ring data capacity, in bytes.
+			*
+			* \return	Bytes needed, including the header.
+			*/
+			static inline size_t RequiredSize(size_t capacity)
+			{
+				return sizeof(__SpscRingHeader) + capacity;
+			}
+
+			/*!
+			* \fn	void CreateNew(Client& memory, size_t offset, size_t capacity)
+			*
+			* \brief	Initialize a new, empty ring in a shared memory. Only one process should create it, others Connect.
+			* 			The shared memory must outlive the ring.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory to place the ring in.
+			* \param	offset				Offset of the ring in the shared memory, aligned to 64 bytes.
+			* \param	capacity			Ring data capacity, in bytes. Must be a power of 2, at least 64.
+			* Note: throws std::runtime_error if memory is too small or parameters are invalid.
+			*/
+			void CreateNew(Client& memory, size_t offset, size_t capacity)
+			{
+				if (capacity < 64 || (capacity & (capacity - 1))) throw std::runtime_error("Ring capacity must be a power of 2, at least 64!");
+				_Attach(memory, offset, true, capacity);
+			}
+
+			/*!
+			* \fn	void Connect(Client& memory, size_t offset)
+			*
+			* \brief	Connect to a ring another process created.
+			*
+			* \date		10/19/2026
+			*
+			* \param	memory 				Shared memory the ring is in.
+			* \param	offset				Offset of the ring in the shared memory.
+			* Note: throws std::runtime_error if there is no ring at this offset.
+			*/
+			void Connect(Client& memory, size_t offset)
+			{
+				_Attach(memory, offset, false, 0);
+			}
+
+			// return if ring is attached to a shared memory
+			inline bool IsValid() const { return _Header != nullptr; }
+
+			// get ring data capacity, in bytes
+			inline size_t GetCapacity() const { return (size_t)(_Mask + 1); }
+
+			// get max size of a single record: half the capacity, so a record always fits after wrapping, and below
+			// the wrap marker, since frames keep the size in 32 bits
+			inline size_t MaxRecordSize() const
+			{
+				uint64_t max = (_Mask + 1) / 2 - _FrameSize;
+				return (size_t)(max < _WrapMarker ? max : _WrapMarker - 1);
+			}
+
+			/*!
+			* \fn	char* Reserve(size_t size)
+			*
+			* \brief	Producer: reserve space for the next record, to write it in place.
+			* 			Call Commit when done writing, then Publish to make it visible.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size 				Record size, in bytes (at most MaxRecordSize).
+			*
+			* \return	Where to write the record, or null if there is not enough free space right now.
+			*/
+			char* Reserve(size_t size)
+			{
+				if (size > MaxRecordSize()) throw std::runtime_error("Record is too big for ring!");
+				uint64_t needed = _FrameSize + _Align(size);
+				uint64_t index = _WritePosition & _Mask;
+				uint64_t untilEnd = (_Mask + 1) - index;
+				uint64_t total = needed <= untilEnd ? needed : untilEnd + needed;
+
+				// check free space, refreshing consumer position only if cached one is not enough
+				uint64_t capacity = _Mask + 1;
+				if (_WritePosition + total - _CachedTail > capacity)
+				{
+					_CachedTail = _Header->Tail.load(std::memory_order_acquire);
+					if (_WritePosition + total - _CachedTail > capacity) return nullptr;
+				}
+
+				// record doesn't fit before end of ring? mark padding and wrap around
+				if (needed > untilEnd)
+				{
+					*(uint32_t*)(_Data + index) = _WrapMarker;
+					_WritePosition += untilEnd;
+					index = 0;
+				}
+				_Reserved = size;
+				_HasReservation = true;
+				return _Data + index + _FrameSize;
+			}
+
+			/*!
+			* \fn	void Commit(size_t size)
+			*
+			* \brief	Producer: finish writing the reserved record. It is not visible until Publish.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size 				Actual record size, can be smaller than reserved.
+			*/
+			void Commit(size_t size)
+			{
+				if (!_HasReservation || size > _Reserved) throw std::runtime_error("Invalid ring commit!");
+				*(uint32_t*)(_Data + (_WritePosition & _Mask)) = (uint32_t)size;
+				_WritePosition += _FrameSize + _Align(size);
+				_HasReservation = false;
+			}
+
+			/*!
+			* \fn	inline void Publish()
+			*
+			* \brief	Producer: make all committed records visible to the consumer.
+			*
+			* \date		10/19/2026
+			*/
+			inline void Publish()
+			{
+				_Header->Head.store(_WritePosition, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	bool Write(const void* data, size_t size, bool publish = true)
+			*
+			* \brief	Producer: copy a record into the ring.
+			*
+			* \date		10/19/2026
+			*
+			* \param	data 				Record data.
+			* \param	size 				Record size, in bytes.
+			* \param	publish				(Optional) If false, record is visible only on next Publish (to batch records).
+			*
+			* \return	False if there is not enough free space right now.
+			*/
+			bool Write(const void* data, size_t size, bool publish = true)
+			{
+				char* target = Reserve(size);
+				if (!target) return false;
+				memcpy(target, data, size);
+				Commit(size);
+				if (publish) Publish();
+				return true;
+			}
+
+			/*!
+			* \fn	const char* Peek(size_t& size)
+			*
+			* \brief	Consumer: get the next record in place, without removing it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	size 				Record size, in bytes.
+			*
+			* \return	Record data, or null if ring is empty.
+			*/
+			const char* Peek(size_t& size)
+			{
+				while (true)
+				{
+					if (_ReadPosition == _CachedHead)
+					{
+						_CachedHead = _Header->Head.load(std::memory_order_acquire);
+						if (_ReadPosition == _CachedHead) return nullptr;
+					}
+					uint64_t index = _ReadPosition & _Mask;
+					uint32_t frame = *(const uint32_t*)(_Data + index);
+					if (frame == _WrapMarker)
+					{
+						_ReadPosition += (_Mask + 1) - index;
+						continue;
+					}
+					size = frame;
+					return _Data + index + _FrameSize;
+				}
+			}
+
+			/*!
+			* \fn	void Pop(bool release = true)
+			*
+			* \brief	Consumer: remove the record returned by Peek.
+			*
+			* \date		10/19/2026
+			*
+			* \param	release				(Optional) If false, its space is given back to the producer only on next Release (to batch records).
+			*/
+			void Pop(bool release = true)
+			{
+				uint32_t frame = *(const uint32_t*)(_Data + (_ReadPosition & _Mask));
+				_ReadPosition += _FrameSize + _Align(frame);
+				if (release) Release();
+			}
+
+			/*!
+			* \fn	inline void Release()
+			*
+			* \brief	Consumer: give the space of all popped records back to the producer.
+			*
+			* \date		10/19/2026
+			*/
+			inline void Release()
+			{
+				_Header->Tail.store(_ReadPosition, std::memory_order_release);
+			}
+
+			/*!
+			* \fn	bool Read(std::string& out)
+			*
+			* \brief	Consumer: copy the next record out of the ring and remove it.
+			*
+			* \date		10/19/2026
+			*
+			* \param	out 				String to copy record into.
+			*
+			* \return	False if ring is empty.
+			*/
+			bool Read(std::string& out)
+			{
+				size_t size;
+				const char* data = Peek(size);
+				if (!data) return false;
+				out.assign(data, size);
+				Pop();
+				return true;
+			}
+
+			/*!
+			* \fn	template <typename Handler> size_t Consume(Handler handler, size_t maxRecords = (size_t)-1)
+			*
+			* \brief	Consumer: handle available records in place, as one batch: handler(const char* data, size_t size).
+			* 			Their space is released once, after the last record.
+			*
+			* \date		10/19/2026
+			*
+			* \param	handler				Called for every record.
+			* \param	maxRecords			(Optional) Max records to handle.
+			*
+			* \return	Number of records handled.
+			*/
+			template <typename Handler>
+			size_t Consume(Handler handler, size_t maxRecords = (size_t)-1)
+			{
+				size_t count = 0;
+				size_t size;
+				const char* data;
+				while (count < maxRecords && (data = Peek(size)) != nullptr)
+				{
+					handler(data, size);
+					Pop(false);
+					count++;
+				}
+				if (count) Release();
+				return count;
+			}
+
+			// return if there is nothing to read (consumer side; may be stale on producer side)
+			inline bool IsEmpty() const
+			{
+				return _ReadPosition == _Header->Head.load(std::memory_order_acquire);
+			}
+		};
+	}
+}
@@ -1,11 +1,32 @@
 import os
+import re
+
+# normalize path to the 'Folder\\File.h' form used as key
+def normalize(path):
+    return os.path.normpath(path).replace(os.sep, '\\')
+
+# convert key back to a path we can open
+def native(path):
+    return path.replace('\\', os.sep)
 
 # method to iterate file names
 def iterate_files(directory):
-    for root, _, files in os.walk(directory):
-        for file_name in files:
+    for root, dirs, files in os.walk(directory):
+        dirs.sort(key=str.lower)
+        for file_name in sorted(files, key=str.lower):
             file_path = os.path.join(root, file_name)
-            yield file_path
+            yield normalize(file_path)
+
+# get the local headers a file includes (headers included via 'All.h' are expanded)
+def local_includes(file_path):
+    content = files_content[file_path] if file_path in files_content else open(native(file_path), 'r').read()
+    for include in re.findall(r'#include "([^"]+)"', content):
+        include_path = normalize(os.path.join(os.path.dirname(native(file_path)), native(include)))
+        if include_path.endswith('\\All.h') or include_path == 'All.h':
+            for sub_include in local_includes(include_path):
+                yield sub_include
+        else:
+            yield include_path
 
 # iterate header files and build dictionary of file content
 files_content = {}
@@ -17,13 +38,27 @@ for directory in ['Strings', 'Files', 'Execute', 'Http', 'SharedMemory', 'DLLs']
         print(file_path)
         if file_path not in files_order:
             files_order.append(file_path)
-        files_content[file_path] = open(file_path, 'r').read()
-        
+        files_content[file_path] = open(native(file_path), 'r').read()
+
+# includes are commented out in the merged file, so every header must come after the headers it includes
+sorted_order = []
+visiting = set()
+def add_with_dependencies(file_path):
+    if file_path in sorted_order or file_path in visiting:
+        return
+    visiting.add(file_path)
+    for include in local_includes(file_path):
+        if include in files_content:
+            add_with_dependencies(include)
+    sorted_order.append(file_path)
+for file_path in files_order:
+    add_with_dependencies(file_path)
+
 # build unified output file
 outfile = open("../JustAll.h", 'w')
 outfile.write("#pragma once\n\n")
-for file_path in files_order:
+for file_path in sorted_order:
     content = files_content[file_path].replace("#pragma once", "// #pragma once").replace('#include "', '// #include "')
     outfile.write('\n\n// ::' + file_path + '::\n\n')
     outfile.write(content)
-    outfile.write('\n\n')
\ No newline at end of file
+    outfile.write('\n\n')
@@ -0,0 +1,118 @@
+/*!
+* \file	Tests\Benchmarks\BulkCopy.cpp.
+*
+* \brief	Benchmark: BulkCopy into shared memory, cached (memcpy) against streaming (non-temporal stores), for sizes
+* 			from 4 KB to 256 MB: copy bandwidth, and how long a 1 MB working set takes to walk right after the copy
+* 			(what the copy evicted from the cache). Also checks odd sizes and offsets, and WriteFields (linux).
+*
+* 			g++ -std=c++20 -O2 -pthread BulkCopy.cpp -o BulkCopy && ./BulkCopy
+*/
+#include "../../Source/SharedMemory/All.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace Just::SharedMemory;
+
+static const size_t _MaxSize = 256u << 20;
+static volatile uint64_t _Sink;
+
+// walk a working set, return microseconds it took
+static double Walk(const std::vector<uint64_t>& workingSet)
+{
+	auto start = std::chrono::steady_clock::now();
+	uint64_t sum = 0;
+	for (size_t i = 0; i < workingSet.size(); i += 8) sum += workingSet[i];
+	_Sink = sum;
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+#ifdef JUST_SHM_STREAMING_COPY
+	printf("AVX2: %s, L3 cache: %ld KB, streaming threshold: %zu KB\n\n", _HasAvx2() ? "yes" : "no", sysconf(_SC_LEVEL3_CACHE_SIZE) / 1024, GetStreamingThreshold() / 1024);
+#else
+	printf("No streaming stores on this architecture, both modes are memcpy\n\n");
+#endif
+	Client memory;
+	if (!memory.CreateAnonymous(_MaxSize + 4096))
+	{
+		printf("Error creating shared memory!\n");
+		return 1;
+	}
+	std::vector<char> source(_MaxSize, 7), target(_MaxSize);
+
+	// odd sizes and offsets, both ways, both modes
+	int errors = 0;
+	for (size_t size : { 1, 15, 31, 63, 127, 129, 1000, 4097, 100003 })
+	{
+		for (size_t offset : { 0, 1, 17, 33 })
+		{
+			for (size_t i = 0; i < size; ++i) source[i] = (char)(i * 31 + offset);
+			for (CopyMode mode : { CopyMode::Cached, CopyMode::Streaming })
+			{
+				memset(memory.GetBuffer(), 0, size + 64);
+				memory.WriteBuffer(source.data(), size, offset, mode);
+				if (memcmp(memory.GetBuffer() + offset, source.data(), size) != 0) errors++;
+				memory.ReadBuffer(target.data() + offset % 7, size, offset, mode);
+				if (memcmp(target.data() + offset % 7, source.data(), size) != 0) errors++;
+			}
+		}
+	}
+	printf("Odd sizes and offsets: %s\n\n", errors ? "FAILED" : "ok");
+
+	// bandwidth, and cost of walking a hot 1 MB working set after each copy
+	std::vector<uint64_t> workingSet(1u << 17, 1);
+	printf("%10s %14s %14s %18s %18s\n", "bytes", "cached GB/s", "stream GB/s", "walk after cached", "walk after stream");
+	for (size_t size = 4096; size <= _MaxSize; size *= 4)
+	{
+		int repeats = (int)std::max<size_t>(1, (1u << 30) / size);
+		double bandwidth[2], walk[2];
+		for (int m = 0; m < 2; ++m)
+		{
+			CopyMode mode = m ? CopyMode::Streaming : CopyMode::Cached;
+			auto start = std::chrono::steady_clock::now();
+			for (int r = 0; r < repeats; ++r) memory.WriteBuffer(source.data(), size, 0, mode);
+			bandwidth[m] = (double)size * repeats / std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+			const int rounds = 20;
+			walk[m] = 0;
+			for (int r = 0; r < rounds; ++r)
+			{
+				Walk(workingSet);
+				memory.WriteBuffer(source.data(), size, 0, mode);
+				walk[m] += Walk(workingSet) / rounds;
+			}
+		}
+		printf("%10zu %14.2f %14.2f %15.1f us %15.1f us\n", size, bandwidth[0], bandwidth[1], walk[0], walk[1]);
+	}
+
+	// a record of 4 fields: separate writes and a fence, against one WriteFields
+	uint64_t id = 1, flags = 2;
+	double price = 3;
+	char name[24] = "instrument";
+	const int count = 10000000;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i)
+	{
+		id = i;
+		memory.WriteBuffer(&id, 8, 0);
+		memory.WriteBuffer(&flags, 8, 8);
+		memory.WriteBuffer(&price, 8, 16);
+		memory.WriteBuffer(name, 24, 24);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+	double separate = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i)
+	{
+		id = i;
+		memory.WriteFields({ { 0, &id, 8 }, { 8, &flags, 8 }, { 16, &price, 8 }, { 24, name, 24 } });
+	}
+	double fields = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+	printf("\n4 field record: separate writes %.2f ns, WriteFields %.2f ns\n", separate, fields);
+	return errors ? 1 : 0;
+}
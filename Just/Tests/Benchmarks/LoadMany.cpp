@@ -0,0 +1,150 @@
+/*!
+* \file	Tests\Benchmarks\LoadMany.cpp.
+*
+* \brief	Benchmark: LoadMany against loading libraries one by one, with the files in and out of the page cache,
+* 			and how much loading from many threads actually overlaps (linux, needs a C compiler as cc).
+* 			Each measurement runs in a forked child, so every run starts with nothing loaded.
+*
+* 			g++ -std=c++20 -O2 -pthread LoadMany.cpp -o LoadMany -ldl && ./LoadMany
+*/
+#include "../../Source/DLLs/All.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Just::DLLs;
+
+// write a library source and compile it. relocations and data make the file big and its load real work
+static bool BuildLibrary(const std::string& folder, const std::string& name, int pointers, int dataKb, int initMicroseconds)
+{
+	std::string source = folder + "/" + name + ".c";
+	std::ofstream file(source);
+	file << "#include <unistd.h>\n";
+	file << "static int target;\n";
+	file << "int* " << name << "_table[" << pointers << "] = {";
+	for (int i = 0; i < pointers; ++i) file << "&target,";
+	file << "};\n";
+	file << "const char " << name << "_data[" << dataKb << " * 1024] = { 1 };\n";
+	file << "__attribute__((constructor)) static void init(void) { " << (initMicroseconds ? "usleep(" + std::to_string(initMicroseconds) + ");" : "") << " }\n";
+	file.close();
+	std::string command = "cc -shared -fPIC -O1 " + source + " -o " + folder + "/lib" + name + ".so";
+	return system(command.c_str()) == 0;
+}
+
+// drop files from the page cache, so reading them goes to disk
+static void Evict(const std::vector<std::string>& paths)
+{
+	for (const auto& path : paths)
+	{
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd == -1) continue;
+		fdatasync(fd);
+		posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+		close(fd);
+	}
+}
+
+// run work in a forked child and return the milliseconds it reports
+static double InChild(const std::function<double()>& work)
+{
+	int fds[2];
+	if (pipe(fds) != 0) return -1;
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		double ms = work();
+		if (write(fds[1], &ms, sizeof(ms)) != sizeof(ms)) _exit(1);
+		_exit(0);
+	}
+	close(fds[1]);
+	double ms = -1;
+	if (read(fds[0], &ms, sizeof(ms)) != sizeof(ms)) ms = -1;
+	close(fds[0]);
+	waitpid(pid, nullptr, 0);
+	return ms;
+}
+
+static double Milliseconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// load one by one
+static double LoadSequential(const std::vector<std::string>& paths)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (const auto& path : paths) if (!Load(path)) return -1;
+	return Milliseconds(start);
+}
+
+// load with LoadMany
+static double LoadAll(const std::vector<std::string>& paths)
+{
+	auto start = std::chrono::steady_clock::now();
+	if (!LoadMany(paths).IsSuccess()) return -1;
+	return Milliseconds(start);
+}
+
+// call Load from one thread per library
+static double LoadThreads(const std::vector<std::string>& paths)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (const auto& path : paths) threads.emplace_back([&path]() { Load(path); });
+	for (auto& thread : threads) thread.join();
+	return Milliseconds(start);
+}
+
+int main()
+{
+	std::string folder = (std::filesystem::temp_directory_path() / ("just_loadmany_" + std::to_string(getpid()))).string();
+	std::filesystem::create_directories(folder);
+
+	// big libraries (slow to read and relocate), and small ones with slow initializers
+	std::vector<std::string> big, slowInit;
+	for (int i = 0; i < 24; ++i)
+	{
+		std::string name = "big" + std::to_string(i);
+		if (!BuildLibrary(folder, name, 20000, 2048, 0)) { printf("Error compiling test libraries, is cc installed?\n"); return 1; }
+		big.push_back(folder + "/lib" + name + ".so");
+	}
+	for (int i = 0; i < 8; ++i)
+	{
+		std::string name = "init" + std::to_string(i);
+		if (!BuildLibrary(folder, name, 10, 1, 20000)) { printf("Error compiling test libraries, is cc installed?\n"); return 1; }
+		slowInit.push_back(folder + "/lib" + name + ".so");
+	}
+
+	// reading ahead overlaps with loading when the files are not cached
+	printf("%zu libraries of %zu KB each\n", big.size(), (size_t)(std::filesystem::file_size(big[0]) / 1024));
+	printf("%-34s %12s\n", "", "ms");
+	for (int round = 0; round < 3; ++round)
+	{
+		Evict(big);
+		printf("%-34s %12.1f\n", "Load one by one, cold cache", InChild([&]() { return LoadSequential(big); }));
+		Evict(big);
+		printf("%-34s %12.1f\n", "LoadMany, cold cache", InChild([&]() { return LoadAll(big); }));
+	}
+	printf("%-34s %12.1f\n", "Load one by one, warm cache", InChild([&]() { return LoadSequential(big); }));
+	printf("%-34s %12.1f\n\n", "LoadMany, warm cache", InChild([&]() { return LoadAll(big); }));
+
+	// loads themselves don't overlap: the dynamic loader holds its lock while running initializers,
+	// so one thread per library takes as long as loading one by one
+	printf("%zu libraries with a 20 ms initializer\n", slowInit.size());
+	printf("%-34s %12.1f\n", "Load one by one", InChild([&]() { return LoadSequential(slowInit); }));
+	printf("%-34s %12.1f\n", "Load on a thread per library", InChild([&]() { return LoadThreads(slowInit); }));
+	printf("%-34s %12.1f\n", "LoadMany", InChild([&]() { return LoadAll(slowInit); }));
+
+	std::error_code error;
+	std::filesystem::remove_all(folder, error);
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*!
+* \file	Tests\Benchmarks\MpmcQueue.cpp.
+*
+* \brief	Benchmark: MpmcQueue throughput with 1 to 32 producer and consumer processes, and a few uneven mixes.
+* 			Every item is a distinct number, consumers sum them (and their squares) to check each one
+* 			was delivered exactly once (linux).
+*
+* 			g++ -std=c++20 -O2 -pthread MpmcQueue.cpp -o MpmcQueue && ./MpmcQueue
+*/
+#include "../../Source/SharedMemory/All.h"
+#include <stdio.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <vector>
+
+using namespace Just::SharedMemory;
+
+static const size_t _Capacity = 1024;
+static const uint64_t _Items = 2000000;
+
+// counters shared by the consumers, after the queue
+struct Totals
+{
+	alignas(_CacheLineSize) std::atomic<uint64_t> Consumed;
+	alignas(_CacheLineSize) std::atomic<uint64_t> Sum;
+	std::atomic<uint64_t> SquaresSum;
+};
+
+// run producers and consumers, return millions of items per second, or -1 if an item was lost or duplicated
+static double Run(int producers, int consumers)
+{
+	const size_t queueSize = (MpmcQueue::RequiredSize(_Capacity, sizeof(uint64_t)) + _CacheLineSize - 1) / _CacheLineSize * _CacheLineSize;
+	Client memory;
+	if (!memory.CreateAnonymous(queueSize + sizeof(Totals))) return -1;
+	MpmcQueue queue;
+	queue.CreateNew(memory, 0, _Capacity, sizeof(uint64_t));
+	Totals* totals = new (memory.GetBuffer() + queueSize) Totals();
+
+	const uint64_t perProducer = _Items / producers;
+	const uint64_t total = perProducer * producers;
+	auto start = std::chrono::steady_clock::now();
+	std::vector<pid_t> children;
+	for (int p = 0; p < producers; ++p)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			for (uint64_t i = 0; i < perProducer; ++i)
+			{
+				uint64_t value = p * perProducer + i + 1;
+				while (!queue.TryPush(value)) sched_yield();
+			}
+			_exit(0);
+		}
+		children.push_back(pid);
+	}
+	for (int c = 0; c < consumers; ++c)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			uint64_t sum = 0, squares = 0, count = 0;
+			while (totals->Consumed.load(std::memory_order_relaxed) < total)
+			{
+				// count consumed items in batches, and whenever the queue is empty so the others can see we are done
+				uint64_t value;
+				if (!queue.TryPop(value))
+				{
+					totals->Consumed.fetch_add(count);
+					count = 0;
+					sched_yield();
+					continue;
+				}
+				sum += value;
+				squares += value * value;
+				if (++count == 256)
+				{
+					totals->Consumed.fetch_add(count);
+					count = 0;
+				}
+			}
+			totals->Sum.fetch_add(sum);
+			totals->SquaresSum.fetch_add(squares);
+			_exit(0);
+		}
+		children.push_back(pid);
+	}
+	for (pid_t pid : children) waitpid(pid, nullptr, 0);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// 1..total, each exactly once (sums wrap the same way on both sides)
+	uint64_t expectedSum = total * (total + 1) / 2, expectedSquares = 0;
+	for (uint64_t i = 1; i <= total; ++i) expectedSquares += i * i;
+	if (totals->Consumed.load() != total || totals->Sum.load() != expectedSum || totals->SquaresSum.load() != expectedSquares) return -1;
+	return total / seconds / 1e6;
+}
+
+int main()
+{
+	setvbuf(stdout, nullptr, _IONBF, 0);
+	printf("%-12s %-12s %20s\n", "producers", "consumers", "M items/s");
+	int errors = 0;
+	const int mixes[][2] = { { 1, 1 }, { 2, 2 }, { 4, 4 }, { 8, 8 }, { 16, 16 }, { 32, 32 }, { 1, 8 }, { 8, 1 }, { 1, 32 }, { 32, 1 } };
+	for (const auto& mix : mixes)
+	{
+		double rate = Run(mix[0], mix[1]);
+		if (rate < 0)
+		{
+			printf("%-12d %-12d %20s\n", mix[0], mix[1], "ERROR: items lost or duplicated");
+			errors++;
+		}
+		else printf("%-12d %-12d %20.2f\n", mix[0], mix[1], rate);
+	}
+	return errors ? 1 : 0;
+}
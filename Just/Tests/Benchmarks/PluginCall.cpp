@@ -0,0 +1,125 @@
+/*!
+* \file	Tests\Benchmarks\PluginCall.cpp.
+*
+* \brief	Benchmark: cost of calling a function through a Plugin, against a plain indirect call and GetMethod,
+* 			from 1 to 16 threads. Also calls from several threads while the plugin reloads, to check the swap is safe.
+* 			The same file builds the plugin library (linux):
+*
+* 			g++ -std=c++20 -O2 -shared -fPIC -DJUST_BENCHMARK_PLUGIN PluginCall.cpp -o PluginCallPlugin.so
+* 			g++ -std=c++20 -O2 -pthread PluginCall.cpp -o PluginCall -ldl && ./PluginCall ./PluginCallPlugin.so
+*/
+#ifdef JUST_BENCHMARK_PLUGIN
+
+extern "C" int compute(int value) { return value + 1; }
+extern "C" int version() { return 1; }
+
+#else
+#include "../../Source/DLLs/All.h"
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace Just::DLLs;
+
+// plugin interface
+struct Strategy
+{
+	int (*Compute)(int);
+	int (*Version)();
+	template <typename Binder> void Bind(Binder& bind) { bind("compute", Compute); bind("version", Version); }
+};
+
+// keep the compiler from inlining the indirect call
+__attribute__((noinline)) static int CallDirect(int (*function)(int), int count)
+{
+	int sum = 0;
+	for (int i = 0; i < count; ++i) sum += function(i);
+	return sum;
+}
+
+// nanoseconds per call of work, run count times
+template <typename Work>
+static double Nanoseconds(int count, Work work)
+{
+	auto start = std::chrono::steady_clock::now();
+	work(count);
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: PluginCall <plugin.so>\n");
+		return 1;
+	}
+	std::string path = std::filesystem::absolute(argv[1]).string();
+	Plugin<Strategy> plugin(path);
+	if (!plugin.IsLoaded())
+	{
+		printf("Error loading plugin: %s\n", plugin.GetError().c_str());
+		return 1;
+	}
+
+	// calls during reloads
+	std::atomic<bool> stop(false);
+	std::atomic<long> calls(0), errors(0);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&]() {
+			while (!stop)
+			{
+				auto guard = plugin.Acquire();
+				if (!guard || guard->Compute(10) != 10 + guard->Version()) errors++;
+				calls++;
+			}
+		});
+	}
+	for (int i = 0; i < 100; ++i) plugin.Reload();
+	stop = true;
+	for (auto& thread : threads) thread.join();
+	printf("Reload safety: %ld calls during %u reloads, %ld errors\n\n", calls.load(), plugin.GetReloadsCount(), errors.load());
+
+	// single thread call cost
+	const int count = 20000000;
+	volatile int sink = 0;
+	auto guard = plugin.Acquire();
+	int (*compute)(int) = guard->Compute;
+	printf("%-28s %10.2f ns\n", "plain indirect call", Nanoseconds(count, [&](int n) { sink = CallDirect(compute, n); }));
+	printf("%-28s %10.2f ns\n", "call through held guard", Nanoseconds(count, [&](int n) { for (int i = 0; i < n; ++i) sink = sink + guard->Compute(i); }));
+	printf("%-28s %10.2f ns\n", "Plugin::Call", Nanoseconds(count, [&](int n) { for (int i = 0; i < n; ++i) sink = sink + plugin.Call(&Strategy::Compute, i); }));
+	printf("%-28s %10.2f ns\n\n", "GetMethod per call", Nanoseconds(count / 10, [&](int n) { for (int i = 0; i < n; ++i) sink = sink + ((int (*)(int))GetMethod(path, "compute"))(i); }));
+
+	// Plugin::Call from many threads at once. each thread counts its calls in its own cache line, so the
+	// wall time per call should drop with threads up to the number of cores, and stay flat after that
+	printf("%-10s %24s\n", "threads", "wall ns per call (all)");
+	for (int threadsCount : { 1, 2, 4, 8, 16 })
+	{
+		const int perThread = count / threadsCount;
+		threads.clear();
+		std::atomic<int> ready(0);
+		std::atomic<bool> go(false);
+		for (int t = 0; t < threadsCount; ++t)
+		{
+			threads.emplace_back([&]() {
+				ready++;
+				while (!go) std::this_thread::yield();
+				int sum = 0;
+				for (int i = 0; i < perThread; ++i) sum += plugin.Call(&Strategy::Compute, i);
+				sink = sum;
+			});
+		}
+		while (ready < threadsCount) std::this_thread::yield();
+		auto start = std::chrono::steady_clock::now();
+		go = true;
+		for (auto& thread : threads) thread.join();
+		double wall = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		printf("%-10d %24.2f\n", threadsCount, wall / ((double)perThread * threadsCount));
+	}
+	return errors ? 1 : 0;
+}
+#endif
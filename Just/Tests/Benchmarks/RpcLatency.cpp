@@ -0,0 +1,207 @@
+/*!
+* \file	Tests\Benchmarks\RpcLatency.cpp.
+*
+* \brief	Benchmark: RpcChannel round trip latency against a unix socketpair, as percentiles and a histogram.
+* 			Also checks many clients get their own answers, and that a client leaving after a timed out call
+* 			does not get its slot reused while the server is still answering it (linux).
+*
+* 			g++ -std=c++20 -O2 -pthread RpcLatency.cpp -o RpcLatency && ./RpcLatency
+*/
+#include "../../Source/SharedMemory/All.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace Just::SharedMemory;
+
+static const int _Calls = 100000;
+static const size_t _PayloadSize = 64;
+
+// print percentiles and a histogram of latencies, in microseconds
+static void Report(const char* name, std::vector<double>& latencies)
+{
+	std::sort(latencies.begin(), latencies.end());
+	size_t count = latencies.size();
+	printf("%s: p50 %.2f us, p90 %.2f us, p99 %.2f us, p99.9 %.2f us, max %.2f us\n", name, latencies[count / 2],
+		latencies[count * 9 / 10], latencies[count * 99 / 100], latencies[count * 999 / 1000], latencies.back());
+
+	const double bounds[] = { 1, 2, 3, 4, 6, 8, 12, 16, 32, 64, 1e300 };
+	size_t index = 0;
+	double low = 0;
+	for (double bound : bounds)
+	{
+		size_t inBucket = 0;
+		while (index < count && latencies[index] < bound) { ++index; ++inBucket; }
+		char label[32];
+		if (bound > 1e299) snprintf(label, sizeof(label), ">= %g us", low);
+		else snprintf(label, sizeof(label), "%g - %g us", low, bound);
+		printf("  %-14s %7zu ", label, inBucket);
+		for (size_t i = 0; i < inBucket * 60 / count; ++i) putchar('#');
+		putchar('\n');
+		low = bound;
+	}
+	putchar('\n');
+}
+
+// echo server: flips the first byte, "slow" requests take 200 ms, "fail" throws, "quit" stops
+static void Serve(Client& memory)
+{
+	RpcChannel server;
+	server.Connect(memory, 0);
+	bool running = true;
+	while (running)
+	{
+		server.Serve([&](const void* request, size_t size, void* response, size_t) -> size_t {
+			if (size == 4 && !memcmp(request, "quit", 4)) running = false;
+			if (size == 4 && !memcmp(request, "fail", 4)) throw std::runtime_error("failed on purpose");
+			if (size == 4 && !memcmp(request, "slow", 4)) usleep(200000);
+			memcpy(response, request, size);
+			((char*)response)[0] ^= 1;
+			return size;
+		}, 100000);
+	}
+}
+
+int main()
+{
+	setvbuf(stdout, nullptr, _IONBF, 0);
+	int errors = 0;
+
+	Client memory;
+	if (!memory.CreateAnonymous(RpcChannel::RequiredSize(16, 4096)))
+	{
+		printf("Error creating shared memory!\n");
+		return 1;
+	}
+	{
+		RpcChannel channel;
+		channel.CreateNew(memory, 0, 16, 4096);
+	}
+	pid_t server = fork();
+	if (server == 0)
+	{
+		Serve(memory);
+		_exit(0);
+	}
+
+	// many clients at once, each must get the answers to its own requests
+	std::vector<pid_t> clients;
+	for (int c = 0; c < 8; ++c)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			RpcChannel channel;
+			channel.Connect(memory, 0);
+			if (!channel.Register()) _exit(1);
+			std::string response;
+			for (int i = 0; i < 20000; ++i)
+			{
+				char request[32];
+				int size = snprintf(request, sizeof(request), "client %d call %d", c, i);
+				if (!channel.Call(request, size, response)) _exit(1);
+				request[0] ^= 1;
+				if (response != std::string(request, size)) _exit(1);
+			}
+			_exit(0);
+		}
+		clients.push_back(pid);
+	}
+	for (pid_t pid : clients)
+	{
+		int status;
+		waitpid(pid, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status)) errors++;
+	}
+	printf("8 clients x 20000 calls: %s\n", errors ? "FAILED" : "ok");
+
+	// client leaves after a timed out call: its slot must not be handed out until the server answered
+	{
+		Client small;
+		small.CreateAnonymous(RpcChannel::RequiredSize(1, 64));
+		{
+			RpcChannel channel;
+			channel.CreateNew(small, 0, 1, 64);
+		}
+		pid_t slowServer = fork();
+		if (slowServer == 0)
+		{
+			Serve(small);
+			_exit(0);
+		}
+		std::string response;
+		{
+			RpcChannel leaving;
+			leaving.Connect(small, 0);
+			leaving.Register();
+			if (leaving.Call("slow", 4, response, 20000)) errors++;
+		}
+		RpcChannel next;
+		next.Connect(small, 0);
+		bool tookBusySlot = next.Register();
+		usleep(300000);
+		bool tookFreedSlot = !tookBusySlot && next.Register();
+		bool answered = tookFreedSlot && next.Call("next", 4, response, 1000000) && response == "oext";
+		if (tookBusySlot || !tookFreedSlot || !answered) errors++;
+		printf("Slot of abandoned call: %s\n\n", !tookBusySlot && tookFreedSlot && answered ? "ok" : "FAILED");
+		if (tookFreedSlot) next.Call("quit", 4, response, 1000000);
+		waitpid(slowServer, nullptr, 0);
+	}
+
+	// rpc round trips
+	char payload[_PayloadSize];
+	memset(payload, 'x', sizeof(payload));
+	std::vector<double> latencies(_Calls);
+	{
+		RpcChannel channel;
+		channel.Connect(memory, 0);
+		channel.Register();
+		for (int i = 0; i < _Calls; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			memcpy(channel.ReserveRequest(), payload, sizeof(payload));
+			const void* response;
+			size_t size;
+			channel.Call(sizeof(payload), response, size);
+			latencies[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+		}
+		Report("RpcChannel, 64 byte echo", latencies);
+		std::string response;
+		channel.Call("quit", 4, response);
+	}
+	waitpid(server, nullptr, 0);
+
+	// unix socketpair round trips
+	int sockets[2];
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets) != 0) return 1;
+	pid_t echo = fork();
+	if (echo == 0)
+	{
+		close(sockets[0]);
+		char buffer[4096];
+		ssize_t size;
+		while ((size = read(sockets[1], buffer, sizeof(buffer))) > 0)
+		{
+			buffer[0] ^= 1;
+			if (write(sockets[1], buffer, size) != size) break;
+		}
+		_exit(0);
+	}
+	close(sockets[1]);
+	for (int i = 0; i < _Calls; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		if (write(sockets[0], payload, sizeof(payload)) != (ssize_t)sizeof(payload) || read(sockets[0], payload, sizeof(payload)) <= 0) return 1;
+		latencies[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+	Report("unix socketpair, 64 byte echo", latencies);
+	close(sockets[0]);
+	waitpid(echo, nullptr, 0);
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/*!
+* \file	Tests\Benchmarks\SnapshotTorture.cpp.
+*
+* \brief	Torture test and benchmark of Snapshot (seqlock). A writer process rewrites a value as fast as it can while
+* 			reader processes check every copy they get is whole (all words from the same write) and never goes
+* 			back in time. The writer starts once all readers are reading, and a reader that got fewer than
+* 			_MinReads copies fails the run, since it checked nothing. Then measures read and write latency for
+* 			a few value sizes (linux).
+*
+* 			g++ -std=c++20 -O2 -pthread SnapshotTorture.cpp -o SnapshotTorture && ./SnapshotTorture
+*/
+#include "../../Source/SharedMemory/All.h"
+#include <stdio.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+using namespace Just::SharedMemory;
+
+// test values, every word holds the number of the write that made it
+template <size_t Words>
+struct Value
+{
+	uint64_t Data[Words];
+};
+
+static const uint64_t _Writes = 3000000;
+static const uint64_t _MinReads = 1000;
+static const int _Readers = 3;
+
+// writer and readers on one snapshot, return readers that saw a torn or stale value, or read too few times
+template <size_t Words>
+static int Torture(Client& memory, size_t offset)
+{
+	Snapshot<Value<Words>> snapshot;
+	snapshot.CreateNew(memory, offset);
+
+	// readers count themselves in here once they run, the writer waits for all of them
+	std::atomic<int>* ready = new (memory.GetBuffer() + memory.GetSize() - 64) std::atomic<int>(0);
+
+	pid_t writer = fork();
+	if (writer == 0)
+	{
+		while (ready->load() < _Readers) sched_yield();
+		Value<Words> value;
+		for (uint64_t i = 1; i <= _Writes; ++i)
+		{
+			for (auto& word : value.Data) word = i;
+			snapshot.Write(value);
+		}
+		_exit(0);
+	}
+	std::vector<pid_t> readers;
+	for (int r = 0; r < _Readers; ++r)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			uint64_t reads = 0, torn = 0, backwards = 0, last = 0;
+			ready->fetch_add(1);
+			while (last != _Writes)
+			{
+				Value<Words> value = snapshot.Read();
+				reads++;
+				for (auto word : value.Data) if (word != value.Data[0]) { torn++; break; }
+				if (value.Data[0] < last) backwards++;
+				last = value.Data[0];
+			}
+			printf("  reader %d: %llu reads, %llu torn, %llu went back%s\n", r, (unsigned long long)reads, (unsigned long long)torn,
+				(unsigned long long)backwards, reads < _MinReads ? ", too few reads" : "");
+			_exit(torn || backwards || reads < _MinReads ? 1 : 0);
+		}
+		readers.push_back(pid);
+	}
+	waitpid(writer, nullptr, 0);
+	int failed = 0;
+	for (pid_t pid : readers)
+	{
+		int status;
+		waitpid(pid, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status)) failed++;
+	}
+	return failed;
+}
+
+// nanoseconds per read and per write of an uncontended snapshot
+template <size_t Words>
+static void Latency(Client& memory, size_t offset)
+{
+	Snapshot<Value<Words>> snapshot;
+	snapshot.CreateNew(memory, offset);
+	const long count = 20000000 / (long)Words;
+	volatile uint64_t sink = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < count; ++i) sink = sink + snapshot.Read().Data[Words - 1];
+	double read = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+
+	Value<Words> value = {};
+	start = std::chrono::steady_clock::now();
+	for (long i = 0; i < count; ++i)
+	{
+		value.Data[0] = i;
+		snapshot.Write(value);
+	}
+	double write = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+	printf("%-10zu %14.1f %14.1f\n", sizeof(Value<Words>), read, write);
+}
+
+int main()
+{
+	setvbuf(stdout, nullptr, _IONBF, 0);
+	Client memory;
+	if (!memory.CreateAnonymous(1 << 16))
+	{
+		printf("Error creating shared memory!\n");
+		return 1;
+	}
+
+	int failed = 0;
+	// at least 2 words, so a torn copy can show
+	printf("Torture, 16 byte value, %llu writes, %d readers:\n", (unsigned long long)_Writes, _Readers);
+	failed += Torture<2>(memory, 0);
+	printf("Torture, 128 byte value:\n");
+	failed += Torture<16>(memory, 4096);
+	printf("Torture, 1 KB value:\n");
+	failed += Torture<128>(memory, 8192);
+	printf("%s\n\n", failed ? "FAILED" : "ok");
+
+	printf("%-10s %14s %14s\n", "bytes", "read ns", "write ns");
+	Latency<1>(memory, 0);
+	Latency<16>(memory, 4096);
+	Latency<128>(memory, 8192);
+	Latency<512>(memory, 16384);
+	return failed ? 1 : 0;
+}
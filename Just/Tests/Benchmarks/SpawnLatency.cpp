@@ -0,0 +1,91 @@
+/*!
+* \file	Tests\Benchmarks\SpawnLatency.cpp.
+*
+* \brief	Benchmark: child spawn latency per spawn method, as the parent's RSS grows (linux).
+* 			Also spawns from several threads while the spawn server starts and stops, to check switching is safe.
+*
+* 			g++ -std=c++20 -O2 -pthread SpawnLatency.cpp -o SpawnLatency && ./SpawnLatency
+*/
+#include "../../Source/Execute/All.h"
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Just::Execute;
+
+// average microseconds to spawn and wait for 'true'
+static double SpawnMicroseconds(int count)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i) Run({ "true" });
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+int main()
+{
+	// start the server while we are still small
+	if (!SpawnServer::Start())
+	{
+		printf("Error starting spawn server!\n");
+		return 1;
+	}
+	const char* names[] = { "Fork", "VFork", "PosixSpawn", "Server" };
+	const SpawnMethod methods[] = { SpawnMethod::Fork, SpawnMethod::VFork, SpawnMethod::PosixSpawn, SpawnMethod::Server };
+
+	// correctness of every method
+	int errors = 0;
+	for (SpawnMethod method : methods)
+	{
+		SetSpawnMethod(method);
+		ProcessOutput echo = Run({ "echo", "foo" });
+		if (echo.Output != "foo\n" || !echo.IsSuccess()) errors++;
+		if (Run({ "nonexistent-program-xyz" }).ReturnCode != 127) errors++;
+	}
+
+	// spawn from threads while the server starts and stops under them
+	SetSpawnMethod(SpawnMethod::Server);
+	std::atomic<bool> running(true);
+	std::atomic<int> threadErrors(0);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&]() {
+			while (running.load())
+			{
+				if (Run({ "echo", "x" }).Output != "x\n") threadErrors++;
+			}
+		});
+	}
+	for (int i = 0; i < 20; ++i)
+	{
+		SpawnServer::Stop();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		SpawnServer::Start();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	running = false;
+	for (auto& thread : threads) thread.join();
+	errors += threadErrors.load();
+	printf("correctness: %s\n", errors ? "FAILED" : "ok");
+
+	// latency as RSS grows. the server was forked small, so it is not affected
+	printf("%-8s", "RSS");
+	for (const char* name : names) printf(" %12s", name);
+	printf("\n");
+	for (size_t gigabytes : { 0, 1, 3 })
+	{
+		std::vector<char> memory(gigabytes << 30);
+		for (size_t i = 0; i < memory.size(); i += 4096) memory[i] = 1;
+		printf("%-8s", (std::to_string(gigabytes) + "GB").c_str());
+		for (SpawnMethod method : methods)
+		{
+			SetSpawnMethod(method);
+			printf(" %10.0fus", SpawnMicroseconds(50));
+		}
+		printf("\n");
+	}
+	SpawnServer::Stop();
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+/*!
+* \file	Tests\Benchmarks\SpscPingPong.cpp.
+*
+* \brief	Benchmark: SpscRing between two processes. Streams records of random sizes checking every byte,
+* 			measures throughput, and the round trip latency of ping-pong over two rings (linux).
+*
+* 			g++ -std=c++20 -O2 -pthread SpscPingPong.cpp -o SpscPingPong && ./SpscPingPong
+*/
+#include "../../Source/SharedMemory/All.h"
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace Just::SharedMemory;
+
+static const char* _Name = "just_bench_spsc";
+static const size_t _Capacity = 1 << 16;
+static const long _Records = 2000000;
+static const long _PingPongs = 200000;
+
+// next pseudo random record size, the same sequence on both sides
+static inline size_t NextSize(unsigned& seed)
+{
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 8) % 300;
+}
+
+int main()
+{
+	Client::Unlink(_Name);
+	Client memory;
+	if (!memory.CreateNew(_Name, 2 * SpscRing::RequiredSize(_Capacity)))
+	{
+		printf("Error creating shared memory!\n");
+		return 1;
+	}
+	const size_t secondOffset = SpscRing::RequiredSize(_Capacity);
+	SpscRing toParent, toChild;
+	toParent.CreateNew(memory, 0, _Capacity);
+	toChild.CreateNew(memory, secondOffset, _Capacity);
+
+	// stream: child produces records of random sizes, publishing every 16, parent checks them
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		Client childMemory;
+		childMemory.Connect(_Name);
+		SpscRing ring;
+		ring.Connect(childMemory, 0);
+		unsigned seed = 1;
+		char buffer[512];
+		for (long i = 0; i < _Records; ++i)
+		{
+			size_t size = NextSize(seed);
+			for (size_t k = 0; k < size; ++k) buffer[k] = (char)(i + k);
+			while (!ring.Write(buffer, size, (i % 16) == 15))
+			{
+				ring.Publish();
+				sched_yield();
+			}
+		}
+		ring.Publish();
+		_exit(0);
+	}
+	unsigned seed = 1;
+	long received = 0, errors = 0;
+	size_t bytes = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (received < _Records)
+	{
+		size_t count = toParent.Consume([&](const char* data, size_t size) {
+			if (size != NextSize(seed)) errors++;
+			else for (size_t k = 0; k < size; ++k) if (data[k] != (char)(received + k)) { errors++; break; }
+			bytes += size;
+			received++;
+		});
+		if (!count) sched_yield();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	waitpid(pid, nullptr, 0);
+	printf("Stream: %ld records, %ld errors, %.2f M records/s, %.0f MB/s\n\n", received, errors, received / seconds / 1e6, bytes / seconds / 1e6);
+
+	// ping-pong: parent writes a value, child echoes it back on the other ring
+	pid = fork();
+	if (pid == 0)
+	{
+		Client childMemory;
+		childMemory.Connect(_Name);
+		SpscRing in, out;
+		in.Connect(childMemory, secondOffset);
+		out.Connect(childMemory, 0);
+		for (long i = 0; i < _PingPongs; ++i)
+		{
+			size_t size;
+			const char* data;
+			while (!(data = in.Peek(size))) sched_yield();
+			long value;
+			memcpy(&value, data, sizeof(value));
+			in.Pop();
+			out.Write(&value, sizeof(value));
+		}
+		_exit(0);
+	}
+	std::vector<double> roundTrips(_PingPongs);
+	for (long i = 0; i < _PingPongs; ++i)
+	{
+		auto sent = std::chrono::steady_clock::now();
+		toChild.Write(&i, sizeof(i));
+		size_t size;
+		const char* data;
+		while (!(data = toParent.Peek(size))) sched_yield();
+		long value;
+		memcpy(&value, data, sizeof(value));
+		if (value != i) errors++;
+		toParent.Pop();
+		roundTrips[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - sent).count();
+	}
+	waitpid(pid, nullptr, 0);
+	std::sort(roundTrips.begin(), roundTrips.end());
+	printf("Ping-pong round trip, %ld messages (ns):\n", _PingPongs);
+	printf("%10s %10s %10s %10s %10s\n", "p50", "p90", "p99", "p99.9", "max");
+	printf("%10.0f %10.0f %10.0f %10.0f %10.0f\n", roundTrips[_PingPongs / 2], roundTrips[_PingPongs * 9 / 10],
+		roundTrips[_PingPongs * 99 / 100], roundTrips[_PingPongs * 999 / 1000], roundTrips.back());
+
+	Client::Unlink(_Name);
+	return errors ? 1 : 0;
+}